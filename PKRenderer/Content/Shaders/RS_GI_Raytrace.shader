@@ -154,14 +154,15 @@ void MainRms()
 
 void MainRchs()
 {
-    const float3 p0 = gl_HitTriangleVertexPositionsEXT[0];
-    const float3 p1 = gl_HitTriangleVertexPositionsEXT[1];
-    const float3 p2 = gl_HitTriangleVertexPositionsEXT[2];
+    // Static mesh positions are quantized & their instance transforms include a non uniform dequantization scale.
+    // Derive the normal from world space positions so that it is not skewed by the scale.
+    const float3 p0 = gl_ObjectToWorldEXT * float4(gl_HitTriangleVertexPositionsEXT[0], 1.0f);
+    const float3 p1 = gl_ObjectToWorldEXT * float4(gl_HitTriangleVertexPositionsEXT[1], 1.0f);
+    const float3 p2 = gl_ObjectToWorldEXT * float4(gl_HitTriangleVertexPositionsEXT[2], 1.0f);
     const float3 v0 = normalize(p1 - p0);
     const float3 v1 = normalize(p2 - p0);
 
-    float3 normal = cross(v0, v1);
-    normal = gl_ObjectToWorldEXT * float4(normal, 0.0f);
+    float3 normal = normalize(cross(v0, v1));
 
     if (dot(normal, gl_WorldRayDirectionEXT) > 0)
     {
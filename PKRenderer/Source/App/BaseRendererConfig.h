@@ -9,6 +9,12 @@ namespace PK::App
     {
         float TimeScale = 1.0f;
         uint32_t InactiveFrameInterval = 0u;
+        // Zero uses processor count - 1.
+        uint32_t WorkerThreadCount = 0u;
+        // Runs the update step of a frame on a worker thread while the previous frame is presented.
+        bool OverlapUpdateWithPresent = false;
+        // Stores static mesh vertex streams as snorm16. Disable to keep full precision float positions.
+        bool QuantizeStaticMeshes = true;
         RHIDriverDescriptor RHIDesc = {};
         WindowDescriptor WindowDesc = {};
         CVariablesYaml ConsoleVariables = {};
@@ -9,5 +9,7 @@ namespace PK::App
         AABB<float3> localAABB;
         PK_ECS_PRIVATE_FIELDS
         AABB<float3> worldAABB;
+        // Incremented when worldAABB changes. Used to validate cached visibility.
+        uint32_t version = 0u;
     };
 }
@@ -8,7 +8,7 @@ namespace PK::App
     struct ComponentLight
     {
         IESProfileRef IESProfile = nullptr;
-        color color = PK_COLOR_WHITE;
+        PK::color color = PK_COLOR_WHITE;
         float sourceRadius = 0.1f;
         float nearClip = 0.1f;
         float exponent = 8.0f;
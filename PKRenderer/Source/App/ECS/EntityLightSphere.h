@@ -18,7 +18,7 @@ namespace PK::App
             IESProfileRef IESProfile;
             float3 position;
             float3 rotation;
-            color color;
+            PK::color color;
             float angle;
             float radius;
             float sourceRadius;
@@ -1,4 +1,5 @@
 #include "PrecompiledHeader.h"
+#include "Core/Base/Hash.h"
 #include "Core/Input/InputState.h"
 #include "Core/Input/InputKeyConfig.h"
 #include "Core/Rendering/Font.h"
@@ -33,6 +34,15 @@ namespace PK::App
             const auto renderArea = gui->GUIGetRenderAreaRect();
             const short4 rectWindow(renderArea.x + 4, renderArea.y + 4, renderArea.z - 8, 32);
             const short4 rectText(rectWindow.x + 8, rectWindow.y + 4, rectWindow.z - 16, rectWindow.w - 8);
+            const auto isCaretVisible = m_caretTimer < 500u;
+            const auto listHash = Hash::MurmurHash(text.c_str(), text.Length(), Hash::MurmurHash(hint.c_str(), hint.Length(), Hash::FNV1AHash(&rectWindow, sizeof(rectWindow)) + isCaretVisible));
+
+            // Console contents rarely change between frames.
+            if (!gui->GUIBeginList(reinterpret_cast<uint64_t>(this), listHash))
+            {
+                return;
+            }
+
             gui->GUIDrawRect(COLOR_BG, rectWindow);
             gui->GUIDrawWireRect(COLOR_FG, rectWindow, 1);
             
@@ -46,10 +56,12 @@ namespace PK::App
             }
 
             // Draw wide box caret. Offsets hard coded as I can't be bothered to get the actual font data here. 
-            if (m_caretTimer < 500u)
+            if (isCaretVisible)
             {
                 gui->GUIDrawRect(COLOR_TEXT, short4(rectText.x + text.Length() * 8, rectText.y + 5, 6, rectText.w - 10));
             }
+
+            gui->GUIEndList();
         }
     }
 
@@ -84,12 +96,24 @@ namespace PK::App
             {
                 if (input->GetKeyDown(bindings[i].key))
                 {
-                    m_sequencer->NextRoot<CArgumentConst>({ bindings[i].command });
+                    QueueCommand(bindings[i].command);
                 }
             }
         }
     }
 
+    // Commands can touch any part of the engine, including the RHI.
+    // Execute them on the render thread as the update step may run on the update thread.
+    void EngineCommandInput::OnStepFrameRender([[maybe_unused]] FrameContext* ctx)
+    {
+        for (auto i = 0u; i < m_pendingCommandCount; ++i)
+        {
+            m_sequencer->NextRoot<CArgumentConst>({ m_pendingCommands[i].c_str() });
+        }
+
+        m_pendingCommandCount = 0u;
+    }
+
     void EngineCommandInput::Step(AssetImportEvent<Config<InputKeyConfig>>* evt)
     {
         m_inputKeyCommands.memory.Copy(evt->asset->InputKeyCommands.memory);
@@ -97,6 +121,17 @@ namespace PK::App
         evt->asset->CommandInputKeys.TryGetKey("Console.Toggle", &m_keyToggleConsole);
     }
 
+    void EngineCommandInput::QueueCommand(const char* command)
+    {
+        if (m_pendingCommandCount >= MAX_PENDING_COMMANDS)
+        {
+            PK_LOG_WARNING("EngineCommandInput.QueueCommand: Pending command limit reached. Discarding command '%s'.", command);
+            return;
+        }
+
+        m_pendingCommands[m_pendingCommandCount++] = FixedString<LINE_LENGTH>({ command });
+    }
+
     bool EngineCommandInput::ProcessConsoleInput(FrameContext* ctx)
     {
         auto& input = ctx->input.lastDeviceState.state;
@@ -104,7 +139,7 @@ namespace PK::App
 
         if (input->GetKeyDown(InputKey::Enter))
         {
-            m_sequencer->NextRoot<CArgumentConst>({ m_lines[m_lineEdit].c_str() });
+            QueueCommand(m_lines[m_lineEdit].c_str());
             m_lineEdit = (m_lineEdit + 1u) % LINE_COUNT;
             m_lineHistory = m_lineEdit;
             m_lines[m_lineEdit].Clear();
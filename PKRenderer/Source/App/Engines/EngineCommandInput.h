@@ -17,19 +17,23 @@ namespace PK::App
     struct EngineCommandInput : 
         public IStep<IGUIRenderer*>,
         public IStepFrameUpdate<>,
+        public IStepFrameRender<>,
         public IStep<AssetImportEvent<Config<InputKeyConfig>>*>
     {
         constexpr const static uint32_t LINE_COUNT = 32u;
         constexpr const static uint32_t LINE_LENGTH = 128u;
+        constexpr const static uint32_t MAX_PENDING_COMMANDS = 16u;
 
         EngineCommandInput(Sequencer* sequencer, InputKeyConfig* keyConfig);
 
         virtual void Step(IGUIRenderer* gui) final;
         virtual void OnStepFrameUpdate(FrameContext* ctx) final;
+        virtual void OnStepFrameRender(FrameContext* ctx) final;
         virtual void Step(AssetImportEvent<Config<InputKeyConfig>>* evt) final;
 
     private:
         bool ProcessConsoleInput(FrameContext* ctx);
+        void QueueCommand(const char* command);
 
         Sequencer* m_sequencer = nullptr;
         InputKeyCommandBindings m_inputKeyCommands;
@@ -37,6 +41,8 @@ namespace PK::App
         
         FixedString<LINE_LENGTH> m_lineHint;
         FixedString<LINE_LENGTH> m_lines[LINE_COUNT];
+        FixedString<LINE_LENGTH> m_pendingCommands[MAX_PENDING_COMMANDS];
+        uint32_t m_pendingCommandCount = 0u;
         uint32_t m_lineEdit = 0;
         uint32_t m_lineHistory = 0;
         int32_t m_hintIndex = 0;
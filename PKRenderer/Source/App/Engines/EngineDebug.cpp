@@ -58,7 +58,7 @@ namespace PK::App
             EntityMeshStatic::Descriptor desc;
             desc.entityName = "Floor";
             desc.entitySerialize = true;
-            desc.flags = ScenePrimitiveFlags::DefaultMesh;
+            desc.flags = ScenePrimitiveFlags::DefaultMesh | ScenePrimitiveFlags::Occluder;
             desc.mesh = planeMesh;
             desc.materials = { &material, 1u };
             desc.position = { 0.0f, -5.0f, 0.0f };
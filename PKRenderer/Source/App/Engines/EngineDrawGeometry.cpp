@@ -21,6 +21,31 @@ namespace PK::App
         m_gbufferAttribs.blending.colorMask = ColorMask::RGBA;
     }
 
+    // Picks the coarsest lod whose projected simplification error stays within the screen error limit.
+    // Culling depth is measured to the far side of the bounds. The near side is approximated from the bounds radius.
+    static uint16_t SelectSubmeshLod(const MeshStatic* mesh, uint16_t submesh, float farDepth, float znear, float scale, float pixelsPerUnit, float maxScreenError)
+    {
+        const auto& source = mesh->GetSubmesh(submesh);
+        const auto radius = math::length(source.bounds.extents()) * scale;
+        const auto depth = math::max(znear, farDepth - 2.0f * radius);
+        const auto projectedRadius = radius * pixelsPerUnit / depth;
+        auto selected = (uint32_t)submesh;
+
+        for (auto lod = 1u; lod <= source.lodCount; ++lod)
+        {
+            const auto lodSubmesh = mesh->GetLodSubmeshIndex(submesh, lod);
+
+            if (mesh->GetSubmesh((int32_t)lodSubmesh).lodError * projectedRadius > maxScreenError)
+            {
+                break;
+            }
+
+            selected = lodSubmesh;
+        }
+
+        return (uint16_t)selected;
+    }
+
     void EngineDrawGeometry::Step(RenderPipelineEvent* renderEvent)
     {
         auto view = renderEvent->context->views[0];
@@ -29,9 +54,12 @@ namespace PK::App
         {
             case RenderPipelineEvent::CollectDraws:
             {
+                const auto& geometrySettings = view->settings.GeometrySettings;
+
                 RequestEntityCullFrustum cullRequest;
                 cullRequest.mask = ScenePrimitiveFlags::Mesh;
                 cullRequest.matrix = view->worldToClip;
+                cullRequest.useOcclusion = geometrySettings.OcclusionCullingEnabled;
                 m_sequencer->Next(this, renderEvent->context->frameArena, &cullRequest);
                 view->primaryPassGroup = 0xFFFFFFFF;
 
@@ -39,19 +67,39 @@ namespace PK::App
                 {
                     view->primaryPassGroup = renderEvent->context->batcher->BeginNewGroup();
 
+                    // Culling depth is quantized over the frustum depth range.
+                    const auto depthScale = (view->zfar - view->znear) / (float)0xFFFF;
+                    // Pixels per world unit at unit view depth.
+                    const auto pixelsPerUnit = math::abs(view->viewToClip[1][1]) * 0.5f * view->GetResolution().y;
+
+                    if (geometrySettings.MeshletCutEnabled)
+                    {
+                        renderEvent->context->batcher->SetMeshletCut(view->worldToClip, 1.0f / pixelsPerUnit);
+                    }
+
                     for (auto i = 0u; i < cullRequest.GetCount(); ++i)
                     {
                         auto& info = cullRequest[i];
                         const auto entity = m_entityDb->Query<EntityViewMeshStatic>(info.entityId);
+                        const auto mesh = entity.staticMesh->sharedMesh.get();
+                        const auto farDepth = view->znear + info.depth * depthScale;
+                        const auto scale = math::cmax(math::abs(entity.transform->scale));
 
                         for (const auto& kv : entity.materials->materials)
                         {
+                            auto submesh = (uint16_t)kv.submesh;
+
+                            if (geometrySettings.LodEnabled)
+                            {
+                                submesh = SelectSubmeshLod(mesh, submesh, farDepth, view->znear, scale, pixelsPerUnit, geometrySettings.LodScreenError);
+                            }
+
                             renderEvent->context->batcher->SubmitMeshStaticDraw(
                                 entity.transform,
                                 kv.material->GetShader(),
                                 kv.material.get(), 
-                                entity.staticMesh->sharedMesh.get(), 
-                                (uint16_t)kv.submesh, 
+                                mesh, 
+                                submesh, 
                                 0u, 
                                 info.depth);
                         }
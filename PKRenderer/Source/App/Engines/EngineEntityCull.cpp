@@ -1,13 +1,234 @@
 #include "PrecompiledHeader.h"
-#include "Core/Base/Containers/FixedArena.h"
 #include "Core/Math/Extended.h"
+#include "Core/CLI/CVariableRegister.h"
+#include "Core/CLI/Log.h"
+#include "Core/ControlFlow/Sequencer.h"
+#include "Core/ControlFlow/WorkerPool.h"
 #include "Core/ECS/EntityDatabase.h"
 #include "Core/RHI/Structs.h"
 #include "App/ECS/EntityViewScenePrimitive.h"
+#include "App/ECS/EntityViewTransform.h"
 #include "EngineEntityCull.h"
 
 namespace PK::App
 {
+    // Returns the index of the first plane that rejects the bounds or the plane count if none do.
+    static uint32_t GetRejectingPlane(const AABB<float3>& aabb, const float4* planes, uint32_t count)
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            if (math::distanceToPlaneMax(aabb, planes[i]) < 0.0f)
+            {
+                return i;
+            }
+        }
+
+        return count;
+    }
+
+    EngineEntityCull::EngineEntityCull(EntityDatabase* entityDb, Sequencer* sequencer, WorkerPool* workerPool) :
+        m_entityDb(entityDb),
+        m_sequencer(sequencer),
+        m_workerPool(workerPool)
+    {
+        CVariableRegister::Create<CVariableFuncSimple>("Engine.EntityCull.Cache.Toggle", [this]()
+        {
+            m_cacheEnabled ^= true;
+
+            for (auto& view : m_cachedViews)
+            {
+                view.isValid = false;
+            }
+
+            PK_LOG_INFO("Engine.EntityCull.Cache: %s", m_cacheEnabled ? "Enabled" : "Disabled");
+        });
+    }
+
+    // Splits the entity range into slices that are culled in parallel.
+    // Each slice writes to its own range of a shared buffer sized for the worst case output of its entities.
+    // Slice results are gathered into the frame arena in slice order. This keeps the output identical to a serial pass.
+    template<typename TKernel>
+    ConstBufferView<CulledEntityInfo> EngineEntityCull::Dispatch(IArena* frameArena, uint32_t maxResultsPerEntity, float& minDepth, float& maxDepth, const TKernel& kernel)
+    {
+        auto entityViews = m_entityDb->Query<EntityViewScenePrimitive>();
+        auto entityCount = entityViews.count();
+        auto sliceCount = math::min((uint32_t)(entityCount / MIN_ENTITIES_PER_SLICE), math::min(m_workerPool->GetWorkerCount() * SLICES_PER_WORKER, MAX_SLICES));
+
+        // Not worth going wide. Write directly to the frame arena.
+        if (sliceCount <= 1u)
+        {
+            auto entityInfos = frameArena->GetHead<CulledEntityInfo>();
+            kernel(entityViews, frameArena, minDepth, maxDepth);
+            return { entityInfos, frameArena->GetHeadDelta(entityInfos) };
+        }
+
+        ConstBufferView<CulledEntityInfo> sliceResults[MAX_SLICES];
+        float sliceMinDepths[MAX_SLICES];
+        float sliceMaxDepths[MAX_SLICES];
+
+        m_sliceResults.Reserve(entityCount * maxResultsPerEntity, false);
+
+        m_workerPool->ParallelFor(sliceCount, [&](uint32_t index, [[maybe_unused]] uint32_t workerIndex)
+        {
+            auto first = (entityCount * index) / sliceCount;
+            auto last = (entityCount * (index + 1ull)) / sliceCount;
+            auto entityInfos = m_sliceResults.GetData() + first * maxResultsPerEntity;
+            BufferArena arena(entityInfos, sizeof(CulledEntityInfo) * (last - first) * maxResultsPerEntity);
+            sliceMinDepths[index] = minDepth;
+            sliceMaxDepths[index] = maxDepth;
+            kernel(entityViews.Slice(first, last - first), &arena, sliceMinDepths[index], sliceMaxDepths[index]);
+            sliceResults[index] = { entityInfos, arena.GetHeadDelta(entityInfos) };
+        });
+
+        for (auto i = 0u; i < sliceCount; ++i)
+        {
+            minDepth = math::min(minDepth, sliceMinDepths[i]);
+            maxDepth = math::max(maxDepth, sliceMaxDepths[i]);
+        }
+
+        return frameArena->Gather(sliceResults, sliceCount);
+    }
+
+    // Rasterizes the largest occluders by screen area & removes results that are fully behind them.
+    // Results are compacted in place. Returns the number of removed results.
+    uint32_t EngineEntityCull::CullOccluded(const float4x4& worldToClip, ConstBufferView<CulledEntityInfo>* results)
+    {
+        struct Occluder
+        {
+            float area;
+            uint32_t entityId;
+        };
+
+        Occluder occluders[MAX_OCCLUDERS];
+        auto occluderCount = 0u;
+
+        m_occlusionRasterizer.Clear(worldToClip);
+
+        for (auto i = 0u; i < results->count; ++i)
+        {
+            const auto entityId = results->data[i].entityId;
+            const auto entityView = m_entityDb->Query<EntityViewScenePrimitive>(entityId);
+
+            if ((entityView.primitive->flags & ScenePrimitiveFlags::Occluder) == 0u)
+            {
+                continue;
+            }
+
+            const auto area = m_occlusionRasterizer.GetScreenArea(entityView.bounds->worldAABB);
+
+            if (area < MIN_OCCLUDER_SCREEN_AREA || (occluderCount == MAX_OCCLUDERS && area <= occluders[MAX_OCCLUDERS - 1u].area))
+            {
+                continue;
+            }
+
+            // Sorted insert. Smallest occluder is dropped when full.
+            auto index = occluderCount < MAX_OCCLUDERS ? occluderCount++ : MAX_OCCLUDERS - 1u;
+
+            for (; index > 0u && occluders[index - 1u].area < area; --index)
+            {
+                occluders[index] = occluders[index - 1u];
+            }
+
+            occluders[index] = { area, entityId };
+        }
+
+        if (occluderCount == 0u)
+        {
+            return 0u;
+        }
+
+        for (auto i = 0u; i < occluderCount; ++i)
+        {
+            const auto entityView = m_entityDb->Query<EntityViewTransform>(occluders[i].entityId);
+            m_occlusionRasterizer.RasterizeBox(entityView.bounds->localAABB, entityView.transform->localToWorld);
+        }
+
+        m_occlusionRasterizer.Finalize();
+
+        auto entityInfos = const_cast<CulledEntityInfo*>(results->data);
+        auto visibleCount = 0u;
+
+        for (auto i = 0u; i < results->count; ++i)
+        {
+            const auto entityView = m_entityDb->Query<EntityViewScenePrimitive>(entityInfos[i].entityId);
+
+            if ((entityView.primitive->flags & ScenePrimitiveFlags::NeverCull) != 0 || m_occlusionRasterizer.TestAABB(entityView.bounds->worldAABB))
+            {
+                entityInfos[visibleCount++] = entityInfos[i];
+            }
+        }
+
+        const auto occludedCount = (uint32_t)results->count - visibleCount;
+        results->count = visibleCount;
+        return occludedCount;
+    }
+
+    // Finds the cached view closest to the matrix that has not been used this frame. Evicts the least recently used view if none match.
+    // Cached entities are only valid if the view is coherent. A large matrix delta is treated as a camera cut.
+    EngineEntityCull::CachedView* EngineEntityCull::GetCachedView(ScenePrimitiveFlags mask, const float4x4& matrix, uint32_t entityCount, bool* outIsCoherent)
+    {
+        CachedView* matchView = nullptr;
+        CachedView* oldestView = nullptr;
+        auto matchDelta = FLT_MAX;
+
+        for (auto& view : m_cachedViews)
+        {
+            // Views are used once per frame so that multiple views with the same mask dont thrash the same entry.
+            if (view.lastUsedFrame == m_frameIndex)
+            {
+                continue;
+            }
+
+            if (oldestView == nullptr || view.lastUsedFrame < oldestView->lastUsedFrame)
+            {
+                oldestView = &view;
+            }
+
+            if (view.isValid && view.mask == mask)
+            {
+                auto delta = 0.0f;
+                auto scale = 0.0f;
+
+                for (auto i = 0u; i < 4u; ++i)
+                {
+                    delta = math::max(delta, math::cmax(math::abs(matrix[i] - view.matrix[i])));
+                    scale = math::max(scale, math::cmax(math::abs(matrix[i])));
+                }
+
+                delta /= math::max(scale, 1e-6f);
+
+                if (delta < matchDelta)
+                {
+                    matchDelta = delta;
+                    matchView = &view;
+                }
+            }
+        }
+
+        *outIsCoherent = matchView != nullptr && matchDelta <= CACHE_CUT_THRESHOLD && matchView->entityCount == entityCount;
+        m_cacheInfo.requestCount++;
+
+        if (matchView != nullptr && !*outIsCoherent)
+        {
+            m_cacheInfo.invalidatedCount++;
+        }
+
+        auto view = matchView != nullptr ? matchView : oldestView;
+
+        if (view != nullptr)
+        {
+            view->mask = mask;
+            view->entityCount = entityCount;
+            view->lastUsedFrame = m_frameIndex;
+            view->isValid = true;
+            view->entities.Reserve(entityCount, *outIsCoherent);
+        }
+
+        return view;
+    }
+
+    // Visibility is cached per view & reused for entities whose bounds have not changed.
+    // Cached rejections are validated against the rejecting plane only. Entities revealed by view movement fail that test & are fully tested.
     void EngineEntityCull::Step(IArena* frameArena, RequestEntityCullFrustum* request)
     {
         auto cullingMask = request->mask;
@@ -18,30 +239,99 @@ namespace PK::App
         auto cullingMinDepth = cullingRange;
         auto cullingMaxDepth = 0.0f;
 
-        auto entityViews = m_entityDb->Query<EntityViewScenePrimitive>();
-        auto entityInfos = frameArena->GetHead<CulledEntityInfo>();
+        auto cacheIsCoherent = false;
+        auto cacheView = m_cacheEnabled ? GetCachedView(cullingMask, request->matrix, (uint32_t)m_entityDb->Query<EntityViewScenePrimitive>().count(), &cacheIsCoherent) : nullptr;
+        auto cacheViewIsStatic = cacheIsCoherent && memcmp(&cacheView->matrix, &request->matrix, sizeof(float4x4)) == 0;
+        auto cacheEntities = cacheView != nullptr ? cacheView->entities.GetData() : nullptr;
 
-        for (auto& entityView : entityViews)
+        request->outResults = Dispatch(frameArena, 1u, cullingMinDepth, cullingMaxDepth, [&](const auto& entityViews, IArena* arena, float& minDepth, float& maxDepth)
         {
-            auto viewFlags = entityView.primitive->flags;
+            auto cacheIndex = entityViews.first;
+            auto reusedCount = 0u;
+            auto retestedCount = 0u;
+            auto testedCount = 0u;
 
-            if ((viewFlags & cullingMask) == cullingMask)
+            for (auto& entityView : entityViews)
             {
-                if ((viewFlags & ScenePrimitiveFlags::NeverCull) != 0 || math::intersectsConvex(entityView.bounds->worldAABB, cullingPlanes.array_ptr(), 6))
+                auto viewFlags = entityView.primitive->flags;
+                auto entityId = *entityView.entityId;
+                auto cached = cacheEntities != nullptr ? cacheEntities + cacheIndex++ : nullptr;
+
+                if ((viewFlags & cullingMask) != cullingMask)
+                {
+                    if (cached != nullptr)
+                    {
+                        cached->state = CACHE_STATE_INVALID;
+                    }
+
+                    continue;
+                }
+
+                auto& entityBounds = entityView.bounds->worldAABB;
+                auto isUnchanged = cacheIsCoherent && cached->entityId == entityId && cached->boundsVersion == entityView.bounds->version && cached->state != CACHE_STATE_INVALID;
+                auto isVisible = false;
+                auto depth = 0.0f;
+
+                if (isUnchanged && cacheViewIsStatic)
+                {
+                    isVisible = cached->state == CACHE_STATE_VISIBLE;
+                    depth = cached->depth;
+                    reusedCount++;
+                }
+                else if (isUnchanged && cached->state != CACHE_STATE_VISIBLE && math::distanceToPlaneMax(entityBounds, cullingPlanes.array_ptr()[cached->state]) < 0.0f)
+                {
+                    retestedCount++;
+                }
+                else
+                {
+                    auto rejectingPlane = (viewFlags & ScenePrimitiveFlags::NeverCull) != 0 ? 6u : GetRejectingPlane(entityBounds, cullingPlanes.array_ptr(), 6u);
+                    isVisible = rejectingPlane == 6u;
+                    depth = isVisible ? math::distanceToPlaneMax(entityBounds, cullingPlanes.near()) : 0.0f;
+                    testedCount++;
+
+                    if (cached != nullptr)
+                    {
+                        *cached = { entityId, entityView.bounds->version, depth, isVisible ? CACHE_STATE_VISIBLE : (uint8_t)rejectingPlane };
+                    }
+                }
+
+                if (isVisible)
                 {
-                    auto depth = math::distanceToPlaneMax(entityView.bounds->worldAABB, cullingPlanes.near());
                     auto fixedDepth = math::min(0xFFFFu, (uint32_t)math::max(0.0f, depth * cullingInvRange));
-                    cullingMinDepth = math::min(cullingMinDepth, depth);
-                    cullingMaxDepth = math::max(cullingMaxDepth, depth);
-                    frameArena->Emplace<CulledEntityInfo>({ *entityView.entityId, (uint16_t)fixedDepth, 0u });
+                    minDepth = math::min(minDepth, depth);
+                    maxDepth = math::max(maxDepth, depth);
+                    arena->Emplace<CulledEntityInfo>({ entityId, (uint16_t)fixedDepth, 0u });
                 }
             }
+
+            if (cacheEntities != nullptr)
+            {
+                Platform::InterlockedAdd(&m_cacheInfo.reusedCount, reusedCount);
+                Platform::InterlockedAdd(&m_cacheInfo.retestedCount, retestedCount);
+                Platform::InterlockedAdd(&m_cacheInfo.testedCount, testedCount);
+            }
+        });
+
+        if (cacheView != nullptr)
+        {
+            cacheView->matrix = request->matrix;
         }
 
-        request->outResults = { entityInfos, frameArena->GetHeadDelta(entityInfos) };
         request->outMinDepth = cullingMinDepth;
         request->outMaxDepth = cullingMaxDepth;
         request->outDepthRange = cullingMaxDepth - cullingMinDepth;
+        request->outOccludedCount = request->useOcclusion ? CullOccluded(request->matrix, &request->outResults) : 0u;
+    }
+
+    void EngineEntityCull::OnStepFrameFinalize([[maybe_unused]] FrameContext* ctx)
+    {
+        if (m_sequencer != nullptr)
+        {
+            m_sequencer->Next(this, &m_cacheInfo);
+        }
+
+        m_cacheInfo = {};
+        m_frameIndex++;
     }
 
     void EngineEntityCull::Step(IArena* frameArena, RequestEntityCullCubeFaces* request)
@@ -58,63 +348,63 @@ namespace PK::App
         auto cullingMinDepth = cullingRange;
         auto cullingMaxDepth = 0.0f;
 
-        auto entityViews = m_entityDb->Query<EntityViewScenePrimitive>();
-        auto entityInfos = frameArena->GetHead<CulledEntityInfo>();
-
-        for (auto& entityView : entityViews)
+        auto entityResults = Dispatch(frameArena, 6u, cullingMinDepth, cullingMaxDepth, [&](const auto& entityViews, IArena* arena, float& minDepth, float& maxDepth)
         {
-            auto viewFlags = entityView.primitive->flags;
-            auto ignoreCulling = (viewFlags & ScenePrimitiveFlags::NeverCull) != 0;
-
-            if ((viewFlags & cullingMask) == cullingMask)
+            for (auto& entityView : entityViews)
             {
-                auto entityBounds = entityView.bounds->worldAABB;
+                auto viewFlags = entityView.primitive->flags;
+                auto ignoreCulling = (viewFlags & ScenePrimitiveFlags::NeverCull) != 0;
 
-                if (ignoreCulling || math::intersects(cullingBounds, entityBounds))
+                if ((viewFlags & cullingMask) == cullingMask)
                 {
-                    auto entityOffset = entityBounds.center() - cullingBoundsCenter;
-                    auto entityExtents = entityBounds.extents();
-                    bool rp[6], rn[6];
+                    auto entityBounds = entityView.bounds->worldAABB;
 
-                    // Source: https://newq.net/dl/pub/s2015_shadows.pdf
-                    for (auto j = 0u; j < 6u; ++j)
+                    if (ignoreCulling || math::intersects(cullingBounds, entityBounds))
                     {
-                        auto dist = math::dot(entityOffset, cubePlaneNormals[j]);
-                        auto radius = math::dot(entityExtents, cubePlaneNormalsAbs[j]);
-                        rp[j] = dist > -radius;
-                        rn[j] = dist < +radius;
-                    }
+                        auto entityOffset = entityBounds.center() - cullingBoundsCenter;
+                        auto entityExtents = entityBounds.extents();
+                        bool rp[6], rn[6];
 
-                    uint32_t isVisible = 0u;
-                    isVisible |= (uint32_t)(rn[0] && rp[1] && rp[2] && rp[3] && entityBounds.max.x > cullingBoundsCenter.x) << PK_RHI_CUBE_FACE_RIGHT;
-                    isVisible |= (uint32_t)(rp[0] && rn[1] && rn[2] && rn[3] && entityBounds.min.x < cullingBoundsCenter.x) << PK_RHI_CUBE_FACE_LEFT;
-                    isVisible |= (uint32_t)(rp[0] && rp[1] && rp[4] && rn[5] && entityBounds.max.y > cullingBoundsCenter.y) << PK_RHI_CUBE_FACE_UP;
-                    isVisible |= (uint32_t)(rn[0] && rn[1] && rn[4] && rp[5] && entityBounds.min.y < cullingBoundsCenter.y) << PK_RHI_CUBE_FACE_DOWN;
-                    isVisible |= (uint32_t)(rp[2] && rn[3] && rp[4] && rp[5] && entityBounds.max.z > cullingBoundsCenter.z) << PK_RHI_CUBE_FACE_FRONT;
-                    isVisible |= (uint32_t)(rn[2] && rp[3] && rn[4] && rn[5] && entityBounds.min.z < cullingBoundsCenter.z) << PK_RHI_CUBE_FACE_BACK;
-                    isVisible |= ignoreCulling ? ~0u : 0u;
+                        // Source: https://newq.net/dl/pub/s2015_shadows.pdf
+                        for (auto j = 0u; j < 6u; ++j)
+                        {
+                            auto dist = math::dot(entityOffset, cubePlaneNormals[j]);
+                            auto radius = math::dot(entityExtents, cubePlaneNormalsAbs[j]);
+                            rp[j] = dist > -radius;
+                            rn[j] = dist < +radius;
+                        }
 
-                    if (isVisible != 0u)
-                    {
-                        auto depth = math::distanceToExtents(entityOffset, entityExtents);
-                        auto fixedDepth = math::min(0xFFFFu, (uint32_t)math::max(0.0f, depth * cullingInvRange));
-                        auto entityId = *entityView.entityId;
+                        uint32_t isVisible = 0u;
+                        isVisible |= (uint32_t)(rn[0] && rp[1] && rp[2] && rp[3] && entityBounds.max.x > cullingBoundsCenter.x) << PK_RHI_CUBE_FACE_RIGHT;
+                        isVisible |= (uint32_t)(rp[0] && rn[1] && rn[2] && rn[3] && entityBounds.min.x < cullingBoundsCenter.x) << PK_RHI_CUBE_FACE_LEFT;
+                        isVisible |= (uint32_t)(rp[0] && rp[1] && rp[4] && rn[5] && entityBounds.max.y > cullingBoundsCenter.y) << PK_RHI_CUBE_FACE_UP;
+                        isVisible |= (uint32_t)(rn[0] && rn[1] && rn[4] && rp[5] && entityBounds.min.y < cullingBoundsCenter.y) << PK_RHI_CUBE_FACE_DOWN;
+                        isVisible |= (uint32_t)(rp[2] && rn[3] && rp[4] && rp[5] && entityBounds.max.z > cullingBoundsCenter.z) << PK_RHI_CUBE_FACE_FRONT;
+                        isVisible |= (uint32_t)(rn[2] && rp[3] && rn[4] && rn[5] && entityBounds.min.z < cullingBoundsCenter.z) << PK_RHI_CUBE_FACE_BACK;
+                        isVisible |= ignoreCulling ? ~0u : 0u;
 
-                        for (auto j = 0u; j < 6u; ++j)
+                        if (isVisible != 0u)
                         {
-                            if (isVisible & (1 << j))
+                            auto depth = math::distanceToExtents(entityOffset, entityExtents);
+                            auto fixedDepth = math::min(0xFFFFu, (uint32_t)math::max(0.0f, depth * cullingInvRange));
+                            auto entityId = *entityView.entityId;
+
+                            for (auto j = 0u; j < 6u; ++j)
                             {
-                                cullingMinDepth = math::min(cullingMinDepth, depth);
-                                cullingMaxDepth = math::max(cullingMaxDepth, depth);
-                                frameArena->Emplace<CulledEntityInfo>({ entityId, (uint16_t)fixedDepth, (uint16_t)j });
+                                if (isVisible & (1 << j))
+                                {
+                                    minDepth = math::min(minDepth, depth);
+                                    maxDepth = math::max(maxDepth, depth);
+                                    arena->Emplace<CulledEntityInfo>({ entityId, (uint16_t)fixedDepth, (uint16_t)j });
+                                }
                             }
                         }
                     }
                 }
             }
-        }
+        });
 
-        request->outResults = { entityInfos, frameArena->GetHeadDelta(entityInfos) };
+        request->outResults = entityResults;
         request->outMinDepth = cullingMinDepth;
         request->outMaxDepth = cullingMaxDepth;
         request->outDepthRange = cullingMaxDepth - cullingMinDepth;
@@ -151,49 +441,50 @@ namespace PK::App
 
         auto cullingMinDepth = cullingMaxDepth;
 
-        auto entityViews = m_entityDb->Query<EntityViewScenePrimitive>();
-        auto entityInfos = frameArena->GetHead<CulledEntityInfo>();
-
-        for (auto& entityView : entityViews)
+        auto entityResults = Dispatch(frameArena, cullingCascadeCount, cullingMinDepth, cullingMaxDepth, [&](const auto& entityViews, IArena* arena, float& minDepth, [[maybe_unused]] float& maxDepth)
         {
-            auto viewFlags = entityView.primitive->flags;
-
-            if ((viewFlags & cullingMask) == cullingMask)
+            for (auto& entityView : entityViews)
             {
-                auto ignoreCulling = (viewFlags & ScenePrimitiveFlags::NeverCull) != 0;
-                auto entityBounds = entityView.bounds->worldAABB;
-                auto isVisible = 0u;
+                auto viewFlags = entityView.primitive->flags;
 
-                for (auto j = 0u; j < cullingCascadeCount; ++j)
+                if ((viewFlags & cullingMask) == cullingMask)
                 {
-                    auto visibility = ignoreCulling ||
-                        (math::intersectsConvex(entityBounds, cullingCascadePlanes[j].array_ptr(), cullingCascadeTestPlaneCount) &&
-                         math::intersectsConvex(entityBounds, &cullingViewPlanes[j], 1u));
+                    auto ignoreCulling = (viewFlags & ScenePrimitiveFlags::NeverCull) != 0;
+                    auto entityBounds = entityView.bounds->worldAABB;
+                    auto isVisible = 0u;
 
-                    isVisible |= (uint32_t)visibility << j;
-                }
+                    for (auto j = 0u; j < cullingCascadeCount; ++j)
+                    {
+                        auto visibility = ignoreCulling ||
+                            (math::intersectsConvex(entityBounds, cullingCascadePlanes[j].array_ptr(), cullingCascadeTestPlaneCount) &&
+                             math::intersectsConvex(entityBounds, &cullingViewPlanes[j], 1u));
 
-                if (isVisible != 0u)
-                {
-                    auto entityId = *entityView.entityId;
+                        isVisible |= (uint32_t)visibility << j;
+                    }
 
-                    for (auto j = 0u; j < cullingCascadeCount; ++j)
+                    if (isVisible != 0u)
                     {
-                        if ((isVisible & (1 << j)) != 0u)
+                        auto entityId = *entityView.entityId;
+
+                        for (auto j = 0u; j < cullingCascadeCount; ++j)
                         {
-                            auto minDistLocal = math::distanceToPlaneMin(entityBounds, cullingCascadePlanes[j].near());
-                            cullingMinDepth = math::min(cullingMinDepth, minDistLocal);
-                            frameArena->Emplace<CulledEntityInfo>({ entityId, math::f32tof16(minDistLocal), (uint16_t)j });
+                            if ((isVisible & (1 << j)) != 0u)
+                            {
+                                auto minDistLocal = math::distanceToPlaneMin(entityBounds, cullingCascadePlanes[j].near());
+                                minDepth = math::min(minDepth, minDistLocal);
+                                arena->Emplace<CulledEntityInfo>({ entityId, math::f32tof16(minDistLocal), (uint16_t)j });
+                            }
                         }
                     }
                 }
             }
-        }
+        });
 
         // In case of 0 results this will also output 0 which should be taken into account by users.
-        const auto culledCount = frameArena->GetHeadDelta(entityInfos);
+        const auto culledCount = entityResults.count;
         const auto cullingRange = cullingMaxDepth - cullingMinDepth;
         const auto cullingInvRange = (float)0xFFFF / cullingRange;
+        auto entityInfos = const_cast<CulledEntityInfo*>(entityResults.data);
 
         for (auto i = 0u; i < culledCount; ++i)
         {
@@ -203,7 +494,7 @@ namespace PK::App
             info.depth = (uint16_t)fixedDepth;
         }
 
-        request->outResults = { entityInfos, culledCount };
+        request->outResults = entityResults;
         request->outMinDepth = cullingMinDepth;
         request->outMaxDepth = cullingMaxDepth;
         request->outDepthRange = cullingRange;
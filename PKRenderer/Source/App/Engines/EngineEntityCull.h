@@ -1,23 +1,76 @@
 #pragma once
+#include "Core/Base/Containers/ArrayList.h"
+#include "Core/Base/Containers/FixedArena.h"
 #include "Core/ControlFlow/IStep.h"
+#include "App/FrameStep.h"
 #include "App/Renderer/EntityCulling.h"
+#include "App/Renderer/OcclusionRasterizer.h"
 
 namespace PK { struct EntityDatabase; }
+namespace PK { class WorkerPool; }
+namespace PK { struct Sequencer; }
 
 namespace PK::App
 {
     class EngineEntityCull : 
         public IStep<IArena*, RequestEntityCullFrustum*>,
         public IStep<IArena*, RequestEntityCullCubeFaces*>,
-        public IStep<IArena*, RequestEntityCullCascades*>
+        public IStep<IArena*, RequestEntityCullCascades*>,
+        public IStepFrameFinalize<>
     {
+        constexpr static const uint32_t MIN_ENTITIES_PER_SLICE = 512u;
+        constexpr static const uint32_t SLICES_PER_WORKER = 4u;
+        constexpr static const uint32_t MAX_SLICES = 64u;
+        constexpr static const uint32_t MAX_OCCLUDERS = 32u;
+        // Screen area ratio below which entities are not considered as occluders.
+        constexpr static const float MIN_OCCLUDER_SCREEN_AREA = 0.005f;
+        constexpr static const uint32_t MAX_CACHED_VIEWS = 8u;
+        // Max matrix element delta relative to the largest element before a view change is considered a camera cut.
+        constexpr static const float CACHE_CUT_THRESHOLD = 0.1f;
+        constexpr static const uint8_t CACHE_STATE_VISIBLE = 0x80u;
+        constexpr static const uint8_t CACHE_STATE_INVALID = 0xFFu;
+
+        // Cached frustum visibility of an entity. Indexed by query order.
+        // State is either visible or the index of the plane that rejected the entity.
+        struct CachedEntity
+        {
+            uint32_t entityId;
+            uint32_t boundsVersion;
+            float depth;
+            uint8_t state;
+        };
+
+        struct CachedView
+        {
+            ScenePrimitiveFlags mask;
+            float4x4 matrix;
+            uint32_t entityCount = 0u;
+            uint64_t lastUsedFrame = 0ull;
+            bool isValid = false;
+            HeapArray<CachedEntity> entities;
+        };
+
     public:
-        EngineEntityCull(EntityDatabase* entityDb) : m_entityDb(entityDb) {};
+        EngineEntityCull(EntityDatabase* entityDb, Sequencer* sequencer, WorkerPool* workerPool);
         virtual void Step(IArena* frameArena, RequestEntityCullFrustum* request) final;
         virtual void Step(IArena* frameArena, RequestEntityCullCubeFaces* request) final;
         virtual void Step(IArena* frameArena, RequestEntityCullCascades* request) final;
+        virtual void OnStepFrameFinalize(FrameContext* ctx) final;
 
     private:
+        template<typename TKernel>
+        ConstBufferView<CulledEntityInfo> Dispatch(IArena* frameArena, uint32_t maxResultsPerEntity, float& minDepth, float& maxDepth, const TKernel& kernel);
+        uint32_t CullOccluded(const float4x4& worldToClip, ConstBufferView<CulledEntityInfo>* results);
+        CachedView* GetCachedView(ScenePrimitiveFlags mask, const float4x4& matrix, uint32_t entityCount, bool* outIsCoherent);
+
         EntityDatabase* m_entityDb = nullptr;
+        Sequencer* m_sequencer = nullptr;
+        WorkerPool* m_workerPool = nullptr;
+        HeapArray<CulledEntityInfo> m_sliceResults;
+        OcclusionRasterizer m_occlusionRasterizer;
+        CachedView m_cachedViews[MAX_CACHED_VIEWS];
+        EntityCullCacheInfo m_cacheInfo{};
+        uint64_t m_frameIndex = 1ull;
+        bool m_cacheEnabled = true;
     };
 }
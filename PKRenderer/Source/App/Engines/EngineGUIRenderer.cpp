@@ -72,20 +72,73 @@ namespace PK::App
     {
         m_gui_vertexCount = 0u;
         m_gui_indexCount = 0u;
+        m_gui_immediateIndexFirst = 0u;
+        m_gui_drawRanges.ClearFast();
         m_gui_renderAreaRect = renderArea;
-        m_gui_vertexView = {};
-        m_gui_indexView = {};
+        m_gui_hasDraws = false;
         m_gui_commandBuffer = m_gui_enabled ? &cmd : nullptr;
+        m_gui_frameIndex++;
 
         if (m_gui_enabled)
         {
             m_sequencer->Next<IGUIRenderer*>(this, this);
         }
 
-        if (m_gui_vertexView.data != nullptr)
+        PK_WARNING_ASSERT(m_gui_listActive == nullptr, "GUI list was not ended before the end of the frame!");
+        m_gui_listActive = nullptr;
+
+        // Close the trailing immediate range.
+        GUIPushDrawRange(GUI_LIST_INDEX_IMMEDIATE);
+
+        if (m_gui_drawRanges.GetCount() > 0u)
         {
-            cmd->EndBufferWrite(m_gui_vertexBuffer.get());
-            cmd->EndBufferWrite(m_gui_indexBuffer.get());
+            // Recreated buffers lose the resident region. Upload every list again.
+            auto isRecreated = RHI::ValidateBuffer<GUIVertex>(m_gui_vertexBuffer, m_gui_residentVertexCapacity + m_gui_vertexCount);
+            isRecreated |= RHI::ValidateBuffer<uint32_t>(m_gui_indexBuffer, m_gui_residentIndexCapacity + m_gui_indexCount);
+
+            if (isRecreated)
+            {
+                RHI::SetBuffer(HashCache::Get()->pk_GUI_Vertices, m_gui_vertexBuffer.get());
+
+                for (auto& list : m_gui_lists)
+                {
+                    list.isDirty = !list.isVolatile && list.indexCount > 0u;
+                }
+            }
+
+            for (auto& list : m_gui_lists)
+            {
+                if (list.isDirty)
+                {
+                    cmd.UploadBufferSubData(m_gui_vertexBuffer.get(), list.vertices.GetData(), sizeof(GUIVertex) * list.residentVertexFirst, sizeof(GUIVertex) * list.vertexCount);
+                    cmd.UploadBufferSubData(m_gui_indexBuffer.get(), list.indices.GetData(), sizeof(uint32_t) * list.residentIndexFirst, sizeof(uint32_t) * list.indexCount);
+                    list.isDirty = false;
+                }
+            }
+
+            if (m_gui_indexCount > 0u)
+            {
+                cmd.UploadBufferSubData(m_gui_vertexBuffer.get(), m_gui_vertices.GetData(), sizeof(GUIVertex) * m_gui_residentVertexCapacity, sizeof(GUIVertex) * m_gui_vertexCount);
+                cmd.UploadBufferSubData(m_gui_indexBuffer.get(), m_gui_indices.GetData(), sizeof(uint32_t) * m_gui_residentIndexCapacity, sizeof(uint32_t) * m_gui_indexCount);
+            }
+
+            for (auto i = 0u; i < m_gui_drawRanges.GetCount(); ++i)
+            {
+                auto& range = m_gui_drawRanges[i];
+
+                if (range.listIndex == GUI_LIST_INDEX_IMMEDIATE)
+                {
+                    range.firstIndex += m_gui_residentIndexCapacity;
+                    range.vertexOffset = (int32_t)m_gui_residentVertexCapacity;
+                }
+                else
+                {
+                    const auto& list = m_gui_lists[range.listIndex];
+                    range.firstIndex = list.residentIndexFirst;
+                    range.indexCount = list.indexCount;
+                    range.vertexOffset = (int32_t)list.residentVertexFirst;
+                }
+            }
         }
 
         m_gui_commandBuffer = nullptr;
@@ -93,13 +146,22 @@ namespace PK::App
 
     void EngineGUIRenderer::GUIDispatchDraws(CommandBufferExt& cmd, RHITexture* target)
     {
-        if (m_gui_vertexCount >= 2)
+        if (m_gui_drawRanges.GetCount() > 0u)
         {
             RHI::SetTextureSet(HashCache::Get()->pk_GUI_Textures, m_gui_textures.get());
-            cmd->SetIndexBuffer(m_gui_indexBuffer.get(), sizeof(uint16_t));
+            cmd->SetIndexBuffer(m_gui_indexBuffer.get(), sizeof(uint32_t));
             cmd.SetShader(m_gui_shader);
             cmd.SetRenderTarget({ target, LoadOp::Load, StoreOp::Store }, true);
-            cmd->DrawIndexed(math::min(GUI_MAX_INDICES, m_gui_indexCount), 1u, 0u, 0u, 0u);
+
+            for (auto i = 0u; i < m_gui_drawRanges.GetCount(); ++i)
+            {
+                const auto& range = m_gui_drawRanges[i];
+
+                if (range.indexCount > 0u)
+                {
+                    cmd->DrawIndexed(range.indexCount, 1u, range.firstIndex, range.vertexOffset, 0u);
+                }
+            }
         }
     }
 
@@ -112,27 +174,165 @@ namespace PK::App
             {
                 m_gui_shader = m_assetDatabase->Find<ShaderAsset>("VS_GUI").get();
                 m_gui_font = m_assetDatabase->Load<Font>("Content/Fonts/FSEX302.pkfont").get();
-                m_gui_vertexBuffer = RHI::CreateBuffer<GUIVertex>(GUI_MAX_VERTICES, BufferUsage::PersistentStorage, "GUI.VertexBuffer");
-                m_gui_indexBuffer = RHI::CreateBuffer<uint16_t>(GUI_MAX_INDICES, BufferUsage::DefaultIndex | BufferUsage::PersistentStage, "GUI.IndexBuffer");
+                // Not persistently staged. Each dirty list is uploaded separately & persistent stages only hold one write per frame in flight.
+                m_gui_vertexBuffer = RHI::CreateBuffer<GUIVertex>(m_gui_residentVertexCapacity + GUI_INITIAL_VERTICES, BufferUsage::DefaultStorage, "GUI.VertexBuffer");
+                m_gui_indexBuffer = RHI::CreateBuffer<uint32_t>(m_gui_residentIndexCapacity + GUI_INITIAL_INDICES, BufferUsage::DefaultIndex, "GUI.IndexBuffer");
                 m_gui_textures = RHI::CreateBindSet<RHITexture>(GUI_MAX_TEXTURES);
+                m_gui_vertices.Reserve(GUI_INITIAL_VERTICES, false);
+                m_gui_indices.Reserve(GUI_INITIAL_INDICES, false);
                 RHI::SetBuffer(HashCache::Get()->pk_GUI_Vertices, m_gui_vertexBuffer.get());
             }
 
             // Initialize draw state
-            if (m_gui_vertexView.data == nullptr)
+            if (!m_gui_hasDraws)
             {
-                m_gui_vertexView = m_gui_commandBuffer->BeginBufferWrite<GUIVertex>(m_gui_vertexBuffer.get());
-                m_gui_indexView = m_gui_commandBuffer->BeginBufferWrite<uint16_t>(m_gui_indexBuffer.get());
                 m_gui_textures->Clear();
                 m_gui_textures->Add(RHI::GetBuiltInResources()->WhiteTexture2D.get());
                 m_gui_textures->Add(RHI::GetBuiltInResources()->ErrorTexture2D.get());
                 m_gui_textures->Add(m_gui_font->GetRHI());
+                m_gui_hasDraws = true;
             }
         }
         
         return m_gui_commandBuffer != nullptr;
     }
 
+    // Returns the index of the first allocated vertex. Cpu side storage grows to fit the frame.
+    uint32_t EngineGUIRenderer::GUIAllocate(uint32_t vertexCount, uint32_t indexCount, GUIVertex** outVertices, uint32_t** outIndices)
+    {
+        const auto vertexFirst = m_gui_vertexCount;
+        const auto indexFirst = m_gui_indexCount;
+        m_gui_vertexCount += vertexCount;
+        m_gui_indexCount += indexCount;
+
+        if (m_gui_vertexCount > m_gui_vertices.GetCount())
+        {
+            m_gui_vertices.Reserve(math::max((size_t)m_gui_vertexCount, m_gui_vertices.GetCount() * 2ull), true);
+        }
+
+        if (m_gui_indexCount > m_gui_indices.GetCount())
+        {
+            m_gui_indices.Reserve(math::max((size_t)m_gui_indexCount, m_gui_indices.GetCount() * 2ull), true);
+        }
+
+        *outVertices = m_gui_vertices.GetData() + vertexFirst;
+        *outIndices = m_gui_indices.GetData() + indexFirst;
+        return vertexFirst;
+    }
+
+    // Lists keep their location while they fit. Otherwise they are appended to the resident region.
+    // Space left behind by moved lists is reclaimed by repacking all lists once the region is full.
+    void EngineGUIRenderer::GUIAllocateResident(GUIRetainedList* list)
+    {
+        if (list->vertexCount <= list->residentVertexCapacity && list->indexCount <= list->residentIndexCapacity)
+        {
+            return;
+        }
+
+        if (m_gui_residentVertexHead + list->vertexCount > m_gui_residentVertexCapacity ||
+            m_gui_residentIndexHead + list->indexCount > m_gui_residentIndexCapacity)
+        {
+            m_gui_residentVertexHead = 0u;
+            m_gui_residentIndexHead = 0u;
+
+            for (auto& other : m_gui_lists)
+            {
+                if (&other == list || other.isVolatile || other.indexCount == 0u)
+                {
+                    other.residentVertexCapacity = 0u;
+                    other.residentIndexCapacity = 0u;
+                    continue;
+                }
+
+                other.residentVertexFirst = m_gui_residentVertexHead;
+                other.residentVertexCapacity = other.vertexCount;
+                other.residentIndexFirst = m_gui_residentIndexHead;
+                other.residentIndexCapacity = other.indexCount;
+                other.isDirty = true;
+                m_gui_residentVertexHead += other.vertexCount;
+                m_gui_residentIndexHead += other.indexCount;
+            }
+
+            // Growing moves the immediate region & recreates the buffers on the next upload.
+            if (m_gui_residentVertexHead + list->vertexCount > m_gui_residentVertexCapacity)
+            {
+                m_gui_residentVertexCapacity = math::max(m_gui_residentVertexHead + list->vertexCount, m_gui_residentVertexCapacity * 2u);
+            }
+
+            if (m_gui_residentIndexHead + list->indexCount > m_gui_residentIndexCapacity)
+            {
+                m_gui_residentIndexCapacity = math::max(m_gui_residentIndexHead + list->indexCount, m_gui_residentIndexCapacity * 2u);
+            }
+        }
+
+        list->residentVertexFirst = m_gui_residentVertexHead;
+        list->residentVertexCapacity = list->vertexCount;
+        list->residentIndexFirst = m_gui_residentIndexHead;
+        list->residentIndexCapacity = list->indexCount;
+        m_gui_residentVertexHead += list->vertexCount;
+        m_gui_residentIndexHead += list->indexCount;
+    }
+
+    // Closes the open immediate range & optionally appends a retained list after it.
+    void EngineGUIRenderer::GUIPushDrawRange(uint32_t listIndex)
+    {
+        if (m_gui_indexCount > m_gui_immediateIndexFirst)
+        {
+            m_gui_drawRanges.Add(GUIDrawRange{ GUI_LIST_INDEX_IMMEDIATE, m_gui_immediateIndexFirst, m_gui_indexCount - m_gui_immediateIndexFirst, 0 });
+        }
+
+        m_gui_immediateIndexFirst = m_gui_indexCount;
+
+        if (listIndex != GUI_LIST_INDEX_IMMEDIATE)
+        {
+            m_gui_drawRanges.Add(GUIDrawRange{ listIndex, 0u, 0u, 0 });
+        }
+    }
+
+    // Layouts are cached per string, area & style.
+    // Strings are mostly either stable or change every frame. The cache is simply flushed once full.
+    const FontRect* EngineGUIRenderer::GUICalculateTextRects(const char* text, const short4& rect, const FontStyle& style, uint32_t* outCount)
+    {
+        struct LayoutKey
+        {
+            short4 rect;
+            float2 align;
+            float2 spacing;
+            float size;
+            uint32_t flags;
+        };
+
+        const LayoutKey layoutKey{ rect, style.align, style.spacing, style.size, (uint32_t)style.wrap | ((uint32_t)style.clip << 1u) };
+        const auto hash = Hash::MurmurHash(text, strlen(text), Hash::FNV1AHash(&layoutKey, sizeof(LayoutKey)));
+        const auto layout = m_gui_textLayouts.GetValuePtr(hash);
+
+        if (layout != nullptr)
+        {
+            *outCount = layout->rectCount;
+            return m_gui_textRects.GetData() + layout->rectFirst;
+        }
+
+        const auto maxRects = Font::CalculateMaxRectCount(text, m_gui_font);
+
+        if (m_gui_textRectCount + maxRects > GUI_MAX_CACHED_TEXT_RECTS)
+        {
+            m_gui_textLayouts.Clear();
+            m_gui_textRectCount = 0u;
+        }
+
+        if (m_gui_textRectCount + maxRects > m_gui_textRects.GetCount())
+        {
+            m_gui_textRects.Reserve(math::max((size_t)(m_gui_textRectCount + maxRects), m_gui_textRects.GetCount() * 2ull), true);
+        }
+
+        auto rects = m_gui_textRects.GetData() + m_gui_textRectCount;
+        auto rectCount = maxRects > 0u ? Font::CalculateRects(text, m_gui_font, rect, rect, style, rects, maxRects) : 0u;
+        m_gui_textLayouts.AddValue(hash, { m_gui_textRectCount, rectCount });
+        m_gui_textRectCount += rectCount;
+        *outCount = rectCount;
+        return rects;
+    }
+
     uint16_t EngineGUIRenderer::GUIAddTexture(RHITexture* texture)
     {
         if (!GUIValidateDraw())
@@ -147,6 +347,11 @@ namespace PK::App
             return GUI_TEX_INDEX_ERROR;
         }
 
+        if (m_gui_listActive != nullptr)
+        {
+            m_gui_listActive->isVolatile = true;
+        }
+
         return (uint16_t)m_gui_textures->Add(texture);
     }
 
@@ -154,20 +359,15 @@ namespace PK::App
     {
         if (GUIValidateDraw())
         {
-            auto idxv = m_gui_vertexCount;
-            auto idxi = m_gui_indexCount;
-            m_gui_vertexCount += 3u;
-            m_gui_indexCount += 3u;
-
-            if (m_gui_vertexCount <= GUI_MAX_VERTICES && m_gui_indexCount <= GUI_MAX_INDICES)
-            {
-                m_gui_indexView[idxi++] = idxv + 0u;
-                m_gui_indexView[idxi++] = idxv + 1u;
-                m_gui_indexView[idxi++] = idxv + 2u;
-                m_gui_vertexView[idxv++] = a;
-                m_gui_vertexView[idxv++] = b;
-                m_gui_vertexView[idxv++] = c;
-            }
+            GUIVertex* vertices;
+            uint32_t* indices;
+            auto idxv = GUIAllocate(3u, 3u, &vertices, &indices);
+            indices[0] = idxv + 0u;
+            indices[1] = idxv + 1u;
+            indices[2] = idxv + 2u;
+            vertices[0] = a;
+            vertices[1] = b;
+            vertices[2] = c;
         }
     }
 
@@ -180,27 +380,23 @@ namespace PK::App
     {
         if (GUIValidateDraw())
         {
-            auto idxv = m_gui_vertexCount;
-            auto idxi = m_gui_indexCount;
-            m_gui_vertexCount += 4u;
-            m_gui_indexCount += 6u;
-
-            if (m_gui_vertexCount <= GUI_MAX_VERTICES && m_gui_indexCount <= GUI_MAX_INDICES)
-            {
-                const short4 sminmax = short4(rect.x, rect.y, rect.x + rect.z, rect.y + rect.w);
-                const float4 tminmax = float4(textureRect.x, textureRect.y, textureRect.x + textureRect.z, textureRect.y + textureRect.w);
-                const float2 texelSize = (1.0f / float3(m_gui_textures->GetBoundTextureSize(textureIndex))).xy;
-                m_gui_indexView[idxi++] = idxv + 0u;
-                m_gui_indexView[idxi++] = idxv + 1u;
-                m_gui_indexView[idxi++] = idxv + 2u;
-                m_gui_indexView[idxi++] = idxv + 2u;
-                m_gui_indexView[idxi++] = idxv + 3u;
-                m_gui_indexView[idxi++] = idxv + 0u;
-                m_gui_vertexView[idxv++] = { color, sminmax.xy, math::f32tof16(tminmax.xy * texelSize), textureIndex, 0u };
-                m_gui_vertexView[idxv++] = { color, sminmax.xw, math::f32tof16(tminmax.xw * texelSize), textureIndex, 0u };
-                m_gui_vertexView[idxv++] = { color, sminmax.zw, math::f32tof16(tminmax.zw * texelSize), textureIndex, 0u };
-                m_gui_vertexView[idxv++] = { color, sminmax.zy, math::f32tof16(tminmax.zy * texelSize), textureIndex, 0u };
-            }
+            GUIVertex* vertices;
+            uint32_t* indices;
+            auto idxv = GUIAllocate(4u, 6u, &vertices, &indices);
+
+            const short4 sminmax = short4(rect.x, rect.y, rect.x + rect.z, rect.y + rect.w);
+            const float4 tminmax = float4(textureRect.x, textureRect.y, textureRect.x + textureRect.z, textureRect.y + textureRect.w);
+            const float2 texelSize = (1.0f / float3(m_gui_textures->GetBoundTextureSize(textureIndex))).xy;
+            indices[0] = idxv + 0u;
+            indices[1] = idxv + 1u;
+            indices[2] = idxv + 2u;
+            indices[3] = idxv + 2u;
+            indices[4] = idxv + 3u;
+            indices[5] = idxv + 0u;
+            vertices[0] = { color, sminmax.xy, math::f32tof16(tminmax.xy * texelSize), textureIndex, 0u };
+            vertices[1] = { color, sminmax.xw, math::f32tof16(tminmax.xw * texelSize), textureIndex, 0u };
+            vertices[2] = { color, sminmax.zw, math::f32tof16(tminmax.zw * texelSize), textureIndex, 0u };
+            vertices[3] = { color, sminmax.zy, math::f32tof16(tminmax.zy * texelSize), textureIndex, 0u };
         }
     }
 
@@ -213,42 +409,39 @@ namespace PK::App
     {
         if (GUIValidateDraw())
         {
-            auto idxv = m_gui_vertexCount;
-            auto idxi = m_gui_indexCount;
-            m_gui_vertexCount += 8u;
-            m_gui_indexCount += 24u;
+            GUIVertex* vertices;
+            uint32_t* indices;
+            auto idxv = GUIAllocate(8u, 24u, &vertices, &indices);
+            auto idxi = 0u;
 
-            if (m_gui_vertexCount <= GUI_MAX_VERTICES && m_gui_indexCount <= GUI_MAX_INDICES)
+            const short4 outer = short4(rect.x, rect.y, rect.x + rect.z, rect.y + rect.w);
+            const short4 inner = short4(outer.x + inset, outer.y + inset, outer.z - inset, outer.w - inset);
+
+            for (auto i = 0u; i < 4; ++i)
             {
-                const short4 outer = short4(rect.x, rect.y, rect.x + rect.z, rect.y + rect.w);
-                const short4 inner = short4(outer.x + inset, outer.y + inset, outer.z - inset, outer.w - inset);
+                auto base0 = idxv + i * 2u;
+                auto base1 = idxv + ((i + 1u) % 4u) * 2u;
 
-                for (auto i = 0u; i < 4; ++i)
-                {
-                    auto base0 = idxv + i * 2u;
-                    auto base1 = idxv + ((i + 1u) % 4u) * 2u;
+                indices[idxi++] = base0 + 0u;
+                indices[idxi++] = base0 + 1u;
+                indices[idxi++] = base1 + 1u;
 
-                    m_gui_indexView[idxi++] = base0 + 0u;
-                    m_gui_indexView[idxi++] = base0 + 1u;
-                    m_gui_indexView[idxi++] = base1 + 1u;
+                indices[idxi++] = base1 + 1u;
+                indices[idxi++] = base1 + 0u;
+                indices[idxi++] = base0 + 0u;
+            }
 
-                    m_gui_indexView[idxi++] = base1 + 1u;
-                    m_gui_indexView[idxi++] = base1 + 0u;
-                    m_gui_indexView[idxi++] = base0 + 0u;
-                }
+            vertices[0u] = { color, outer.xy, PK_USHORT2_ZERO, 0, 0u };
+            vertices[1u] = { color, inner.xy, PK_USHORT2_ZERO, 0, 0u };
 
-                m_gui_vertexView[idxv + 0u] = { color, outer.xy, PK_USHORT2_ZERO, 0, 0u };
-                m_gui_vertexView[idxv + 1u] = { color, inner.xy, PK_USHORT2_ZERO, 0, 0u };
-
-                m_gui_vertexView[idxv + 2u] = { color, outer.xw, PK_USHORT2_ZERO, 0, 0u };
-                m_gui_vertexView[idxv + 3u] = { color, inner.xw, PK_USHORT2_ZERO, 0, 0u };
-                
-                m_gui_vertexView[idxv + 4u] = { color, outer.zw, PK_USHORT2_ZERO, 0, 0u };
-                m_gui_vertexView[idxv + 5u] = { color, inner.zw, PK_USHORT2_ZERO, 0, 0u };
-                
-                m_gui_vertexView[idxv + 6u] = { color, outer.zy, PK_USHORT2_ZERO, 0, 0u };
-                m_gui_vertexView[idxv + 7u] = { color, inner.zy, PK_USHORT2_ZERO, 0, 0u };
-            }
+            vertices[2u] = { color, outer.xw, PK_USHORT2_ZERO, 0, 0u };
+            vertices[3u] = { color, inner.xw, PK_USHORT2_ZERO, 0, 0u };
+            
+            vertices[4u] = { color, outer.zw, PK_USHORT2_ZERO, 0, 0u };
+            vertices[5u] = { color, inner.zw, PK_USHORT2_ZERO, 0, 0u };
+            
+            vertices[6u] = { color, outer.zy, PK_USHORT2_ZERO, 0, 0u };
+            vertices[7u] = { color, inner.zy, PK_USHORT2_ZERO, 0, 0u };
         }
     }
 
@@ -256,30 +449,26 @@ namespace PK::App
     {
         if (GUIValidateDraw())
         {
-            auto idxv = m_gui_vertexCount;
-            auto idxi = m_gui_indexCount;
-            m_gui_vertexCount += 4u;
-            m_gui_indexCount += 6u;
-
-            if (m_gui_vertexCount <= GUI_MAX_VERTICES && m_gui_indexCount <= GUI_MAX_INDICES)
-            {
-                const auto p0f = float2(p0.x + 0.5f, p0.y + 0.5f);
-                const auto p1f = float2(p1.x + 0.5f, p1.y + 0.5f);
-                const auto direction = math::normalize(p1f - p0f);
-                const auto tangent = float2(-direction.y, direction.x);
-                const auto offset = math::normalize(tangent + direction) * 0.5f * width;
- 
-                m_gui_indexView[idxi++] = idxv + 0u;
-                m_gui_indexView[idxi++] = idxv + 1u;
-                m_gui_indexView[idxi++] = idxv + 2u;
-                m_gui_indexView[idxi++] = idxv + 2u;
-                m_gui_indexView[idxi++] = idxv + 3u;
-                m_gui_indexView[idxi++] = idxv + 0u;
-                m_gui_vertexView[idxv++] = { color0, math::round(p0f + float2(-offset.y, +offset.x)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
-                m_gui_vertexView[idxv++] = { color1, math::round(p1f + float2(+offset.x, +offset.y)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
-                m_gui_vertexView[idxv++] = { color1, math::round(p1f + float2(+offset.y, -offset.x)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
-                m_gui_vertexView[idxv++] = { color0, math::round(p0f + float2(-offset.x, -offset.y)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
-            }
+            GUIVertex* vertices;
+            uint32_t* indices;
+            auto idxv = GUIAllocate(4u, 6u, &vertices, &indices);
+
+            const auto p0f = float2(p0.x + 0.5f, p0.y + 0.5f);
+            const auto p1f = float2(p1.x + 0.5f, p1.y + 0.5f);
+            const auto direction = math::normalize(p1f - p0f);
+            const auto tangent = float2(-direction.y, direction.x);
+            const auto offset = math::normalize(tangent + direction) * 0.5f * width;
+
+            indices[0] = idxv + 0u;
+            indices[1] = idxv + 1u;
+            indices[2] = idxv + 2u;
+            indices[3] = idxv + 2u;
+            indices[4] = idxv + 3u;
+            indices[5] = idxv + 0u;
+            vertices[0] = { color0, math::round(p0f + float2(-offset.y, +offset.x)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
+            vertices[1] = { color1, math::round(p1f + float2(+offset.x, +offset.y)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
+            vertices[2] = { color1, math::round(p1f + float2(+offset.y, -offset.x)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
+            vertices[3] = { color0, math::round(p0f + float2(-offset.x, -offset.y)), PK_USHORT2_ZERO, GUI_TEX_INDEX_WHITE, 0u };
         }
     }
 
@@ -290,46 +479,36 @@ namespace PK::App
         
         if (GUIValidateDraw())
         {
-            auto max_rects = Font::CalculateMaxRectCount(text, m_gui_font);
-            
-            if (max_rects > 0u)
+            auto rect_count = 0u;
+            auto text_rects = GUICalculateTextRects(text, rect, style, &rect_count);
+
+            if (rect_count > 0u)
             {
-                auto text_rects = PK_STACK_ALLOC(FontRect, max_rects);
-                auto rect_count = Font::CalculateRects(text, m_gui_font, rect, rect, style, text_rects, max_rects);
+                GUIVertex* vertices;
+                uint32_t* indices;
+                auto idxv = GUIAllocate(rect_count * 4u, rect_count * 6u, &vertices, &indices);
+                const float2 texelSize = m_gui_font->GetRHI()->GetTexelSize().xy;
 
-                if (rect_count > 0u)
+                for (auto i = 0u; i < rect_count; ++i, idxv += 4u, vertices += 4u, indices += 6u)
                 {
-                    auto idxv = m_gui_vertexCount;
-                    auto idxi = m_gui_indexCount;
-                    m_gui_vertexCount += rect_count * 4u;
-                    m_gui_indexCount += rect_count * 6u;
-
-                    if (m_gui_vertexCount <= GUI_MAX_VERTICES && m_gui_indexCount <= GUI_MAX_INDICES)
-                    {
-                        const float2 texelSize = m_gui_font->GetRHI()->GetTexelSize().xy;
-
-                        for (auto i = 0u; i < rect_count; ++i)
-                        {
-                            auto& crect = text_rects[i];
-                            const auto sminmax = short4(crect.rect.x, crect.rect.y, crect.rect.x + crect.rect.z, crect.rect.y + crect.rect.w);
-                            const auto tminmax = float4(crect.texrect.x, crect.texrect.y, crect.texrect.x + crect.texrect.z, crect.texrect.y + crect.texrect.w);
-                            m_gui_indexView[idxi++] = idxv + 0u;
-                            m_gui_indexView[idxi++] = idxv + 1u;
-                            m_gui_indexView[idxi++] = idxv + 2u;
-                            m_gui_indexView[idxi++] = idxv + 2u;
-                            m_gui_indexView[idxi++] = idxv + 3u;
-                            m_gui_indexView[idxi++] = idxv + 0u;
-                            m_gui_vertexView[idxv++] = { color, sminmax.xy, math::f32tof16(tminmax.xy * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
-                            m_gui_vertexView[idxv++] = { color, sminmax.xw, math::f32tof16(tminmax.xw * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
-                            m_gui_vertexView[idxv++] = { color, sminmax.zw, math::f32tof16(tminmax.zw * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
-                            m_gui_vertexView[idxv++] = { color, sminmax.zy, math::f32tof16(tminmax.zy * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
-
-                            text_area_min.x = math::min(text_area_min.x, sminmax.x, sminmax.z);
-                            text_area_min.y = math::min(text_area_min.y, sminmax.y, sminmax.w);
-                            text_area_max.x = math::max(text_area_max.x, sminmax.x, sminmax.z);
-                            text_area_max.y = math::max(text_area_max.y, sminmax.y, sminmax.w);
-                        }
-                    }
+                    auto& crect = text_rects[i];
+                    const auto sminmax = short4(crect.rect.x, crect.rect.y, crect.rect.x + crect.rect.z, crect.rect.y + crect.rect.w);
+                    const auto tminmax = float4(crect.texrect.x, crect.texrect.y, crect.texrect.x + crect.texrect.z, crect.texrect.y + crect.texrect.w);
+                    indices[0] = idxv + 0u;
+                    indices[1] = idxv + 1u;
+                    indices[2] = idxv + 2u;
+                    indices[3] = idxv + 2u;
+                    indices[4] = idxv + 3u;
+                    indices[5] = idxv + 0u;
+                    vertices[0] = { color, sminmax.xy, math::f32tof16(tminmax.xy * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
+                    vertices[1] = { color, sminmax.xw, math::f32tof16(tminmax.xw * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
+                    vertices[2] = { color, sminmax.zw, math::f32tof16(tminmax.zw * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
+                    vertices[3] = { color, sminmax.zy, math::f32tof16(tminmax.zy * texelSize), GUI_TEX_INDEX_DEFAULT_FONT, 1u };
+
+                    text_area_min.x = math::min(text_area_min.x, sminmax.x, sminmax.z);
+                    text_area_min.y = math::min(text_area_min.y, sminmax.y, sminmax.w);
+                    text_area_max.x = math::max(text_area_max.x, sminmax.x, sminmax.z);
+                    text_area_max.y = math::max(text_area_max.y, sminmax.y, sminmax.w);
                 }
             }
         }
@@ -337,6 +516,93 @@ namespace PK::App
         return { text_area_min, text_area_max - text_area_min };
     }
 
+    bool EngineGUIRenderer::GUIBeginList(uint64_t key, uint64_t contentHash)
+    {
+        PK_DEBUG_FATAL_ASSERT(m_gui_listActive == nullptr, "Nested gui lists are not supported!");
+
+        if (!GUIValidateDraw())
+        {
+            return false;
+        }
+
+        GUIRetainedList* list = nullptr;
+        GUIRetainedList* oldestList = m_gui_lists;
+
+        for (auto& candidate : m_gui_lists)
+        {
+            if (candidate.key == key)
+            {
+                list = &candidate;
+                break;
+            }
+
+            if (candidate.lastUsedFrame < oldestList->lastUsedFrame)
+            {
+                oldestList = &candidate;
+            }
+        }
+
+        // Unchanged. Reference the resident geometry.
+        if (list != nullptr && list->contentHash == contentHash && !list->isVolatile)
+        {
+            list->lastUsedFrame = m_gui_frameIndex;
+            GUIPushDrawRange((uint32_t)(list - m_gui_lists));
+            return false;
+        }
+
+        list = list != nullptr ? list : oldestList;
+
+        // Slot is already referenced by this frame. Record as immediate geometry instead of overwriting it.
+        if (list->lastUsedFrame == m_gui_frameIndex)
+        {
+            return true;
+        }
+
+        list->key = key;
+        list->contentHash = contentHash;
+        list->lastUsedFrame = m_gui_frameIndex;
+        list->isVolatile = false;
+        m_gui_listActive = list;
+        m_gui_listVertexFirst = m_gui_vertexCount;
+        m_gui_listIndexFirst = m_gui_indexCount;
+        return true;
+    }
+
+    void EngineGUIRenderer::GUIEndList()
+    {
+        if (m_gui_listActive != nullptr)
+        {
+            auto list = m_gui_listActive;
+            m_gui_listActive = nullptr;
+
+            // Geometry stays in the immediate region.
+            if (list->isVolatile)
+            {
+                list->vertexCount = 0u;
+                list->indexCount = 0u;
+                return;
+            }
+
+            list->vertexCount = m_gui_vertexCount - m_gui_listVertexFirst;
+            list->indexCount = m_gui_indexCount - m_gui_listIndexFirst;
+            list->vertices.Reserve(list->vertexCount, false);
+            list->indices.Reserve(list->indexCount, false);
+            Memory::CopyArray(list->vertices.GetData(), m_gui_vertices.GetData() + m_gui_listVertexFirst, list->vertexCount);
+
+            for (auto i = 0u; i < list->indexCount; ++i)
+            {
+                list->indices[i] = m_gui_indices[m_gui_listIndexFirst + i] - m_gui_listVertexFirst;
+            }
+
+            // Move the recorded geometry from the immediate region to the resident region.
+            m_gui_vertexCount = m_gui_listVertexFirst;
+            m_gui_indexCount = m_gui_listIndexFirst;
+            GUIAllocateResident(list);
+            list->isDirty = list->indexCount > 0u;
+            GUIPushDrawRange((uint32_t)(list - m_gui_lists));
+        }
+    }
+
 
     void EngineGUIRenderer::GizmosCollectDraws(const uint4& renderArea, const float4x4& worldToClip, CommandBufferExt& cmd)
     {
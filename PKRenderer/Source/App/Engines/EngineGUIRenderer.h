@@ -1,4 +1,6 @@
 #pragma once
+#include "Core/Base/Containers/ArrayList.h"
+#include "Core/Base/Containers/HashMap.h"
 #include "Core/ControlFlow/IStep.h"
 #include "Core/RHI/Layout.h"
 #include "Core/Rendering/Font.h"
@@ -43,6 +45,8 @@ namespace PK::App
         void GUIDrawWireRect(const color32& color, const short4& rect, short inset) final;
         void GUIDrawLine(const color32& color0, const color32& color1, const short2& p0, const short2& p1, const float width) final;
         short4 GUIDrawText(const color32& color, const short4& rect, const char* text, const FontStyle& style) final;
+        bool GUIBeginList(uint64_t key, uint64_t contentHash) final;
+        void GUIEndList() final;
 
         void GizmosCollectDraws(const uint4& renderArea, const float4x4& worldToClip, CommandBufferExt& cmd);
         void GizmosDispatchDraws(CommandBufferExt& cmd, RHITexture* target);
@@ -57,13 +61,64 @@ namespace PK::App
         const short4& GizmosGetRenderAreaRect() const final;
 
     private:
-        constexpr static const uint32_t GUI_MAX_VERTICES = 16384u;
-        constexpr static const uint32_t GUI_MAX_INDICES = GUI_MAX_VERTICES * 3u;
+        // Gpu buffers are split into a resident region holding retained lists & an immediate region that is uploaded every frame.
+        // Immediate geometry is collected on the cpu & uploaded once per frame. Both regions grow to fit.
+        constexpr static const uint32_t GUI_INITIAL_VERTICES = 16384u;
+        constexpr static const uint32_t GUI_INITIAL_INDICES = GUI_INITIAL_VERTICES * 3u;
+        constexpr static const uint32_t GUI_INITIAL_RESIDENT_VERTICES = 16384u;
+        constexpr static const uint32_t GUI_INITIAL_RESIDENT_INDICES = GUI_INITIAL_RESIDENT_VERTICES * 3u;
+        constexpr static const uint32_t GUI_LIST_INDEX_IMMEDIATE = 0xFFFFFFFFu;
         constexpr static const uint32_t GUI_MAX_TEXTURES = 64;
+        constexpr static const uint32_t GUI_MAX_RETAINED_LISTS = 32u;
+        // Text layout cache is flushed when it exceeds this many glyph rects.
+        constexpr static const uint32_t GUI_MAX_CACHED_TEXT_RECTS = 65536u;
         constexpr static const uint16_t GUI_TEX_INDEX_WHITE = 0u;
         constexpr static const uint16_t GUI_TEX_INDEX_ERROR = 1u;
         constexpr static const uint16_t GUI_TEX_INDEX_DEFAULT_FONT = 2u;
 
+        struct GUIRetainedList
+        {
+            uint64_t key = 0ull;
+            uint64_t contentHash = 0ull;
+            uint64_t lastUsedFrame = 0ull;
+            uint32_t vertexCount = 0u;
+            uint32_t indexCount = 0u;
+            // Location in the resident region of the gpu buffers.
+            uint32_t residentVertexFirst = 0u;
+            uint32_t residentVertexCapacity = 0u;
+            uint32_t residentIndexFirst = 0u;
+            uint32_t residentIndexCapacity = 0u;
+            // Lists referencing textures added during the frame cannot be reused as texture indices are not stable.
+            // Their geometry stays in the immediate region.
+            bool isVolatile = false;
+            // Cpu copy has not been uploaded to the resident region yet.
+            bool isDirty = false;
+            HeapArray<GUIVertex> vertices;
+            // Relative to the first vertex of the list.
+            HeapArray<uint32_t> indices;
+        };
+
+        // Draws are issued per range to preserve the order between immediate geometry & retained lists.
+        // Offsets are resolved once the frame has been collected as lists can move in the resident region.
+        struct GUIDrawRange
+        {
+            uint32_t listIndex;
+            uint32_t firstIndex;
+            uint32_t indexCount;
+            int32_t vertexOffset;
+        };
+
+        struct GUITextLayout
+        {
+            uint32_t rectFirst;
+            uint32_t rectCount;
+        };
+
+        uint32_t GUIAllocate(uint32_t vertexCount, uint32_t indexCount, GUIVertex** outVertices, uint32_t** outIndices);
+        void GUIAllocateResident(GUIRetainedList* list);
+        void GUIPushDrawRange(uint32_t listIndex);
+        const FontRect* GUICalculateTextRects(const char* text, const short4& rect, const FontStyle& style, uint32_t* outCount);
+
         Sequencer* m_sequencer = nullptr;
         AssetDatabase* m_assetDatabase = nullptr;
 
@@ -73,12 +128,29 @@ namespace PK::App
         Font* m_gui_font = nullptr;
         RHIBufferRef m_gui_vertexBuffer;
         RHIBufferRef m_gui_indexBuffer;
-        BufferView<GUIVertex> m_gui_vertexView;
-        BufferView<uint16_t> m_gui_indexView;
+        HeapArray<GUIVertex> m_gui_vertices;
+        HeapArray<uint32_t> m_gui_indices;
         short4 m_gui_renderAreaRect = PK_SHORT4_ZERO;
         uint32_t m_gui_vertexCount = 0u;
         uint32_t m_gui_indexCount = 0u;
+        uint32_t m_gui_immediateIndexFirst = 0u;
+        HeapList<GUIDrawRange> m_gui_drawRanges;
+        uint64_t m_gui_frameIndex = 0ull;
         bool m_gui_enabled = true;
+        bool m_gui_hasDraws = false;
+
+        GUIRetainedList m_gui_lists[GUI_MAX_RETAINED_LISTS];
+        GUIRetainedList* m_gui_listActive = nullptr;
+        uint32_t m_gui_listVertexFirst = 0u;
+        uint32_t m_gui_listIndexFirst = 0u;
+        uint32_t m_gui_residentVertexCapacity = GUI_INITIAL_RESIDENT_VERTICES;
+        uint32_t m_gui_residentIndexCapacity = GUI_INITIAL_RESIDENT_INDICES;
+        uint32_t m_gui_residentVertexHead = 0u;
+        uint32_t m_gui_residentIndexHead = 0u;
+
+        HashMap<uint64_t, GUITextLayout> m_gui_textLayouts;
+        HeapArray<FontRect> m_gui_textRects;
+        uint32_t m_gui_textRectCount = 0u;
 
         ShaderAsset* m_gizmos_shader = nullptr;
         RHIBufferRef m_gizmos_vertexBuffer;
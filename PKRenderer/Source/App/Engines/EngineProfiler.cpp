@@ -1,10 +1,14 @@
 #include "PrecompiledHeader.h"
 #include "Core/Platform/PlatformInterfaces.h"
+#include "Core/Base/Hash.h"
 #include "Core/Base/Containers/FixedString.h"
 #include "Core/Math/Color.h"
 #include "Core/Math/Extended.h"
+#include "Core/Base/MemoryTracker.h"
 #include "Core/Assets/AssetDatabase.h"
 #include "Core/CLI/CVariableRegister.h"
+#include "Core/CLI/Log.h"
+#include "Core/Timers/CPUProfiler.h"
 #include "Core/Rendering/ShaderAsset.h"
 #include "Core/Rendering/Font.h"
 #include "App/Renderer/IGUIRenderer.h"
@@ -15,6 +19,22 @@ namespace PK::App
     EngineProfiler::EngineProfiler()
     {
         CVariableRegister::Create<CVariableFuncSimple>("Engine.Profiler.Toggle", [this]() { m_enabled ^= true; });
+        CVariableRegister::Create<CVariableFuncSimple>("Engine.Profiler.FlameGraph.Toggle", [this]() { m_flameGraphEnabled ^= true; });
+        CVariableRegister::Create<CVariableFuncSimple>("Engine.Profiler.Memory.Toggle", [this]() { m_memoryTagsEnabled ^= true; });
+        CVariableRegister::Create<CVariableFuncSimple>("Engine.Profiler.Memory.Dump", [this]() { LogMemoryTags(); });
+        CVariableRegister::Create<CVariableFuncSimple>("Engine.Profiler.CPU.Toggle", []() { CPUProfiler::SetEnabled(!CPUProfiler::IsEnabled()); });
+        CVariableRegister::Create<CVariableFunc>("Engine.Profiler.CPU.ExportTrace", [](const char* const* args, [[maybe_unused]] uint32_t count)
+            {
+                if (CPUProfiler::ExportChromeTrace(args[0]))
+                {
+                    PK_LOG_INFO("EngineProfiler: Exported cpu trace to: %s", args[0]);
+                }
+                else
+                {
+                    PK_LOG_WARNING("EngineProfiler: Failed to export cpu trace to: %s", args[0]);
+                }
+            }, 
+            "path", 1u);
     }
     
     void EngineProfiler::Step(IGUIRenderer* gui)
@@ -32,6 +52,8 @@ namespace PK::App
         constexpr auto COLOR_VRAM = color32(0, 255, 255, 127);
         constexpr auto COLOR_ERAM = color32(255, 0, 255, 127);
         constexpr auto COLOR_IRAM = color32(255, 255, 0, 127);
+        constexpr auto COLOR_CULL = color32(127, 127, 255, 127);
+        constexpr auto COLOR_BIND = color32(255, 127, 127, 127);
 
         // @TODO this is pretty hacky & hard coded. fix later
         const auto height = 74;
@@ -48,6 +70,7 @@ namespace PK::App
 
         auto cpumemory = Platform::GetMemoryInfo();
         auto gpumemory = RHI::GetMemoryInfo();
+        auto bindStats = RHI::GetBindStats();
 
         m_timeHistory.Reserve(sampleCountMax, true);
         m_timeHistory[m_timeHistoryHead % sampleCountMax] = m_framerate.frameMs;
@@ -70,6 +93,13 @@ namespace PK::App
         FixedString64 textMemoryIram("Ram Total: %s", String::FormatBytes<16>(cpumemory.programMemoryUsedInclusive).c_str());
         FixedString64 textMemoryVram("Vram: %s", String::FormatBytes<16>(gpumemory.usedBytes).c_str());
 
+        const auto cullCacheTotal = m_cullCache.reusedCount + m_cullCache.retestedCount + m_cullCache.testedCount;
+        const auto cullCacheHits = m_cullCache.reusedCount + m_cullCache.retestedCount;
+        FixedString64 textCullCache("Cull Cache: %4.1f%% (%u cuts)", cullCacheTotal > 0u ? 100.0f * cullCacheHits / cullCacheTotal : 0.0f, m_cullCache.invalidatedCount);
+
+        const auto setCacheHitRate = bindStats.descriptorSetLookups > 0u ? 100.0f * bindStats.descriptorSetCacheHits / bindStats.descriptorSetLookups : 0.0f;
+        FixedString64 textBinds("Binds: %u pso %u set (%4.1f%% cached)", bindStats.pipelineBinds, bindStats.descriptorSetBinds, setCacheHitRate);
+
         gui->GUIDrawRect(COLOR_BG, rectWindow);
         gui->GUIDrawWireRect(COLOR_FG, rectWindow, 1);
         auto area_text = short4(rectWindow.xy + short2(padding * 2, padding + 2), 0, 16);
@@ -80,6 +110,8 @@ namespace PK::App
         area_text = gui->GUIDrawText(COLOR_VRAM,    short4(math::align(area_text.x + area_text.z + padding * 4, fontSize), rectWindow.y + padding + 2, 0, 0), textMemoryVram.c_str(), FontStyle().SetSize(fontSize));
         area_text = gui->GUIDrawText(COLOR_ERAM,    short4(math::align(area_text.x + area_text.z + padding * 4, fontSize), rectWindow.y + padding + 2, 0, 0), textMemoryEram.c_str(), FontStyle().SetSize(fontSize));
         area_text = gui->GUIDrawText(COLOR_IRAM,    short4(math::align(area_text.x + area_text.z + padding * 4, fontSize), rectWindow.y + padding + 2, 0, 0), textMemoryIram.c_str(), FontStyle().SetSize(fontSize));
+        area_text = gui->GUIDrawText(COLOR_CULL,    short4(math::align(area_text.x + area_text.z + padding * 4, fontSize), rectWindow.y + padding + 2, 0, 0), textCullCache.c_str(), FontStyle().SetSize(fontSize));
+        area_text = gui->GUIDrawText(COLOR_BIND,    short4(math::align(area_text.x + area_text.z + padding * 4, fontSize), rectWindow.y + padding + 2, 0, 0), textBinds.c_str(), FontStyle().SetSize(fontSize));
 
         for (auto i = 0ull; i < sampleCountMin; ++i)
         {
@@ -95,6 +127,198 @@ namespace PK::App
         gui->GUIDrawRect(COLOR_FPS_AVG, rectBar + short4(0, -sampleHeight / 2, 0, 0));
         gui->GUIDrawRect(COLOR_FPS_MAX, rectBar + short4(0, -sampleHeight * 1, 0, 0));
 
+        auto rectStack = rectWindow;
+
+        if (m_memoryTagsEnabled)
+        {
+            rectStack = DrawMemoryTags(gui, rectStack);
+        }
+
+        if (m_flameGraphEnabled)
+        {
+            DrawFlameGraph(gui, rectStack);
+        }
+
         m_timeHistoryHead++;
     }
+
+    // Draws the largest memory tags by live bytes. Returns the drawn rect so that other panels can stack on top of it.
+    short4 EngineProfiler::DrawMemoryTags(IGUIRenderer* gui, const short4& rectWindow)
+    {
+        constexpr auto COLOR_BG = color32(0, 0, 0, 192);
+        constexpr auto COLOR_FG = color32(255, 255, 255, 127);
+        constexpr auto COLOR_TEXT = color32(255, 255, 255, 192);
+        constexpr auto MAX_ROWS = 8u;
+
+        const auto fontSize = 14;
+        const auto padding = 4;
+
+        uint16_t tags[MAX_ROWS];
+        const auto count = MemoryTracker::GetTopTags(tags, MAX_ROWS);
+
+        if (count == 0u)
+        {
+            return rectWindow;
+        }
+
+        const auto height = (int32_t)count * (fontSize + padding) + padding * 2;
+        const auto rectTags = short4(rectWindow.x, rectWindow.y - height - padding, rectWindow.z, height);
+
+        FixedString128 texts[MAX_ROWS];
+        auto listHash = Hash::FNV1AHash(&rectTags, sizeof(rectTags));
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto stats = MemoryTracker::GetTagStats(tags[i]);
+
+            texts[i] = FixedString128("%s: Live: %s, Peak: %s, Frame: %lli allocs, %s", 
+                stats->name, 
+                String::FormatBytes<16>(stats->liveBytes).c_str(),
+                String::FormatBytes<16>(stats->peakBytes).c_str(),
+                stats->frameCount,
+                String::FormatBytes<16>(stats->frameBytes).c_str());
+
+            listHash = Hash::MurmurHash(texts[i].c_str(), texts[i].Length(), listHash);
+        }
+
+        if (gui->GUIBeginList(reinterpret_cast<uint64_t>(this), listHash))
+        {
+            gui->GUIDrawRect(COLOR_BG, rectTags);
+            gui->GUIDrawWireRect(COLOR_FG, rectTags, 1);
+
+            for (auto i = 0u; i < count; ++i)
+            {
+                auto rectText = short4(rectTags.x + padding * 2, rectTags.y + padding + (int32_t)i * (fontSize + padding), rectTags.z - padding * 4, fontSize);
+                gui->GUIDrawText(COLOR_TEXT, rectText, texts[i].c_str(), FontStyle().SetSize(fontSize).SetClip(true));
+            }
+
+            gui->GUIEndList();
+        }
+
+        return rectTags;
+    }
+
+    void EngineProfiler::LogMemoryTags()
+    {
+        uint16_t tags[MemoryTracker::MAX_TAGS];
+        const auto count = MemoryTracker::GetTopTags(tags, MemoryTracker::MAX_TAGS);
+
+        PK_LOG_NEWLINE();
+        PK_LOG_HEADER_SCOPE("----------MEMORY TAGS----------");
+
+#if !PK_MEMORY_TRACKING
+        PK_LOG_INFO("Memory tracking is disabled in this build. Define PK_MEMORY_TRACKING=1 to enable it.");
+#endif
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto stats = MemoryTracker::GetTagStats(tags[i]);
+
+            PK_LOG_INFO("%-32s Live: %-12s (%lli) Peak: %-12s Total: %-12s (%lli) Frame: %s (%lli)",
+                stats->name,
+                String::FormatBytes<16>(stats->liveBytes).c_str(),
+                stats->liveCount,
+                String::FormatBytes<16>(stats->peakBytes).c_str(),
+                String::FormatBytes<16>(stats->totalBytes).c_str(),
+                stats->totalCount,
+                String::FormatBytes<16>(stats->frameBytes).c_str(),
+                stats->frameCount);
+        }
+
+        PK_LOG_NEWLINE();
+    }
+
+    // Draws scopes recorded during the previous frame. One block of rows per thread.
+    void EngineProfiler::DrawFlameGraph(IGUIRenderer* gui, const short4& rectWindow)
+    {
+        constexpr auto COLOR_BG = color32(0, 0, 0, 192);
+        constexpr auto COLOR_FG = color32(255, 255, 255, 127);
+        constexpr auto COLOR_TEXT = color32(0, 0, 0, 255);
+        constexpr auto MAX_DEPTH = 8u;
+
+        const auto rowHeight = 14;
+        const auto fontSize = 12;
+        const auto padding = 4;
+        const auto frameBegin = CPUProfiler::GetFrameBegin(1u);
+        const auto frameEnd = CPUProfiler::GetFrameBegin(0u);
+        const auto threadCount = CPUProfiler::GetThreadCount();
+
+        if (frameBegin == 0ull || frameEnd <= frameBegin)
+        {
+            return;
+        }
+
+        auto forEachEvent = [frameBegin, frameEnd](const CPUProfiler::ThreadRing* ring, auto&& function)
+        {
+            const auto count = math::min((uint64_t)CPUProfiler::MAX_EVENTS, ring->head);
+
+            for (auto i = 0ull; i < count; ++i)
+            {
+                auto& event = ring->events[(ring->head - i - 1ull) & (CPUProfiler::MAX_EVENTS - 1u)];
+
+                // Events are in begin order. Nothing older is within the frame.
+                if (event.begin < frameBegin)
+                {
+                    break;
+                }
+
+                if (event.begin < frameEnd && event.end != 0ull && event.depth < MAX_DEPTH)
+                {
+                    function(event);
+                }
+            }
+        };
+
+        uint32_t rowCounts[CPUProfiler::MAX_THREADS]{};
+        auto totalRowCount = 0u;
+
+        for (auto i = 0u; i < threadCount; ++i)
+        {
+            if (auto ring = CPUProfiler::GetThreadRing(i))
+            {
+                forEachEvent(ring, [&](const CPUProfiler::Event& event) { rowCounts[i] = math::max(rowCounts[i], event.depth + 1u); });
+                totalRowCount += rowCounts[i];
+            }
+        }
+
+        if (totalRowCount == 0u)
+        {
+            return;
+        }
+
+        const auto height = (int32_t)totalRowCount * rowHeight + padding * 2;
+        const auto rectFlame = short4(rectWindow.x, rectWindow.y - height - padding, rectWindow.z, height);
+        const auto width = rectFlame.z - padding * 2;
+        const auto cyclesToPixels = (double)width / (double)(frameEnd - frameBegin);
+        auto rowOffset = rectFlame.y + padding;
+
+        gui->GUIDrawRect(COLOR_BG, rectFlame);
+        gui->GUIDrawWireRect(COLOR_FG, rectFlame, 1);
+
+        for (auto i = 0u; i < threadCount; ++i)
+        {
+            if (rowCounts[i] == 0u)
+            {
+                continue;
+            }
+
+            forEachEvent(CPUProfiler::GetThreadRing(i), [&](const CPUProfiler::Event& event)
+            {
+                const auto offset = (int32_t)((event.begin - frameBegin) * cyclesToPixels);
+                const auto length = math::max(1, math::min(width - offset, (int32_t)((math::min(event.end, frameEnd) - event.begin) * cyclesToPixels)));
+                const auto hue = (float)((reinterpret_cast<uint64_t>(event.name) * 0x9E3779B97F4A7C15ull) >> 40ull) / (float)(1u << 24u);
+                const auto color = math::hueToRgb32(hue);
+                const auto rect = short4(rectFlame.x + padding + offset, rowOffset + (int32_t)event.depth * rowHeight, length, rowHeight - 1);
+
+                gui->GUIDrawRect(color32(color.r, color.g, color.b, 192), rect);
+
+                if (length > fontSize * 4)
+                {
+                    gui->GUIDrawText(COLOR_TEXT, rect + short4(2, 0, -4, 0), event.name, FontStyle().SetSize(fontSize).SetClip(true));
+                }
+            });
+
+            rowOffset += (int32_t)rowCounts[i] * rowHeight;
+        }
+    }
 }
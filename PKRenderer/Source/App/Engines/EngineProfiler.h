@@ -2,6 +2,7 @@
 #include "Core/Base/Containers/ArrayList.h"
 #include "Core/ControlFlow/IStep.h"
 #include "Core/Timers/TimeFrameInfo.h"
+#include "App/Renderer/EntityCulling.h"
 
 namespace PK { class AssetDatabase; }
 
@@ -11,18 +12,27 @@ namespace PK::App
 
     class EngineProfiler :
         public IStep<IGUIRenderer*>,
-        public IStep<TimeFramerateInfo*>
+        public IStep<TimeFramerateInfo*>,
+        public IStep<EntityCullCacheInfo*>
     {
     public:
         EngineProfiler();
 
         virtual void Step(IGUIRenderer* gui) final;
         virtual void Step(TimeFramerateInfo* framerate) final { m_framerate = *framerate; }
+        virtual void Step(EntityCullCacheInfo* cullCache) final { m_cullCache = *cullCache; }
 
     private:
+        short4 DrawMemoryTags(IGUIRenderer* gui, const short4& rectWindow);
+        void DrawFlameGraph(IGUIRenderer* gui, const short4& rectWindow);
+        void LogMemoryTags();
+
         TimeFramerateInfo m_framerate{};
+        EntityCullCacheInfo m_cullCache{};
         HeapArray<double> m_timeHistory;
         uint64_t m_timeHistoryHead = 0ull;
         bool m_enabled = false;
+        bool m_flameGraphEnabled = false;
+        bool m_memoryTagsEnabled = false;
     };
 }
@@ -1,7 +1,7 @@
 #include "PrecompiledHeader.h"
+#include "Core/Math/Batch.h"
 #include "Core/Math/Bounds.h"
 #include "Core/ECS/EntityDatabase.h"
-#include "App/ECS/EntityViewTransform.h"
 #include "EngineUpdateTransforms.h"
 
 namespace PK::App
@@ -9,18 +9,115 @@ namespace PK::App
     EngineUpdateTransforms::EngineUpdateTransforms(EntityDatabase* entityDb)
     {
         m_entityDb = entityDb;
+        m_batch = Memory::New<TransformBatch>();
+    }
+
+    EngineUpdateTransforms::~EngineUpdateTransforms()
+    {
+        Memory::Delete(m_batch);
     }
 
     void EngineUpdateTransforms::OnStepFrameUpdate([[maybe_unused]] FrameContext* ctx)
     {
         auto views = m_entityDb->Query<EntityViewTransform>();
+        auto count = 0u;
 
         for (auto& view : views)
         {
-            view.transform->localToWorld = view.transform->GetLocalToWorld();
-            view.transform->worldToLocal = math::affineInverseTranspose(view.transform->localToWorld);
-            view.transform->minUniformScale = math::cmin(math::abs(view.transform->scale));
-            view.bounds->worldAABB = math::mul(view.transform->localToWorld, view.bounds->localAABB);
+            auto transform = view.transform;
+            auto localAABB = &view.bounds->localAABB;
+            m_batch->views[count] = view;
+
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                m_batch->position[i][count] = transform->position[i];
+                m_batch->scale[i][count] = transform->scale[i];
+                m_batch->localAABB[i][count] = localAABB->min[i];
+                m_batch->localAABB[i + 3u][count] = localAABB->max[i];
+            }
+
+            m_batch->rotation[0][count] = transform->rotation.x;
+            m_batch->rotation[1][count] = transform->rotation.y;
+            m_batch->rotation[2][count] = transform->rotation.z;
+            m_batch->rotation[3][count] = transform->rotation.w;
+
+            if (++count == BATCH_SIZE)
+            {
+                UpdateBatch(count);
+                count = 0u;
+            }
+        }
+
+        UpdateBatch(count);
+    }
+
+    void EngineUpdateTransforms::UpdateBatch(uint32_t count)
+    {
+        if (count == 0u)
+        {
+            return;
+        }
+
+        auto batch = m_batch;
+        math::trs_soa trs;
+        math::float3x4_soa localToWorld;
+        math::float3x4_soa worldToLocal;
+        math::aabb_soa localAABB;
+        math::aabb_soa worldAABB;
+
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            trs.position[i] = batch->position[i];
+            trs.scale[i] = batch->scale[i];
+            localAABB.min[i] = batch->localAABB[i];
+            localAABB.max[i] = batch->localAABB[i + 3u];
+            worldAABB.min[i] = batch->worldAABB[i];
+            worldAABB.max[i] = batch->worldAABB[i + 3u];
+        }
+
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            trs.rotation[i] = batch->rotation[i];
+        }
+
+        for (auto i = 0u; i < 12u; ++i)
+        {
+            localToWorld.elements[i] = batch->localToWorld[i];
+            worldToLocal.elements[i] = batch->worldToLocal[i];
+        }
+
+        math::transformTRS3x4(trs, localToWorld, count);
+        math::affineInverseTranspose(localToWorld, worldToLocal, count);
+        math::mul(localToWorld, localAABB, worldAABB, count);
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto transform = batch->views[i].transform;
+            auto bounds = batch->views[i].bounds;
+            auto l2w = &transform->localToWorld[0][0];
+            auto w2l = &transform->worldToLocal;
+
+            for (auto j = 0u; j < 12u; ++j)
+            {
+                l2w[j] = batch->localToWorld[j][i];
+            }
+
+            for (auto j = 0u; j < 4u; ++j)
+            {
+                (*w2l)[j] = float4(batch->worldToLocal[j * 3u + 0u][i], batch->worldToLocal[j * 3u + 1u][i], batch->worldToLocal[j * 3u + 2u][i], j == 3u ? 1.0f : 0.0f);
+            }
+
+            transform->minUniformScale = math::cmin(math::abs(transform->scale));
+
+            auto aabb = AABB<float3>(
+                float3(batch->worldAABB[0][i], batch->worldAABB[1][i], batch->worldAABB[2][i]),
+                float3(batch->worldAABB[3][i], batch->worldAABB[4][i], batch->worldAABB[5][i]));
+
+            if (memcmp(&aabb, &bounds->worldAABB, sizeof(AABB<float3>)) != 0)
+            {
+                bounds->worldAABB = aabb;
+                bounds->version++;
+            }
         }
     }
 }
@@ -1,4 +1,5 @@
 #pragma once
+#include "App/ECS/EntityViewTransform.h"
 #include "App/FrameStep.h"
 
 namespace PK { struct EntityDatabase; }
@@ -9,9 +10,28 @@ namespace PK::App
     {
     public:
         EngineUpdateTransforms(EntityDatabase* entityDb);
+        ~EngineUpdateTransforms();
         virtual void OnStepFrameUpdate(FrameContext* ctx) final;
 
     private:
+        constexpr static const uint32_t BATCH_SIZE = 256u;
+
+        // Components are gathered into struct of arrays blocks for the batched math kernels.
+        struct TransformBatch
+        {
+            EntityViewTransform views[BATCH_SIZE];
+            float position[3][BATCH_SIZE];
+            float rotation[4][BATCH_SIZE];
+            float scale[3][BATCH_SIZE];
+            float localToWorld[12][BATCH_SIZE];
+            float worldToLocal[12][BATCH_SIZE];
+            float localAABB[6][BATCH_SIZE];
+            float worldAABB[6][BATCH_SIZE];
+        };
+
+        void UpdateBatch(uint32_t count);
+
         EntityDatabase* m_entityDb = nullptr;
+        TransformBatch* m_batch = nullptr;
     };
 }
@@ -1,17 +1,19 @@
 #include "PrecompiledHeader.h"
 #include "Core/Base/Sort.h"
 #include "Core/CLI/Log.h"
+#include "Core/Assets/AssetDatabase.h"
 #include "Core/RHI/RHInterfaces.h"
 #include "Core/Rendering/CommandBufferExt.h"
 #include "Core/Rendering/ShaderAsset.h"
 #include "Core/Rendering/Material.h"
+#include "Core/Rendering/MeshUtilities.h"
 #include "App/ECS/ComponentTransform.h"
 #include "App/Renderer/HashCache.h"
 #include "BatcherMeshStatic.h"
 
 namespace PK::App
 {
-    BatcherMeshStatic::BatcherMeshStatic() : m_transforms(1024u, 3u)
+    BatcherMeshStatic::BatcherMeshStatic(bool quantizeMeshes) : m_meshAllocator(quantizeMeshes), m_transforms(1024u, 3u)
     {
         PK_LOG_VERBOSE_FUNC();
         m_textures2D = RHI::CreateBindSet<RHITexture>(PK_RHI_MAX_UNBOUNDED_SIZE);
@@ -26,6 +28,22 @@ namespace PK::App
         Memory::Construct(memory, &m_meshAllocator, filepath);
     }
 
+    void BatcherMeshStatic::Step(AssetImportEvent<ShaderAsset>* evt)
+    {
+        auto shader = evt->asset;
+        evt->assetDatabase->ReloadWhere<Material>([shader](Material* material)
+        {
+            return material->GetShader() == shader || material->GetShaderShadow() == shader;
+        });
+
+        auto index = m_shaders.GetIndex({ shader });
+
+        if (index != -1)
+        {
+            m_shaders[index].materialStride = 0ull;
+        }
+    }
+
     void BatcherMeshStatic::BeginCollectDrawCalls()
     {
         for (auto i = 0u; i < m_shaders.GetCount(); ++i)
@@ -39,6 +57,7 @@ namespace PK::App
         m_groupCount = 0u;
         m_drawInfoCount = 0u;
         m_materials.ClearFast();
+        m_meshletCuts.ClearFast();
         m_transforms.ClearFast();
         m_textures2D->Clear();
         m_drawArena.Clear();
@@ -110,6 +129,7 @@ namespace PK::App
 
         auto taskletCount = 0u;
         auto taskletDrawStart = 0u;
+        const MeshletCut* meshletCut = nullptr;
 
         for (auto i = 0u; i < m_drawInfoCount; ++i)
         {
@@ -129,6 +149,16 @@ namespace PK::App
                     passDrawCalls = m_drawArena.GetHead<DrawCall>();
                 }
 
+                if (i == 0u || info->group != lastInfo->group)
+                {
+                    meshletCut = nullptr;
+
+                    for (auto j = 0u; j < m_meshletCuts.GetCount(); ++j)
+                    {
+                        meshletCut = m_meshletCuts[j].group == info->group ? &m_meshletCuts[j] : meshletCut;
+                    }
+                }
+
                 lastInfo = info;
             }
 
@@ -146,6 +176,46 @@ namespace PK::App
                     info->userdata
                 );
 
+                if (submesh.hierarchy && meshletCut)
+                {
+                    // Consecutive selected meshlets are coalesced into tasklets.
+                    const auto transform = m_transforms[info->transform];
+                    const auto scratchSize = MeshUtilities::GetMeshletCutScratchSize(*submesh.hierarchy);
+                    m_meshletCutScratch.Reserve(scratchSize + submesh.meshletCount, false);
+                    auto selected = m_meshletCutScratch.GetData() + scratchSize;
+
+                    const auto selectedCount = MeshUtilities::SelectMeshletCut(*submesh.hierarchy,
+                        transform->localToWorld,
+                        meshletCut->worldToClip,
+                        transform->minUniformScale,
+                        meshletCut->errorScale * MESHLET_CUT_SCALE_MIN,
+                        meshletCut->errorScale * MESHLET_CUT_SCALE_MAX,
+                        m_meshletCutScratch.GetData(),
+                        selected);
+
+                    for (auto j = 0u; j < selectedCount;)
+                    {
+                        auto taskletMeshletCount = 1u;
+
+                        while (j + taskletMeshletCount < selectedCount &&
+                               taskletMeshletCount < PK_RHI_MAX_MESHLETS_PER_TASK &&
+                               selected[j + taskletMeshletCount] == selected[j] + taskletMeshletCount)
+                        {
+                            ++taskletMeshletCount;
+                        }
+
+                        taskletView[taskletCount++] =
+                        {
+                            submesh.meshletFirst + selected[j],
+                            (i & 0xFFFFFFu) | ((taskletMeshletCount & 0xFF) << 24u)
+                        };
+
+                        j += taskletMeshletCount;
+                    }
+
+                    continue;
+                }
+
                 for (auto j = 0u; j < taskCount; ++j)
                 {
                     auto taskletMeshletCount = math::min(PK_RHI_MAX_MESHLETS_PER_TASK, submesh.meshletCount - j * PK_RHI_MAX_MESHLETS_PER_TASK);
@@ -226,12 +296,32 @@ namespace PK::App
             info->material = (uint16_t)m_materials[materialIndex].batchIndex;
         }
 
-        auto meshletCount = mesh->GetSubmesh(submesh).meshletCount;
-        m_taskletCount += (meshletCount + PK_RHI_MAX_MESHLETS_PER_TASK - 1u) / PK_RHI_MAX_MESHLETS_PER_TASK;
+        // Meshlet cuts can split tasklets at every meshlet. Reserve for the worst case.
+        const auto& drawSubmesh = mesh->GetSubmesh(submesh);
+        const auto meshletCount = drawSubmesh.meshletCount;
+        m_taskletCount += drawSubmesh.hierarchy ? meshletCount : (meshletCount + PK_RHI_MAX_MESHLETS_PER_TASK - 1u) / PK_RHI_MAX_MESHLETS_PER_TASK;
         m_drawInfoCount++;
     }
 
+    void BatcherMeshStatic::SetMeshletCut(const float4x4& worldToClip, float errorScale)
+    {
+        PK_FATAL_ASSERT(m_groupIndex > 0u, "Cannot set a meshlet cut without an active group!");
+
+        if (m_meshletCuts.GetCount() < MAX_MESHLET_CUTS)
+        {
+            m_meshletCuts.Add(MeshletCut{ worldToClip, errorScale, m_groupIndex - 1u });
+        }
+    }
+
     bool BatcherMeshStatic::RenderGroup(CommandBufferExt cmd, uint32_t group, FixedFunctionShaderAttributes* overrideAttributes, uint32_t requireKeyword)
+    {
+        m_commandList.Reset();
+        RecordGroup(&m_commandList, group, overrideAttributes, requireKeyword);
+        m_commandList.Replay(cmd);
+        return true;
+    }
+
+    bool BatcherMeshStatic::RecordGroup(CommandList* list, uint32_t group, FixedFunctionShaderAttributes* overrideAttributes, uint32_t requireKeyword)
     {
         if (group >= m_groupCount)
         {
@@ -240,14 +330,14 @@ namespace PK::App
 
         if (requireKeyword > 0u)
         {
-            RHI::SetKeyword(requireKeyword, true);
+            list->SetKeyword(requireKeyword, true);
         }
 
         auto hash = HashCache::Get();
-        RHI::SetBuffer(hash->pk_Meshlet_Submeshes, m_meshAllocator.GetMeshletSubmeshBuffer());
-        RHI::SetBuffer(hash->pk_Meshlets, m_meshAllocator.GetMeshletBuffer());
-        RHI::SetBuffer(hash->pk_Meshlet_Vertices, m_meshAllocator.GetMeshletVertexBuffer());
-        RHI::SetBuffer(hash->pk_Meshlet_Indices, m_meshAllocator.GetMeshletIndexBuffer());
+        list->SetBuffer(hash->pk_Meshlet_Submeshes, m_meshAllocator.GetMeshletSubmeshBuffer());
+        list->SetBuffer(hash->pk_Meshlets, m_meshAllocator.GetMeshletBuffer());
+        list->SetBuffer(hash->pk_Meshlet_Vertices, m_meshAllocator.GetMeshletVertexBuffer());
+        list->SetBuffer(hash->pk_Meshlet_Indices, m_meshAllocator.GetMeshletIndexBuffer());
 
         const auto& passGroup = m_resolvedGroups[group];
 
@@ -258,16 +348,16 @@ namespace PK::App
 
             if (requireKeyword == 0u || shader->SupportsKeyword(requireKeyword))
             {
-                RHI::SetConstant<uint>(hash->pk_Meshlet_DispatchOffset, (uint32_t)dc.indices.offset);
-                cmd.SetShader(shader);
-                cmd.SetFixedStateAttributes(overrideAttributes);
-                cmd->DrawMeshTasks({ (uint32_t)dc.indices.count, 1u, 1u });
+                list->SetConstant<uint>(hash->pk_Meshlet_DispatchOffset, (uint32_t)dc.indices.offset);
+                list->SetShader(shader);
+                list->SetFixedStateAttributes(overrideAttributes);
+                list->DrawMeshTasks({ (uint32_t)dc.indices.count, 1u, 1u });
             }
         }
 
         if (requireKeyword > 0u)
         {
-            RHI::SetKeyword(requireKeyword, false);
+            list->SetKeyword(requireKeyword, false);
         }
 
         return true;
@@ -1,6 +1,9 @@
 #pragma once
 #include "Core/Base/Containers/FixedArena.h"
 #include "Core/Base/Containers/HashMap.h"
+#include "Core/Assets/AssetImportEvent.h"
+#include "Core/ControlFlow/IStep.h"
+#include "Core/Rendering/CommandList.h"
 #include "Core/Rendering/Mesh.h"
 #include "Core/Rendering/ShaderAsset.h"
 #include "Core/Rendering/Material.h"
@@ -13,10 +16,14 @@ namespace PK::App
 {
     struct ComponentTransform;
 
-    class BatcherMeshStatic : public IBatcher, public AssetFactory<MeshStatic>
+    class BatcherMeshStatic : public IBatcher, public AssetFactory<MeshStatic>, public IStep<AssetImportEvent<ShaderAsset>*>
     {
         constexpr static uint32_t MAX_SHADERS = 64u;
         constexpr static uint32_t MAX_MATERIALS = 2048u;
+        constexpr static uint32_t MAX_MESHLET_CUTS = 64u;
+        // Range of PK_MESHLET_LOD_SCALE used by surface & shadow shaders.
+        constexpr static float MESHLET_CUT_SCALE_MIN = 1.0f;
+        constexpr static float MESHLET_CUT_SCALE_MAX = 8.0f;
 
         struct DrawInfo
         {
@@ -52,6 +59,13 @@ namespace PK::App
             size_t count = 0ull;
         };
 
+        struct MeshletCut
+        {
+            float4x4 worldToClip;
+            float errorScale = 0.0f;
+            uint32_t group = 0u;
+        };
+
         struct ShaderReference
         {
             ShaderAsset* reference = nullptr;
@@ -96,18 +110,23 @@ namespace PK::App
         };
 
     public:
-        BatcherMeshStatic();
+        BatcherMeshStatic(bool quantizeMeshes);
 
         inline MeshStaticAllocator* GetMeshStaticAllocator() { return &m_meshAllocator; }
 
         void AssetConstruct(MeshStatic* memory, const char* filepath) final;
 
+        // Material property layouts are derived from the shader. Rebuilds dependent materials & cached slot strides.
+        virtual void Step(AssetImportEvent<ShaderAsset>* evt) final;
+
         void BeginCollectDrawCalls() final;
 
         void EndCollectDrawCalls(CommandBufferExt cmd) final;
 
         uint32_t BeginNewGroup() final { return m_groupIndex++; }
 
+        void SetMeshletCut(const float4x4& worldToClip, float errorScale) final;
+
         void SubmitMeshStaticDraw(ComponentTransform* transform,
             ShaderAsset* shader,
             Material* material,
@@ -121,6 +140,11 @@ namespace PK::App
             FixedFunctionShaderAttributes* overrideAttributes = nullptr,
             uint32_t requireKeyword = 0u) final;
 
+        bool RecordGroup(CommandList* list,
+            uint32_t group,
+            FixedFunctionShaderAttributes* overrideAttributes = nullptr,
+            uint32_t requireKeyword = 0u) final;
+
     private:
         void UploadTransforms(CommandBufferExt cmd);
         void UploadMaterials(CommandBufferExt cmd);
@@ -131,6 +155,9 @@ namespace PK::App
         FixedSet16<MaterialReference, MAX_MATERIALS, MaterialReferenceHash> m_materials;
         HashSet<ComponentTransform*> m_transforms;
         FixedArena<32768ull> m_drawArena;
+        FixedList<MeshletCut, MAX_MESHLET_CUTS> m_meshletCuts;
+        HeapArray<uint32_t> m_meshletCutScratch;
+        CommandList m_commandList;
         uint16_t m_groupIndex = 0u;
         uint32_t m_taskletCount = 0u;
         uint32_t m_drawInfoCount = 0u;
@@ -4,11 +4,12 @@
 
 namespace PK::App
 {
-    RequestEntityCullResults EntityCullSequencerProxy::CullFrustum(ScenePrimitiveFlags mask, const float4x4& matrix)
+    RequestEntityCullResults EntityCullSequencerProxy::CullFrustum(ScenePrimitiveFlags mask, const float4x4& matrix, bool useOcclusion)
     {
         RequestEntityCullFrustum request;
         request.mask = mask;
         request.matrix = matrix;
+        request.useOcclusion = useOcclusion;
         sequencer->Next(sequencerRoot, frameArena, &request);
         return request;
     }
@@ -34,6 +34,21 @@ namespace PK::App
     {
         ScenePrimitiveFlags mask;
         float4x4 matrix;
+        // Tests results against the largest occluders in the results. Requires a reverse z projection.
+        bool useOcclusion = false;
+        uint32_t outOccludedCount = 0u;
+    };
+
+    // Frustum visibility cache statistics of the previous frame.
+    struct EntityCullCacheInfo
+    {
+        uint32_t requestCount = 0u;
+        uint32_t invalidatedCount = 0u;
+        // Entities whose cached visibility was reused without testing.
+        uint32_t reusedCount = 0u;
+        // Cached rejections that were validated against a single plane.
+        uint32_t retestedCount = 0u;
+        uint32_t testedCount = 0u;
     };
 
     struct RequestEntityCullCubeFaces : public RequestEntityCullResults
@@ -74,7 +89,7 @@ namespace PK::App
         {
         }
 
-        RequestEntityCullResults CullFrustum(ScenePrimitiveFlags mask, const float4x4& matrix);
+        RequestEntityCullResults CullFrustum(ScenePrimitiveFlags mask, const float4x4& matrix, bool useOcclusion = false);
         RequestEntityCullResults CullCubeFaces(ScenePrimitiveFlags mask, const AABB<float3>& aabb);
         RequestEntityCullResults CullCascades(ScenePrimitiveFlags mask, float4x4* cascades, const float4& viewForwardPlane, const float* viewZOffsets, uint32_t count);
         void CullRayTracingGeometry(ScenePrimitiveFlags mask, const AABB<float3>& bounds, bool useBounds, QueueType queue, RHIAccelerationStructure* structure);
@@ -11,6 +11,8 @@ namespace PK::App
         CastShadows = 1 << 2,
         NeverCull = 1 << 3,
         RayTraceable = 1 << 4,
+        // Local bounds are solid & can be rasterized as occluder geometry.
+        Occluder = 1 << 5,
 
         // Presets
         DefaultMesh = Mesh | CastShadows | RayTraceable,
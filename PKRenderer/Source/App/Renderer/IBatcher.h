@@ -11,6 +11,8 @@ namespace PK::App
         virtual void BeginCollectDrawCalls() = 0;
         virtual void EndCollectDrawCalls(CommandBufferExt cmd) = 0;
         virtual uint32_t BeginNewGroup() = 0;
+        // Applies to the current group. Meshes with a meshlet hierarchy only dispatch meshlets that can pass the task shader lod test.
+        virtual void SetMeshletCut(const float4x4& worldToClip, float errorScale) = 0;
         virtual void SubmitMeshStaticDraw(ComponentTransform* transform,
             ShaderAsset* shader,
             Material* material,
@@ -23,5 +25,11 @@ namespace PK::App
             uint32_t group,
             FixedFunctionShaderAttributes* overrideAttributes = nullptr,
             uint32_t requireKeyword = 0u) = 0;
+
+        // Same as RenderGroup but records into a command list. Only reads batcher state, safe to call from worker threads.
+        virtual bool RecordGroup(CommandList* list,
+            uint32_t group,
+            FixedFunctionShaderAttributes* overrideAttributes = nullptr,
+            uint32_t requireKeyword = 0u) = 0;
     };
 }
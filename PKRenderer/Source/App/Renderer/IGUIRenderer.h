@@ -26,6 +26,11 @@ namespace PK::App
         virtual void GUIDrawWireRect(const color32& color, const short4& rect, short inset) = 0;
         virtual void GUIDrawLine(const color32& color0, const color32& color1, const short2& p0, const short2& p1, const float width) = 0;
         virtual short4 GUIDrawText(const color32& color, const short4& rect, const char* text, const FontStyle& style) = 0;
+
+        // Retained draw lists. Returns false if the list with the same key & content hash was drawn during the previous frames.
+        // In that case the resident geometry is drawn & the caller should skip its draws. Otherwise draws are recorded until GUIEndList.
+        virtual bool GUIBeginList(uint64_t key, uint64_t contentHash) = 0;
+        virtual void GUIEndList() = 0;
     };
 
     struct IGizmosRenderer
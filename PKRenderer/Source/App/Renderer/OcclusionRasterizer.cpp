@@ -0,0 +1,380 @@
+#include "PrecompiledHeader.h"
+#include "Core/Base/Memory.h"
+#include "Core/Math/Batch.h"
+#include "OcclusionRasterizer.h"
+
+#if PK_MATH_SIMD_SSE2
+#include <immintrin.h>
+#endif
+
+namespace PK::App
+{
+    constexpr static const uint64_t OCCLUSION_TILE_MASK_FULL = ~0ull;
+
+    // Edge functions are in the form of a * x + b * y + c. Inside is positive for all three edges.
+    static uint64_t OcclusionTileCoverageScalar(const float* a, const float* b, const float* c, float x0, float y0)
+    {
+        uint64_t mask = 0ull;
+
+        for (auto row = 0u; row < OcclusionRasterizer::TILE_SIZE; ++row)
+        {
+            const auto y = y0 + row;
+
+            for (auto column = 0u; column < OcclusionRasterizer::TILE_SIZE; ++column)
+            {
+                const auto x = x0 + column;
+                const auto r0 = (a[0] * x + c[0]) + b[0] * y;
+                const auto r1 = (a[1] * x + c[1]) + b[1] * y;
+                const auto r2 = (a[2] * x + c[2]) + b[2] * y;
+                mask |= (uint64_t)(math::min(r0, math::min(r1, r2)) >= 0.0f) << (row * OcclusionRasterizer::TILE_SIZE + column);
+            }
+        }
+
+        return mask;
+    }
+
+    #if PK_MATH_SIMD_SSE2
+    PK_BATCH_TARGET_BEGIN("avx2")
+    // One tile row per iteration. Evaluated in the same order as the scalar path so that masks match exactly.
+    static uint64_t OcclusionTileCoverageAvx2(const float* a, const float* b, const float* c, float x0, float y0)
+    {
+        uint64_t mask = 0ull;
+        const auto zero = _mm256_setzero_ps();
+        const auto x = _mm256_add_ps(_mm256_set1_ps(x0), _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f));
+        const auto e0 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[0]), x), _mm256_set1_ps(c[0]));
+        const auto e1 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[1]), x), _mm256_set1_ps(c[1]));
+        const auto e2 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(a[2]), x), _mm256_set1_ps(c[2]));
+
+        for (auto row = 0u; row < OcclusionRasterizer::TILE_SIZE; ++row)
+        {
+            const auto y = y0 + row;
+            const auto r0 = _mm256_add_ps(e0, _mm256_set1_ps(b[0] * y));
+            const auto r1 = _mm256_add_ps(e1, _mm256_set1_ps(b[1] * y));
+            const auto r2 = _mm256_add_ps(e2, _mm256_set1_ps(b[2] * y));
+            const auto inside = _mm256_cmp_ps(_mm256_min_ps(r0, _mm256_min_ps(r1, r2)), zero, _CMP_GE_OQ);
+            mask |= (uint64_t)(uint32_t)_mm256_movemask_ps(inside) << (row * OcclusionRasterizer::TILE_SIZE);
+        }
+
+        return mask;
+    }
+    PK_BATCH_TARGET_END()
+    #endif
+
+    // Dispatched at runtime so that the baseline target does not need to include avx2.
+    static uint64_t OcclusionTileCoverage(const float* a, const float* b, const float* c, float x0, float y0)
+    {
+        #if PK_MATH_SIMD_SSE2
+        if ((uint32_t)math::getSimdIsa() >= (uint32_t)math::simd_isa::avx2)
+        {
+            return OcclusionTileCoverageAvx2(a, b, c, x0, y0);
+        }
+        #endif
+
+        return OcclusionTileCoverageScalar(a, b, c, x0, y0);
+    }
+
+    static bool OcclusionProjectVertex(const float4& clip, float3* outScreen)
+    {
+        // Reverse z. Points in front of the near plane have z > w.
+        if (clip.w <= 1e-6f || clip.z > clip.w)
+        {
+            return false;
+        }
+
+        const auto rcpw = 1.0f / clip.w;
+        outScreen->x = (clip.x * rcpw * 0.5f + 0.5f) * OcclusionRasterizer::WIDTH;
+        outScreen->y = (clip.y * rcpw * 0.5f + 0.5f) * OcclusionRasterizer::HEIGHT;
+        outScreen->z = clip.z * rcpw;
+        return true;
+    }
+
+
+    void OcclusionRasterizer::Clear(const float4x4& worldToClip)
+    {
+        m_worldToClip = worldToClip;
+        m_triangleCount = 0u;
+
+        for (auto& tile : m_tiles)
+        {
+            tile.mask = 0ull;
+            tile.zMin0 = PK_CLIPZ_FAR;
+            tile.zMin1 = PK_CLIPZ_NEAR;
+        }
+
+        Memory::Memset(m_blocks, 0, BLOCK_COUNT_X * BLOCK_COUNT_Y);
+    }
+
+    void OcclusionRasterizer::RasterizeTriangles(const float4* clipPositions, const uint16_t* indices, uint32_t triangleCount)
+    {
+        for (auto i = 0u; i < triangleCount; ++i)
+        {
+            float3 v0, v1, v2;
+
+            // Clipping is not worth it for a conservative result. Skip triangles crossing the near plane.
+            if (OcclusionProjectVertex(clipPositions[indices[i * 3u + 0u]], &v0) &&
+                OcclusionProjectVertex(clipPositions[indices[i * 3u + 1u]], &v1) &&
+                OcclusionProjectVertex(clipPositions[indices[i * 3u + 2u]], &v2))
+            {
+                RasterizeTriangle(v0, v1, v2);
+            }
+        }
+    }
+
+    void OcclusionRasterizer::RasterizeBox(const AABB<float3>& localAABB, const float3x4& localToWorld)
+    {
+        const uint16_t boxIndices[36] =
+        {
+            0, 1, 3, 0, 3, 2,
+            4, 6, 7, 4, 7, 5,
+            0, 4, 5, 0, 5, 1,
+            2, 3, 7, 2, 7, 6,
+            0, 2, 6, 0, 6, 4,
+            1, 5, 7, 1, 7, 3
+        };
+
+        float4 clipPositions[8];
+
+        for (auto i = 0u; i < 8u; ++i)
+        {
+            const auto local = float3(i & 1u ? localAABB.max.x : localAABB.min.x, i & 2u ? localAABB.max.y : localAABB.min.y, i & 4u ? localAABB.max.z : localAABB.min.z);
+            const auto world = float4(local, 1.0f) * localToWorld;
+            clipPositions[i] = m_worldToClip * float4(world, 1.0f);
+        }
+
+        RasterizeTriangles(clipPositions, boxIndices, 12u);
+    }
+
+    void OcclusionRasterizer::Finalize()
+    {
+        for (auto by = 0u; by < BLOCK_COUNT_Y; ++by)
+        for (auto bx = 0u; bx < BLOCK_COUNT_X; ++bx)
+        {
+            auto zMin = PK_CLIPZ_NEAR;
+
+            for (auto ty = by * BLOCK_SIZE; ty < (by + 1u) * BLOCK_SIZE; ++ty)
+            for (auto tx = bx * BLOCK_SIZE; tx < (bx + 1u) * BLOCK_SIZE; ++tx)
+            {
+                zMin = math::min(zMin, m_tiles[ty * TILE_COUNT_X + tx].zMin0);
+            }
+
+            m_blocks[by * BLOCK_COUNT_X + bx] = zMin;
+        }
+    }
+
+    bool OcclusionRasterizer::TestAABB(const AABB<float3>& aabb) const
+    {
+        float4 rect;
+        float zMax;
+
+        if (!ProjectAABB(aabb, &rect, &zMax))
+        {
+            return true;
+        }
+
+        const auto px0 = (int32_t)math::max(0.0f, rect.x);
+        const auto py0 = (int32_t)math::max(0.0f, rect.y);
+        const auto px1 = (int32_t)math::min((float)(WIDTH - 1u), rect.z);
+        const auto py1 = (int32_t)math::min((float)(HEIGHT - 1u), rect.w);
+
+        // Off screen due to precision. Frustum culling has already accepted these.
+        if (px0 > px1 || py0 > py1)
+        {
+            return true;
+        }
+
+        const auto tx0 = (uint32_t)px0 / TILE_SIZE;
+        const auto ty0 = (uint32_t)py0 / TILE_SIZE;
+        const auto tx1 = (uint32_t)px1 / TILE_SIZE;
+        const auto ty1 = (uint32_t)py1 / TILE_SIZE;
+
+        for (auto by = ty0 / BLOCK_SIZE; by <= ty1 / BLOCK_SIZE; ++by)
+        for (auto bx = tx0 / BLOCK_SIZE; bx <= tx1 / BLOCK_SIZE; ++bx)
+        {
+            // Whole block is in front of the bounds.
+            if (zMax < m_blocks[by * BLOCK_COUNT_X + bx])
+            {
+                continue;
+            }
+
+            const auto blockTy0 = math::max(ty0, by * BLOCK_SIZE);
+            const auto blockTy1 = math::min(ty1, (by + 1u) * BLOCK_SIZE - 1u);
+            const auto blockTx0 = math::max(tx0, bx * BLOCK_SIZE);
+            const auto blockTx1 = math::min(tx1, (bx + 1u) * BLOCK_SIZE - 1u);
+
+            for (auto ty = blockTy0; ty <= blockTy1; ++ty)
+            for (auto tx = blockTx0; tx <= blockTx1; ++tx)
+            {
+                if (zMax >= m_tiles[ty * TILE_COUNT_X + tx].zMin0)
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    float OcclusionRasterizer::GetScreenArea(const AABB<float3>& aabb) const
+    {
+        float4 rect;
+        float zMax;
+
+        if (!ProjectAABB(aabb, &rect, &zMax))
+        {
+            return 0.0f;
+        }
+
+        const auto w = math::min((float)WIDTH, rect.z) - math::max(0.0f, rect.x);
+        const auto h = math::min((float)HEIGHT, rect.w) - math::max(0.0f, rect.y);
+        return w > 0.0f && h > 0.0f ? (w * h) / (float)(WIDTH * HEIGHT) : 0.0f;
+    }
+
+
+    void OcclusionRasterizer::RasterizeTriangle(const float3& v0, const float3& v1, const float3& v2)
+    {
+        const auto area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+
+        if (math::abs(area) < 1e-4f)
+        {
+            return;
+        }
+
+        // Both windings are accepted. Flip to keep the inside positive.
+        const float3 v[3] = { v0, area > 0.0f ? v1 : v2, area > 0.0f ? v2 : v1 };
+
+        const auto minx = math::max(0.0f, math::floor(math::min(v[0].x, math::min(v[1].x, v[2].x))));
+        const auto miny = math::max(0.0f, math::floor(math::min(v[0].y, math::min(v[1].y, v[2].y))));
+        const auto maxx = math::min((float)(WIDTH - 1u), math::ceil(math::max(v[0].x, math::max(v[1].x, v[2].x))));
+        const auto maxy = math::min((float)(HEIGHT - 1u), math::ceil(math::max(v[0].y, math::max(v[1].y, v[2].y))));
+
+        if (minx > maxx || miny > maxy)
+        {
+            return;
+        }
+
+        // Conservative depth of an occluder is its farthest point.
+        const auto triZ = math::min(v[0].z, math::min(v[1].z, v[2].z));
+
+        float a[3], b[3], c[3];
+
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            const auto& p0 = v[i];
+            const auto& p1 = v[(i + 1u) % 3u];
+            a[i] = p0.y - p1.y;
+            b[i] = p1.x - p0.x;
+            c[i] = (p1.y - p0.y) * p0.x - (p1.x - p0.x) * p0.y;
+        }
+
+        const auto tx0 = (uint32_t)minx / TILE_SIZE;
+        const auto ty0 = (uint32_t)miny / TILE_SIZE;
+        const auto tx1 = (uint32_t)maxx / TILE_SIZE;
+        const auto ty1 = (uint32_t)maxy / TILE_SIZE;
+
+        for (auto ty = ty0; ty <= ty1; ++ty)
+        for (auto tx = tx0; tx <= tx1; ++tx)
+        {
+            auto& tile = m_tiles[ty * TILE_COUNT_X + tx];
+
+            // Already covered by something closer.
+            if (triZ <= tile.zMin0)
+            {
+                continue;
+            }
+
+            const auto mask = OcclusionTileCoverage(a, b, c, tx * TILE_SIZE + 0.5f, ty * TILE_SIZE + 0.5f);
+
+            if (mask == 0ull)
+            {
+                continue;
+            }
+
+            // Merge into the working layer. Once fully covered it replaces the reference layer.
+            tile.zMin1 = math::min(tile.zMin1, triZ);
+            tile.mask |= mask;
+
+            if (tile.mask == OCCLUSION_TILE_MASK_FULL)
+            {
+                tile.zMin0 = math::max(tile.zMin0, tile.zMin1);
+                tile.zMin1 = PK_CLIPZ_NEAR;
+                tile.mask = 0ull;
+            }
+        }
+
+        ++m_triangleCount;
+    }
+
+    bool OcclusionRasterizer::ProjectAABB(const AABB<float3>& aabb, float4* outRect, float* outZMax) const
+    {
+        *outRect = float4(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+        *outZMax = PK_CLIPZ_FAR;
+
+        // Corner pairs of the box edges. Corner bits are xyz.
+        const uint8_t edges[12][2] =
+        {
+            { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+            { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+            { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+        };
+
+        float4 clipPositions[8];
+        auto validMask = 0u;
+
+        auto include = [outRect, outZMax](const float3& screen)
+        {
+            outRect->x = math::min(outRect->x, screen.x);
+            outRect->y = math::min(outRect->y, screen.y);
+            outRect->z = math::max(outRect->z, screen.x);
+            outRect->w = math::max(outRect->w, screen.y);
+            *outZMax = math::max(*outZMax, screen.z);
+        };
+
+        for (auto i = 0u; i < 8u; ++i)
+        {
+            const auto corner = float3(i & 1u ? aabb.max.x : aabb.min.x, i & 2u ? aabb.max.y : aabb.min.y, i & 4u ? aabb.max.z : aabb.min.z);
+            clipPositions[i] = m_worldToClip * float4(corner, 1.0f);
+            float3 screen;
+
+            if (OcclusionProjectVertex(clipPositions[i], &screen))
+            {
+                include(screen);
+                validMask |= 1u << i;
+            }
+        }
+
+        // Fully in front of the near plane.
+        if (validMask == 0u)
+        {
+            return false;
+        }
+
+        // Clip edges crossing the near plane. The clipped box projects to the bounds of the remaining corners & the edge intersections.
+        if (validMask != 0xFFu)
+        {
+            for (const auto& edge : edges)
+            {
+                const auto valid0 = (validMask & (1u << edge[0])) != 0u;
+                const auto valid1 = (validMask & (1u << edge[1])) != 0u;
+
+                if (valid0 != valid1)
+                {
+                    const auto& c0 = clipPositions[edge[0]];
+                    const auto& c1 = clipPositions[edge[1]];
+                    const auto d0 = c0.w - c0.z;
+                    const auto d1 = c1.w - c1.z;
+                    auto clip = c0 + (c1 - c0) * (d0 / (d0 - d1));
+                    // Snap onto the near plane to avoid rejecting the intersection due to rounding.
+                    clip.z = clip.w;
+                    float3 screen;
+
+                    if (OcclusionProjectVertex(clip, &screen))
+                    {
+                        include(screen);
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+}
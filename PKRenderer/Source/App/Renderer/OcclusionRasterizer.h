@@ -0,0 +1,56 @@
+#pragma once
+#include "Core/Base/NoCopy.h"
+#include "Core/Math/Math.h"
+
+namespace PK::App
+{
+    // Masked software occlusion. Occluders are rasterized into a coarse tiled depth buffer.
+    // Each tile stores a coverage mask of 8x8 pixels & two conservative depth layers.
+    // Depth is reverse z ndc. Only triangles fully in front of the near plane are rasterized.
+    // Tile coverage uses avx2 when getSimdIsa reports it. The masks match the scalar path exactly.
+    class OcclusionRasterizer : public NoCopy
+    {
+    public:
+        constexpr static const uint32_t WIDTH = 256u;
+        constexpr static const uint32_t HEIGHT = 128u;
+        constexpr static const uint32_t TILE_SIZE = 8u;
+        constexpr static const uint32_t TILE_COUNT_X = WIDTH / TILE_SIZE;
+        constexpr static const uint32_t TILE_COUNT_Y = HEIGHT / TILE_SIZE;
+        // Tiles per side of a hierarchy block.
+        constexpr static const uint32_t BLOCK_SIZE = 4u;
+        constexpr static const uint32_t BLOCK_COUNT_X = TILE_COUNT_X / BLOCK_SIZE;
+        constexpr static const uint32_t BLOCK_COUNT_Y = TILE_COUNT_Y / BLOCK_SIZE;
+
+        struct Tile
+        {
+            uint64_t mask;
+            // Farthest depth of the fully covered layer.
+            float zMin0;
+            // Farthest depth of the partially covered working layer.
+            float zMin1;
+        };
+
+        void Clear(const float4x4& worldToClip);
+        void RasterizeTriangles(const float4* clipPositions, const uint16_t* indices, uint32_t triangleCount);
+        void RasterizeBox(const AABB<float3>& localAABB, const float3x4& localToWorld);
+        // Builds the hierarchy levels. Call after rasterizing all occluders.
+        void Finalize();
+
+        // Returns false for bounds that are fully behind rasterized occluders.
+        bool TestAABB(const AABB<float3>& aabb) const;
+        // Projected screen area ratio of the bounds. Bounds crossing the near plane are clipped against it.
+        float GetScreenArea(const AABB<float3>& aabb) const;
+
+        constexpr uint32_t GetRasterizedTriangleCount() const { return m_triangleCount; }
+        constexpr const Tile* GetTiles() const { return m_tiles; }
+
+    private:
+        void RasterizeTriangle(const float3& v0, const float3& v1, const float3& v2);
+        bool ProjectAABB(const AABB<float3>& aabb, float4* outRect, float* outZMax) const;
+
+        float4x4 m_worldToClip = PK_FLOAT4X4_IDENTITY;
+        Tile m_tiles[TILE_COUNT_X * TILE_COUNT_Y];
+        float m_blocks[BLOCK_COUNT_X * BLOCK_COUNT_Y];
+        uint32_t m_triangleCount = 0u;
+    };
+}
@@ -2,6 +2,7 @@
 #include <bend/bend_sss_cpu.h>
 #include "Core/Base/Containers/FixedArena.h"
 #include "Core/Base/Sort.h"
+#include "Core/ControlFlow/WorkerPool.h"
 #include "Core/Math/Projection.h"
 #include "Core/ECS/EntityDatabase.h"
 #include "Core/Assets/AssetDatabase.h"
@@ -156,6 +157,34 @@ namespace PK::App
         RHI::GetQueues()->GetCommandBuffer(QueueType::Transfer)->Clear(m_lightsCounter.get(), 0, sizeof(uint32_t), 0u);
     }
 
+    uint32_t PassLights::BuildLightSortKeys(EntityDatabase* entityDb, const RequestEntityCullResults& culledLights, LightSortKey* outKeys, uint32_t* outShadowCasterCount)
+    {
+        const auto lightCount = (uint32_t)culledLights.GetCount();
+        auto matrixCount = 0u;
+        auto shadowCasterCount = 0u;
+
+        for (auto i = 0U; i < lightCount; ++i)
+        {
+            auto view = entityDb->Query<EntityViewLight>(culledLights[i].entityId);
+            outKeys[i] = { *view.entityId, view.light->type, view.primitive->flags };
+
+            auto castsSHadows = bool(view.primitive->flags & ScenePrimitiveFlags::CastShadows);
+            matrixCount += SHADOW_TYPE_INFOS[(int)view.light->type].MatrixCount * castsSHadows;
+            shadowCasterCount += castsSHadows;
+        }
+
+        PK::IntroSort(outKeys, outKeys + lightCount, TLessFunc<LightSortKey>(
+        [](LightSortKey const& a, LightSortKey const& b)
+        {
+            auto keyA = (int32_t)a.type | ((int32_t)((a.flags & ScenePrimitiveFlags::CastShadows) == 0) << 4);
+            auto keyB = (int32_t)b.type | ((int32_t)((b.flags & ScenePrimitiveFlags::CastShadows) == 0) << 4);
+            return keyA < keyB;
+        }));
+
+        *outShadowCasterCount = shadowCasterCount;
+        return matrixCount;
+    }
+
     void PassLights::BuildLights(RenderPipelineContext* context)
     {
         auto renderView = context->views[0];
@@ -171,32 +200,18 @@ namespace PK::App
         const auto tileZParams = math::exponentialZParams<float>(renderView->znear, renderView->zfar, m_tileZDistribution, LightGridSizeZ);
         const auto shadowCasterMask = ScenePrimitiveFlags::Mesh | ScenePrimitiveFlags::CastShadows;
         const auto lightCount = (uint)culledLights.GetCount();
-        auto matrixCount = 1u;
         auto shadowCount = 0u;
 
         float cascadeZSplits[5];
         math::cascadeDepths<float, 5>(renderView->znear, renderView->zfar, m_cascadeDistribution, cascadeZSplits, tileZParams);
 
+        auto shadowCasterCount = 0u;
         resources->lightKeys = { context->frameArena->Allocate<LightSortKey>(lightCount), lightCount };
-        resources->shadowBatches = { context->frameArena->GetHead<ShadowbatchInfo>(), 0ull };
+        auto matrixCount = 1u + BuildLightSortKeys(context->entityDb, culledLights, resources->lightKeys.data, &shadowCasterCount);
 
-        for (auto i = 0U; i < lightCount; ++i)
-        {
-            auto view = context->entityDb->Query<EntityViewLight>(culledLights[i].entityId);
-            resources->lightKeys[i] = { *view.entityId, view.light->type, view.primitive->flags };
-
-            auto castsSHadows = bool(view.primitive->flags & ScenePrimitiveFlags::CastShadows);
-            matrixCount += SHADOW_TYPE_INFOS[(int)view.light->type].MatrixCount * castsSHadows;
-            context->frameArena->Allocate<ShadowbatchInfo>(castsSHadows);
-        }
-
-        PK::IntroSort(resources->lightKeys.data, resources->lightKeys.data + lightCount, TLessFunc<LightSortKey>(
-        [](LightSortKey const& a, LightSortKey const& b)
-        {
-            auto keyA = (int32_t)a.type | ((int32_t)((a.flags & ScenePrimitiveFlags::CastShadows) == 0) << 4);
-            auto keyB = (int32_t)b.type | ((int32_t)((b.flags & ScenePrimitiveFlags::CastShadows) == 0) << 4);
-            return keyA < keyB;
-        }));
+        // Reserve the upper bound of batches. Actual count is resolved when rendering shadows.
+        resources->shadowBatches = { context->frameArena->GetHead<ShadowbatchInfo>(), 0ull };
+        context->frameArena->Allocate<ShadowbatchInfo>(shadowCasterCount);
 
         RHI::ValidateBuffer<PackedLight>(m_lightsBuffer, lightCount + 1u);
         RHI::ValidateBuffer<float4x4>(m_lightMatricesBuffer, matrixCount);
@@ -360,12 +375,24 @@ namespace PK::App
             hash->PK_LIGHT_PASS_POINT,
         };
 
+        while (m_shadowCommandLists.GetCount() < batches.count)
+        {
+            m_shadowCommandLists.Add(CreateUnique<CommandList>());
+        }
+
+        // Batch groups are recorded in parallel & replayed in batch order between the render target changes.
+        context->workerPool->ParallelFor((uint32_t)batches.count, [&](uint32_t index, [[maybe_unused]] uint32_t workerIndex)
+        {
+            auto list = m_shadowCommandLists[index].get();
+            list->Reset();
+            context->batcher->RecordGroup(list, batches[index].batchGroup, nullptr, passKeywords[(uint32_t)batches[index].type]);
+        });
+
         for (auto i = 0u; i < batches.count; ++i)
         {
             const auto& batch = batches[i];
             auto& shadow = SHADOW_TYPE_INFOS[(int)batch.type];
             auto tileCount = shadow.TileCount * batch.count;
-            auto keyword = passKeywords[(uint32_t)batch.type];
 
             cmd->BeginDebugScope("ShadowBatch", PK_COLOR_RED);
 
@@ -377,7 +404,7 @@ namespace PK::App
                 auto targetDepth = RenderTargetBinding(m_depthTargetCube.get(), range0, LoadOp::Clear, StoreOp::Store, { PK_CLIPZ_FAR, 0u });
                 auto targetDist = RenderTargetBinding(m_shadowTargetCube.get(), range0, LoadOp::Clear, StoreOp::Store, float4(PK_HALF_MAX) );
                 cmd.SetRenderTarget({ targetDepth, targetDist }, true);
-                context->batcher->RenderGroup(cmd, batch.batchGroup, nullptr, keyword);
+                m_shadowCommandLists[i]->Replay(cmd);
 
                 RHI::SetTexture(hash->pk_Texture, m_shadowTargetCube.get());
                 RHI::SetImage(hash->pk_Image, m_shadowmaps.get(), range1);
@@ -388,7 +415,7 @@ namespace PK::App
                 auto targetDepth = RenderTargetBinding(m_depthTarget2D.get(), range0, LoadOp::Clear, StoreOp::Store, { PK_CLIPZ_FAR, 0u });
                 auto targetDist = RenderTargetBinding(m_shadowmaps.get(), range1, LoadOp::Clear, StoreOp::Store, float4(PK_HALF_MAX));
                 cmd.SetRenderTarget({ targetDepth, targetDist }, true);
-                context->batcher->RenderGroup(cmd, batch.batchGroup, nullptr, keyword);
+                m_shadowCommandLists[i]->Replay(cmd);
             }
 
             cmd->EndDebugScope();
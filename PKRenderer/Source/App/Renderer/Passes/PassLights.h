@@ -1,9 +1,11 @@
 #pragma once
 #include "Core/CLI/CVariable.h"
+#include "Core/Rendering/CommandList.h"
 #include "Core/Rendering/IESProfile.h"
 #include "App/Renderer/RenderView.h"
 
 namespace PK { class AssetDatabase; }
+namespace PK { struct EntityDatabase; }
 
 namespace PK::App
 {
@@ -64,6 +66,9 @@ namespace PK::App
             void ComputeClusters(CommandBufferExt cmd, RenderPipelineContext* context);
 
             static void BuildShadowCascadeMatrices(const ShadowCascadeCreateInfo info, float4x4* outMatrices);
+            
+            // Writes type & shadow sorted keys for culled lights. Returns the number of shadow matrices required.
+            static uint32_t BuildLightSortKeys(EntityDatabase* entityDb, const RequestEntityCullResults& culledLights, LightSortKey* outKeys, uint32_t* outShadowCasterCount);
 
         private:
             ShaderAsset* m_computeLightAssignment = nullptr;
@@ -77,6 +82,7 @@ namespace PK::App
             RHITextureRef m_depthTargetCube;
             RHITextureRef m_shadowTargetCube;
             IESProfileAtlas m_iesAtlas;
+            HeapList<Unique<CommandList>> m_shadowCommandLists;
             
             CVariableField<float> m_cascadeDistribution = { "Renderer.Lights.CascadeDistribution", 0.5f };
             CVariableField<float> m_tileZDistribution = { "Renderer.Lights.TileZDistribution", 10.0f };
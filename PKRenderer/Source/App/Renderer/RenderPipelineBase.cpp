@@ -20,8 +20,9 @@
 
 namespace PK::App
 {
-    RenderPipelineBase::RenderPipelineBase(EntityDatabase* entityDb, AssetDatabase* assetDatabase, Sequencer* sequencer, IBatcher* batcher) :
+    RenderPipelineBase::RenderPipelineBase(EntityDatabase* entityDb, AssetDatabase* assetDatabase, Sequencer* sequencer, WorkerPool* workerPool, IBatcher* batcher) :
         m_sequencer(sequencer),
+        m_workerPool(workerPool),
         m_entityDb(entityDb),
         m_batcher(batcher),
         m_renderViewCount(0u)
@@ -204,6 +205,7 @@ namespace PK::App
         RenderPipelineContext context;
         context.frameArena = ctx->frameArena;
         context.sequencer = m_sequencer;
+        context.workerPool = m_workerPool;
         context.entityDb = m_entityDb;
         context.cullingProxy = &cullingProxy;
         context.batcher = m_batcher;
@@ -252,6 +254,8 @@ namespace PK::App
 
     void RenderPipelineBase::DispatchRenderPipelineEvent(RHICommandBuffer* cmd, RenderPipelineContext* context, RenderPipelineEvent::Type type)
     {
+        PK_PROFILE_SCOPE(RenderPipelineEvent::TypeNames[type]);
+
         // all active views should be of the same type
         auto view = context->views[0];
 
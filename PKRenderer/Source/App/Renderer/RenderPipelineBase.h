@@ -9,6 +9,7 @@
 
 namespace PK { struct IArena; }
 namespace PK { struct Sequencer; }
+namespace PK { class WorkerPool; }
 namespace PK { struct EntityDatabase; }
 namespace PK { class AssetDatabase; }
 
@@ -22,6 +23,7 @@ namespace PK::App
     {
         IArena* frameArena;
         Sequencer* sequencer;
+        WorkerPool* workerPool;
         EntityDatabase* entityDb;
         struct EntityCullSequencerProxy* cullingProxy;
         IBatcher* batcher;
@@ -66,6 +68,7 @@ namespace PK::App
         RenderPipelineBase(EntityDatabase* entityDb,
             AssetDatabase* assetDatabase,
             Sequencer* sequencer,
+            WorkerPool* workerPool,
             IBatcher* batcher);
 
         void OnStepFrameRender(FrameContext* ctx) final;
@@ -80,6 +83,7 @@ namespace PK::App
     
         private:
             Sequencer* m_sequencer = nullptr;
+            WorkerPool* m_workerPool = nullptr;
             EntityDatabase* m_entityDb = nullptr;
             IBatcher* m_batcher;
             RenderView m_renderViews[MAX_RENDER_VIEWS]{};
@@ -93,8 +97,9 @@ namespace PK::App
         IRenderPipeline(EntityDatabase* entityDb, 
             AssetDatabase* assetDatabase,
             Sequencer* sequencer,
+            WorkerPool* workerPool,
             IBatcher* batcher) : 
-            RenderPipelineBase(entityDb, assetDatabase, sequencer, batcher) 
+            RenderPipelineBase(entityDb, assetDatabase, sequencer, workerPool, batcher) 
         {
         }
 
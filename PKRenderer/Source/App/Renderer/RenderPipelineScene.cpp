@@ -17,8 +17,9 @@ namespace PK::App
     RenderPipelineScene::RenderPipelineScene(AssetDatabase* assetDatabase,
         EntityDatabase* entityDb,
         Sequencer* sequencer,
+        WorkerPool* workerPool,
         IBatcher* batcher) : 
-        IRenderPipeline(entityDb, assetDatabase, sequencer, batcher),
+        IRenderPipeline(entityDb, assetDatabase, sequencer, workerPool, batcher),
         m_passLights(assetDatabase),
         m_passSceneGI(assetDatabase),
         m_passVolumetricFog(assetDatabase),
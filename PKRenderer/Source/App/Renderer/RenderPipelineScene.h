@@ -35,6 +35,7 @@ namespace PK::App
             RenderPipelineScene(AssetDatabase* assetDatabase,
                 EntityDatabase* entityDb,
                 Sequencer* sequencer,
+                WorkerPool* workerPool,
                 IBatcher* batcher);
 
             ~RenderPipelineScene();
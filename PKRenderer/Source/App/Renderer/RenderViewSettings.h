@@ -147,19 +147,32 @@ namespace PK::App
         TextureAsset* EnvironmentTextureAsset = nullptr;
     };
 
+    struct GeometrySettings
+    {
+        bool LodEnabled = true;
+        // Max projected simplification error in pixels.
+        float LodScreenError = 1.0f;
+        // Cpu side meshlet selection for meshes with a meshlet hierarchy.
+        bool MeshletCutEnabled = true;
+        // Cpu side occlusion culling against entities flagged as occluders.
+        bool OcclusionCullingEnabled = true;
+    };
+
+    // Member types are qualified as gcc rejects members that change the meaning of their type name.
     struct RenderViewSettings
     {
         PostEffectsSettings PostEffectSettings;
-        RenderingDebugSettings RenderingDebugSettings;
-        DepthOfFieldSettings DepthOfFieldSettings;
-        AutoExposureSettings AutoExposureSettings;
-        FilmGrainSettings FilmGrainSettings;
-        VignetteSettings VignetteSettings;
-        DistortSettings DistortSettings;
-        ColorGradingSettings ColorGradingSettings;
-        BloomSettings BloomSettings;
-        TemporalAntialiasingSettings TemporalAntialiasingSettings;
-        FogSettings FogSettings;
-        EnvBackgroundSettings EnvBackgroundSettings;
+        App::RenderingDebugSettings RenderingDebugSettings;
+        App::DepthOfFieldSettings DepthOfFieldSettings;
+        App::AutoExposureSettings AutoExposureSettings;
+        App::FilmGrainSettings FilmGrainSettings;
+        App::VignetteSettings VignetteSettings;
+        App::DistortSettings DistortSettings;
+        App::ColorGradingSettings ColorGradingSettings;
+        App::BloomSettings BloomSettings;
+        App::TemporalAntialiasingSettings TemporalAntialiasingSettings;
+        App::FogSettings FogSettings;
+        App::EnvBackgroundSettings EnvBackgroundSettings;
+        App::GeometrySettings GeometrySettings;
     };
 }
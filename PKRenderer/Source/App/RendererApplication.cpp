@@ -2,11 +2,14 @@
 #include "Core/ECS/EntityDatabase.h"
 #include "Core/ECS/EntitySerializerRegister.h"
 #include "Core/Assets/AssetDatabase.h"
+#include "Core/Assets/AssetWatcher.h"
 #include "Core/CLI/CVariableRegister.h"
 #include "Core/CLI/Log.h"
 #include "Core/CLI/LoggerPrintf.h"
 #include "Core/ControlFlow/Sequencer.h"
 #include "Core/ControlFlow/RemoteProcessRunner.h"
+#include "Core/ControlFlow/WorkerPool.h"
+#include "Core/ControlFlow/WorkerThread.h"
 #include "Core/RHI/RHInterfaces.h"
 #include "Core/Rendering/ShaderAsset.h"
 #include "Core/Rendering/Mesh.h"
@@ -35,6 +38,7 @@
 #include "App/Renderer/RenderPipelineScene.h"
 #include "App/Renderer/RenderView.h"
 #include "App/BaseRendererConfig.h"
+#include "Benchmarks/BenchmarkApplication.h"
 #include "RendererApplication.h"
 
 namespace PK::App
@@ -67,6 +71,7 @@ namespace PK::App
 
         auto config = Serialize::Load<BaseRendererConfig>("Content/Configs/BaseRenderer.cfg");
         m_inactiveFrameInterval = config.InactiveFrameInterval;
+        m_isUpdateOverlapped = config.OverlapUpdateWithPresent;
         m_RHIDriver = RHI::CreateDriver(GetWorkingDirectory(), config.RHIDesc);
 
         config.WindowDesc.title = { GetName(), m_RHIDriver->GetDriverHeader() };
@@ -76,6 +81,7 @@ namespace PK::App
         GetServices()->Create<HashCache>();
 
         auto sequencer = GetServices()->Create<Sequencer>();
+        auto workerPool = GetServices()->Create<WorkerPool>(config.WorkerThreadCount);
         auto assetDatabase = GetServices()->Create<AssetDatabase>(sequencer);
         auto entityDb = GetServices()->Create<EntityDatabase>(32, 512);
         auto input = GetServices()->Create<EngineInput>(sequencer);
@@ -90,19 +96,21 @@ namespace PK::App
                 EntityFactory<EntityMeshStatic>::GetSerializer(),
             });
 
+        ShaderAsset::LoadVariantWarmupList(GetWorkingDirectory());
         assetDatabase->LoadDirectory<ShaderAsset>("Content/Shaders/");
 
-        auto batcherMeshStatic = GetServices()->Create<BatcherMeshStatic>();
+        auto batcherMeshStatic = GetServices()->Create<BatcherMeshStatic>(config.QuantizeStaticMeshes);
         assetDatabase->RegisterFactory<MeshStatic>(batcherMeshStatic);
 
-        auto renderPipelineScene = GetServices()->Create<RenderPipelineScene>(assetDatabase, entityDb, sequencer, batcherMeshStatic);
+        auto renderPipelineScene = GetServices()->Create<RenderPipelineScene>(assetDatabase, entityDb, sequencer, workerPool, batcherMeshStatic);
 
         auto inputConfig = assetDatabase->Load<Config<InputKeyConfig>>("Content/Configs/Input.cfg").get();
-        auto remoteProcessRunner = GetServices()->Create<RemoteProcessRunner>();
+        auto remoteProcessRunner = GetServices()->Create<RemoteProcessRunner>(sequencer);
+        auto assetWatcher = GetServices()->Create<AssetWatcher>(assetDatabase, "Content/");
         auto engineViewUpdate = GetServices()->Create<EngineViewUpdate>(sequencer, entityDb);
         auto engineCommands = GetServices()->Create<EngineCommandInput>(sequencer, inputConfig);
         auto engineUpdateTransforms = GetServices()->Create<EngineUpdateTransforms>(entityDb);
-        auto engineEntityCull = GetServices()->Create<EngineEntityCull>(entityDb);
+        auto engineEntityCull = GetServices()->Create<EngineEntityCull>(entityDb, sequencer, workerPool);
         auto engineDrawGeometry = GetServices()->Create<EngineDrawGeometry>(entityDb, sequencer);
         auto engineGatherRayTracingGeometry = GetServices()->Create<EngineGatherRayTracingGeometry>(entityDb);
         auto engineScreenshot = GetServices()->Create<EngineScreenshot>();
@@ -126,8 +134,10 @@ namespace PK::App
                         Sequencer::Step::Create<FrameStep::Update, FrameContext*>(engineViewUpdate),
                         Sequencer::Step::Create<FrameStep::Update, FrameContext*>(engineFlyCamera),
                         Sequencer::Step::Create<FrameStep::Update, FrameContext*>(engineUpdateTransforms),
+                        Sequencer::Step::Create<FrameStep::Render, FrameContext*>(engineCommands),
                         Sequencer::Step::Create<FrameStep::Render, FrameContext*>(renderPipelineScene),
                         Sequencer::Step::Create<FrameStep::Render, FrameContext*>(engineScreenshot),
+                        Sequencer::Step::Create<FrameStep::Finalize, FrameContext*>(engineEntityCull),
                         Sequencer::Step::Create<FrameStep::Finalize, FrameContext*>(time),
 
                         Sequencer::Step::Create<CArgumentsConst>(cvariableRegister),
@@ -141,6 +151,12 @@ namespace PK::App
                         Sequencer::Step::Create<TimeFramerateInfo*>(engineProfiler)
                     }
                 },
+                {
+                    engineEntityCull,
+                    {
+                        Sequencer::Step::Create<EntityCullCacheInfo*>(engineProfiler)
+                    }
+                },
                 {
                     renderPipelineScene,
                     {
@@ -166,12 +182,19 @@ namespace PK::App
                         Sequencer::Step::Create<IGUIRenderer*>(engineCommands)
                     }
                 },
+                {
+                    remoteProcessRunner,
+                    {
+                        Sequencer::Step::Create<RemoteProcessResult*>(assetWatcher)
+                    }
+                },
                 {
                     assetDatabase,
                     {
                         Sequencer::Step::Create<AssetImportEvent<Config<EngineDebugConfig>>*>(engineDebug),
                         Sequencer::Step::Create<AssetImportEvent<Config<InputKeyConfig>>*>(engineFlyCamera),
-                        Sequencer::Step::Create<AssetImportEvent<Config<InputKeyConfig>>*>(engineCommands)
+                        Sequencer::Step::Create<AssetImportEvent<Config<InputKeyConfig>>*>(engineCommands),
+                        Sequencer::Step::Create<AssetImportEvent<ShaderAsset>*>(batcherMeshStatic)
                     }
                 },
             });
@@ -193,13 +216,20 @@ namespace PK::App
         CVariableRegister::Create<CVariableFunc>("Application.Fullscreen", [](const char* const* args, [[maybe_unused]] uint32_t count)
             {
                 IApplication::Get()->GetPrimaryWindow()->SetFullscreen((bool)atoi(args[0]));
-            }, "0 = 0ff, 1 = On", 1u);
+            }, "0 = Off, 1 = On", 1u);
 
         CVariableRegister::Create<CVariableFuncSimple>("Application.Fullscreen.Toggle", []()
             {
                 IApplication::Get()->GetPrimaryWindow()->SetFullscreen(!IApplication::Get()->GetPrimaryWindow()->IsFullscreen());
             });
 
+        CVariableRegister::Create<CVariableFunc>("Application.OverlapUpdateWithPresent", [this](const char* const* args, [[maybe_unused]] uint32_t count)
+            {
+                m_isUpdateOverlapped = (bool)atoi(args[0]);
+            }, "0 = Off, 1 = On", 1u);
+
+        CVariableRegister::Create<CVariableFuncSimple>("ShaderAsset.Query.Variants", []() { ShaderAsset::LogVariantStatistics(); });
+
         PK_LOG_HEADER("----------RendererApplication.Ctor End----------");
     }
 
@@ -207,6 +237,7 @@ namespace PK::App
     {
         Platform::SetInputHandler(nullptr);
         GetService<Sequencer>()->Release();
+        ShaderAsset::SaveVariantWarmupList(GetWorkingDirectory());
         GetService<AssetDatabase>()->UnloadAll();
         GetServices()->Clear();
         m_window = nullptr;
@@ -214,23 +245,48 @@ namespace PK::App
         PK_LOG_HEADER("----------RendererApplication.Dtor----------");
     }
 
+    // Overlapped updates run the update step of a frame on the update thread while the previous frame is presented.
+    // This is not a pipelined frame loop. There is no entity state snapshot & nothing else runs ahead:
+    // culling, batching & submission read the live entity state on the render thread after the update has joined.
+    // Acquiring the next image is deferred until after the update so that the update does not wait for the frame fence.
+    // Update steps must not access the RHI as presentation owns the queues while they run.
+    // Console commands are deferred to the render step for this reason.
     void RendererApplication::Execute()
     {
         // Move me out if running out of stack space
         FixedArena<32768> frameArena;
+        WorkerThread updateThread;
 
         auto sequencer = GetService<Sequencer>();
+        auto remoteProcessRunner = GetService<RemoteProcessRunner>();
+        auto assetWatcher = GetService<AssetWatcher>();
+        auto isPresentPending = false;
+
+        auto presentPending = [&]()
+        {
+            if (isPresentPending)
+            {
+                PK_PROFILE_SCOPE("Window.PresentImage");
+                m_window->PresentImage();
+                isPresentPending = false;
+            }
+        };
 
         while (m_isRunning)
         {
             Platform::PollEvents();
+            remoteProcessRunner->Poll();
+            assetWatcher->Poll();
 
             if (m_window->IsMinimized())
             {
+                presentPending();
                 Platform::WaitEvents();
                 continue;
             }
 
+            CPUProfiler::NextFrame();
+            MemoryTracker::NextFrame();
             frameArena.Clear();
 
             FrameContext ctx{};
@@ -239,22 +295,56 @@ namespace PK::App
 
             sequencer->NextRoot(FrameStep::Initialize(), &ctx);
 
-            m_window->AcquireImage();
+            if (m_isUpdateOverlapped)
+            {
+                // Dispatch stores the address of the task. Keep it alive until the thread has joined.
+                auto updateTask = [&]() { sequencer->NextRoot(FrameStep::Update(), &ctx); };
+                updateThread.Dispatch(updateTask);
+                presentPending();
+                updateThread.Wait();
+
+                // Update steps may release resources. Collect after joining.
+                RHI::GC();
+
+                {
+                    PK_PROFILE_SCOPE("Window.AcquireImage");
+                    m_window->AcquireImage();
+                }
 
-            sequencer->NextRoot(FrameStep::Update(), &ctx);
-            sequencer->NextRoot(FrameStep::Render(), &ctx);
+                sequencer->NextRoot(FrameStep::Render(), &ctx);
+                sequencer->NextRoot(FrameStep::Finalize(), &ctx);
+                isPresentPending = true;
+            }
+            else
+            {
+                // Flush the overlapped present if the mode was changed.
+                presentPending();
 
-            m_window->PresentImage();
+                {
+                    PK_PROFILE_SCOPE("Window.AcquireImage");
+                    m_window->AcquireImage();
+                }
 
-            sequencer->NextRoot(FrameStep::Finalize(), &ctx);
+                sequencer->NextRoot(FrameStep::Update(), &ctx);
+                sequencer->NextRoot(FrameStep::Render(), &ctx);
 
-            RHI::GC();
+                {
+                    PK_PROFILE_SCOPE("Window.PresentImage");
+                    m_window->PresentImage();
+                }
+
+                sequencer->NextRoot(FrameStep::Finalize(), &ctx);
+
+                RHI::GC();
+            }
 
             if (m_inactiveFrameInterval > 0 && !Platform::GetHasFocus())
             {
                 Sleep(m_inactiveFrameInterval);
             }
         }
+
+        presentPending();
     }
 
     void RendererApplication::Close()
@@ -266,6 +356,13 @@ namespace PK::App
 
 PK::IApplication* PK::CreateProjectApplication(const PK::CArguments& arguments)
 {
+    if (Benchmarks::BenchmarkApplication::IsRequested(arguments))
+    {
+        auto app = Memory::Allocate<Benchmarks::BenchmarkApplication>(1u);
+        PK::Platform::AddManagedAllocation(app, [](void* ptr) { Memory::Destruct(static_cast<Benchmarks::BenchmarkApplication*>(ptr)); });
+        return Memory::Construct(app, arguments);
+    }
+
     auto app = Memory::Allocate<App::RendererApplication>(1u);
     PK::Platform::AddManagedAllocation(app, [](void* ptr) { Memory::Destruct(static_cast<App::RendererApplication*>(ptr)); });
     return Memory::Construct(app, arguments);
@@ -24,5 +24,6 @@ namespace PK::App
         WindowScope m_window;
         uint32_t m_inactiveFrameInterval = 0u;
         bool m_isRunning = true;
+        bool m_isUpdateOverlapped = false;
     };
 }
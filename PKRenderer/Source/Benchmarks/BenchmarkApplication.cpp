@@ -0,0 +1,778 @@
+#include "PrecompiledHeader.h"
+#include "Core/Base/FileIO.h"
+#include "Core/CLI/Log.h"
+#include "Core/CLI/LoggerPrintf.h"
+#include "Core/ControlFlow/WorkerPool.h"
+#include "Core/ECS/EntityDatabase.h"
+#include "Core/Math/Batch.h"
+#include "Core/Math/Extended.h"
+#include "Core/Math/Random.h"
+#include "Core/Math/Projection.h"
+#include "Core/RHI/RHInterfaces.h"
+#include "Core/RHI/Null/NullDriver.h"
+#include "Core/Rendering/CommandBufferExt.h"
+#include "Core/Rendering/Mesh.h"
+#include "Core/Rendering/MeshUtilities.h"
+#include "Core/Serialization/Serialize.h"
+#include "App/ECS/EntityLight.h"
+#include "App/ECS/EntityMeshStatic.h"
+#include "App/ECS/EntityViewMeshStatic.h"
+#include "App/Engines/EngineUpdateTransforms.h"
+#include "App/Engines/EngineEntityCull.h"
+#include "App/Renderer/BatcherMeshStatic.h"
+#include "App/Renderer/HashCache.h"
+#include "App/Renderer/OcclusionRasterizer.h"
+#include "App/Renderer/Passes/PassLights.h"
+#include "BenchmarkApplication.h"
+
+namespace PK::Benchmarks
+{
+    using namespace PK::App;
+
+    // Batched & scalar paths differ by floating point contraction only.
+    constexpr static const float SIMD_RELATIVE_TOLERANCE = 1e-5f;
+
+    // Magnitude is the scale of the terms that were summed into the values. Sums that cancel lose precision relative to it.
+    static bool IsNearlyEqual(const float* a, const float* b, uint32_t count, float magnitude = 1.0f)
+    {
+        for (auto i = 0u; i < count; ++i)
+        {
+            if (math::abs(a[i] - b[i]) > SIMD_RELATIVE_TOLERANCE * math::max(magnitude, math::abs(a[i])))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Every cull request may return each entity once per face or cascade. Light sort keys are allocated after the light results.
+    // Ryml asserts when looking up children of missing or non map nodes. Baselines are hand edited so every level is checked.
+    static SerialNodeRead FindMapChild(SerialNodeRead node, const char* name)
+    {
+        return node.readable() && node.is_map() ? node.find_child(ryml::to_csubstr(name)) : SerialNodeRead();
+    }
+
+    static size_t GetFrameArenaSize(const BenchmarkConfig& config)
+    {
+        const auto entityCount = (size_t)config.MeshEntityCount + config.LightEntityCount + 1ull;
+        const auto maxResultsPerEntity = (size_t)math::max(6u, PassLights::ShadowCascadeCount);
+        return entityCount * maxResultsPerEntity * sizeof(CulledEntityInfo) + entityCount * sizeof(PassLights::LightSortKey) + 64ull;
+    }
+
+    BenchmarkApplication::BenchmarkApplication(const CArguments& arguments) :
+        IApplication(arguments, "PK Benchmarks", CreateRef<LoggerPrintf>()),
+        m_config(Serialize::Load<BenchmarkConfig>("Content/Configs/Benchmark.cfg")),
+        m_frameArenaMemory(Memory::Allocate<uint8_t>(GetFrameArenaSize(m_config))),
+        m_frameArena(m_frameArenaMemory, GetFrameArenaSize(m_config))
+    {
+        PK_LOG_TIMER_FUNC();
+        PK_LOG_HEADER_SCOPE("----------BenchmarkApplication.Ctor Begin----------");
+
+        RHIDriverDescriptor driverDescriptor{};
+        driverDescriptor.api = RHIAPI::Null;
+        m_RHIDriver = RHI::CreateDriver(GetWorkingDirectory(), driverDescriptor);
+
+        GetServices()->Create<HashCache>();
+
+        auto workerPool = GetServices()->Create<WorkerPool>(m_config.WorkerThreadCount);
+        m_entityDb = GetServices()->Create<EntityDatabase>(32, m_config.MeshEntityCount + m_config.LightEntityCount + 1u);
+        m_batcher = GetServices()->Create<BatcherMeshStatic>(true);
+        m_engineUpdateTransforms = GetServices()->Create<EngineUpdateTransforms>(m_entityDb);
+        m_engineEntityCull = GetServices()->Create<EngineEntityCull>(m_entityDb, nullptr, workerPool);
+
+        // Fixed seed so that scenes are comparable between runs.
+        math::setSeed(44u);
+
+        for (auto i = 0u; i < MESH_VARIANT_COUNT; ++i)
+        {
+            auto extents = float3(0.5f + i * 0.5f, 1.0f + i, 0.5f + i * 0.25f);
+            m_meshes[i] = CreateRef<MeshStatic>(MeshUtilities::CreateBoxMeshStatic(m_batcher->GetMeshStaticAllocator(), PK_FLOAT3_ZERO, extents));
+        }
+
+        // Welded rippled grid. Shared vertices let the hierarchy simplify across meshlet borders.
+        {
+            constexpr auto resolution = CLUSTER_GRID_RESOLUTION;
+            constexpr auto vertexCount = (resolution + 1u) * (resolution + 1u);
+            constexpr auto indexCount = resolution * resolution * 6u;
+            auto vertices = Memory::Allocate<MeshUtilities::VertexDefault>(vertexCount);
+            auto indices = Memory::Allocate<uint32_t>(indexCount);
+
+            for (auto y = 0u; y <= resolution; ++y)
+            for (auto x = 0u; x <= resolution; ++x)
+            {
+                const auto uv = float2((float)x, (float)y) / (float)resolution;
+                const auto height = math::sin(uv.x * 24.0f) * math::cos(uv.y * 18.0f) * 0.5f;
+                vertices[y * (resolution + 1u) + x] = { float3(uv.x * 16.0f - 8.0f, height, uv.y * 16.0f - 8.0f), PK_FLOAT3_UP, uv, PK_FLOAT4_ZERO };
+            }
+
+            for (auto y = 0u; y < resolution; ++y)
+            for (auto x = 0u; x < resolution; ++x)
+            {
+                const auto baseVertex = y * (resolution + 1u) + x;
+                const auto baseIndex = (y * resolution + x) * 6u;
+                indices[baseIndex + 0u] = baseVertex;
+                indices[baseIndex + 1u] = baseVertex + resolution + 1u;
+                indices[baseIndex + 2u] = baseVertex + resolution + 2u;
+                indices[baseIndex + 3u] = baseVertex + resolution + 2u;
+                indices[baseIndex + 4u] = baseVertex + 1u;
+                indices[baseIndex + 5u] = baseVertex;
+            }
+
+            MeshUtilities::GeometryContext ctx{};
+            ctx.pVertices = vertices;
+            ctx.pIndices = indices;
+            ctx.countVertex = vertexCount;
+            ctx.countIndex = indexCount;
+            ctx.aabb = math::centerExtentsToAABB(PK_FLOAT3_ZERO, float3(8.0f, 0.5f, 8.0f));
+            MeshUtilities::CalculateNormals(&ctx);
+
+            MeshUtilities::MeshOptimizeOptions options{};
+            options.meshletHierarchy = true;
+            m_clusterMesh = CreateRef<MeshStatic>(MeshUtilities::CreateMeshStatic(m_batcher->GetMeshStaticAllocator(), &ctx, "Benchmark_ClusterGrid", &options));
+            m_clusterCutScratch = Memory::Allocate<uint32_t>(MeshUtilities::GetMeshletCutScratchSize(*m_clusterMesh->GetSubmesh(0).hierarchy) + m_clusterMesh->GetSubmesh(0).meshletCount);
+
+            Memory::Free(vertices);
+            Memory::Free(indices);
+        }
+
+        const auto minpos = float3(-200.0f, -10.0f, -200.0f);
+        const auto maxpos = float3(+200.0f, +10.0f, +200.0f);
+
+        m_entityDb->Reserve<EntityMeshStatic>(m_config.MeshEntityCount);
+        m_entityDb->Reserve<EntityLight>(m_config.LightEntityCount + 1u);
+
+        for (auto i = 0u; i < m_config.MeshEntityCount; ++i)
+        {
+            MaterialTarget material{ nullptr, 0u };
+            EntityMeshStatic::Descriptor desc{};
+            desc.entitySerialize = false;
+            // Box meshes have solid bounds.
+            desc.flags = ScenePrimitiveFlags::DefaultMesh | ScenePrimitiveFlags::Occluder;
+            desc.mesh = m_meshes[i % MESH_VARIANT_COUNT];
+            desc.materials = { &material, 1u };
+            desc.position = math::halton(i, uint3(7, 11, 17)) * (maxpos - minpos) + minpos;
+            desc.rotation = math::randomRadianFloat3();
+            desc.scale = math::randomRange(1.0f, 3.0f) * PK_FLOAT3_ONE;
+            EntityFactory<EntityMeshStatic>::Create(m_entityDb, desc);
+        }
+
+        for (auto i = 0u; i < m_config.LightEntityCount; ++i)
+        {
+            EntityLight::Descriptor desc{};
+            desc.type = i % 2 == 0 ? LightType::Spot : LightType::Point;
+            desc.position = math::randomRange(minpos, maxpos);
+            desc.rotation = math::randomRadianFloat3();
+            desc.color = PK_COLOR_WHITE * math::randomRange(8.0f, 128.0f);
+            desc.angle = 90.0f;
+            desc.radius = 20.0f;
+            desc.sourceRadius = 0.2f;
+            desc.castShadow = i % 4 == 0;
+            EntityFactory<EntityLight>::Create(m_entityDb, desc);
+        }
+
+        // Directional light
+        {
+            EntityLight::Descriptor desc{};
+            desc.type = LightType::Directional;
+            desc.position = PK_FLOAT3_ZERO;
+            desc.rotation = float3(10, -35, 0) * PK_FLOAT_DEG2RAD;
+            desc.color = PK_COLOR_WHITE * 24.0f;
+            desc.angle = 90.0f;
+            desc.radius = 1000.0f;
+            desc.sourceRadius = 0.1f;
+            desc.castShadow = true;
+            EntityFactory<EntityLight>::Create(m_entityDb, desc);
+        }
+
+        // View parameters match a typical first person view into the scene.
+        const auto viewPosition = float3(0.0f, 5.0f, -150.0f);
+        const auto viewRotation = float3(10.0f, 0.0f, 0.0f) * PK_FLOAT_DEG2RAD;
+        const auto localToWorld = math::transformTRS(viewPosition, viewRotation, PK_FLOAT3_ONE);
+        m_znear = 0.1f;
+        m_zfar = 100.0f;
+        m_worldToClip = math::perspective(75.0f, 16.0f / 9.0f, m_znear, m_zfar) * math::affineInverse(localToWorld);
+        m_viewForwardPlane = math::mulplanar(localToWorld, float4(0, 0, 1, 0));
+        m_lightWorldToLocal = math::transformTRSInverse(PK_FLOAT3_ZERO, float3(10, -35, 0) * PK_FLOAT_DEG2RAD, PK_FLOAT3_ONE);
+        m_cubeFaceBounds = math::centerExtentsToAABB(float3(0.0f, 0.0f, 0.0f), PK_FLOAT3_ONE * 25.0f);
+        m_pixelsPerUnit = math::abs(math::perspective(75.0f, 16.0f / 9.0f, m_znear, m_zfar)[1][1]) * 0.5f * 1080.0f;
+
+        // Cluster grid instances spread over the view depth range so that cuts cover all hierarchy levels.
+        for (auto i = 0u; i < CLUSTER_INSTANCE_COUNT; ++i)
+        {
+            const auto depth = m_znear + 1.0f + (m_zfar - m_znear) * (i + 0.5f) / CLUSTER_INSTANCE_COUNT;
+            const auto position = viewPosition + float3(math::randomRange(-8.0f, 8.0f), -4.0f, depth);
+            m_clusterTransforms[i] = math::transformTRS3x4(position, float3(0.0f, math::randomRange(0.0f, PK_FLOAT_TWO_PI), 0.0f), PK_FLOAT3_ONE);
+        }
+
+        // Self tests. Timings are meaningless if any of the optimized paths disagree with their reference.
+        auto failureCount = ValidateBatchKernels();
+        failureCount += ValidateUpdateTransforms();
+        failureCount += ValidateQuantization();
+        failureCount += ValidateOcclusion();
+        PK_FATAL_ASSERT(failureCount == 0u, "Benchmark self tests failed with %u errors! See the log for details.", failureCount);
+
+        PK_LOG_INFO("Meshes: %u, Lights: %u, Workers: %u, Simd: %s", m_config.MeshEntityCount, m_config.LightEntityCount, workerPool->GetWorkerCount(), math::getSimdIsaName(math::getSimdIsa()));
+        PK_LOG_HEADER("----------BenchmarkApplication.Ctor End----------");
+    }
+
+    BenchmarkApplication::~BenchmarkApplication()
+    {
+        for (auto i = 0u; i < MESH_VARIANT_COUNT; ++i)
+        {
+            m_meshes[i] = nullptr;
+        }
+
+        m_clusterMesh = nullptr;
+        Memory::Free(m_clusterCutScratch);
+        Memory::Free(m_frameArenaMemory);
+
+        GetServices()->Clear();
+        m_RHIDriver = nullptr;
+        PK_LOG_HEADER("----------BenchmarkApplication.Dtor----------");
+    }
+
+    bool BenchmarkApplication::IsRequested(const CArguments& arguments)
+    {
+        for (auto i = 1u; i < arguments.count; ++i)
+        {
+            if (strcmp(arguments.args[i], "-benchmark") == 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void BenchmarkApplication::Execute()
+    {
+        double stageTotals[(uint32_t)Stage::Count]{};
+        Timing timings[(uint32_t)Stage::Count]{};
+
+        for (auto i = 0u; i < (uint32_t)Stage::Count; ++i)
+        {
+            timings[i].MinMs = DBL_MAX;
+        }
+
+        const auto iterationCount = math::max(1u, m_config.Iterations);
+
+        for (auto i = 0u; i < m_config.WarmupIterations; ++i)
+        {
+            ExecuteFrame(stageTotals);
+        }
+
+        for (auto i = 0u; i < iterationCount; ++i)
+        {
+            double stageMilliseconds[(uint32_t)Stage::Count]{};
+            ExecuteFrame(stageMilliseconds);
+
+            for (auto j = 0u; j < (uint32_t)Stage::Count; ++j)
+            {
+                timings[j].MeanMs += stageMilliseconds[j] / iterationCount;
+                timings[j].MinMs = math::min(timings[j].MinMs, stageMilliseconds[j]);
+                timings[j].MaxMs = math::max(timings[j].MaxMs, stageMilliseconds[j]);
+            }
+        }
+
+        PK_LOG_NEWLINE();
+        PK_LOG_HEADER_SCOPE("----------BENCHMARK RESULTS (%u iterations)----------", iterationCount);
+
+        for (auto i = 0u; i < (uint32_t)Stage::Count; ++i)
+        {
+            PK_LOG_INFO("%-32s mean: %8.4fms, min: %8.4fms, max: %8.4fms", STAGE_NAMES[i], timings[i].MeanMs, timings[i].MinMs, timings[i].MaxMs);
+        }
+
+        PK_LOG_INFO("Occlusion: %u visible, %u occluded", m_occlusionVisibleCount, m_occlusionOccludedCount);
+
+        const auto& commandStats = static_cast<NullDriver*>(m_RHIDriver.get())->GetFrameStats();
+        PK_LOG_INFO("Commands: %u per frame, %s uploaded", commandStats.commandCount, String::FormatBytes<16>(commandStats.bytesUploaded).c_str());
+
+        WriteResults(timings);
+
+        auto regressionCount = CompareBaseline(timings);
+
+        if (regressionCount > 0u)
+        {
+            PK_LOG_ERROR("Benchmark detected %u regression(s) over baseline '%s'", regressionCount, m_config.BaselinePath.c_str());
+            SetExitCode(1);
+        }
+    }
+
+    uint32_t BenchmarkApplication::ValidateBatchKernels()
+    {
+        // Odd count so that every instruction set also runs its scalar tail.
+        constexpr auto count = 1027u;
+        // Inputs: position 3, rotation 4, scale 3, aabb 6. Outputs per pass: matrices 12, inverses 12, aabbs 6.
+        constexpr auto inputStreams = 16u;
+        constexpr auto outputStreams = 30u;
+        auto buffer = Memory::Allocate<float>(count * (inputStreams + outputStreams * 2u));
+        auto stream = [buffer](uint32_t index) { return buffer + index * count; };
+
+        math::trs_soa trs;
+        math::aabb_soa localAABBs;
+        math::float3x4_soa matrices[2];
+        math::float3x4_soa inverses[2];
+        math::aabb_soa worldAABBs[2];
+
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            trs.position[i] = stream(i);
+            trs.scale[i] = stream(7u + i);
+            localAABBs.min[i] = stream(10u + i);
+            localAABBs.max[i] = stream(13u + i);
+        }
+
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            trs.rotation[i] = stream(3u + i);
+        }
+
+        // Pass 0 is the scalar reference.
+        for (auto pass = 0u; pass < 2u; ++pass)
+        {
+            const auto first = inputStreams + pass * outputStreams;
+
+            for (auto i = 0u; i < 12u; ++i)
+            {
+                matrices[pass].elements[i] = stream(first + i);
+                inverses[pass].elements[i] = stream(first + 12u + i);
+            }
+
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                worldAABBs[pass].min[i] = stream(first + 24u + i);
+                worldAABBs[pass].max[i] = stream(first + 27u + i);
+            }
+        }
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            const auto position = (math::halton(i, uint3(2, 3, 5)) * 2.0f - 1.0f) * 100.0f;
+            const auto rotation = math::normalize(math::halton(i, uint4(7, 11, 13, 17)) * 2.0f - 1.0f);
+            const auto scale = 0.5f + math::halton(i, uint3(19, 23, 29)) * 1.5f;
+            const auto center = math::halton(i, uint3(31, 37, 41)) * 2.0f - 1.0f;
+            const auto extents = 0.1f + math::halton(i, uint3(43, 47, 53));
+
+            for (auto j = 0u; j < 3u; ++j)
+            {
+                stream(j)[i] = position[j];
+                stream(7u + j)[i] = scale[j];
+                stream(10u + j)[i] = center[j] - extents[j];
+                stream(13u + j)[i] = center[j] + extents[j];
+            }
+
+            for (auto j = 0u; j < 4u; ++j)
+            {
+                stream(3u + j)[i] = rotation[j];
+            }
+        }
+
+        auto runKernels = [&](uint32_t pass)
+        {
+            math::transformTRS3x4(trs, matrices[pass], count);
+            math::affineInverseTranspose(matrices[pass], inverses[pass], count);
+            math::mul(matrices[pass], localAABBs, worldAABBs[pass], count);
+        };
+
+        const auto supported = math::getSimdIsaSupported();
+        auto failureCount = 0u;
+
+        math::setSimdIsa(math::simd_isa::scalar);
+        runKernels(0u);
+
+        for (auto isa = 1u; isa <= (uint32_t)supported; ++isa)
+        {
+            math::setSimdIsa((math::simd_isa)isa);
+            runKernels(1u);
+
+            auto transformMismatches = 0u;
+            auto inverseMismatches = 0u;
+            auto aabbMismatches = 0u;
+
+            for (auto i = 0u; i < 12u; ++i)
+            {
+                transformMismatches += IsNearlyEqual(matrices[0].elements[i], matrices[1].elements[i], count) ? 0u : 1u;
+                inverseMismatches += IsNearlyEqual(inverses[0].elements[i], inverses[1].elements[i], count) ? 0u : 1u;
+            }
+
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                aabbMismatches += IsNearlyEqual(worldAABBs[0].min[i], worldAABBs[1].min[i], count) ? 0u : 1u;
+                aabbMismatches += IsNearlyEqual(worldAABBs[0].max[i], worldAABBs[1].max[i], count) ? 0u : 1u;
+            }
+
+            if (transformMismatches + inverseMismatches + aabbMismatches > 0u)
+            {
+                PK_LOG_ERROR("Batch %s kernels mismatch scalar results. transformTRS3x4: %u, affineInverseTranspose: %u, mul aabb: %u mismatching streams",
+                    math::getSimdIsaName((math::simd_isa)isa),
+                    transformMismatches,
+                    inverseMismatches,
+                    aabbMismatches);
+                ++failureCount;
+            }
+        }
+
+        math::setSimdIsa(supported);
+        Memory::Free(buffer);
+        return failureCount;
+    }
+
+    uint32_t BenchmarkApplication::ValidateUpdateTransforms()
+    {
+        // Cross-check the batched kernels of each supported instruction set against the scalar math.
+        const auto supported = math::getSimdIsaSupported();
+        auto failureCount = 0u;
+
+        for (auto isa = 0u; isa <= (uint32_t)supported; ++isa)
+        {
+            math::setSimdIsa((math::simd_isa)isa);
+            m_engineUpdateTransforms->OnStepFrameUpdate(nullptr);
+            auto mismatchCount = 0u;
+
+            for (auto& view : m_entityDb->Query<EntityViewTransform>())
+            {
+                const auto localToWorld = view.transform->GetLocalToWorld();
+                const auto worldToLocal = math::affineInverseTranspose(localToWorld);
+                const auto worldAABB = math::mul(localToWorld, view.bounds->localAABB);
+                // Inverse translation is a dot product of the translation & rotation. Compare it relative to the translation magnitude.
+                const auto translationMagnitude = math::max(1.0f, math::length(view.transform->position) / math::cmin(math::abs(view.transform->scale)));
+                auto isEqual = IsNearlyEqual(&localToWorld[0][0], &view.transform->localToWorld[0][0], 12u);
+                isEqual &= IsNearlyEqual(&worldToLocal[0][0], &view.transform->worldToLocal[0][0], 16u, translationMagnitude);
+                isEqual &= IsNearlyEqual(&worldAABB.min[0], &view.bounds->worldAABB.min[0], 3u);
+                isEqual &= IsNearlyEqual(&worldAABB.max[0], &view.bounds->worldAABB.max[0], 3u);
+                mismatchCount += isEqual ? 0u : 1u;
+            }
+
+            if (mismatchCount > 0u)
+            {
+                PK_LOG_ERROR("EngineUpdateTransforms %s kernels mismatch scalar results for %u entities", math::getSimdIsaName((math::simd_isa)isa), mismatchCount);
+                ++failureCount;
+            }
+        }
+
+        math::setSimdIsa(supported);
+        return failureCount;
+    }
+
+    uint32_t BenchmarkApplication::ValidateQuantization()
+    {
+        // Encode/decode round trip of the static mesh vertex layout over small, unit & large bounds with & without an offset from the origin.
+        constexpr auto vertexCount = 4096u;
+        const float2 scaleOffsets[] = { { 0.01f, 0.0f }, { 1.0f, 0.0f }, { 1000.0f, 0.0f }, { 0.01f, 500.0f }, { 1.0f, 500.0f } };
+        auto failureCount = 0u;
+
+        for (const auto& scaleOffset : scaleOffsets)
+        {
+            const auto bounds = math::centerExtentsToAABB(float3(scaleOffset.y, -scaleOffset.y, scaleOffset.y * 0.5f), float3(1.0f, 0.5f, 2.0f) * scaleOffset.x);
+            auto errorCount = 0u;
+
+            for (auto i = 0u; i < vertexCount; ++i)
+            {
+                MeshUtilities::VertexDefault vertex{};
+                vertex.in_POSITION = bounds.min + math::halton(i, uint3(2, 3, 5)) * (bounds.max - bounds.min);
+                vertex.in_NORMAL = math::normalize(math::octadecode(math::halton(i, uint2(7, 11))));
+                const auto axis = math::abs(vertex.in_NORMAL.y) < 0.99f ? PK_FLOAT3_UP : PK_FLOAT3_RIGHT;
+                vertex.in_TANGENT = float4(math::normalize(math::cross(vertex.in_NORMAL, axis)), i % 2u == 0u ? 1.0f : -1.0f);
+                vertex.in_TEXCOORD0 = math::halton(i, uint2(13, 17)) * 4.0f;
+
+                MeshUtilities::VertexQuantizedAttributes attributes;
+                MeshUtilities::VertexQuantizedPosition position;
+                MeshUtilities::EncodeVertexQuantized(vertex, bounds, &attributes, &position);
+                const auto decoded = MeshUtilities::DecodeVertexQuantized(attributes, position, bounds);
+                errorCount += MeshUtilities::IsQuantizedVertexWithinTolerance(vertex, decoded, bounds) ? 0u : 1u;
+            }
+
+            if (errorCount > 0u)
+            {
+                PK_LOG_ERROR("Vertex quantization round trip exceeds tolerance for %u/%u vertices. scale: %f, offset: %f", errorCount, vertexCount, scaleOffset.x, scaleOffset.y);
+                ++failureCount;
+            }
+        }
+
+        return failureCount;
+    }
+
+    uint32_t BenchmarkApplication::ValidateOcclusion()
+    {
+        struct TestCase
+        {
+            const char* name;
+            AABB<float3> bounds;
+            bool isVisible;
+        };
+
+        // View looks down +z from the origin. A wall occluder at z = 10 covers the center of the screen.
+        const TestCase testCases[] =
+        {
+            { "Behind occluder", math::centerExtentsToAABB(float3(0.0f, 0.0f, 20.0f), PK_FLOAT3_ONE), false },
+            { "In front of occluder", math::centerExtentsToAABB(float3(0.0f, 0.0f, 5.0f), PK_FLOAT3_ONE), true },
+            { "Beside occluder", math::centerExtentsToAABB(float3(25.0f, 0.0f, 20.0f), PK_FLOAT3_ONE), true },
+            { "Wider than occluder", math::centerExtentsToAABB(float3(0.0f, 0.0f, 20.0f), float3(12.0f, 1.0f, 1.0f)), true },
+            { "Crossing near plane", math::centerExtentsToAABB(float3(0.0f, 0.0f, 0.1f), float3(1.0f, 1.0f, 0.5f)), true },
+        };
+
+        const auto occluder = math::centerExtentsToAABB(float3(0.0f, 0.0f, 10.0f), float3(4.0f, 4.0f, 0.5f));
+        const auto worldToClip = math::perspective(75.0f, (float)OcclusionRasterizer::WIDTH / OcclusionRasterizer::HEIGHT, 0.1f, 100.0f);
+        const auto supported = math::getSimdIsaSupported();
+        constexpr auto tileCount = OcclusionRasterizer::TILE_COUNT_X * OcclusionRasterizer::TILE_COUNT_Y;
+        OcclusionRasterizer::Tile referenceTiles[tileCount];
+        OcclusionRasterizer rasterizer;
+        auto failureCount = 0u;
+
+        for (auto isa = 0u; isa <= (uint32_t)supported; ++isa)
+        {
+            math::setSimdIsa((math::simd_isa)isa);
+            rasterizer.Clear(worldToClip);
+            rasterizer.RasterizeBox(occluder, PK_FLOAT3X4_IDENTITY);
+            rasterizer.Finalize();
+
+            for (const auto& testCase : testCases)
+            {
+                if (rasterizer.TestAABB(testCase.bounds) != testCase.isVisible)
+                {
+                    PK_LOG_ERROR("OcclusionRasterizer %s: '%s' expected to be %s", math::getSimdIsaName((math::simd_isa)isa), testCase.name, testCase.isVisible ? "visible" : "occluded");
+                    ++failureCount;
+                }
+            }
+
+            // The near plane crossing bounds surround the view.
+            if (rasterizer.GetScreenArea(testCases[4].bounds) < 0.99f)
+            {
+                PK_LOG_ERROR("OcclusionRasterizer: screen area of bounds crossing the near plane is %f, expected full screen", rasterizer.GetScreenArea(testCases[4].bounds));
+                ++failureCount;
+            }
+
+            // Coverage masks of the wide paths must match the scalar path exactly.
+            if (isa == 0u)
+            {
+                Memory::Memcpy(referenceTiles, rasterizer.GetTiles(), tileCount);
+            }
+            else if (memcmp(referenceTiles, rasterizer.GetTiles(), sizeof(referenceTiles)) != 0)
+            {
+                PK_LOG_ERROR("OcclusionRasterizer %s tile coverage mismatches scalar results", math::getSimdIsaName((math::simd_isa)isa));
+                ++failureCount;
+            }
+        }
+
+        math::setSimdIsa(supported);
+        return failureCount;
+    }
+
+    void BenchmarkApplication::ExecuteFrame(double* outStageMilliseconds)
+    {
+        auto measure = [outStageMilliseconds](Stage stage, const auto& function)
+        {
+            auto begin = Platform::GetTimeSeconds();
+            function();
+            outStageMilliseconds[(uint32_t)stage] += (Platform::GetTimeSeconds() - begin) * 1000.0;
+        };
+
+        m_frameArena.ClearFast();
+
+        measure(Stage::UpdateTransforms, [&]() { m_engineUpdateTransforms->OnStepFrameUpdate(nullptr); });
+
+        // Primary view draws
+        {
+            RequestEntityCullFrustum request{};
+            request.mask = ScenePrimitiveFlags::Mesh;
+            request.matrix = m_worldToClip;
+            measure(Stage::CullFrustum, [&]() { m_engineEntityCull->Step(&m_frameArena, &request); });
+
+            measure(Stage::BatcherSubmit, [&]()
+            {
+                m_batcher->BeginCollectDrawCalls();
+                m_batcher->BeginNewGroup();
+
+                for (auto i = 0u; i < request.GetCount(); ++i)
+                {
+                    auto& info = request[i];
+                    const auto entity = m_entityDb->Query<EntityViewMeshStatic>(info.entityId);
+
+                    // Shaders & materials are only used as batch keys here. Leave them empty as the stub driver cannot create them.
+                    for (const auto& kv : entity.materials->materials)
+                    {
+                        m_batcher->SubmitMeshStaticDraw(entity.transform, nullptr, nullptr, entity.staticMesh->sharedMesh.get(), (uint16_t)kv.submesh, 0u, info.depth);
+                    }
+                }
+            });
+
+            measure(Stage::BatcherEndCollect, [&]() { m_batcher->EndCollectDrawCalls(RHI::GetCommandBuffer(QueueType::Graphics)); });
+        }
+
+        m_frameArena.ClearFast();
+
+        {
+            RequestEntityCullFrustum request{};
+            request.mask = ScenePrimitiveFlags::Mesh;
+            request.matrix = m_worldToClip;
+            request.useOcclusion = true;
+            measure(Stage::CullFrustumOcclusion, [&]() { m_engineEntityCull->Step(&m_frameArena, &request); });
+            m_occlusionVisibleCount = (uint32_t)request.GetCount();
+            m_occlusionOccludedCount = request.outOccludedCount;
+        }
+
+        m_frameArena.ClearFast();
+
+        {
+            RequestEntityCullCubeFaces request{};
+            request.mask = ScenePrimitiveFlags::Mesh | ScenePrimitiveFlags::CastShadows;
+            request.aabb = m_cubeFaceBounds;
+            measure(Stage::CullCubeFaces, [&]() { m_engineEntityCull->Step(&m_frameArena, &request); });
+        }
+
+        m_frameArena.ClearFast();
+
+        {
+            const auto tileZParams = math::exponentialZParams<float>(m_znear, m_zfar, 10.0f, PassLights::LightGridSizeZ);
+            float cascadeZSplits[PassLights::ShadowCascadeCount + 1u];
+            float4x4 cascades[PassLights::ShadowCascadeCount];
+            math::cascadeDepths<float, PassLights::ShadowCascadeCount + 1u>(m_znear, m_zfar, 0.5f, cascadeZSplits, tileZParams);
+
+            ShadowCascadeCreateInfo cascadeInfo{};
+            cascadeInfo.worldToLocal = m_lightWorldToLocal;
+            cascadeInfo.clipToWorld = math::inverse(m_worldToClip);
+            cascadeInfo.nearPlaneOffset = 1.0f;
+            cascadeInfo.padding = m_znear;
+            cascadeInfo.splitPlanes = cascadeZSplits;
+            cascadeInfo.resolution = 1024u;
+            cascadeInfo.count = PassLights::ShadowCascadeCount;
+            PassLights::BuildShadowCascadeMatrices(cascadeInfo, cascades);
+
+            RequestEntityCullCascades request{};
+            request.mask = ScenePrimitiveFlags::Mesh | ScenePrimitiveFlags::CastShadows;
+            request.cascades = cascades;
+            request.viewForwardPlane = m_viewForwardPlane;
+            request.viewZOffsets = cascadeZSplits;
+            request.count = PassLights::ShadowCascadeCount;
+            measure(Stage::CullCascades, [&]() { m_engineEntityCull->Step(&m_frameArena, &request); });
+        }
+
+        m_frameArena.ClearFast();
+
+        {
+            RequestEntityCullFrustum request{};
+            request.mask = ScenePrimitiveFlags::Light;
+            request.matrix = m_worldToClip;
+            m_engineEntityCull->Step(&m_frameArena, &request);
+
+            measure(Stage::LightSortKeys, [&]()
+            {
+                auto shadowCasterCount = 0u;
+                auto keys = m_frameArena.Allocate<PassLights::LightSortKey>(request.GetCount());
+                PassLights::BuildLightSortKeys(m_entityDb, request, keys, &shadowCasterCount);
+            });
+        }
+
+        {
+            const auto& hierarchy = *m_clusterMesh->GetSubmesh(0).hierarchy;
+            const auto scratchSize = MeshUtilities::GetMeshletCutScratchSize(hierarchy);
+            const auto errorScale = 1.0f / m_pixelsPerUnit;
+
+            measure(Stage::MeshletCut, [&]()
+            {
+                for (auto i = 0u; i < CLUSTER_INSTANCE_COUNT; ++i)
+                {
+                    MeshUtilities::SelectMeshletCut(hierarchy, m_clusterTransforms[i], m_worldToClip, 1.0f, errorScale, errorScale * 8.0f, m_clusterCutScratch, m_clusterCutScratch + scratchSize);
+                }
+            });
+        }
+
+        m_engineEntityCull->OnStepFrameFinalize(nullptr);
+        RHI::GetQueues()->Submit(QueueType::Graphics);
+        RHI::GC();
+    }
+
+    void BenchmarkApplication::WriteResults(const Timing* timings)
+    {
+        ryml::Tree tree;
+        auto root = tree.rootref();
+        root.set_map();
+
+        auto results = root["BenchmarkResults"];
+        results.set_map();
+        Serialize::WriteVal(results["MeshEntityCount"], &m_config.MeshEntityCount);
+        Serialize::WriteVal(results["LightEntityCount"], &m_config.LightEntityCount);
+        Serialize::WriteVal(results["Iterations"], &m_config.Iterations);
+
+        auto stages = results["Stages"];
+        stages.set_map();
+
+        for (auto i = 0u; i < (uint32_t)Stage::Count; ++i)
+        {
+            auto stage = stages[STAGE_NAMES[i]];
+            stage.set_map();
+            Serialize::WriteVal(stage, timings + i);
+        }
+
+        // First pass only measures the required size.
+        const auto size = ryml::emit_json(tree, c4::substr(), false).len;
+        auto buffer = Memory::Allocate<char>(size);
+        ryml::emit_json(tree, c4::substr(buffer, size));
+
+        if (FileIO::WriteBinary(m_config.OutputPath.c_str(), true, buffer, size) == 0)
+        {
+            PK_LOG_INFO("Benchmark results written to '%s'", m_config.OutputPath.c_str());
+        }
+        else
+        {
+            PK_LOG_WARNING("Failed to write benchmark results to '%s'", m_config.OutputPath.c_str());
+        }
+
+        Memory::Free(buffer);
+    }
+
+    uint32_t BenchmarkApplication::CompareBaseline(const Timing* timings)
+    {
+        void* fileData = nullptr;
+        size_t fileSize = 0ull;
+
+        if (FileIO::ReadBinary(m_config.BaselinePath.c_str(), false, &fileData, &fileSize) != 0)
+        {
+            PK_LOG_WARNING("No benchmark baseline found at '%s'. Copy the results file there to create one.", m_config.BaselinePath.c_str());
+            return 0u;
+        }
+
+        // Json is a subset of yaml. The regular parser is sufficient.
+        auto tree = ryml::parse_in_place(c4::substr(static_cast<char*>(fileData), fileSize));
+        auto results = FindMapChild(tree.crootref(), "BenchmarkResults");
+        auto stages = FindMapChild(results, "Stages");
+        auto hasStages = stages.readable() && stages.is_map();
+        auto regressionCount = 0u;
+
+        if (!hasStages)
+        {
+            PK_LOG_WARNING("Benchmark baseline '%s' has no 'BenchmarkResults.Stages' map. Skipping comparison.", m_config.BaselinePath.c_str());
+        }
+
+        for (auto i = 0u; i < (uint32_t)Stage::Count && hasStages; ++i)
+        {
+            auto stage = FindMapChild(stages, STAGE_NAMES[i]);
+
+            if (!stage.readable())
+            {
+                PK_LOG_WARNING("Benchmark baseline '%s' has no entry for stage '%s'.", m_config.BaselinePath.c_str(), STAGE_NAMES[i]);
+                continue;
+            }
+
+            Timing baseline{};
+            Serialize::ReadVal(stage, &baseline);
+
+            // Min is used as the mean is dominated by preemption & clock changes on shared machines.
+            const auto delta = baseline.MinMs > 0.0 ? timings[i].MinMs / baseline.MinMs - 1.0 : 0.0;
+
+            if (delta > m_config.RegressionThreshold)
+            {
+                PK_LOG_WARNING("Regression: %-32s %8.4fms -> %8.4fms (%+.1f%%)", STAGE_NAMES[i], baseline.MinMs, timings[i].MinMs, delta * 100.0);
+                ++regressionCount;
+            }
+            else
+            {
+                PK_LOG_INFO("%-32s %8.4fms -> %8.4fms (%+.1f%%)", STAGE_NAMES[i], baseline.MinMs, timings[i].MinMs, delta * 100.0);
+            }
+        }
+
+        Memory::Free(fileData);
+        return regressionCount;
+    }
+}
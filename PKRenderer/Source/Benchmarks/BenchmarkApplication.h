@@ -0,0 +1,106 @@
+#pragma once
+#include "Core/Base/Containers/FixedArena.h"
+#include "Core/IApplication.h"
+#include "Core/Rendering/RenderingFwd.h"
+#include "Benchmarks/BenchmarkConfig.h"
+
+namespace PK { class WorkerPool; }
+namespace PK { struct EntityDatabase; }
+namespace PK::App { class EngineUpdateTransforms; }
+namespace PK::App { class EngineEntityCull; }
+namespace PK::App { class BatcherMeshStatic; }
+
+namespace PK::Benchmarks
+{
+    // Headless runner for the cpu side frame stages.
+    // Populates a procedural scene, times each stage over a number of iterations & compares the results against a stored baseline.
+    // Run with the '-benchmark' argument. Settings are read from 'Content/Configs/Benchmark.cfg'.
+    struct BenchmarkApplication : public IApplication
+    {
+        enum class Stage
+        {
+            UpdateTransforms,
+            CullFrustum,
+            CullFrustumOcclusion,
+            CullCubeFaces,
+            CullCascades,
+            BatcherSubmit,
+            BatcherEndCollect,
+            LightSortKeys,
+            MeshletCut,
+            Count
+        };
+
+        struct Timing
+        {
+            double MeanMs = 0.0;
+            double MinMs = 0.0;
+            double MaxMs = 0.0;
+        };
+
+        BenchmarkApplication(const CArguments& arguments);
+        ~BenchmarkApplication();
+
+        void Close() final {}
+
+        RHIDriver* GetRHIDriver() final { return m_RHIDriver.get(); }
+        Window* GetPrimaryWindow() final { return nullptr; }
+        const RHIDriver* GetRHIDriver() const final { return m_RHIDriver.get(); }
+        const Window* GetPrimaryWindow() const final { return nullptr; }
+
+        static bool IsRequested(const CArguments& arguments);
+
+    protected:
+        void Execute() final;
+
+    private:
+        // Self tests. Each returns the number of failed checks.
+        uint32_t ValidateBatchKernels();
+        uint32_t ValidateUpdateTransforms();
+        uint32_t ValidateQuantization();
+        uint32_t ValidateOcclusion();
+        void ExecuteFrame(double* outStageMilliseconds);
+        void WriteResults(const Timing* timings);
+        uint32_t CompareBaseline(const Timing* timings);
+
+        constexpr static const uint32_t MESH_VARIANT_COUNT = 4u;
+        constexpr static const uint32_t CLUSTER_GRID_RESOLUTION = 128u;
+        constexpr static const uint32_t CLUSTER_INSTANCE_COUNT = 64u;
+        constexpr static const char* STAGE_NAMES[(uint32_t)Stage::Count] =
+        {
+            "EngineUpdateTransforms",
+            "EngineEntityCull.Frustum",
+            "EngineEntityCull.FrustumOcclusion",
+            "EngineEntityCull.CubeFaces",
+            "EngineEntityCull.Cascades",
+            "BatcherMeshStatic.Submit",
+            "BatcherMeshStatic.EndCollect",
+            "PassLights.BuildLightSortKeys",
+            "MeshUtilities.SelectMeshletCut"
+        };
+
+        BenchmarkConfig m_config;
+        RHIDriverScope m_RHIDriver;
+        EntityDatabase* m_entityDb = nullptr;
+        App::EngineUpdateTransforms* m_engineUpdateTransforms = nullptr;
+        App::EngineEntityCull* m_engineEntityCull = nullptr;
+        App::BatcherMeshStatic* m_batcher = nullptr;
+        MeshStaticRef m_meshes[MESH_VARIANT_COUNT];
+        MeshStaticRef m_clusterMesh;
+        float3x4 m_clusterTransforms[CLUSTER_INSTANCE_COUNT];
+        uint32_t* m_clusterCutScratch = nullptr;
+        uint32_t m_occlusionVisibleCount = 0u;
+        uint32_t m_occlusionOccludedCount = 0u;
+        // Sized for the worst case output of the configured scene.
+        uint8_t* m_frameArenaMemory = nullptr;
+        BufferArena m_frameArena;
+
+        float4x4 m_worldToClip;
+        float4x4 m_lightWorldToLocal;
+        float4 m_viewForwardPlane;
+        float m_znear;
+        float m_zfar;
+        float m_pixelsPerUnit;
+        AABB<float3> m_cubeFaceBounds;
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "Core/Base/Containers/FixedString.h"
+
+namespace PK::Benchmarks
+{
+    struct BenchmarkConfig
+    {
+        uint32_t MeshEntityCount = 4096u;
+        uint32_t LightEntityCount = 512u;
+        uint32_t WarmupIterations = 16u;
+        uint32_t Iterations = 128u;
+        // Zero uses processor count - 1.
+        uint32_t WorkerThreadCount = 0u;
+        // Relative min time increase over the baseline that is reported as a regression.
+        // Baselines are machine specific. Regenerate them on the machine that runs the comparison.
+        float RegressionThreshold = 0.15f;
+        FixedString256 OutputPath = "Benchmarks/Results.json";
+        FixedString256 BaselinePath = "Benchmarks/Baseline.json";
+    };
+}
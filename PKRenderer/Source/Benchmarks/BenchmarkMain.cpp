@@ -0,0 +1,16 @@
+#include "PrecompiledHeader.h"
+#include "Benchmarks/BenchmarkApplication.h"
+
+// Entry point of the standalone benchmark build (see CMakeLists.txt).
+// The renderer project excludes this file from its build as RendererApplication.cpp provides the application there.
+PK::IApplication* PK::CreateProjectApplication(const PK::CArguments& arguments)
+{
+    auto app = Memory::Allocate<Benchmarks::BenchmarkApplication>(1u);
+    PK::Platform::AddManagedAllocation(app, [](void* ptr) { Memory::Destruct(static_cast<Benchmarks::BenchmarkApplication*>(ptr)); });
+    return Memory::Construct(app, arguments);
+}
+
+void PK::FreeProjectApplication(IApplication* application)
+{
+    PK::Platform::ManagedDeallocate(application);
+}
@@ -257,6 +257,12 @@ namespace PK
         }
     }
 
+    bool AssetDatabase::IsLoaded(AssetID assetId) const
+    {
+        auto index = m_assets.GetHashIndex(assetId);
+        return index != -1 && m_assets[index]->isLoaded;
+    }
+
 
     void AssetDatabase::LoadAsset(AssetObjectBase* object, bool isReload)
     {
@@ -3,6 +3,7 @@
 #include "Core/Base/Types/Singleton.h"
 #include "Core/Base/TypeMeta.h"
 #include "Core/Base/FileIO.h"
+#include "Core/Base/MemoryTracker.h"
 #include "Core/Assets/Asset.h"
 #include "Core/Assets/AssetImportEvent.h"
 #include "Core/ControlFlow/Sequencer.h"
@@ -138,6 +139,7 @@ namespace PK
         template<typename T, typename ... Args>
         Ref<T> CreateVirtual(AssetID assetId, Args&& ... args)
         {
+            PK_MEMORY_TAG_SCOPE(pk_inner_type_name<T>());
             auto object = CreateAssetObject<T>(assetId, CacheMode::Persistent);
             PK_FATAL_ASSERT(!object->isLoaded, "AssetDatabase.Register: (%s) already exists!", assetId.c_str());
             PK_LOG_VERBOSE_FUNC_FMT("%s, %s", pk_inner_type_name<T>(), assetId.c_str());
@@ -154,6 +156,7 @@ namespace PK
         template<typename T>
         Ref<T> Load(AssetID assetId, CacheMode cacheMode = CacheMode::Persistent, bool forceReload = false)
         {
+            PK_MEMORY_TAG_SCOPE(pk_inner_type_name<T>());
             auto object = CreateAssetObject<T>(assetId, cacheMode);
             LoadAsset(object, forceReload);
             return object->GetReference();
@@ -184,6 +187,19 @@ namespace PK
         template<typename T>
         void ReloadByType() { ReloadByType(pk_base_type_index<T>()); }
 
+        // Reloads loaded assets of type T that match the predicate. Used to propagate reloads to dependent assets.
+        template<typename T, typename TPredicate>
+        void ReloadWhere(TPredicate predicate)
+        {
+            for (auto index = GetTypeHead(pk_base_type_index<T>()); index != INVALID_LINK; index = m_assets[index]->indexNext)
+            {
+                if (m_assets[index]->isLoaded && predicate(static_cast<T*>(m_assets[index]->GetAsset())))
+                {
+                    LoadAsset(m_assets[index], true);
+                }
+            }
+        }
+
         template<typename T>
         void UnloadDirectoryByType(const char* directory) { UnloadDirectoryByType(pk_base_type_index<T>(), directory); }
        
@@ -224,6 +240,8 @@ namespace PK
         void LogByType(uint32_t typeIndex);
         void LogAll();
 
+        bool IsLoaded(AssetID assetId) const;
+
     private:
         template<typename T>
         TypeInfo* CreateTypeInfo() 
@@ -0,0 +1,121 @@
+#include "PrecompiledHeader.h"
+#include "Core/CLI/Log.h"
+#include "Core/Assets/AssetDatabase.h"
+#include "AssetWatcher.h"
+
+namespace PK
+{
+    AssetWatcher::AssetWatcher(AssetDatabase* assetDatabase, const char* directory) : 
+        m_assetDatabase(assetDatabase), 
+        m_directory({ directory })
+    {
+        m_watcher = Platform::CreateFileWatcher(directory, true);
+
+        if (m_watcher == nullptr)
+        {
+            PK_LOG_WARNING("AssetWatcher: Failed to watch directory '%s'. Hot reload is disabled.", directory);
+        }
+    }
+
+    AssetWatcher::~AssetWatcher()
+    {
+        Platform::DestroyFileWatcher(m_watcher);
+    }
+
+    void AssetWatcher::Poll()
+    {
+        ReadChanges();
+
+        if (m_pending.GetCount() > 0u || m_isRescanPending)
+        {
+            ReloadChanges(Platform::GetTimeSeconds() - m_debounceSeconds);
+        }
+    }
+
+    void AssetWatcher::Step(RemoteProcessResult* result)
+    {
+        ReadChanges();
+
+        if (!result->isCancelled && result->exitCode == 0u && (m_pending.GetCount() > 0u || m_isRescanPending))
+        {
+            ReloadChanges(Platform::GetTimeSeconds());
+        }
+    }
+
+    void AssetWatcher::ReadChanges()
+    {
+        if (m_watcher == nullptr)
+        {
+            return;
+        }
+
+        Platform::PollFileWatcher(m_watcher, this, [](void* ctx, const char* path)
+        {
+            auto watcher = reinterpret_cast<AssetWatcher*>(ctx);
+
+            if (!watcher->m_isEnabled)
+            {
+                return;
+            }
+
+            auto timestamp = Platform::GetTimeSeconds();
+
+            if (path == nullptr)
+            {
+                watcher->m_isRescanPending = true;
+                watcher->m_rescanTimestamp = timestamp;
+                return;
+            }
+
+            auto assetId = AssetID(path);
+
+            for (auto i = 0u; i < watcher->m_pending.GetCount(); ++i)
+            {
+                if (watcher->m_pending[i].assetId == assetId)
+                {
+                    watcher->m_pending[i].timestamp = timestamp;
+                    return;
+                }
+            }
+
+            watcher->m_pending.Add(PendingChange{ assetId, timestamp });
+        });
+    }
+
+    void AssetWatcher::ReloadChanges(double maxTimestamp)
+    {
+        if (m_isRescanPending)
+        {
+            if (m_rescanTimestamp > maxTimestamp)
+            {
+                return;
+            }
+
+            // The rescan covers every pending change.
+            PK_LOG_WARNING("AssetWatcher: Changes in '%s' were lost. Reloading all loaded assets in it.", m_directory.c_str());
+            m_isRescanPending = false;
+            m_pending.Clear();
+            m_assetDatabase->ReloadDirectory(m_directory.c_str());
+            return;
+        }
+
+        for (auto i = 0u; i < m_pending.GetCount();)
+        {
+            if (m_pending[i].timestamp > maxTimestamp)
+            {
+                ++i;
+                continue;
+            }
+
+            auto assetId = m_pending[i].assetId;
+            m_pending.UnorderedRemoveAt(i);
+
+            // Only assets that are in use are reloaded. Others pick up the change when they are loaded.
+            if (m_assetDatabase->IsLoaded(assetId))
+            {
+                PK_LOG_INFO("AssetWatcher: Reloading '%s'", assetId.c_str());
+                m_assetDatabase->Reload(assetId);
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Core/Base/Containers/ArrayList.h"
+#include "Core/Base/Containers/FixedString.h"
+#include "Core/Base/NoCopy.h"
+#include "Core/CLI/CVariable.h"
+#include "Core/Assets/Asset.h"
+#include "Core/ControlFlow/IStep.h"
+#include "Core/ControlFlow/RemoteProcessRunner.h"
+
+namespace PK
+{
+    class AssetDatabase;
+
+    // Watches a content directory & reloads loaded assets whose files changed.
+    // Changes are debounced as tools & editors often write a file multiple times.
+    // Dependent assets are reloaded through the import events of the changed asset.
+    class AssetWatcher : public IStep<RemoteProcessResult*>, public NoCopy
+    {
+    public:
+        AssetWatcher(AssetDatabase* assetDatabase, const char* directory);
+        ~AssetWatcher();
+
+        void Poll();
+
+        // Remote processes run the asset tools. Their output has settled once they exit.
+        virtual void Step(RemoteProcessResult* result) final;
+
+    private:
+        struct PendingChange
+        {
+            AssetID assetId;
+            double timestamp;
+        };
+
+        void ReadChanges();
+        void ReloadChanges(double maxTimestamp);
+
+        AssetDatabase* m_assetDatabase = nullptr;
+        void* m_watcher = nullptr;
+        FixedString256 m_directory;
+        HeapList<PendingChange> m_pending;
+        // Set when the watcher lost changes. Loaded assets of the whole directory are reloaded instead.
+        bool m_isRescanPending = false;
+        double m_rescanTimestamp = 0.0;
+        CVariableField<bool> m_isEnabled = { "AssetDatabase.HotReload", true };
+        CVariableField<float> m_debounceSeconds = { "AssetDatabase.HotReload.Debounce", 0.25f };
+    };
+}
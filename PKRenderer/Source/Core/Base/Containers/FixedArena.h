@@ -1,6 +1,7 @@
 #pragma once
 #include "Core/Base/Memory.h"
 #include "Core/Base/NoCopy.h"
+#include "Core/Base/Containers/BufferView.h"
 
 namespace PK
 {
@@ -40,6 +41,30 @@ namespace PK
             return New<T>(PK::Forward<T>(element));
         }
 
+        // Concatenates views into a single contiguous allocation with one copy per view.
+        template<typename T>
+        ConstBufferView<T> Gather(const ConstBufferView<T>* views, size_t count)
+        {
+            auto totalCount = 0ull;
+
+            for (auto i = 0u; i < count; ++i)
+            {
+                totalCount += views[i].count;
+            }
+
+            auto elements = totalCount > 0ull ? Allocate<T>(totalCount) : GetHead<T>();
+
+            for (auto i = 0u, offset = 0u; i < count; offset += (uint32_t)views[i++].count)
+            {
+                if (views[i].count > 0ull)
+                {
+                    memcpy(elements + offset, views[i].data, sizeof(T) * views[i].count);
+                }
+            }
+
+            return { elements, totalCount };
+        }
+
         virtual uint64_t GetAlignedHead(size_t alignment) const = 0;
         virtual uint64_t GetRelativeHead(size_t alignment) const = 0;
         virtual void* AllocateBlock(size_t size, size_t alignment) = 0;
@@ -84,4 +109,43 @@ namespace PK
         uint8_t m_data[capacity]{};
         size_t m_head = 0ull;
     };
+
+    // Non owning arena over an external memory range.
+    struct BufferArena : public IArena
+    {
+        BufferArena(void* data, size_t capacity) : m_data(static_cast<uint8_t*>(data)), m_capacity(capacity) {}
+
+        uint64_t GetAlignedHead(size_t alignment) const final 
+        { 
+            return ((reinterpret_cast<uint64_t>(m_data + m_head) + alignment - 1ull) & ~(alignment - 1ull)); 
+        }
+
+        uint64_t GetRelativeHead(size_t alignment) const final 
+        {
+            return GetAlignedHead(alignment) - reinterpret_cast<uint64_t>(m_data); 
+        }
+
+        void* AllocateBlock(size_t size, size_t alignment) final
+        {
+            auto relativeHead = GetRelativeHead(alignment);
+            m_head = relativeHead + size;
+            Memory::Assert(m_head <= m_capacity, "Arena capacity exceeded!");
+            return m_data + relativeHead;
+        }
+
+        void Clear() final
+        { 
+            m_head = 0ull;
+            memset(m_data, 0, sizeof(char) * m_capacity); 
+        }
+
+        void ClearFast() final
+        {
+            m_head = 0ull;
+        }
+
+        uint8_t* m_data = nullptr;
+        size_t m_capacity = 0ull;
+        size_t m_head = 0ull;
+    };
 }
@@ -115,7 +115,7 @@ namespace PK
             constexpr const void* GetByteBuffer() const { return m_buffer; }
             constexpr void* GetByteBuffer() { return m_buffer; }
 
-        private:
+        protected:
             const void* GetValuePtr(uint64_t key, size_t* size) const;
             uint32_t AddKey(uint64_t key, size_t size);
             bool WriteValue(const void* src, uint32_t index, size_t writeSize);
@@ -0,0 +1,101 @@
+#include "PrecompiledHeader.h"
+#include "Core/Base/Memory.h"
+#include "VersionedPropertyBlock.h"
+
+namespace PK
+{
+    void VersionedPropertyBlock::Clear()
+    {
+        PropertyBlock::Clear();
+        // Invalidate any cached versions & value pointers.
+        ++m_version;
+        ++m_storageVersion;
+    }
+
+    void VersionedPropertyBlock::ClearAndReserve(uint64_t byteCapacity, uint32_t propertyCapacity)
+    {
+        Clear();
+        ReserveMemory(byteCapacity, propertyCapacity);
+    }
+
+
+    const void* VersionedPropertyBlock::GetValuePtr(uint64_t key, size_t* size) const
+    {
+        const auto header = reinterpret_cast<const SlotHeader*>(PropertyBlock::GetValuePtr(key, nullptr));
+
+        if (header == nullptr)
+        {
+            return nullptr;
+        }
+
+        if (size != nullptr)
+        {
+            *size = (uint64_t)header->size;
+        }
+
+        return GetSlotPtr(header, header->front);
+    }
+
+    uint32_t VersionedPropertyBlock::AddKey(uint64_t key, size_t size)
+    {
+        // Header & both slots are stored as a single property in the base block.
+        const auto storageSize = size > 0ull ? SLOT_HEADER_SIZE + GetSlotStride(size) * 2ull : 0ull;
+        Memory::Assert(storageSize <= 0xFFFFull, "Value size exceeds versioned property block limits");
+
+        const auto propertyCount = m_propertyCount;
+        const auto buffer = m_buffer;
+        const auto index = PropertyBlock::AddKey(key, storageSize);
+
+        // Buffer was reallocated.
+        if (m_buffer != buffer)
+        {
+            ++m_storageVersion;
+        }
+
+        // Storage is cleared on allocation. Only the value size needs to be initialized.
+        if (m_propertyCount != propertyCount)
+        {
+            GetSlotHeader(index)->size = (uint16_t)size;
+        }
+
+        return index;
+    }
+
+    bool VersionedPropertyBlock::WriteValue(const void* src, uint32_t index, size_t writeSize)
+    {
+        if (index >= m_propertyCount)
+        {
+            return false;
+        }
+
+        auto header = GetSlotHeader(index);
+
+        if (header->size < writeSize)
+        {
+            return false;
+        }
+
+        auto dst = GetSlotPtr(header, header->front);
+
+        // Rebinding an identical value is common. Keep the version so that readers can early out.
+        if (header->frame != 0u && memcmp(dst, src, writeSize) == 0)
+        {
+            return true;
+        }
+
+        // First write this frame. Leave the front slot for previous frame readers.
+        // Carry the full value forward as the write might only cover a part of it.
+        if (header->frame != m_frame)
+        {
+            auto back = GetSlotPtr(header, header->front ^ 1u);
+            memcpy(back, dst, header->size);
+            header->front ^= 1u;
+            header->frame = m_frame;
+            dst = back;
+        }
+
+        memcpy(dst, src, writeSize);
+        ++m_version;
+        return true;
+    }
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include "PropertyBlock.h"
+
+namespace PK
+{
+    // Double buffered variant of PropertyBlock. Shares its storage & lookup.
+    // Each property stores a small header followed by two value slots. The first write to a property within a frame
+    // flips the slots & carries the value forward, leaving the previous value intact for readers that still reference it.
+    // Writes that dont change the value are discarded so that the version only advances on actual changes.
+    // Do not store non trivially destructible types.
+    // Doesnt support removes. arena style allocation.
+    class VersionedPropertyBlock : protected PropertyBlock
+    {
+        private:
+            struct SlotHeader
+            {
+                uint32_t frame = 0u;
+                uint16_t size = 0u;
+                uint8_t front = 0u;
+            };
+
+            constexpr static const size_t SLOT_HEADER_SIZE = Memory::AlignSize<uint64_t>(sizeof(SlotHeader));
+
+        public:
+            VersionedPropertyBlock(uint64_t capacityBytes, uint32_t capacityProperties) : PropertyBlock(capacityBytes, capacityProperties) {}
+
+            void Clear();
+            void ClearAndReserve(uint64_t capacityBytes, uint32_t capacityProperties);
+
+            // Values written after this go to the other slot.
+            void NextFrame() { ++m_frame; }
+
+            constexpr uint32_t GetFrame() const { return m_frame; }
+            constexpr uint32_t GetVersion() const { return m_version; }
+            // Advances when values move in memory. Pointers to values are only valid while it stays the same.
+            constexpr uint32_t GetStorageVersion() const { return m_storageVersion; }
+
+            template<typename T>
+            const T* Get(const uint32_t hashId, size_t* size) const
+            {
+                return reinterpret_cast<const T*>(GetValuePtr(MakeKey<T>(hashId), size));
+            }
+
+            template<typename T>
+            const T* Get(const uint32_t hashId) const
+            {
+                return Get<T>(hashId, nullptr);
+            }
+
+            template<typename T>
+            bool TryGet(const uint32_t hashId, const T** value, uint64_t* size) const
+            {
+                *value = Get<T>(hashId, size);
+                return *value != nullptr;
+            }
+
+            template<typename T>
+            bool TryGet(const uint32_t hashId, T& value) const
+            {
+                const T* ptr = Get<T>(hashId, nullptr);
+                if (ptr) value = *ptr;
+                return ptr != nullptr;
+            }
+
+
+            template<typename T>
+            bool TrySet(uint32_t hashId, const T* src, uint32_t count)
+            {
+                const auto wsize = sizeof(T) * count;
+                const auto index = AddKey(MakeKey<T>(hashId), wsize);
+                return WriteValue(src, index, wsize);
+            }
+
+            template<typename T>
+            bool TrySet(uint32_t hashId, const T& src)
+            {
+                return TrySet(hashId, &src, 1u);
+            }
+
+            template<typename T>
+            void Set(uint32_t hashId, const T* src, uint32_t count)
+            {
+                Memory::Assert(TrySet(hashId, src, count), "Value not found in property block");
+            }
+
+            template<typename T>
+            void Set(uint32_t hashId, const T& src)
+            {
+                Set(hashId, &src, 1u);
+            }
+
+
+            template<typename T>
+            void Reserve(uint32_t hashId, uint32_t count = 1u)
+            {
+                AddKey(MakeKey<T>(hashId), sizeof(T) * count);
+            }
+
+        private:
+            const void* GetValuePtr(uint64_t key, size_t* size) const;
+            uint32_t AddKey(uint64_t key, size_t size);
+            bool WriteValue(const void* src, uint32_t index, size_t writeSize);
+
+            inline static size_t GetSlotStride(size_t size) { return Memory::AlignSize<uint64_t>(size); }
+            inline static const char* GetSlotPtr(const SlotHeader* header, uint32_t slot) { return reinterpret_cast<const char*>(header) + SLOT_HEADER_SIZE + GetSlotStride(header->size) * slot; }
+            inline static char* GetSlotPtr(SlotHeader* header, uint32_t slot) { return reinterpret_cast<char*>(header) + SLOT_HEADER_SIZE + GetSlotStride(header->size) * slot; }
+            inline SlotHeader* GetSlotHeader(uint32_t index) { return reinterpret_cast<SlotHeader*>(static_cast<char*>(m_buffer) + m_properties[index].offset); }
+
+            uint32_t m_frame = 1u;
+            uint32_t m_version = 0u;
+            uint32_t m_storageVersion = 0u;
+    };
+}
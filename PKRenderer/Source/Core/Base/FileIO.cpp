@@ -83,7 +83,11 @@ namespace PK::FileIO
         if (outSize)
         {
             struct stat filestat;
+            #if PK_PLATFORM_WINDOWS
             int fileNumber = _fileno(file);
+            #else
+            int fileNumber = fileno(file);
+            #endif
 
             if (fstat(fileNumber, &filestat) != 0)
             {
@@ -1,6 +1,8 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 #include <new>
 #if !defined(PK_SYSTEM_ERROR)
 #include <assert.h>
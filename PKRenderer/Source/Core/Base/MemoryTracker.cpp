@@ -0,0 +1,168 @@
+#include "PrecompiledHeader.h"
+#include "MemoryTracker.h"
+
+namespace PK
+{
+    constexpr static const uint16_t PK_MEMORY_HEADER_MAGIC = 0x504Bu;
+
+    thread_local uint16_t MemoryTracker::s_threadTag = MemoryTracker::TAG_UNTAGGED;
+    thread_local uint32_t MemoryTracker::s_threadShard = ~0u;
+
+    // Static storage only. Allocating here would recurse into the tracker.
+    static MemoryTracker::TagStats s_tags[MemoryTracker::MAX_TAGS] = { { "Untagged", 0ll, 0ll, 0ll, 0ll, 0ll, 0ll, 0ll, 0ll, 0ll } };
+    // Shard major so that threads with different shards never write to the same cache line.
+    static MemoryTracker::Counters s_counters[MemoryTracker::MAX_SHARDS][MemoryTracker::MAX_TAGS];
+    static volatile uint32_t s_shardCount = 0u;
+    static volatile uint32_t s_tagCount = 1u;
+    static volatile uint32_t s_tagLock = 0u;
+
+    MemoryTracker::Counters& MemoryTracker::GetThreadCounters(uint16_t tag)
+    {
+        // Threads past the shard count share shards. Counter updates are atomic so this only costs contention.
+        if (s_threadShard == ~0u)
+        {
+            s_threadShard = (Platform::InterlockedIncrement(&s_shardCount) - 1u) % MAX_SHARDS;
+        }
+
+        return s_counters[s_threadShard][tag];
+    }
+
+    uint16_t MemoryTracker::RegisterTag(const char* name)
+    {
+        while (Platform::InterlockedCompareExchange(&s_tagLock, 1u, 0u) != 0u)
+        {
+        }
+
+        auto count = Platform::AtomicRead(&s_tagCount);
+        auto index = count;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            if (strcmp(s_tags[i].name, name) == 0)
+            {
+                index = i;
+                break;
+            }
+        }
+
+        if (index == count)
+        {
+            // Out of tags. Attribute to untagged instead of failing.
+            if (count >= MAX_TAGS)
+            {
+                index = TAG_UNTAGGED;
+            }
+            else
+            {
+                s_tags[index].name = name;
+                Platform::AtomicStore(&s_tagCount, count + 1u);
+            }
+        }
+
+        Platform::AtomicStore(&s_tagLock, 0u);
+        return (uint16_t)index;
+    }
+
+    void* MemoryTracker::TrackAllocation(void* block, size_t size, size_t alignment)
+    {
+        const auto offset = GetHeaderSize(alignment);
+        auto ptr = reinterpret_cast<char*>(block) + offset;
+        auto header = reinterpret_cast<Header*>(ptr) - 1;
+        auto tag = s_threadTag < MAX_TAGS ? s_threadTag : TAG_UNTAGGED;
+        auto& counters = GetThreadCounters(tag);
+
+        header->size = size;
+        header->offset = (uint32_t)offset;
+        header->tag = tag;
+        header->magic = PK_MEMORY_HEADER_MAGIC;
+
+        Platform::InterlockedAdd64(&counters.liveBytes, (int64_t)size);
+        Platform::InterlockedAdd64(&counters.liveCount, 1ll);
+        Platform::InterlockedAdd64(&counters.totalBytes, (int64_t)size);
+        Platform::InterlockedAdd64(&counters.totalCount, 1ll);
+        return ptr;
+    }
+
+    void* MemoryTracker::TrackFree(void* ptr, size_t* outSize)
+    {
+        auto header = reinterpret_cast<Header*>(ptr) - 1;
+        Memory::Assert(header->magic == PK_MEMORY_HEADER_MAGIC, "Freeing memory that wasnt allocated by the platform allocator!");
+
+        // Live counters of a single shard can go negative. Only their sum is meaningful.
+        auto& counters = GetThreadCounters(header->tag);
+        Platform::InterlockedAdd64(&counters.liveBytes, -(int64_t)header->size);
+        Platform::InterlockedAdd64(&counters.liveCount, -1ll);
+
+        *outSize = header->size;
+        header->magic = 0u;
+        return reinterpret_cast<char*>(ptr) - header->offset;
+    }
+
+    void MemoryTracker::NextFrame()
+    {
+        const auto count = GetTagCount();
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto& stats = s_tags[i];
+            stats.liveBytes = 0ll;
+            stats.liveCount = 0ll;
+            stats.totalBytes = 0ll;
+            stats.totalCount = 0ll;
+
+            for (auto j = 0u; j < MAX_SHARDS; ++j)
+            {
+                const auto& counters = s_counters[j][i];
+                stats.liveBytes += counters.liveBytes;
+                stats.liveCount += counters.liveCount;
+                stats.totalBytes += counters.totalBytes;
+                stats.totalCount += counters.totalCount;
+            }
+
+            stats.peakBytes = stats.liveBytes > stats.peakBytes ? stats.liveBytes : stats.peakBytes;
+            stats.frameBytes = stats.totalBytes - stats.previousTotalBytes;
+            stats.frameCount = stats.totalCount - stats.previousTotalCount;
+            stats.previousTotalBytes = stats.totalBytes;
+            stats.previousTotalCount = stats.totalCount;
+        }
+    }
+
+    uint32_t MemoryTracker::GetTagCount()
+    {
+        return Platform::AtomicRead(&s_tagCount);
+    }
+
+    const MemoryTracker::TagStats* MemoryTracker::GetTagStats(uint16_t tag)
+    {
+        return tag < GetTagCount() ? s_tags + tag : nullptr;
+    }
+
+    uint32_t MemoryTracker::GetTopTags(uint16_t* outTags, uint32_t maxCount)
+    {
+        // Tags are still registered when tracking is compiled out. There is nothing to report for them though.
+        const auto count = PK_MEMORY_TRACKING ? GetTagCount() : 0u;
+        auto outCount = 0u;
+
+        // Insertion sort into the output. Tag counts are small.
+        for (auto i = 0u; i < count; ++i)
+        {
+            auto liveBytes = s_tags[i].liveBytes;
+            auto j = outCount < maxCount ? outCount++ : maxCount;
+
+            for (; j > 0u && s_tags[outTags[j - 1u]].liveBytes < liveBytes; --j)
+            {
+                if (j < maxCount)
+                {
+                    outTags[j] = outTags[j - 1u];
+                }
+            }
+
+            if (j < maxCount)
+            {
+                outTags[j] = (uint16_t)i;
+            }
+        }
+
+        return outCount;
+    }
+}
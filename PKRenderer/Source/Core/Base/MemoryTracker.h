@@ -0,0 +1,109 @@
+#pragma once
+#include <stdint.h>
+
+// Adds a header & counter updates to every platform allocation. Off by default in release builds.
+#if !defined(PK_MEMORY_TRACKING)
+    #if defined(PK_DEBUG)
+        #define PK_MEMORY_TRACKING 1
+    #else
+        #define PK_MEMORY_TRACKING 0
+    #endif
+#endif
+
+namespace PK
+{
+    // Tagged heap accounting for platform allocations.
+    // Allocations are attributed to the tag active on the allocating thread.
+    // Frees are attributed to the tag stored in the allocation header, regardless of the freeing thread.
+    // Counters are sharded per thread & only summed into TagStats by NextFrame.
+    struct MemoryTracker
+    {
+        constexpr static const uint32_t MAX_TAGS = 256u;
+        constexpr static const uint32_t MAX_SHARDS = 16u;
+        constexpr static const uint16_t TAG_UNTAGGED = 0u;
+
+        struct Header
+        {
+            uint64_t size;
+            uint32_t offset;
+            uint16_t tag;
+            uint16_t magic;
+        };
+
+        struct Counters
+        {
+            volatile int64_t liveBytes;
+            volatile int64_t liveCount;
+            volatile int64_t totalBytes;
+            volatile int64_t totalCount;
+        };
+
+        // Values as of the last NextFrame.
+        struct TagStats
+        {
+            const char* name;
+            int64_t liveBytes;
+            int64_t liveCount;
+            int64_t totalBytes;
+            int64_t totalCount;
+            // Highest live bytes sampled at frame boundaries.
+            int64_t peakBytes;
+            // Deltas from the last completed frame.
+            int64_t frameBytes;
+            int64_t frameCount;
+            int64_t previousTotalBytes;
+            int64_t previousTotalCount;
+        };
+
+        struct TagScope
+        {
+            uint16_t previous;
+            TagScope(uint16_t tag) : previous(s_threadTag) { s_threadTag = tag; }
+            ~TagScope() { s_threadTag = previous; }
+        };
+
+        // Returns the same tag index for repeated registrations of an identical name.
+        static uint16_t RegisterTag(const char* name);
+        static uint16_t GetThreadTag() { return s_threadTag; }
+
+        // Multiple of the alignment so that the returned pointer keeps the alignment of the block.
+        constexpr static size_t GetHeaderSize(size_t alignment) 
+        {
+            alignment = alignment > alignof(Header) ? alignment : alignof(Header);
+            return (sizeof(Header) + alignment - 1ull) & ~(alignment - 1ull);
+        }
+
+        // Writes an allocation header in front of the returned pointer.
+        // Block must be aligned to alignment & GetHeaderSize(alignment) bytes larger than size.
+        static void* TrackAllocation(void* block, size_t size, size_t alignment);
+        // Returns the original block for a pointer returned by TrackAllocation.
+        static void* TrackFree(void* ptr, size_t* outSize);
+
+        // Resolves per frame allocation rates.
+        static void NextFrame();
+
+        static uint32_t GetTagCount();
+        static const TagStats* GetTagStats(uint16_t tag);
+        // Fills outTags with tag indices sorted by live bytes. Returns the number of tags written.
+        static uint32_t GetTopTags(uint16_t* outTags, uint32_t maxCount);
+
+    private:
+        static Counters& GetThreadCounters(uint16_t tag);
+
+        static thread_local uint16_t s_threadTag;
+        static thread_local uint32_t s_threadShard;
+    };
+}
+
+#define PK_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+#define PK_MEMORY_TAG_CONCAT(a, b) PK_MEMORY_TAG_CONCAT_INNER(a,b)
+
+#if PK_MEMORY_TRACKING
+    #define PK_MEMORY_TAG_SCOPE_ID(tag) PK::MemoryTracker::TagScope PK_MEMORY_TAG_CONCAT(pk_memory_tag_scope_, __COUNTER__)(tag)
+    #define PK_MEMORY_TAG_SCOPE(name) \
+    static const uint16_t PK_MEMORY_TAG_CONCAT(pk_memory_tag_, __LINE__) = PK::MemoryTracker::RegisterTag(name); \
+    PK_MEMORY_TAG_SCOPE_ID(PK_MEMORY_TAG_CONCAT(pk_memory_tag_, __LINE__))
+#else
+    #define PK_MEMORY_TAG_SCOPE_ID(tag)
+    #define PK_MEMORY_TAG_SCOPE(name)
+#endif
@@ -216,6 +216,17 @@ namespace PK
 
             for (size_t i = 0; i < signatureLength; ++i)
             {
+#if defined(__GNUC__) && !defined(__clang__)
+                // Gcc qualifies the member & wraps the argument in parentheses: "(& Object.Type::Field)"
+                if (signature[i] == '.' || signature[i] == ':')
+                {
+                    start = i;
+                }
+                if (signature[i] == ')')
+                {
+                    end = i;
+                }
+#else
                 if (signature[i] == '>')
                 {
                     start = end;
@@ -229,6 +240,7 @@ namespace PK
                 {
                     end = i;
                 }
+#endif
             }
 
             return StringLiteralView{ signature + start + 1ull, end - start - 1 };
@@ -40,7 +40,11 @@ namespace PK
     template<size_t I> using TIndexConstant = TIntegerConstant<size_t, I>;
 
     template<typename T, T... V> struct TIntegerSequence { using Type = T; static constexpr size_t size() noexcept { return sizeof...(V); } };
+    #if defined(__GNUC__) && !defined(__clang__)
+    template<typename T, T N> using TMakeIntegerSequence = TIntegerSequence<T, __integer_pack(N)...>;
+    #else
     template<typename T, T N> using TMakeIntegerSequence = __make_integer_seq<TIntegerSequence, T, N>;
+    #endif
     template<size_t... V> using TIndexSequence = TIntegerSequence<size_t, V...>;
     template<size_t N> using TMakeIndexSequence = TMakeIntegerSequence<size_t, N>;
     template<typename ... Args> using TIndexSequenceFor = TMakeIndexSequence<sizeof...(Args)>;
@@ -56,7 +60,13 @@ namespace PK
     #endif 
 
     template<typename TBase, typename TDerived> inline constexpr bool TIsBaseOf = __is_base_of(TBase, TDerived);
+    #if defined(__GNUC__) && !defined(__clang__)
+    // Gcc has no __is_convertible_to. Test for an implicit conversion to a by value argument instead.
+    template<typename TTo> void TImplicitConvert(TTo) noexcept;
+    template<typename TFrom, typename TTo>      inline constexpr bool TIsConvertible = requires { TImplicitConvert<TTo>(static_cast<TFrom(*)()>(nullptr)()); };
+    #else
     template<typename TFrom, typename TTo>      inline constexpr bool TIsConvertible = __is_convertible_to(TFrom, TTo);
+    #endif
     template<typename T, typename ... Args>     inline constexpr bool TIsAnyOf = (TIsSame<T, Args> || ...);
     template<typename TFrom, typename TTo>      inline constexpr bool TIsAssignable = __is_assignable(TTo, TFrom);
     template<typename T>                        inline constexpr bool TIsClass = __is_class(T);
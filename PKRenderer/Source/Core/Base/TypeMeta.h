@@ -13,11 +13,21 @@ namespace PK
     #define PK_FUNC_SIG __PRETTY_FUNCTION__
     #define PK_FUNC_SIG_LEN sizeof(__PRETTY_FUNCTION__)
     #define PK_FUNC_SIG_LEN_TRUNC (PK_FUNC_SIG_LEN - 2ull)
+    #elif defined(__GNUC__)
+    // Gcc __PRETTY_FUNCTION__ has an incomplete array type inside templates. Measure it instead.
+    #define PK_FUNC_SIG __PRETTY_FUNCTION__
+    #define PK_FUNC_SIG_LEN (PK::pk_func_sig_length(__PRETTY_FUNCTION__) + 1ull)
+    #define PK_FUNC_SIG_LEN_TRUNC (PK_FUNC_SIG_LEN - 2ull)
     #else
     #error "Unsupported compiler!"
     #endif
     
+    #if defined(__GNUC__) && !defined(__clang__)
+    // Gcc cannot evaluate __PRETTY_FUNCTION__ at compile time inside constructors. Use the unqualified name instead.
+    #define PK_SHORT_FUNCTION_NAME __FUNCTION__
+    #else
     #define PK_SHORT_FUNCTION_NAME pk_short_function_name<StringLiteral<PK_FUNC_SIG_LEN>(PK_FUNC_SIG)>()
+    #endif
 
     template<size_t N>
     struct StringLiteral
@@ -43,9 +53,10 @@ namespace PK
         size_t length;
     };
 
-    consteval bool pk_char_is_alpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c == '_'); }
-    consteval bool pk_char_is_numeric(char c) { return c >= '0' && c <= '9'; }
-    consteval bool pk_char_is_alphanumeric(char c) { return pk_char_is_alpha(c) || pk_char_is_numeric(c); }
+    consteval size_t pk_func_sig_length(const char* signature) { auto length = 0ull; while (signature[length] != '\0') { ++length; } return length; }
+    constexpr bool pk_char_is_alpha(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c == '_'); }
+    constexpr bool pk_char_is_numeric(char c) { return c >= '0' && c <= '9'; }
+    constexpr bool pk_char_is_alphanumeric(char c) { return pk_char_is_alpha(c) || pk_char_is_numeric(c); }
 
     consteval bool pk_is_valid_func_sig(const char* name, size_t length) noexcept
     {
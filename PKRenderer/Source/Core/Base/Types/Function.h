@@ -112,7 +112,7 @@ namespace PK
             
             Unbind();
 
-            if constexpr (__is_convertible_to(T, TFunc))
+            if constexpr (TIsConvertible<T, TFunc>)
             {
                 function = &CallStaticPtr;
                 storage.func = lambda;
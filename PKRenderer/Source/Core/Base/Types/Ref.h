@@ -15,7 +15,7 @@ namespace PK
         constexpr DefaultDeleter() noexcept = default;
 
         template<typename U>  
-        DefaultDeleter(const DefaultDeleter<U>&, typename TEnableIf<__is_convertible_to(U*, T*)>::Type * = 0) noexcept {}
+        DefaultDeleter(const DefaultDeleter<U>&, typename TEnableIf<TIsConvertible<U*, T*>>::Type * = 0) noexcept {}
 
         void operator()(T* p) const noexcept { Memory::Delete(p); }
     };
@@ -1,4 +1,5 @@
 #include "PrecompiledHeader.h"
+#include <ctype.h>
 #include "Core/CLI/Log.h"
 #include "CVariableRegister.h"
 
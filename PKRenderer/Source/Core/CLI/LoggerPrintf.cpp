@@ -1,5 +1,4 @@
 #include "PrecompiledHeader.h"
-#include <conio.h>
 #include "Core/Base/FileIO.h"
 #include "Core/Base/Memory.h"
 #include "LoggerPrintf.h"
@@ -78,9 +77,16 @@ namespace PK
     {
         if (m_crashLogPath.Length() > 0ull)
         {
-            auto length = static_cast<size_t>(vprintf(format, args));
-            auto output = PK_STACK_ALLOC(char, length);
-            _vsnprintf(output, length, format, args);
+            // va_list is consumed by each use on LP64 abis. Format from copies.
+            va_list argsLength;
+            va_list argsOutput;
+            va_copy(argsLength, args);
+            va_copy(argsOutput, args);
+            auto length = static_cast<size_t>(vprintf(format, argsLength));
+            auto output = PK_STACK_ALLOC(char, length + 1ull);
+            vsnprintf(output, length + 1ull, format, argsOutput);
+            va_end(argsOutput);
+            va_end(argsLength);
             FileIO::WriteBinary(m_crashLogPath.c_str(), true, output, length);
         }
 
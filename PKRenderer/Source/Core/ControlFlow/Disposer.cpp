@@ -5,49 +5,196 @@ namespace PK
 {
     Disposer::Disposer(size_t initialCapacity)
     {
-        m_disposables.Reserve(initialCapacity, false);
+        m_handles.Reserve(initialCapacity, false);
+        m_asyncBatch.Reserve(initialCapacity, false);
     }
 
     Disposer::~Disposer()
     {
-        // Note important to go in forward order to preserve call order.
-        for (auto i = 0u; i < m_disposables.GetCount(); ++i)
+        m_asyncWorker.Wait();
+
+        // Note important to go in queue order to preserve call order.
+        for (auto i = 0u; i < m_queues.GetCount(); ++i)
         {
-            m_disposables[i].destructor(m_disposables[i].context, m_disposables[i].disposable);
+            while (m_queues[i].head != INVALID_INDEX)
+            {
+                auto handle = Dequeue(i);
+                handle.destructor(handle.context, handle.disposable);
+            }
         }
     }
 
     void Disposer::Dispose(void* context, void* disposable, Destructor destructor, const FenceRef& releaseFence)
     {
-        if (disposable != nullptr)
+        Enqueue(context, disposable, destructor, releaseFence, false);
+    }
+
+    void Disposer::DisposeAsync(void* context, void* disposable, Destructor destructor, const FenceRef& releaseFence)
+    {
+        Enqueue(context, disposable, destructor, releaseFence, true);
+    }
+
+    void Disposer::Prune()
+    {
+        // Previous batch might still be running.
+        m_asyncWorker.Wait();
+        m_asyncCount = 0u;
+
+        // Queues are accessed by index as destructors might dispose more objects.
+        for (auto i = 0u; i < m_queues.GetCount(); ++i)
+        {
+            while (m_queues[i].head != INVALID_INDEX)
+            {
+                auto head = &m_handles[m_queues[i].head];
+                auto value = head->fence.GetUserdata();
+
+                // Values up to the last completed one don't need to go through the wait function.
+                if (value > m_queues[i].completedValue)
+                {
+                    if (!head->fence.IsComplete())
+                    {
+                        break;
+                    }
+
+                    m_queues[i].completedValue = value;
+                }
+
+                auto handle = Dequeue(i);
+
+                if (handle.isAsync)
+                {
+                    if (m_asyncCount >= m_asyncBatch.GetCount())
+                    {
+                        m_asyncBatch.Reserve(m_asyncCount > 0u ? m_asyncCount * 2u : 64u, true);
+                    }
+
+                    m_asyncBatch[m_asyncCount++] = handle;
+                    continue;
+                }
+
+                handle.destructor(handle.context, handle.disposable);
+            }
+        }
+
+        if (m_asyncCount > 0u)
         {
-            auto handle = m_disposables.Add();
-            handle->context = context;
-            handle->disposable = disposable;
-            handle->destructor = destructor;
-            handle->fence = releaseFence;
+            m_asyncWorker.Dispatch(this, [](void* ctx)
+            {
+                auto disposer = reinterpret_cast<Disposer*>(ctx);
+
+                for (auto i = 0u; i < disposer->m_asyncCount; ++i)
+                {
+                    auto handle = &disposer->m_asyncBatch[i];
+                    handle->destructor(handle->context, handle->disposable);
+                }
+            });
         }
     }
 
-    void Disposer::Prune()
+    void Disposer::Enqueue(void* context, void* disposable, Destructor destructor, const FenceRef& releaseFence, bool isAsync)
     {
-        // Do this in two loops as call order for elements in using the same fence might be important.
-        for (auto i = 0u; i < m_disposables.GetCount(); ++i)
+        if (disposable == nullptr)
         {
-            if (m_disposables[i].fence.IsComplete())
+            return;
+        }
+
+        auto index = m_freeHandle;
+
+        if (index != INVALID_INDEX)
+        {
+            m_freeHandle = m_handles[index].next;
+        }
+        else
+        {
+            if (m_handleCount >= m_handles.GetCount())
             {
-                m_disposables[i].destructor(m_disposables[i].context, m_disposables[i].disposable);
-                m_disposables[i].disposable = nullptr;
-                m_disposables[i].context = nullptr;
+                m_handles.Reserve(m_handleCount > 0u ? m_handleCount * 2u : 64u, true);
             }
+
+            index = m_handleCount++;
         }
 
-        for (auto i = (int32_t)m_disposables.GetCount() - 1; i >= 0; --i)
+        auto queue = &m_queues[GetQueueIndex(releaseFence)];
+        auto handle = &m_handles[index];
+        handle->context = context;
+        handle->disposable = disposable;
+        handle->destructor = destructor;
+        handle->fence = releaseFence;
+        handle->next = INVALID_INDEX;
+        handle->isAsync = isAsync;
+
+        auto value = releaseFence.GetUserdata();
+
+        if (queue->tail == INVALID_INDEX)
+        {
+            queue->head = index;
+            queue->tail = index;
+        }
+        else if (m_handles[queue->tail].fence.GetUserdata() <= value)
+        {
+            m_handles[queue->tail].next = index;
+            queue->tail = index;
+        }
+        else
         {
-            if (m_disposables[i].disposable == nullptr)
+            // Fence values out of submit order are rare. Insert after equal values to preserve call order.
+            auto prev = &queue->head;
+
+            while (m_handles[*prev].fence.GetUserdata() <= value)
             {
-                m_disposables.UnorderedRemoveAt(i);
+                prev = &m_handles[*prev].next;
             }
+
+            handle->next = *prev;
+            *prev = index;
         }
     }
+
+    uint32_t Disposer::GetQueueIndex(const FenceRef& fence)
+    {
+        // Invalid fences are always complete. Share a single queue for them.
+        auto context = fence.IsValid() ? fence.GetContext() : nullptr;
+        auto waitFunction = fence.IsValid() ? fence.GetWaitFunction() : nullptr;
+
+        // Fence contexts are few & long lived. Consecutive disposals usually share one.
+        if (m_lastQueue < m_queues.GetCount() && m_queues[m_lastQueue].context == context && m_queues[m_lastQueue].waitFunction == waitFunction)
+        {
+            return m_lastQueue;
+        }
+
+        for (auto i = 0u; i < m_queues.GetCount(); ++i)
+        {
+            if (m_queues[i].context == context && m_queues[i].waitFunction == waitFunction)
+            {
+                m_lastQueue = i;
+                return i;
+            }
+        }
+
+        auto queue = m_queues.Add();
+        queue->context = context;
+        queue->waitFunction = waitFunction;
+        m_lastQueue = (uint32_t)(m_queues.GetCount() - 1u);
+        return m_lastQueue;
+    }
+
+    Disposer::DisposeHandle Disposer::Dequeue(uint32_t queueIndex)
+    {
+        auto queue = &m_queues[queueIndex];
+        auto index = queue->head;
+        auto handle = m_handles[index];
+        queue->head = handle.next;
+
+        // Context memory might get reused by an object with a new fence timeline.
+        if (queue->head == INVALID_INDEX)
+        {
+            queue->tail = INVALID_INDEX;
+            queue->completedValue = 0ull;
+        }
+
+        m_handles[index] = {};
+        m_handles[index].next = m_freeHandle;
+        m_freeHandle = index;
+        return handle;
+    }
 }
@@ -2,20 +2,26 @@
 #include "Core/Base/Containers/ArrayList.h"
 #include "Core/Base/NoCopy.h"
 #include "Core/ControlFlow/FenceRef.h"
+#include "Core/ControlFlow/WorkerThread.h"
 
 namespace PK
 {
+    // Disposals are queued per fence context & ordered by fence value.
+    // Pruning only tests the head of each queue, so its cost scales with the number of completed disposals.
     class Disposer : public NoCopy
     {
         public:
             typedef void (*Destructor)(void*, void*);
-            
+            constexpr static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
             struct DisposeHandle
             {
                 void* context = nullptr;
                 void* disposable = nullptr;
                 Destructor destructor = nullptr;
                 FenceRef fence{};
+                uint32_t next = INVALID_INDEX;
+                bool isAsync = false;
             };
 
             Disposer(size_t initialCapacity);
@@ -28,9 +34,31 @@ namespace PK
             }
 
             void Dispose(void* context, void* disposable, Destructor destructor, const FenceRef& releaseFence);
+            // Destructor is called in a batch on a background thread. It must not touch driver state.
+            void DisposeAsync(void* context, void* disposable, Destructor destructor, const FenceRef& releaseFence);
             void Prune();
 
         private:
-            HeapList<DisposeHandle> m_disposables;
+            struct FenceQueue
+            {
+                const void* context = nullptr;
+                FenceRef::WaitFunction waitFunction = nullptr;
+                uint64_t completedValue = 0ull;
+                uint32_t head = INVALID_INDEX;
+                uint32_t tail = INVALID_INDEX;
+            };
+
+            void Enqueue(void* context, void* disposable, Destructor destructor, const FenceRef& releaseFence, bool isAsync);
+            uint32_t GetQueueIndex(const FenceRef& fence);
+            DisposeHandle Dequeue(uint32_t queueIndex);
+
+            HeapArray<DisposeHandle> m_handles;
+            HeapList<FenceQueue> m_queues;
+            HeapArray<DisposeHandle> m_asyncBatch;
+            WorkerThread m_asyncWorker;
+            uint32_t m_handleCount = 0u;
+            uint32_t m_freeHandle = INVALID_INDEX;
+            uint32_t m_lastQueue = 0u;
+            uint32_t m_asyncCount = 0u;
     };
 }
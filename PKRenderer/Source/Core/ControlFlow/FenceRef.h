@@ -17,10 +17,13 @@ namespace PK
         };
 
         inline bool Invalidate() { m_waitFunction = nullptr; m_userdata = INVALID_USER_DATA; return true; }
-        inline bool IsValid() { return m_userdata != INVALID_USER_DATA && m_waitFunction != nullptr; }
+        inline bool IsValid() const { return m_userdata != INVALID_USER_DATA && m_waitFunction != nullptr; }
         inline bool Wait(uint64_t timeout) { return !IsValid() || m_waitFunction(m_context, m_userdata, timeout); }
         inline bool WaitInvalidate(uint64_t timeout) { return Wait(timeout) && Invalidate(); }
         inline bool IsComplete() { return Wait(0ull); }
+        constexpr const void* GetContext() const { return m_context; }
+        constexpr WaitFunction GetWaitFunction() const { return m_waitFunction; }
+        constexpr uint64_t GetUserdata() const { return m_userdata; }
         
         private:
             const void* m_context = nullptr;
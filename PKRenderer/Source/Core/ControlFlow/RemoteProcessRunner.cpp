@@ -1,20 +1,45 @@
 #include "PrecompiledHeader.h"
 #include "Core/CLI/Log.h"
 #include "Core/CLI/CVariableRegister.h"
+#include "Core/ControlFlow/Sequencer.h"
 #include "RemoteProcessRunner.h"
 
 namespace PK
 {
-    RemoteProcessRunner::RemoteProcessRunner()
+    RemoteProcessRunner::RemoteProcessRunner(Sequencer* sequencer) : m_sequencer(sequencer)
     {
         CVariableRegister::Create<CVariableFunc>("Application.Run.Executable", [this](const char* const* args, uint32_t count)
             {
                 ExecuteRemoteProcess(args, count);
             }, 
             "executable, arguments", 1u);
+
+        CVariableRegister::Create<CVariableFunc>("Application.Run.Cancel", [this](const char* const* args, uint32_t count)
+            {
+                if (count > 0u)
+                {
+                    CancelRemoteProcess((uint32_t)atoi(args[0]));
+                    return;
+                }
+
+                for (auto i = 0u; i < m_jobs.GetCount(); ++i)
+                {
+                    CancelRemoteProcess(m_jobs[i].id);
+                }
+            }, 
+            "job id, cancels all jobs if omitted", 0u);
+    }
+
+    RemoteProcessRunner::~RemoteProcessRunner()
+    {
+        for (auto i = 0u; i < m_jobs.GetCount(); ++i)
+        {
+            Platform::RemoteProcessTerminate(m_jobs[i].process);
+            Platform::RemoteProcessClose(m_jobs[i].process);
+        }
     }
 
-    void RemoteProcessRunner::ExecuteRemoteProcess(const char* const* args, uint32_t count)
+    uint32_t RemoteProcessRunner::ExecuteRemoteProcess(const char* const* args, uint32_t count)
     {
         FixedString1024 combined;
 
@@ -24,31 +49,121 @@ namespace PK
             combined.Append(' ');
         }
 
-        ExecuteRemoteProcess({ args[0], combined.c_str() });
+        return ExecuteRemoteProcess({ args[0], combined.c_str() });
+    }
+
+    uint32_t RemoteProcessRunner::ExecuteRemoteProcess(const RemoteProcessCommand& command)
+    {
+        auto process = Platform::RemoteProcessStart(command.executablePath, command.arguments);
+
+        if (process == nullptr)
+        {
+            PK_LOG_WARNING("ExecuteRemoteProcess: Failed to run %s %s", command.executablePath, command.arguments);
+            return INVALID_JOB;
+        }
+
+        auto job = m_jobs.Add();
+        job->process = process;
+        job->id = m_nextJobId++;
+        job->executablePath = FixedString256(strlen(command.executablePath), command.executablePath);
+        job->arguments = command.arguments ? FixedString512(strlen(command.arguments), command.arguments) : FixedString512();
+        PK_LOG_INFO("ExecuteRemoteProcess: [%u] %s %s", job->id, command.executablePath, command.arguments);
+        return job->id;
+    }
+
+    bool RemoteProcessRunner::CancelRemoteProcess(uint32_t jobId)
+    {
+        for (auto i = 0u; i < m_jobs.GetCount(); ++i)
+        {
+            if (m_jobs[i].id == jobId && !m_jobs[i].isCancelled)
+            {
+                // Completion is still reported from Poll once the process has exited.
+                Platform::RemoteProcessTerminate(m_jobs[i].process);
+                m_jobs[i].isCancelled = true;
+                return true;
+            }
+        }
+
+        return false;
     }
 
-    void RemoteProcessRunner::ExecuteRemoteProcess(const RemoteProcessCommand& command)
+    void RemoteProcessRunner::Poll()
     {
-        PK_LOG_NEWLINE();
-        PK_LOG_NEWLINE();
-        PK_LOG_INFO("ExecuteRemoteProcess: %s  %s", command.executablePath, command.arguments);
-        PK_LOG_INFO("----------REMOTE EXECUTE SCOPE----------");
-    
-        auto result = Platform::RemoteProcess(command.executablePath, command.arguments);
+        for (auto i = 0u; i < m_jobs.GetCount();)
+        {
+            auto job = &m_jobs[i];
+            auto exitCode = 0u;
+            auto isExited = Platform::RemoteProcessPoll(job->process, &exitCode);
+
+            // Poll before reading so that output written before exiting is not lost.
+            // Reads are bounded while running so that a chatty process can't stall the frame.
+            ReadOutput(job, isExited ? ~0u : 16u);
+
+            if (!isExited)
+            {
+                ++i;
+                continue;
+            }
+
+            FlushLine(job);
+            Platform::RemoteProcessClose(job->process);
+
+            if (job->isCancelled)
+            {
+                PK_LOG_INFO("ExecuteRemoteProcess: [%u] Cancelled %s", job->id, job->executablePath.c_str());
+            }
+            else if (exitCode != 0u)
+            {
+                PK_LOG_WARNING("ExecuteRemoteProcess: [%u] %s exited with code %u", job->id, job->executablePath.c_str(), exitCode);
+            }
+            else
+            {
+                PK_LOG_INFO("ExecuteRemoteProcess: [%u] Finished running %s", job->id, job->executablePath.c_str());
+            }
 
-        if (result != 0u)
+            // Steps might start new jobs. Copy the job out before raising the event.
+            Job finished = *job;
+            m_jobs.UnorderedRemoveAt(i);
+
+            RemoteProcessResult result{ finished.id, finished.executablePath.c_str(), finished.arguments.c_str(), exitCode, finished.isCancelled };
+            m_sequencer->Next<RemoteProcessResult*>(this, &result);
+        }
+    }
+
+    void RemoteProcessRunner::ReadOutput(Job* job, uint32_t maxReads)
+    {
+        char buffer[512];
+
+        for (auto reads = 0u; reads < maxReads; ++reads)
         {
-            PK_LOG_INFO("----------REMOTE EXECUTE SCOPE----------");
-            PK_LOG_INFO("ExecuteRemoteProcess: Failed to run %s %s", command.executablePath, command.arguments);
-            PK_LOG_INFO("Error code: %u", result);
-            PK_LOG_NEWLINE();
+            auto size = Platform::RemoteProcessRead(job->process, buffer, sizeof(buffer));
+
+            if (size == 0u)
+            {
+                break;
+            }
+
+            for (auto i = 0u; i < size; ++i)
+            {
+                if (buffer[i] == '\n' || job->line.Length() >= job->line.max_length)
+                {
+                    FlushLine(job);
+                }
+
+                if (buffer[i] != '\n' && buffer[i] != '\r')
+                {
+                    job->line.Append(buffer[i]);
+                }
+            }
         }
-        else
+    }
+
+    void RemoteProcessRunner::FlushLine(Job* job)
+    {
+        if (job->line.Length() > 0u)
         {
-            PK_LOG_NEWLINE();
-            PK_LOG_INFO("----------REMOTE EXECUTE SCOPE----------");
-            PK_LOG_INFO("ExecuteRemoteProcess: Finished running %s %s", command.executablePath, command.arguments);
-            PK_LOG_NEWLINE();
+            PK_LOG_INFO("[%u] %s", job->id, job->line.c_str());
+            job->line.Clear();
         }
     }
 }
@@ -1,25 +1,66 @@
 #pragma once
+#include "Core/Base/Containers/ArrayList.h"
+#include "Core/Base/Containers/FixedString.h"
+#include "Core/Base/NoCopy.h"
 #include "Core/ControlFlow/IStep.h"
 
 namespace PK
 {
+    struct Sequencer;
+
     struct RemoteProcessCommand
     {
         const char* executablePath;
         const char* arguments;
     };
 
-    class RemoteProcessRunner : public IStep<RemoteProcessCommand*>
+    // Raised through the sequencer when a job finishes or is cancelled.
+    // Results do not say which files a process wrote. Consumers should only reload what they saw change instead of every loaded asset.
+    struct RemoteProcessResult
+    {
+        uint32_t jobId;
+        const char* executablePath;
+        const char* arguments;
+        uint32_t exitCode;
+        bool isCancelled;
+    };
+
+    // Processes run in the background. Poll streams their output to the log & reports finished jobs.
+    class RemoteProcessRunner : public IStep<RemoteProcessCommand*>, public NoCopy
     {
     public:
-        RemoteProcessRunner();
+        constexpr static const uint32_t INVALID_JOB = 0u;
 
-        void ExecuteRemoteProcess(const char* const* args, uint32_t count);
+        RemoteProcessRunner(Sequencer* sequencer);
+        ~RemoteProcessRunner();
 
-        void ExecuteRemoteProcess(const RemoteProcessCommand& command);
+        uint32_t ExecuteRemoteProcess(const char* const* args, uint32_t count);
+
+        // Returns INVALID_JOB if the process could not be started.
+        uint32_t ExecuteRemoteProcess(const RemoteProcessCommand& command);
+
+        bool CancelRemoteProcess(uint32_t jobId);
+
+        void Poll();
 
         virtual void Step(RemoteProcessCommand* command) final { ExecuteRemoteProcess(*command); }
 
-        // @TODO add multithreading support!? Currently blocks application controlflow.
+    private:
+        struct Job
+        {
+            void* process = nullptr;
+            uint32_t id = INVALID_JOB;
+            bool isCancelled = false;
+            FixedString256 executablePath;
+            FixedString512 arguments;
+            FixedString512 line;
+        };
+
+        void ReadOutput(Job* job, uint32_t maxReads);
+        void FlushLine(Job* job);
+
+        Sequencer* m_sequencer = nullptr;
+        HeapList<Job> m_jobs;
+        uint32_t m_nextJobId = 1u;
     };
 }
@@ -2,7 +2,9 @@
 #include "Core/Base/Containers/ArrayList.h"
 #include "Core/Base/Containers/HashMap.h"
 #include "Core/Base/Types/Tuple.h"
+#include "Core/Base/MemoryTracker.h"
 #include "Core/ControlFlow/IStep.h"
+#include "Core/Timers/CPUProfiler.h"
 
 namespace PK
 {
@@ -12,9 +14,15 @@ namespace PK
         {
             uint64_t type = 0u;
             IBaseStep* step = nullptr;
+            const char* name = nullptr;
+            uint16_t memoryTag = 0u;
 
-            template<typename ... Args>
-            static Step Create(IStep<Args...>* s) { return { IStep<Args...>::GetStepTypeId(), static_cast<IStep<Args...>*>(s) }; }
+            template<typename ... Args, typename T>
+            static Step Create(T* s) 
+            { 
+                const char* typeName = pk_full_type_name<T>.str;
+                return { IStep<Args...>::GetStepTypeId(), static_cast<IStep<Args...>*>(s), typeName, MemoryTracker::RegisterTag(typeName) };
+            }
         };
 
         struct StepsKey
@@ -48,12 +56,18 @@ namespace PK
 
             for (auto i = 0u; i < view.count; ++i)
             {
+                PK_PROFILE_SCOPE(view.steps[i].name);
+                PK_MEMORY_TAG_SCOPE_ID(view.steps[i].memoryTag);
                 static_cast<TStep*>(view.steps[i].step)->Step(PK::Forward<Args>(args)...);
             }
         }
 
         template<typename ... Args>
-        void NextRoot(Args ... args) { Next(this, PK::Forward<Args>(args)...); }
+        void NextRoot(Args ... args) 
+        { 
+            PK_PROFILE_SCOPE(pk_full_type_name<IStep<Args...>>.str);
+            Next(this, PK::Forward<Args>(args)...); 
+        }
 
         template<typename T, typename ... Args>
         void NextEmplace(const void* engine, Args&& ... args)
@@ -0,0 +1,111 @@
+#include "PrecompiledHeader.h"
+#include "Core/CLI/Log.h"
+#include "WorkerPool.h"
+
+namespace PK
+{
+    WorkerPool::WorkerPool(uint32_t threadCount)
+    {
+        if (threadCount == 0u)
+        {
+            auto processorCount = Platform::GetProcessorCount();
+            threadCount = processorCount > 1u ? processorCount - 1u : 0u;
+        }
+
+        m_threadCount = threadCount < MAX_WORKERS - 1u ? threadCount : MAX_WORKERS - 1u;
+        m_isRunning = 1u;
+
+        if (m_threadCount > 0u)
+        {
+            m_semaphoreWake = Platform::CreateSemaphore(0u, m_threadCount);
+            m_semaphoreDone = Platform::CreateSemaphore(0u, 1u);
+        }
+
+        for (auto i = 1u; i <= m_threadCount; ++i)
+        {
+            m_workers[i].pool = this;
+            m_workers[i].index = i;
+            m_workers[i].thread = Platform::CreateThread(m_workers + i, WorkerMain);
+            PK_FATAL_ASSERT(m_workers[i].thread != nullptr, "Failed to create worker thread %u", i);
+        }
+
+        PK_LOG_VERBOSE("WorkerPool.Ctor: Created %u worker threads.", m_threadCount);
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        Platform::AtomicStore(&m_isRunning, 0u);
+
+        if (m_threadCount > 0u)
+        {
+            Platform::SignalSemaphore(m_semaphoreWake, m_threadCount);
+        }
+
+        for (auto i = 1u; i <= m_threadCount; ++i)
+        {
+            Platform::JoinThread(m_workers[i].thread);
+        }
+
+        Platform::DestroySemaphore(m_semaphoreWake);
+        Platform::DestroySemaphore(m_semaphoreDone);
+    }
+
+    void WorkerPool::ParallelFor(void* ctx, uint32_t count, Function function)
+    {
+        // Nothing to distribute. Avoid waking up workers.
+        if (m_threadCount == 0u || count <= 1u)
+        {
+            for (auto i = 0u; i < count; ++i)
+            {
+                function(ctx, i, 0u);
+            }
+
+            return;
+        }
+
+        PK_FATAL_ASSERT(Platform::InterlockedExchange(&m_isDispatching, 1u) == 0u, "WorkerPool.ParallelFor is not reentrant!");
+
+        m_context = ctx;
+        m_function = function;
+        m_count = count;
+        Platform::AtomicStore(&m_next, 0u);
+        Platform::AtomicStore(&m_pending, m_threadCount);
+        Platform::SignalSemaphore(m_semaphoreWake, m_threadCount);
+
+        Execute(0u);
+
+        Platform::WaitSemaphore(m_semaphoreDone);
+        Platform::AtomicStore(&m_isDispatching, 0u);
+    }
+
+    void WorkerPool::WorkerMain(void* ctx)
+    {
+        auto worker = reinterpret_cast<Worker*>(ctx);
+        auto pool = worker->pool;
+
+        while (true)
+        {
+            Platform::WaitSemaphore(pool->m_semaphoreWake);
+
+            if (Platform::AtomicRead(&pool->m_isRunning) == 0u)
+            {
+                return;
+            }
+
+            pool->Execute(worker->index);
+
+            if (Platform::InterlockedDecrement(&pool->m_pending) == 0u)
+            {
+                Platform::SignalSemaphore(pool->m_semaphoreDone, 1u);
+            }
+        }
+    }
+
+    void WorkerPool::Execute(uint32_t workerIndex)
+    {
+        for (auto index = Platform::InterlockedIncrement(&m_next) - 1u; index < m_count; index = Platform::InterlockedIncrement(&m_next) - 1u)
+        {
+            m_function(m_context, index, workerIndex);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "Core/Base/NoCopy.h"
+
+namespace PK
+{
+    // Persistent pool of worker threads for short fork join style workloads.
+    // The calling thread participates as worker 0. Not reentrant. Dispatch from one thread only.
+    class WorkerPool : public NoCopy
+    {
+        public:
+            constexpr static const uint32_t MAX_WORKERS = 32u;
+            typedef void (*Function)(void* ctx, uint32_t index, uint32_t workerIndex);
+
+            // Zero thread count uses the processor count minus the calling thread.
+            WorkerPool(uint32_t threadCount);
+            ~WorkerPool();
+
+            constexpr uint32_t GetWorkerCount() const { return m_threadCount + 1u; }
+
+            // Invokes function for every index in [0, count). Returns once all invocations have completed.
+            void ParallelFor(void* ctx, uint32_t count, Function function);
+
+            template<typename TFunc>
+            void ParallelFor(uint32_t count, const TFunc& function)
+            {
+                ParallelFor((void*)&function, count, [](void* ctx, uint32_t index, uint32_t workerIndex)
+                {
+                    (*reinterpret_cast<const TFunc*>(ctx))(index, workerIndex);
+                });
+            }
+
+        private:
+            struct Worker
+            {
+                WorkerPool* pool = nullptr;
+                void* thread = nullptr;
+                uint32_t index = 0u;
+            };
+
+            static void WorkerMain(void* ctx);
+            void Execute(uint32_t workerIndex);
+
+            Worker m_workers[MAX_WORKERS]{};
+            uint32_t m_threadCount = 0u;
+            void* m_semaphoreWake = nullptr;
+            void* m_semaphoreDone = nullptr;
+
+            void* m_context = nullptr;
+            Function m_function = nullptr;
+            uint32_t m_count = 0u;
+            volatile uint32_t m_next = 0u;
+            volatile uint32_t m_pending = 0u;
+            volatile uint32_t m_isRunning = 0u;
+            volatile uint32_t m_isDispatching = 0u;
+    };
+}
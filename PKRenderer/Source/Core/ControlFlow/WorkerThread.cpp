@@ -0,0 +1,60 @@
+#include "PrecompiledHeader.h"
+#include "Core/CLI/Log.h"
+#include "WorkerThread.h"
+
+namespace PK
+{
+    WorkerThread::WorkerThread()
+    {
+        m_isRunning = 1u;
+        m_semaphoreWake = Platform::CreateSemaphore(0u, 1u);
+        m_semaphoreDone = Platform::CreateSemaphore(0u, 1u);
+        m_thread = Platform::CreateThread(this, ThreadMain);
+        PK_FATAL_ASSERT(m_thread != nullptr, "Failed to create worker thread!");
+    }
+
+    WorkerThread::~WorkerThread()
+    {
+        Wait();
+        Platform::AtomicStore(&m_isRunning, 0u);
+        Platform::SignalSemaphore(m_semaphoreWake, 1u);
+        Platform::JoinThread(m_thread);
+        Platform::DestroySemaphore(m_semaphoreWake);
+        Platform::DestroySemaphore(m_semaphoreDone);
+    }
+
+    void WorkerThread::Dispatch(void* ctx, Function function)
+    {
+        PK_FATAL_ASSERT(Platform::InterlockedExchange(&m_isDispatched, 1u) == 0u, "WorkerThread.Dispatch called before waiting for the previous task!");
+        m_context = ctx;
+        m_function = function;
+        Platform::SignalSemaphore(m_semaphoreWake, 1u);
+    }
+
+    void WorkerThread::Wait()
+    {
+        if (Platform::AtomicRead(&m_isDispatched) != 0u)
+        {
+            Platform::WaitSemaphore(m_semaphoreDone);
+            Platform::AtomicStore(&m_isDispatched, 0u);
+        }
+    }
+
+    void WorkerThread::ThreadMain(void* ctx)
+    {
+        auto worker = reinterpret_cast<WorkerThread*>(ctx);
+
+        while (true)
+        {
+            Platform::WaitSemaphore(worker->m_semaphoreWake);
+
+            if (Platform::AtomicRead(&worker->m_isRunning) == 0u)
+            {
+                return;
+            }
+
+            worker->m_function(worker->m_context);
+            Platform::SignalSemaphore(worker->m_semaphoreDone, 1u);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include "Core/Base/NoCopy.h"
+
+namespace PK
+{
+    // Persistent thread for a single long running task that overlaps with work on the calling thread.
+    // Dispatch & Wait are called in pairs from one thread only. The task context must stay valid until Wait returns.
+    class WorkerThread : public NoCopy
+    {
+        public:
+            typedef void (*Function)(void* ctx);
+
+            WorkerThread();
+            ~WorkerThread();
+
+            void Dispatch(void* ctx, Function function);
+            void Wait();
+
+            template<typename TFunc>
+            void Dispatch(const TFunc& function)
+            {
+                Dispatch((void*)&function, [](void* ctx) { (*reinterpret_cast<const TFunc*>(ctx))(); });
+            }
+
+        private:
+            static void ThreadMain(void* ctx);
+
+            void* m_thread = nullptr;
+            void* m_semaphoreWake = nullptr;
+            void* m_semaphoreDone = nullptr;
+            void* m_context = nullptr;
+            Function m_function = nullptr;
+            volatile uint32_t m_isRunning = 0u;
+            volatile uint32_t m_isDispatched = 0u;
+    };
+}
@@ -52,9 +52,20 @@ namespace PK
 
             uint32_t groupIndex = 0u;
             uint32_t arrayCount = 0u;
+            size_t skipCount = 0ull;
+            size_t remaining = ~0ull;
             bool isValid = false;
 
             constexpr ViewIterator(EntityDatabase* db, Composition* data) noexcept : entityDb(db), viewdata(data), isValid(Next()) {}
+            constexpr ViewIterator(EntityDatabase* db, Composition* data, size_t first, size_t count) noexcept : 
+                entityDb(db), 
+                viewdata(data), 
+                skipCount(first), 
+                remaining(count), 
+                isValid(Next()) 
+            {
+            }
+
             TView& operator*() { return view; }
             TView* operator->() { return &view; }
             const TView& operator*() const { return view; }
@@ -65,6 +76,13 @@ namespace PK
 
             bool Next()
             {
+                if (remaining == 0ull)
+                {
+                    return false;
+                }
+
+                remaining--;
+
                 if (arrayCount)
                 {
                     ReflectFields(view, [](auto& field)
@@ -83,12 +101,16 @@ namespace PK
                     auto index = static_cast<const uint32_t*>(viewdata->buffer)[groupIndex++];
                     auto comp = &entityDb->m_compositions[index].value;
                     
-                    if (comp->count)
+                    // Skip whole groups until reaching the first element of a sliced range.
+                    if (comp->count > skipCount)
                     {
-                        arrayCount = comp->count - 1ull;
-                        view = entityDb->BindView<TView>(index, 0);
+                        arrayCount = (uint32_t)(comp->count - skipCount - 1ull);
+                        view = entityDb->BindView<TView>(index, (uint32_t)skipCount);
+                        skipCount = 0ull;
                         return true;
                     }
+
+                    skipCount -= comp->count;
                 }
 
                 return false;
@@ -100,6 +122,8 @@ namespace PK
         {
             EntityDatabase* entityDb;
             Composition* viewdata;
+            size_t first = 0ull;
+            size_t limit = ~0ull;
 
             size_t count() const
             {
@@ -112,10 +136,17 @@ namespace PK
                     count += comp->count;
                 }
 
-                return count;
+                count = count > first ? count - first : 0ull;
+                return count < limit ? count : limit;
+            }
+
+            // Sub range relative to this range. Used to split iteration across workers.
+            ViewRange Slice(size_t offset, size_t count) const 
+            { 
+                return { entityDb, viewdata, first + offset, count < limit - offset ? count : limit - offset }; 
             }
 
-            auto begin() const { return ViewIterator<TView>(entityDb, viewdata); }
+            auto begin() const { return ViewIterator<TView>(entityDb, viewdata, first, limit); }
             auto end() const { return typename ViewIterator<TView>::Sentinel{}; }
         };
 
@@ -39,9 +39,12 @@ namespace PK
         constexpr const CArguments& GetArguments() const { return m_arguments; }
         constexpr const char* GetName() const { return m_name.c_str(); }
         constexpr const char* GetWorkingDirectory() const { return m_workingDirectory.c_str(); }
+        constexpr int32_t GetExitCode() const { return m_exitCode; }
 
     protected:
         inline ServiceRegister* GetServices() { return &m_services; }
+        // Returned from main unless platform termination fails.
+        constexpr void SetExitCode(int32_t exitCode) { m_exitCode = exitCode; }
 
         virtual void Execute() = 0;
         
@@ -52,6 +55,7 @@ namespace PK
 
         Ref<ILogger> m_logger;
         ServiceRegister m_services;
+        int32_t m_exitCode = 0;
 
         friend int ::main(int argc, char** argv);
     };
@@ -0,0 +1,204 @@
+#include "PrecompiledHeader.h"
+#include "Batch.h"
+
+#if PK_MATH_SIMD_SSE2
+    #include <immintrin.h>
+    #if defined(__clang__) || defined(__GNUC__)
+        #include <cpuid.h>
+    #elif defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#endif
+
+namespace PK::math
+{
+    namespace batch_scalar
+    {
+        struct Lanes
+        {
+            using V = float;
+            constexpr static const uint32_t N = 1u;
+            static inline V Load(const float* p) { return *p; }
+            static inline void Store(float* p, V v) { *p = v; }
+            static inline V Set(float v) { return v; }
+            static inline V Add(V a, V b) { return a + b; }
+            static inline V Sub(V a, V b) { return a - b; }
+            static inline V Mul(V a, V b) { return a * b; }
+            static inline V Div(V a, V b) { return a / b; }
+            static inline V Neg(V a) { return -a; }
+            static inline V Abs(V a) { return ::fabsf(a); }
+        };
+
+        #include "BatchKernels.inl"
+    }
+
+    #if PK_MATH_SIMD_SSE2
+    namespace batch_sse
+    {
+        struct Lanes
+        {
+            using V = __m128;
+            constexpr static const uint32_t N = 4u;
+            static inline V Load(const float* p) { return _mm_loadu_ps(p); }
+            static inline void Store(float* p, V v) { _mm_storeu_ps(p, v); }
+            static inline V Set(float v) { return _mm_set1_ps(v); }
+            static inline V Add(V a, V b) { return _mm_add_ps(a, b); }
+            static inline V Sub(V a, V b) { return _mm_sub_ps(a, b); }
+            static inline V Mul(V a, V b) { return _mm_mul_ps(a, b); }
+            static inline V Div(V a, V b) { return _mm_div_ps(a, b); }
+            static inline V Neg(V a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+            static inline V Abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        };
+
+        #include "BatchKernels.inl"
+    }
+
+    PK_BATCH_TARGET_BEGIN("avx2")
+    namespace batch_avx2
+    {
+        struct Lanes
+        {
+            using V = __m256;
+            constexpr static const uint32_t N = 8u;
+            static inline V Load(const float* p) { return _mm256_loadu_ps(p); }
+            static inline void Store(float* p, V v) { _mm256_storeu_ps(p, v); }
+            static inline V Set(float v) { return _mm256_set1_ps(v); }
+            static inline V Add(V a, V b) { return _mm256_add_ps(a, b); }
+            static inline V Sub(V a, V b) { return _mm256_sub_ps(a, b); }
+            static inline V Mul(V a, V b) { return _mm256_mul_ps(a, b); }
+            static inline V Div(V a, V b) { return _mm256_div_ps(a, b); }
+            static inline V Neg(V a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+            static inline V Abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        };
+
+        #include "BatchKernels.inl"
+    }
+    PK_BATCH_TARGET_END()
+
+    PK_BATCH_TARGET_BEGIN("avx512f")
+    namespace batch_avx512
+    {
+        struct Lanes
+        {
+            using V = __m512;
+            constexpr static const uint32_t N = 16u;
+            static inline V Load(const float* p) { return _mm512_loadu_ps(p); }
+            static inline void Store(float* p, V v) { _mm512_storeu_ps(p, v); }
+            static inline V Set(float v) { return _mm512_set1_ps(v); }
+            static inline V Add(V a, V b) { return _mm512_add_ps(a, b); }
+            static inline V Sub(V a, V b) { return _mm512_sub_ps(a, b); }
+            static inline V Mul(V a, V b) { return _mm512_mul_ps(a, b); }
+            static inline V Div(V a, V b) { return _mm512_div_ps(a, b); }
+            static inline V Neg(V a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x80000000))); }
+            static inline V Abs(V a) { return _mm512_abs_ps(a); }
+        };
+
+        #include "BatchKernels.inl"
+    }
+    PK_BATCH_TARGET_END()
+    #endif
+
+    struct BatchKernels
+    {
+        uint32_t (*transformTRS3x4)(const trs_soa&, const float3x4_soa&, uint32_t, uint32_t);
+        uint32_t (*affineInverseTranspose)(const float3x4_soa&, const float3x4_soa&, uint32_t, uint32_t);
+        uint32_t (*mulAABB)(const float3x4_soa&, const aabb_soa&, const aabb_soa&, uint32_t, uint32_t);
+    };
+
+    #define PK_BATCH_KERNELS(ns) { ns::TransformTRS3x4Kernel, ns::AffineInverseTransposeKernel, ns::MulAABBKernel }
+
+    static const BatchKernels s_kernels[] =
+    {
+        PK_BATCH_KERNELS(batch_scalar),
+    #if PK_MATH_SIMD_SSE2
+        PK_BATCH_KERNELS(batch_sse),
+        PK_BATCH_KERNELS(batch_avx2),
+        PK_BATCH_KERNELS(batch_avx512),
+    #endif
+    };
+
+    #undef PK_BATCH_KERNELS
+
+    static simd_isa DetectSimdIsa()
+    {
+    #if PK_MATH_SIMD_SSE2
+        uint32_t regs[4]{};
+        uint64_t xcr0 = 0ull;
+
+        auto cpuid = [&regs](uint32_t leaf, uint32_t subleaf)
+        {
+        #if defined(__clang__) || defined(__GNUC__)
+            __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+        #else
+            __cpuidex(reinterpret_cast<int*>(regs), (int)leaf, (int)subleaf);
+        #endif
+        };
+
+        cpuid(0u, 0u);
+        const auto maxLeaf = regs[0];
+
+        cpuid(1u, 0u);
+        const auto hasOsxsave = (regs[2] & (1u << 27u)) != 0u;
+        const auto hasAvx = (regs[2] & (1u << 28u)) != 0u;
+
+        if (!hasOsxsave || !hasAvx || maxLeaf < 7u)
+        {
+            return simd_isa::sse;
+        }
+
+        // Os must save the ymm & zmm registers for the wider sets to be usable.
+    #if defined(__clang__) || defined(__GNUC__)
+        uint32_t xcr0Low = 0u;
+        uint32_t xcr0High = 0u;
+        __asm__ volatile("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0u));
+        xcr0 = ((uint64_t)xcr0High << 32ull) | xcr0Low;
+    #else
+        xcr0 = _xgetbv(0u);
+    #endif
+
+        cpuid(7u, 0u);
+        const auto hasAvx2 = (regs[1] & (1u << 5u)) != 0u && (xcr0 & 0x6ull) == 0x6ull;
+        const auto hasAvx512 = (regs[1] & (1u << 16u)) != 0u && (xcr0 & 0xE6ull) == 0xE6ull;
+        return hasAvx512 ? simd_isa::avx512 : hasAvx2 ? simd_isa::avx2 : simd_isa::sse;
+    #else
+        return simd_isa::scalar;
+    #endif
+    }
+
+    static simd_isa s_simdIsaSupported = DetectSimdIsa();
+    static simd_isa s_simdIsa = s_simdIsaSupported;
+
+    simd_isa getSimdIsa() { return s_simdIsa; }
+    simd_isa getSimdIsaSupported() { return s_simdIsaSupported; }
+    void setSimdIsa(simd_isa isa) { s_simdIsa = (uint32_t)isa < (uint32_t)s_simdIsaSupported ? isa : s_simdIsaSupported; }
+
+    const char* getSimdIsaName(simd_isa isa)
+    {
+        switch (isa)
+        {
+            case simd_isa::sse: return "SSE";
+            case simd_isa::avx2: return "AVX2";
+            case simd_isa::avx512: return "AVX-512";
+            default: return "Scalar";
+        }
+    }
+
+    // Wide kernels leave a tail that is processed by the scalar kernels.
+    void transformTRS3x4(const trs_soa& src, const float3x4_soa& dst, uint32_t count)
+    {
+        auto first = s_kernels[(uint32_t)s_simdIsa].transformTRS3x4(src, dst, 0u, count);
+        batch_scalar::TransformTRS3x4Kernel(src, dst, first, count);
+    }
+
+    void affineInverseTranspose(const float3x4_soa& src, const float3x4_soa& dst, uint32_t count)
+    {
+        auto first = s_kernels[(uint32_t)s_simdIsa].affineInverseTranspose(src, dst, 0u, count);
+        batch_scalar::AffineInverseTransposeKernel(src, dst, first, count);
+    }
+
+    void mul(const float3x4_soa& matrices, const aabb_soa& src, const aabb_soa& dst, uint32_t count)
+    {
+        auto first = s_kernels[(uint32_t)s_simdIsa].mulAABB(matrices, src, dst, 0u, count);
+        batch_scalar::MulAABBKernel(matrices, src, dst, first, count);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "Forward.h"
+
+#define PK_BATCH_STRINGIFY(x) #x
+
+// Wider instruction sets are enabled per region so that the rest of the binary keeps the baseline target.
+// Functions in these regions may only be called when getSimdIsa reports the instruction set.
+#if defined(__clang__)
+    #define PK_BATCH_TARGET_BEGIN(isa) _Pragma(PK_BATCH_STRINGIFY(clang attribute push(__attribute__((target(isa))), apply_to = function)))
+    #define PK_BATCH_TARGET_END() _Pragma("clang attribute pop")
+#elif defined(__GNUC__)
+    #define PK_BATCH_TARGET_BEGIN(isa) _Pragma("GCC push_options") _Pragma(PK_BATCH_STRINGIFY(GCC target(isa)))
+    #define PK_BATCH_TARGET_END() _Pragma("GCC pop_options")
+#else
+    #define PK_BATCH_TARGET_BEGIN(isa)
+    #define PK_BATCH_TARGET_END()
+#endif
+
+namespace PK::math
+{
+    // Struct of arrays views for batched transform math.
+    // Each element points to an array of count floats.
+    struct trs_soa
+    {
+        const float* position[3];
+        const float* rotation[4];
+        const float* scale[3];
+    };
+
+    // Elements follow the memory order of the aos matrix type.
+    struct float3x4_soa
+    {
+        float* elements[12];
+    };
+
+    struct aabb_soa
+    {
+        float* min[3];
+        float* max[3];
+    };
+
+    // Instruction set used by the batch functions. Detected through cpuid on first use.
+    enum class simd_isa : uint32_t
+    {
+        scalar,
+        sse,
+        avx2,
+        avx512
+    };
+
+    simd_isa getSimdIsa();
+    simd_isa getSimdIsaSupported();
+    // Selects a lower instruction set than the supported one. Used for validating the kernels against each other.
+    void setSimdIsa(simd_isa isa);
+    const char* getSimdIsaName(simd_isa isa);
+
+    // Batched equivalents of transformTRS3x4, affineInverseTranspose & mul(float3x4, AABB).
+    // Results match the scalar paths within floating point contraction differences.
+    void transformTRS3x4(const trs_soa& src, const float3x4_soa& dst, uint32_t count);
+    // Outputs the xyz of each column of the 4x4 result. The w row is always (0,0,0,1).
+    void affineInverseTranspose(const float3x4_soa& src, const float3x4_soa& dst, uint32_t count);
+    void mul(const float3x4_soa& matrices, const aabb_soa& src, const aabb_soa& dst, uint32_t count);
+}
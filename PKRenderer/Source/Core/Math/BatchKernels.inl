@@ -0,0 +1,134 @@
+// Batch kernel bodies. Included once per instruction set by Batch.cpp with a matching Lanes type in scope.
+// Kernels process whole lane groups starting from first & return the index of the first unprocessed element.
+// Operation order mirrors the scalar functions in Transform.h & Bounds.h.
+
+static uint32_t TransformTRS3x4Kernel(const trs_soa& src, const float3x4_soa& dst, uint32_t first, uint32_t count)
+{
+    const auto one = Lanes::Set(1.0f);
+    const auto two = Lanes::Set(2.0f);
+    auto i = first;
+
+    for (; i + Lanes::N <= count; i += Lanes::N)
+    {
+        const auto qx = Lanes::Load(src.rotation[0] + i);
+        const auto qy = Lanes::Load(src.rotation[1] + i);
+        const auto qz = Lanes::Load(src.rotation[2] + i);
+        const auto qw = Lanes::Load(src.rotation[3] + i);
+        const auto sx = Lanes::Load(src.scale[0] + i);
+        const auto sy = Lanes::Load(src.scale[1] + i);
+        const auto sz = Lanes::Load(src.scale[2] + i);
+        const auto qxx = Lanes::Mul(qx, qx);
+        const auto qyy = Lanes::Mul(qy, qy);
+        const auto qzz = Lanes::Mul(qz, qz);
+        const auto qxz = Lanes::Mul(qx, qz);
+        const auto qxy = Lanes::Mul(qx, qy);
+        const auto qyz = Lanes::Mul(qy, qz);
+        const auto qwx = Lanes::Mul(qw, qx);
+        const auto qwy = Lanes::Mul(qw, qy);
+        const auto qwz = Lanes::Mul(qw, qz);
+        Lanes::Store(dst.elements[0] + i, Lanes::Mul(sx, Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(qyy, qzz)))));
+        Lanes::Store(dst.elements[4] + i, Lanes::Mul(sx, Lanes::Mul(two, Lanes::Add(qxy, qwz))));
+        Lanes::Store(dst.elements[8] + i, Lanes::Mul(sx, Lanes::Mul(two, Lanes::Sub(qxz, qwy))));
+        Lanes::Store(dst.elements[1] + i, Lanes::Mul(sy, Lanes::Mul(two, Lanes::Sub(qxy, qwz))));
+        Lanes::Store(dst.elements[5] + i, Lanes::Mul(sy, Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(qxx, qzz)))));
+        Lanes::Store(dst.elements[9] + i, Lanes::Mul(sy, Lanes::Mul(two, Lanes::Add(qyz, qwx))));
+        Lanes::Store(dst.elements[2] + i, Lanes::Mul(sz, Lanes::Mul(two, Lanes::Add(qxz, qwy))));
+        Lanes::Store(dst.elements[6] + i, Lanes::Mul(sz, Lanes::Mul(two, Lanes::Sub(qyz, qwx))));
+        Lanes::Store(dst.elements[10] + i, Lanes::Mul(sz, Lanes::Sub(one, Lanes::Mul(two, Lanes::Add(qxx, qyy)))));
+        Lanes::Store(dst.elements[3] + i, Lanes::Load(src.position[0] + i));
+        Lanes::Store(dst.elements[7] + i, Lanes::Load(src.position[1] + i));
+        Lanes::Store(dst.elements[11] + i, Lanes::Load(src.position[2] + i));
+    }
+
+    return i;
+}
+
+static uint32_t AffineInverseTransposeKernel(const float3x4_soa& src, const float3x4_soa& dst, uint32_t first, uint32_t count)
+{
+    const auto one = Lanes::Set(1.0f);
+    auto i = first;
+
+    for (; i + Lanes::N <= count; i += Lanes::N)
+    {
+        const auto m0x = Lanes::Load(src.elements[0] + i);
+        const auto m0y = Lanes::Load(src.elements[1] + i);
+        const auto m0z = Lanes::Load(src.elements[2] + i);
+        const auto m0w = Lanes::Load(src.elements[3] + i);
+        const auto m1x = Lanes::Load(src.elements[4] + i);
+        const auto m1y = Lanes::Load(src.elements[5] + i);
+        const auto m1z = Lanes::Load(src.elements[6] + i);
+        const auto m1w = Lanes::Load(src.elements[7] + i);
+        const auto m2x = Lanes::Load(src.elements[8] + i);
+        const auto m2y = Lanes::Load(src.elements[9] + i);
+        const auto m2z = Lanes::Load(src.elements[10] + i);
+        const auto m2w = Lanes::Load(src.elements[11] + i);
+
+        const auto c0 = Lanes::Sub(Lanes::Mul(m1y, m2z), Lanes::Mul(m1z, m2y));
+        const auto c1 = Lanes::Sub(Lanes::Mul(m1x, m2z), Lanes::Mul(m1z, m2x));
+        const auto c2 = Lanes::Sub(Lanes::Mul(m1x, m2y), Lanes::Mul(m1y, m2x));
+        const auto det = Lanes::Add(Lanes::Sub(Lanes::Mul(m0x, c0), Lanes::Mul(m0y, c1)), Lanes::Mul(m0z, c2));
+        const auto invd = Lanes::Div(one, det);
+
+        const auto i0x = Lanes::Mul(c0, invd);
+        const auto i1x = Lanes::Mul(Lanes::Neg(Lanes::Sub(Lanes::Mul(m0y, m2z), Lanes::Mul(m0z, m2y))), invd);
+        const auto i2x = Lanes::Mul(Lanes::Sub(Lanes::Mul(m0y, m1z), Lanes::Mul(m0z, m1y)), invd);
+        const auto i0y = Lanes::Mul(Lanes::Neg(c1), invd);
+        const auto i1y = Lanes::Mul(Lanes::Sub(Lanes::Mul(m0x, m2z), Lanes::Mul(m0z, m2x)), invd);
+        const auto i2y = Lanes::Mul(Lanes::Neg(Lanes::Sub(Lanes::Mul(m0x, m1z), Lanes::Mul(m0z, m1x))), invd);
+        const auto i0z = Lanes::Mul(c2, invd);
+        const auto i1z = Lanes::Mul(Lanes::Neg(Lanes::Sub(Lanes::Mul(m0x, m2y), Lanes::Mul(m0y, m2x))), invd);
+        const auto i2z = Lanes::Mul(Lanes::Sub(Lanes::Mul(m0x, m1y), Lanes::Mul(m0y, m1x)), invd);
+
+        Lanes::Store(dst.elements[0] + i, i0x);
+        Lanes::Store(dst.elements[1] + i, i0y);
+        Lanes::Store(dst.elements[2] + i, i0z);
+        Lanes::Store(dst.elements[3] + i, i1x);
+        Lanes::Store(dst.elements[4] + i, i1y);
+        Lanes::Store(dst.elements[5] + i, i1z);
+        Lanes::Store(dst.elements[6] + i, i2x);
+        Lanes::Store(dst.elements[7] + i, i2y);
+        Lanes::Store(dst.elements[8] + i, i2z);
+        Lanes::Store(dst.elements[9] + i, Lanes::Neg(Lanes::Add(Lanes::Add(Lanes::Mul(i0x, m0w), Lanes::Mul(i1x, m1w)), Lanes::Mul(i2x, m2w))));
+        Lanes::Store(dst.elements[10] + i, Lanes::Neg(Lanes::Add(Lanes::Add(Lanes::Mul(i0y, m0w), Lanes::Mul(i1y, m1w)), Lanes::Mul(i2y, m2w))));
+        Lanes::Store(dst.elements[11] + i, Lanes::Neg(Lanes::Add(Lanes::Add(Lanes::Mul(i0z, m0w), Lanes::Mul(i1z, m1w)), Lanes::Mul(i2z, m2w))));
+    }
+
+    return i;
+}
+
+static uint32_t MulAABBKernel(const float3x4_soa& matrices, const aabb_soa& src, const aabb_soa& dst, uint32_t first, uint32_t count)
+{
+    const auto half = Lanes::Set(0.5f);
+    auto i = first;
+
+    for (; i + Lanes::N <= count; i += Lanes::N)
+    {
+        Lanes::V center[3];
+        Lanes::V extents[3];
+
+        for (auto j = 0u; j < 3u; ++j)
+        {
+            const auto bmin = Lanes::Load(src.min[j] + i);
+            const auto bmax = Lanes::Load(src.max[j] + i);
+            extents[j] = Lanes::Mul(Lanes::Sub(bmax, bmin), half);
+            center[j] = Lanes::Add(bmin, extents[j]);
+        }
+
+        for (auto r = 0u; r < 3u; ++r)
+        {
+            auto c = Lanes::Mul(center[0], Lanes::Load(matrices.elements[r * 4u + 0u] + i));
+            c = Lanes::Add(c, Lanes::Mul(center[1], Lanes::Load(matrices.elements[r * 4u + 1u] + i)));
+            c = Lanes::Add(c, Lanes::Mul(center[2], Lanes::Load(matrices.elements[r * 4u + 2u] + i)));
+            c = Lanes::Add(c, Lanes::Load(matrices.elements[r * 4u + 3u] + i));
+
+            auto e = Lanes::Mul(Lanes::Abs(Lanes::Load(matrices.elements[0u * 4u + r] + i)), extents[0]);
+            e = Lanes::Add(e, Lanes::Mul(Lanes::Abs(Lanes::Load(matrices.elements[1u * 4u + r] + i)), extents[1]));
+            e = Lanes::Add(e, Lanes::Mul(Lanes::Abs(Lanes::Load(matrices.elements[2u * 4u + r] + i)), extents[2]));
+
+            Lanes::Store(dst.min[r] + i, Lanes::Sub(c, e));
+            Lanes::Store(dst.max[r] + i, Lanes::Add(c, e));
+        }
+    }
+
+    return i;
+}
@@ -13,15 +13,26 @@ namespace PK::math
         return orthographic(aabb.min.x + paddingLD.x, aabb.max.x + paddingRU.x, aabb.min.y + paddingLD.y, aabb.max.y + paddingRU.y, aabb.min.z + paddingLD.z, aabb.max.z + paddingRU.z) * worldToLocal;
     }
 
-    template<typename T> vector<T,2> octawrap(const vector<T,2>& v) { return (static_cast<T>(1) - abs(v.yx())) * sign(v); }
+    // Unlike sign this maps zero to one. Otherwise -Y axis aligned directions wrap to the +Y pole. Matches OctaWrap in Encoding.glsl.
+    template<typename T> vector<T,2> octawrap(const vector<T,2>& v) { return (static_cast<T>(1) - abs(v.yx())) * vector<T,2>(v.x >= static_cast<T>(0) ? static_cast<T>(1) : static_cast<T>(-1), v.y >= static_cast<T>(0) ? static_cast<T>(1) : static_cast<T>(-1)); }
 
     template<typename T> vector<T,2> octaencode(const vector<T,3>& n)
     {
         auto v = n;
         v /= (abs(v.x) + abs(v.y) + abs(v.z));
-        v.xz = v.y >= static_cast<T>(0) ? v.xz : octawrap(v.xz);
-        v.xz = v.xz * static_cast<T>(0.5) + static_cast<T>(0.5);
-        return v.xz;
+        v.xz = v.y >= static_cast<T>(0) ? v.xz() : octawrap(v.xz());
+        v.xz = v.xz() * static_cast<T>(0.5) + static_cast<T>(0.5);
+        return v.xz();
+    }
+
+    template<typename T> vector<T,3> octadecode(const vector<T,2>& uv)
+    {
+        const auto f = uv * static_cast<T>(2) - static_cast<T>(1);
+        auto n = vector<T,3>(f.x, static_cast<T>(1) - abs(f.x) - abs(f.y), f.y);
+        const auto t = max(-n.y, static_cast<T>(0));
+        n.x += n.x >= static_cast<T>(0) ? -t : t;
+        n.z += n.z >= static_cast<T>(0) ? -t : t;
+        return normalize(n);
     }
 
     template<typename T> vector<T,3> triangleNormal(const T* p0, const T* p1, const T* p2, bool& outIsValid)
@@ -51,7 +51,7 @@ namespace PK::math
     inline int32_t randomInt() { return static_cast<int32_t>(randomUint()); }
     inline int64_t randomLong() { return static_cast<int64_t>(randomUlong()); }
     inline float randomFloat() { return asfloat((randomUint() & 0x007fffffu) | 0x3f800000u) - 1.0f; }
-    inline double randomDouble() { return asdouble((randomUlong() & 0x000fffffffffffffull) | 0x3ff0000000000000ull) - 1.0; }
+    inline double randomDouble() { return asdouble(static_cast<uint64_t>((randomUlong() & 0x000fffffffffffffull) | 0x3ff0000000000000ull)) - 1.0; }
 
     inline vector<uint8_t,2> randomByte2() { return vector<uint8_t,2>(randomByte(), randomByte()); }
     inline vector<uint8_t,3> randomByte3() { return vector<uint8_t,3>(randomByte(), randomByte(), randomByte()); }
@@ -4,6 +4,13 @@
 #include <stdint.h>
 #include <float.h>
 
+// int64_t is long on LP64 linux. The long overloads would redefine the int64_t ones there.
+#if defined(__linux__) && defined(__LP64__)
+    #define PK_MATH_LONG_IS_INT64 1
+#else
+    #define PK_MATH_LONG_IS_INT64 0
+#endif
+
 namespace PK::math
 {
     inline bool isnan(float v) { return ::isnan(v); }
@@ -25,7 +32,7 @@ namespace PK::math
     constexpr int64_t asint(double v) { union { double in; int64_t out; } u{ v }; return u.out; }
     constexpr uint64_t asuint(double v) { union { double in; uint64_t out; } u{ v }; return u.out; }
 
-#if defined(__clang__)
+#if defined(__clang__) || defined(__GNUC__)
     inline uint32_t bitcount(uint32_t v) { return static_cast<uint32_t>(__builtin_popcount(v)); }
     inline uint32_t bitcount(uint64_t v) { return static_cast<uint32_t>(__builtin_popcountll(v)); }
 #else
@@ -85,7 +92,7 @@ namespace PK::math
 #endif
 
     constexpr int8_t packSnorm8(float v) { return int8_t(((v >= -1) ? (v <= +1) ? v : +1 : -1) * 0x7F + (v >= 0 ? 0.5f : -0.5f)); }
-    constexpr int8_t packSnorm16(float v) { return int8_t(((v >= -1) ? (v <= +1) ? v : +1 : -1) * 0x7FFF + (v >= 0 ? 0.5f : -0.5f)); }
+    constexpr int16_t packSnorm16(float v) { return int16_t(((v >= -1) ? (v <= +1) ? v : +1 : -1) * 0x7FFF + (v >= 0 ? 0.5f : -0.5f)); }
     constexpr float unpackSnorm8(int8_t v) { return v / (float)0x7F; }
     constexpr float unpackSnorm16(int16_t v) { return v / (float)0x7FFF; }
 
@@ -150,8 +157,8 @@ namespace PK::math
     
     inline float log2(float v) { return ::log2f(v); }
     inline double log2(double v) { return ::log2(v); }
-#if defined(__clang__)
-    inline uint32_t log2(uint32_t v) { uint32_t y; asm("\tbsr %1, %0\n" : "=r"(y) : "r" (v)); return y; }
+#if defined(__clang__) || defined(__GNUC__)
+    inline uint32_t log2(uint32_t v) { return static_cast<uint32_t>(31 - __builtin_clz(v)); }
     inline uint64_t log2(uint64_t v) { return static_cast<uint64_t>(63 - __builtin_clzll(v)); }
 #else
     inline uint32_t log2(uint32_t v) { auto index = 0ul; return _BitScanReverse(&index, v) ? static_cast<uint32_t>(index) : 0u; }
@@ -181,7 +188,9 @@ namespace PK::math
     constexpr int16_t sign(int16_t v) { return (v > 0) - (v < 0); }
     constexpr int32_t sign(int32_t v) { return (v > 0) - (v < 0); }
     constexpr int64_t sign(int64_t v) { return (v > 0ll) - (v < 0ll); }
+#if !PK_MATH_LONG_IS_INT64
     constexpr long sign(long v) { return (v > 0l) - (v < 0l); }
+#endif
     
     inline float abs(float v) { return ::fabsf(v); }
     inline double abs(double v) { return ::fabs(v); }
@@ -189,7 +198,9 @@ namespace PK::math
     constexpr int16_t abs(int16_t v) { return v < 0 ? -v : v; }
     inline int32_t abs(int32_t v) { return ::abs(v); }
     inline int64_t abs(int64_t v) { return ::llabs(v); }
+#if !PK_MATH_LONG_IS_INT64
     inline long abs(long v) { return ::labs(v); }
+#endif
     
     inline float round(float v) { return ::roundf(v); }
     inline double round(double v) { return ::round(v); }
@@ -230,8 +241,10 @@ namespace PK::math
     constexpr uint16_t min(uint16_t a, uint16_t b) { return a < b ? a : b; }
     constexpr uint32_t min(uint32_t a, uint32_t b) { return a < b ? a : b; }
     constexpr uint64_t min(uint64_t a, uint64_t b) { return a < b ? a : b; }
+#if !PK_MATH_LONG_IS_INT64
     constexpr unsigned long min(unsigned long a, unsigned long b) { return a < b ? a : b; }
     constexpr long min(long a, long b) { return a < b ? a : b; }
+#endif
 
     inline float max(float a, float b) { return ::fmaxf(a, b); }
     inline double max(double a, double b) { return ::fmax(a, b); }
@@ -243,8 +256,10 @@ namespace PK::math
     constexpr uint16_t max(uint16_t a, uint16_t b) { return a > b ? a : b; }
     constexpr uint32_t max(uint32_t a, uint32_t b) { return a > b ? a : b; }
     constexpr uint64_t max(uint64_t a, uint64_t b) { return a > b ? a : b; }
+#if !PK_MATH_LONG_IS_INT64
     constexpr unsigned long max(unsigned long a, unsigned long b) { return a > b ? a : b; }
     constexpr long max(long a, long b) { return a > b ? a : b; }
+#endif
 
     inline float clamp(float v, float mi, float ma) { return min(max(v, mi), ma); }
     inline double clamp(double v, double mi, double ma) { return min(max(v, mi), ma); }
@@ -256,8 +271,10 @@ namespace PK::math
     inline uint16_t clamp(uint16_t v, uint16_t mi, uint16_t ma) { return min(max(v, mi), ma); }
     inline uint32_t clamp(uint32_t v, uint32_t mi, uint32_t ma) { return min(max(v, mi), ma); }
     inline uint64_t clamp(uint64_t v, uint64_t mi, uint64_t ma) { return min(max(v, mi), ma); }
+#if !PK_MATH_LONG_IS_INT64
     inline unsigned long clamp(unsigned long v, unsigned long mi, unsigned long ma) { return min(max(v, mi), ma); }
     inline long clamp(long v, long mi, long ma) { return min(max(v, mi), ma); }
+#endif
 
     inline float saturate(float v) { return min(max(v, 0.0f), 1.0f); }
     inline double saturate(double v) { return min(max(v, 0.0), 1.0); }
@@ -0,0 +1,1049 @@
+#include "PrecompiledHeader.h"
+
+#if PK_PLATFORM_LINUX
+#include <errno.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <fnmatch.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <dirent.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/sysinfo.h>
+#include <sys/wait.h>
+#include <sys/inotify.h>
+#include "Core/Base/Containers/ArrayList.h"
+#include "Core/Base/Containers/FixedString.h"
+#include "Core/Base/MemoryTracker.h"
+#include "Core/Input/InputDevice.h"
+#include "LinuxWindow.h"
+
+#if PK_PLATFORM_X64
+#include <x86intrin.h>
+#endif
+
+extern char** environ;
+
+namespace PK
+{
+    static int64_t s_programMemoryExclusive = 0ll;
+    static volatile sig_atomic_t s_terminateSignal = 0;
+
+    // Blocks at least this large are mapped directly so that freeing them returns the pages to the os.
+    constexpr static size_t LINUX_MAPPED_ALLOCATION_SIZE = 1ull << 20ull;
+    constexpr static int2 LINUX_HEADLESS_DESKTOP_SIZE = { 1920, 1080 };
+
+    struct LinuxResources
+    {
+        void* process = nullptr;
+        InputHandler* inputHandler = nullptr;
+        LinuxWindow* windowHead = nullptr;
+        char* clipboard = nullptr;
+        size_t clipboardSize = 0ull;
+        bool isConsoleColored = false;
+    };
+
+    // Stored in front of every aligned allocation.
+    struct alignas(16) LinuxAllocationHeader
+    {
+        size_t size;
+        uint32_t offset;
+        uint32_t isMapped;
+    };
+
+    // Allocations are made before Initialize, resources included. Query the page size independently of them.
+    static size_t LinuxGetPageSize()
+    {
+        static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        return pageSize;
+    }
+
+    static void OnTerminateSignal(int)
+    {
+        s_terminateSignal = 1;
+    }
+
+    int LinuxPlatform::Initialize()
+    {
+        if (resources)
+        {
+            return -1;
+        }
+
+        resources = Memory::New<LinuxResources>();
+
+        if (!resources)
+        {
+            return -1;
+        }
+
+        resources->process = dlopen(nullptr, RTLD_NOW);
+        resources->isConsoleColored = isatty(STDOUT_FILENO) != 0;
+
+        // There is no window to close. Treat interrupts as a close request so that the app can shut down normally.
+        struct sigaction action {};
+        action.sa_handler = OnTerminateSignal;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        return 0;
+    }
+
+    int LinuxPlatform::Terminate()
+    {
+        auto head = resources->windowHead;
+
+        while (head)
+        {
+            resources->windowHead = head->GetNext();
+
+            if (resources->inputHandler)
+            {
+                resources->inputHandler->InputHandler_OnDisconnect(head);
+            }
+
+            Memory::Delete(head);
+            head = resources->windowHead;
+        }
+
+        signal(SIGINT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+
+        if (resources->process)
+        {
+            dlclose(resources->process);
+        }
+
+        Memory::Free(resources->clipboard);
+        Memory::Delete(resources);
+        resources = nullptr;
+        return 0;
+    }
+
+    PK_ALLOC_CALL void* LinuxPlatform::AllocateAligned(size_t size, size_t alignment) noexcept
+    {
+#if PK_MEMORY_TRACKING
+        auto blockSize = size + MemoryTracker::GetHeaderSize(alignment);
+#else
+        auto blockSize = size;
+#endif
+
+        auto blockAlignment = alignment < alignof(LinuxAllocationHeader) ? alignof(LinuxAllocationHeader) : alignment;
+        auto offset = (sizeof(LinuxAllocationHeader) + blockAlignment - 1ull) & ~(blockAlignment - 1ull);
+        auto isMapped = blockSize + offset >= LINUX_MAPPED_ALLOCATION_SIZE && blockAlignment <= LinuxGetPageSize();
+        void* base = nullptr;
+
+        if (isMapped)
+        {
+            base = mmap(nullptr, blockSize + offset, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            base = base != MAP_FAILED ? base : nullptr;
+        }
+        else if (posix_memalign(&base, blockAlignment, blockSize + offset) != 0)
+        {
+            base = nullptr;
+        }
+
+        if (!base)
+        {
+            Platform::FatalExit("Out of memory");
+        }
+
+        auto ptr = reinterpret_cast<char*>(base) + offset;
+        auto header = reinterpret_cast<LinuxAllocationHeader*>(ptr) - 1;
+        header->size = blockSize;
+        header->offset = (uint32_t)offset;
+        header->isMapped = isMapped ? 1u : 0u;
+
+        InterlockedAdd64(&s_programMemoryExclusive, (int64_t)size);
+
+#if PK_MEMORY_TRACKING
+        return MemoryTracker::TrackAllocation(ptr, size, alignment);
+#else
+        return ptr;
+#endif
+    }
+
+    void LinuxPlatform::FreeAligned(void* block)
+    {
+        if (block)
+        {
+#if PK_MEMORY_TRACKING
+            size_t size = 0ull;
+            block = MemoryTracker::TrackFree(block, &size);
+            auto header = reinterpret_cast<LinuxAllocationHeader*>(block) - 1;
+#else
+            auto header = reinterpret_cast<LinuxAllocationHeader*>(block) - 1;
+            auto size = header->size;
+#endif
+            InterlockedAdd64(&s_programMemoryExclusive, -(int64_t)size);
+
+            auto base = reinterpret_cast<char*>(block) - header->offset;
+
+            if (header->isMapped)
+            {
+                munmap(base, header->size + header->offset);
+            }
+            else
+            {
+                free(base);
+            }
+        }
+    }
+
+    PlatformMemoryInfo LinuxPlatform::GetMemoryInfo()
+    {
+        struct sysinfo system {};
+        ::sysinfo(&system);
+
+        // Second field of statm is the resident set size in pages.
+        size_t pagesTotal = 0ull;
+        size_t pagesResident = 0ull;
+        auto statm = fopen("/proc/self/statm", "r");
+
+        if (statm)
+        {
+            if (fscanf(statm, "%zu %zu", &pagesTotal, &pagesResident) != 2)
+            {
+                pagesResident = 0ull;
+            }
+
+            fclose(statm);
+        }
+
+        PlatformMemoryInfo info{};
+        info.physicalMemoryTotal = (size_t)system.totalram * system.mem_unit;
+        info.physicalMemoryUsed = (size_t)(system.totalram - system.freeram) * system.mem_unit;
+        info.virtualMemoryTotal = (size_t)(system.totalram + system.totalswap) * system.mem_unit;
+        info.virtualMemoryUsed = (size_t)((system.totalram - system.freeram) + (system.totalswap - system.freeswap)) * system.mem_unit;
+        info.programMemoryUsedInclusive = pagesResident * LinuxGetPageSize();
+        info.programMemoryUsedExclusive = s_programMemoryExclusive;
+        return info;
+    }
+
+
+    void LinuxPlatform::PollEvents(bool wait)
+    {
+        // Nothing can wake a headless wait. Yield briefly to avoid spinning.
+        if (wait)
+        {
+            usleep(1000);
+        }
+
+        auto inputHandler = resources->inputHandler;
+
+        if (!wait && inputHandler)
+        {
+            inputHandler->InputHandler_OnPoll();
+
+            auto head = resources->windowHead;
+
+            while (head)
+            {
+                inputHandler->InputHandler_OnPoll(head);
+                head = head->GetNext();
+            }
+        }
+
+        if (s_terminateSignal)
+        {
+            s_terminateSignal = 0;
+            auto head = resources->windowHead;
+
+            while (head)
+            {
+                head->Close();
+                head = head->GetNext();
+            }
+        }
+    }
+
+    void* LinuxPlatform::GetProcess() { return resources->process; }
+    void* LinuxPlatform::GetHelperWindow() { return nullptr; }
+    void* LinuxPlatform::GetProcAddress(void* handle, const char* name) { return dlsym(handle, name); }
+    bool LinuxPlatform::GetProcIsElevated() { return geteuid() == 0; }
+
+    void* LinuxPlatform::LoadLibrary(const char* path)
+    {
+        return dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    }
+
+    void LinuxPlatform::FreeLibrary(void* handle)
+    {
+        if (handle)
+        {
+            dlclose(handle);
+        }
+    }
+
+
+    void LinuxPlatform::FindFiles(void* ctx, const char* directory, const char* pattern, bool recursive, void(*onFile)(void*, const char*))
+    {
+        if (!directory || !directory[0] || !pattern || !pattern[0] || !onFile)
+        {
+            return;
+        }
+
+        auto fd = open(directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+        if (fd < 0)
+        {
+            return;
+        }
+
+        auto lengthDir = strlen(directory);
+        char filepath[PATH_MAX];
+
+        strncpy(filepath, directory, PATH_MAX - 1u);
+        filepath[PATH_MAX - 1u] = '\0';
+
+        if (filepath[lengthDir - 1u] != '/' && lengthDir < PATH_MAX - 1u)
+        {
+            filepath[lengthDir] = '/';
+            filepath[++lengthDir] = '\0';
+        }
+
+        // getdents64 returns many entries per call without the per entry overhead of readdir.
+        alignas(8) char buffer[16384];
+
+        for (auto size = syscall(SYS_getdents64, fd, buffer, sizeof(buffer)); size > 0; size = syscall(SYS_getdents64, fd, buffer, sizeof(buffer)))
+        {
+            for (auto offset = 0l; offset < size;)
+            {
+                struct LinuxDirent64
+                {
+                    ino64_t d_ino;
+                    off64_t d_off;
+                    unsigned short d_reclen;
+                    unsigned char d_type;
+                    char d_name[];
+                };
+
+                auto entry = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+                offset += entry->d_reclen;
+
+                if (!entry->d_name[0] || entry->d_name[0] == '.')
+                {
+                    continue;
+                }
+
+                strncpy(filepath + lengthDir, entry->d_name, PATH_MAX - lengthDir);
+                filepath[PATH_MAX - 1u] = '\0';
+
+                auto type = entry->d_type;
+
+                // Some file systems don't report the type.
+                if (type == DT_UNKNOWN || type == DT_LNK)
+                {
+                    struct stat info;
+                    type = stat(filepath, &info) != 0 ? DT_UNKNOWN : S_ISDIR(info.st_mode) ? DT_DIR : S_ISREG(info.st_mode) ? DT_REG : DT_UNKNOWN;
+                }
+
+                if (type == DT_REG && fnmatch(pattern, entry->d_name, 0) == 0)
+                {
+                    onFile(ctx, filepath);
+                }
+                else if (type == DT_DIR && recursive)
+                {
+                    FindFiles(ctx, filepath, pattern, true, onFile);
+                }
+            }
+        }
+
+        close(fd);
+    }
+
+    bool LinuxPlatform::CreateDirectory(const char* path)
+    {
+        if (!path || !path[0])
+        {
+            return false;
+        }
+
+        char subpath[PATH_MAX];
+        strncpy(subpath, path, PATH_MAX - 1u);
+        subpath[PATH_MAX - 1u] = '\0';
+
+        for (auto i = 0u; i < PATH_MAX - 1u && path[i] && path[i] != '.'; ++i)
+        {
+            if (path[i + 1u] == '\0' || path[i + 1u] == '/')
+            {
+                subpath[i + 1u] = '\0';
+                struct stat info;
+
+                if (stat(subpath, &info) != 0)
+                {
+                    if (errno == EACCES || (mkdir(subpath, 0755) != 0 && errno != EEXIST))
+                    {
+                        return false;
+                    }
+                }
+                else if (!S_ISDIR(info.st_mode))
+                {
+                    return true;
+                }
+
+                subpath[i + 1u] = path[i + 1u];
+            }
+        }
+
+        return true;
+    }
+
+    bool LinuxPlatform::DirectoryExists(const char* path)
+    {
+        struct stat info;
+        return path && stat(path, &info) == 0 && S_ISDIR(info.st_mode);
+    }
+
+    bool LinuxPlatform::FileExists(const char* path)
+    {
+        struct stat info;
+        return path && stat(path, &info) == 0 && !S_ISDIR(info.st_mode);
+    }
+
+
+    struct LinuxFileWatcher
+    {
+        // Kept trivial as list storage is cleared with memset.
+        struct Directory
+        {
+            int descriptor;
+            char path[FixedString256::max_length + 1ull];
+        };
+
+        int fd;
+        bool recursive;
+        HeapList<Directory> directories;
+    };
+
+    // Inotify watches are not recursive. Sub directories get a watch of their own.
+    static void AddFileWatcherDirectory(LinuxFileWatcher* watcher, const char* path)
+    {
+        const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+        auto descriptor = inotify_add_watch(watcher->fd, path, mask | IN_ONLYDIR);
+
+        if (descriptor < 0)
+        {
+            return;
+        }
+
+        FixedString256 directoryPath(strlen(path), path);
+
+        if (directoryPath[directoryPath.Length() - 1u] != '/')
+        {
+            directoryPath.Append('/');
+        }
+
+        LinuxFileWatcher::Directory directory{};
+        directory.descriptor = descriptor;
+        String::Copy(directory.path, directoryPath.c_str(), FixedString256::max_length);
+        watcher->directories.Add(directory);
+
+        if (!watcher->recursive)
+        {
+            return;
+        }
+
+        auto handle = opendir(path);
+
+        if (handle == nullptr)
+        {
+            return;
+        }
+
+        FixedString256 childPath;
+
+        for (auto entry = readdir(handle); entry != nullptr; entry = readdir(handle))
+        {
+            if (entry->d_type == DT_DIR && entry->d_name[0] != '.')
+            {
+                childPath = FixedString256({ directoryPath.c_str(), entry->d_name });
+                AddFileWatcherDirectory(watcher, childPath);
+            }
+        }
+
+        closedir(handle);
+    }
+
+    void* LinuxPlatform::CreateFileWatcher(const char* directory, bool recursive)
+    {
+        if (!directory || !directory[0])
+        {
+            return nullptr;
+        }
+
+        auto fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+        if (fd < 0)
+        {
+            return nullptr;
+        }
+
+        auto watcher = Memory::New<LinuxFileWatcher>();
+        watcher->fd = fd;
+        watcher->recursive = recursive;
+        AddFileWatcherDirectory(watcher, directory);
+
+        if (watcher->directories.GetCount() == 0u)
+        {
+            DestroyFileWatcher(watcher);
+            return nullptr;
+        }
+
+        return watcher;
+    }
+
+    uint32_t LinuxPlatform::PollFileWatcher(void* watcher, void* ctx, void (*onChange)(void*, const char*))
+    {
+        auto fileWatcher = reinterpret_cast<LinuxFileWatcher*>(watcher);
+        alignas(inotify_event) char buffer[4096];
+        FixedString256 path;
+        auto count = 0u;
+
+        for (auto size = read(fileWatcher->fd, buffer, sizeof(buffer)); size > 0; size = read(fileWatcher->fd, buffer, sizeof(buffer)))
+        {
+            for (auto offset = 0; offset < size;)
+            {
+                auto event = reinterpret_cast<const inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    onChange(ctx, nullptr);
+                    count++;
+                    continue;
+                }
+
+                const LinuxFileWatcher::Directory* directory = nullptr;
+
+                for (auto i = 0u; i < fileWatcher->directories.GetCount() && !directory; ++i)
+                {
+                    directory = fileWatcher->directories[i].descriptor == event->wd ? &fileWatcher->directories[i] : nullptr;
+                }
+
+                if (!directory || event->len == 0u)
+                {
+                    continue;
+                }
+
+                path = FixedString256({ directory->path, event->name });
+
+                if (event->mask & IN_ISDIR)
+                {
+                    if (fileWatcher->recursive && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+                    {
+                        AddFileWatcherDirectory(fileWatcher, path);
+                    }
+
+                    continue;
+                }
+
+                // Created files are reported once they are closed after writing.
+                if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    onChange(ctx, path);
+                    count++;
+                }
+            }
+        }
+
+        return count;
+    }
+
+    void LinuxPlatform::DestroyFileWatcher(void* watcher)
+    {
+        if (watcher)
+        {
+            auto fileWatcher = reinterpret_cast<LinuxFileWatcher*>(watcher);
+            close(fileWatcher->fd);
+            Memory::Delete(fileWatcher);
+        }
+    }
+
+
+    double LinuxPlatform::GetTimeSeconds()
+    {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (double)time.tv_sec + (double)time.tv_nsec * 1e-9;
+    }
+
+    // Only used for relative measurements. Profiler calibrates cycles against GetTimeSeconds.
+    uint64_t LinuxPlatform::GetTimeCycles()
+    {
+#if PK_PLATFORM_X64
+        return __rdtsc();
+#else
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (uint64_t)time.tv_sec * 1000000000ull + (uint64_t)time.tv_nsec;
+#endif
+    }
+
+
+    // Headless process is never in the background. Otherwise the app would throttle itself.
+    bool LinuxPlatform::GetHasFocus()
+    {
+        return true;
+    }
+
+    int2 LinuxPlatform::GetDesktopSize()
+    {
+        return LINUX_HEADLESS_DESKTOP_SIZE;
+    }
+
+    int4 LinuxPlatform::GetMonitorRect([[maybe_unused]] const int2& point, [[maybe_unused]] bool preferPrimary)
+    {
+        return { 0, 0, LINUX_HEADLESS_DESKTOP_SIZE.x, LINUX_HEADLESS_DESKTOP_SIZE.y };
+    }
+
+    void* LinuxPlatform::GetNativeMonitorHandle([[maybe_unused]] const int2& point, [[maybe_unused]] bool preferPrimary)
+    {
+        return nullptr;
+    }
+
+    PlatformWindow* LinuxPlatform::CreateWindow(const PlatformWindowDescriptor& descriptor)
+    {
+        auto window = Memory::New<LinuxWindow>(descriptor);
+        window->GetNext() = resources->windowHead;
+        resources->windowHead = window;
+
+        if (resources->inputHandler)
+        {
+            resources->inputHandler->InputHandler_OnConnect(window);
+        }
+
+        return window;
+    }
+
+    void LinuxPlatform::DestroyWindow(PlatformWindow* window)
+    {
+        if (resources->inputHandler)
+        {
+            resources->inputHandler->InputHandler_OnDisconnect(window);
+        }
+
+        auto head = resources->windowHead;
+        auto link = &resources->windowHead;
+
+        while (head)
+        {
+            if (head == window)
+            {
+                *link = head->GetNext();
+                break;
+            }
+
+            link = &head->GetNext();
+            head = head->GetNext();
+        }
+
+        Memory::Delete(static_cast<LinuxWindow*>(window));
+    }
+
+    void LinuxPlatform::SetInputHandler(InputHandler* handler)
+    {
+        resources->inputHandler = handler;
+
+        if (resources->inputHandler)
+        {
+            auto head = resources->windowHead;
+
+            while (head)
+            {
+                resources->inputHandler->InputHandler_OnConnect(head);
+                head = head->GetNext();
+            }
+        }
+    }
+
+
+    // No display server to share with. Clipboard only works within the process.
+    const char* LinuxPlatform::GetClipboardString()
+    {
+        return resources->clipboard ? resources->clipboard : "";
+    }
+
+    void LinuxPlatform::SetClipboardString(const char* str)
+    {
+        auto length = str ? strlen(str) : 0ull;
+
+        if (resources->clipboardSize < length + 1ull)
+        {
+            Memory::Free(resources->clipboard);
+            resources->clipboard = Memory::Allocate<char>(length + 1ull);
+            resources->clipboardSize = length + 1ull;
+        }
+
+        memcpy(resources->clipboard, str ? str : "", length);
+        resources->clipboard[length] = '\0';
+    }
+
+    // Colors follow the win32 console attribute layout. Red & blue bits are swapped in ansi colors.
+    void LinuxPlatform::SetConsoleColor(uint32_t color)
+    {
+        if (resources && resources->isConsoleColored)
+        {
+            auto foreground = ((color & 0x4u) >> 2u) | (color & 0x2u) | ((color & 0x1u) << 2u);
+            auto background = ((color & 0x40u) >> 6u) | ((color & 0x20u) >> 4u) | ((color & 0x10u) >> 2u);
+            auto foregroundBase = (color & 0x8u) ? 90u : 30u;
+            auto backgroundBase = (color & 0x80u) ? 100u : 40u;
+
+            if (color & 0xF0u)
+            {
+                printf("\x1b[%u;%um", foregroundBase + foreground, backgroundBase + background);
+            }
+            else
+            {
+                printf("\x1b[0;%um", foregroundBase + foreground);
+            }
+        }
+    }
+
+    void LinuxPlatform::SetConsoleVisible([[maybe_unused]] bool value)
+    {
+    }
+
+    struct LinuxRemoteProcess
+    {
+        pid_t pid;
+        int outputRead;
+        bool isExited;
+        uint32_t exitCode;
+    };
+
+    // Splits arguments in place. Single & double quotes group words together.
+    static uint32_t SplitRemoteProcessArguments(char* arguments, char** argv, uint32_t maxCount)
+    {
+        auto count = 0u;
+        auto read = arguments;
+
+        while (*read && count < maxCount)
+        {
+            while (*read == ' ')
+            {
+                read++;
+            }
+
+            if (!*read)
+            {
+                break;
+            }
+
+            auto quote = *read == '\'' || *read == '"' ? *read++ : '\0';
+            argv[count++] = read;
+
+            while (*read && (quote ? *read != quote : *read != ' '))
+            {
+                read++;
+            }
+
+            if (*read)
+            {
+                *read++ = '\0';
+            }
+        }
+
+        return count;
+    }
+
+    struct LinuxRemoteProcessArguments
+    {
+        FixedString512 path;
+        FixedString1024 arguments;
+        char* argv[64];
+    };
+
+    static bool GetRemoteProcessArguments(const char* executable, const char* arguments, LinuxRemoteProcessArguments* outArguments)
+    {
+        if (!executable || !executable[0])
+        {
+            return false;
+        }
+
+        auto executableLen = strlen(executable);
+
+        // Remove quotes from path
+        if (executable[executableLen - 1ull] == '\'')
+        {
+            executableLen--;
+        }
+
+        if (executable[0] == '\'')
+        {
+            executableLen--;
+            executable++;
+        }
+
+        if (executableLen == 0ull)
+        {
+            return false;
+        }
+
+        outArguments->path = FixedString512(executableLen, executable);
+        outArguments->arguments = FixedString1024(arguments ? strlen(arguments) : 0ull, arguments);
+        outArguments->argv[0] = outArguments->path.c_str();
+        auto argc = 1u + SplitRemoteProcessArguments(outArguments->arguments.c_str(), outArguments->argv + 1u, 62u);
+        outArguments->argv[argc] = nullptr;
+        return true;
+    }
+
+    uint32_t LinuxPlatform::RemoteProcess(const char* executable, const char* arguments)
+    {
+        LinuxRemoteProcessArguments remoteArguments;
+
+        if (!GetRemoteProcessArguments(executable, arguments, &remoteArguments))
+        {
+            return 1u;
+        }
+
+        pid_t pid = 0;
+        auto result = posix_spawnp(&pid, remoteArguments.path.c_str(), nullptr, nullptr, remoteArguments.argv, environ);
+
+        if (result != 0)
+        {
+            return (uint32_t)result;
+        }
+
+        while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR)
+        {
+        }
+
+        return 0u;
+    }
+
+    void* LinuxPlatform::RemoteProcessStart(const char* executable, const char* arguments)
+    {
+        LinuxRemoteProcessArguments remoteArguments;
+
+        if (!GetRemoteProcessArguments(executable, arguments, &remoteArguments))
+        {
+            return nullptr;
+        }
+
+        int fds[2];
+
+        // Close on exec so that processes spawned later don't inherit this pipe & keep it open past the child's exit.
+        if (pipe2(fds, O_CLOEXEC) != 0)
+        {
+            return nullptr;
+        }
+
+        // Duplicates don't inherit close on exec. Only stdout & stderr of the child remain open.
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDERR_FILENO);
+
+        pid_t pid = 0;
+        auto result = posix_spawnp(&pid, remoteArguments.path.c_str(), &actions, nullptr, remoteArguments.argv, environ);
+        posix_spawn_file_actions_destroy(&actions);
+
+        // The child has its own copy. Closing ours lets reads end once the child exits.
+        close(fds[1]);
+
+        if (result != 0)
+        {
+            close(fds[0]);
+            return nullptr;
+        }
+
+        fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL) | O_NONBLOCK);
+
+        auto process = Memory::New<LinuxRemoteProcess>();
+        process->pid = pid;
+        process->outputRead = fds[0];
+        process->isExited = false;
+        process->exitCode = 0u;
+        return process;
+    }
+
+    uint32_t LinuxPlatform::RemoteProcessRead(void* process, char* buffer, uint32_t size)
+    {
+        auto result = read(reinterpret_cast<LinuxRemoteProcess*>(process)->outputRead, buffer, size);
+        return result > 0 ? (uint32_t)result : 0u;
+    }
+
+    bool LinuxPlatform::RemoteProcessPoll(void* process, uint32_t* outExitCode)
+    {
+        auto remote = reinterpret_cast<LinuxRemoteProcess*>(process);
+
+        // A reaped pid can't be waited on again. Keep the status around.
+        if (!remote->isExited)
+        {
+            int status = 0;
+
+            if (waitpid(remote->pid, &status, WNOHANG) != remote->pid)
+            {
+                return false;
+            }
+
+            remote->isExited = true;
+            remote->exitCode = WIFEXITED(status) ? (uint32_t)WEXITSTATUS(status) : 128u + (uint32_t)WTERMSIG(status);
+        }
+
+        *outExitCode = remote->exitCode;
+        return true;
+    }
+
+    void LinuxPlatform::RemoteProcessTerminate(void* process)
+    {
+        auto remote = reinterpret_cast<LinuxRemoteProcess*>(process);
+
+        if (!remote->isExited)
+        {
+            kill(remote->pid, SIGTERM);
+        }
+    }
+
+    void LinuxPlatform::RemoteProcessClose(void* process)
+    {
+        if (process)
+        {
+            auto remote = reinterpret_cast<LinuxRemoteProcess*>(process);
+
+            // Don't leave a zombie behind.
+            if (!remote->isExited)
+            {
+                kill(remote->pid, SIGKILL);
+                waitpid(remote->pid, nullptr, 0);
+            }
+
+            close(remote->outputRead);
+            Memory::Delete(remote);
+        }
+    }
+
+
+    uint32_t LinuxPlatform::GetProcessorCount()
+    {
+        auto count = sysconf(_SC_NPROCESSORS_ONLN);
+        return count > 0 ? (uint32_t)count : 1u;
+    }
+
+    void* LinuxPlatform::CreateThread(void* ctx, void (*function)(void*))
+    {
+        struct ThreadStart
+        {
+            void* ctx;
+            void (*function)(void*);
+
+            static void* Main(void* parameter)
+            {
+                auto start = *reinterpret_cast<ThreadStart*>(parameter);
+                Memory::Delete(reinterpret_cast<ThreadStart*>(parameter));
+                start.function(start.ctx);
+                return nullptr;
+            }
+        };
+
+        auto start = Memory::New<ThreadStart>();
+        start->ctx = ctx;
+        start->function = function;
+
+        pthread_t thread;
+
+        if (pthread_create(&thread, nullptr, ThreadStart::Main, start) != 0)
+        {
+            Memory::Delete(start);
+            return nullptr;
+        }
+
+        static_assert(sizeof(pthread_t) <= sizeof(void*), "pthread_t doesn't fit a handle!");
+        return reinterpret_cast<void*>(thread);
+    }
+
+    void LinuxPlatform::JoinThread(void* thread)
+    {
+        if (thread)
+        {
+            pthread_join(reinterpret_cast<pthread_t>(thread), nullptr);
+        }
+    }
+
+    // Futex backed counting semaphore. Uncontended signals & waits stay in user space.
+    struct LinuxSemaphore
+    {
+        volatile uint32_t count;
+        uint32_t maxCount;
+        volatile uint32_t waiters;
+    };
+
+    void* LinuxPlatform::CreateSemaphore(uint32_t initialCount, uint32_t maxCount)
+    {
+        auto semaphore = Memory::New<LinuxSemaphore>();
+        semaphore->count = initialCount;
+        semaphore->maxCount = maxCount;
+        semaphore->waiters = 0u;
+        return semaphore;
+    }
+
+    void LinuxPlatform::DestroySemaphore(void* semaphore)
+    {
+        if (semaphore)
+        {
+            Memory::Delete(reinterpret_cast<LinuxSemaphore*>(semaphore));
+        }
+    }
+
+    void LinuxPlatform::SignalSemaphore(void* semaphore, uint32_t count)
+    {
+        auto linuxSemaphore = reinterpret_cast<LinuxSemaphore*>(semaphore);
+        auto current = AtomicRead(&linuxSemaphore->count);
+
+        // Like win32 release, signals that would exceed the max count are dropped.
+        while (true)
+        {
+            if (current + count > linuxSemaphore->maxCount)
+            {
+                return;
+            }
+
+            auto previous = InterlockedCompareExchange(&linuxSemaphore->count, current + count, current);
+
+            if (previous == current)
+            {
+                break;
+            }
+
+            current = previous;
+        }
+
+        if (AtomicRead(&linuxSemaphore->waiters) > 0u)
+        {
+            syscall(SYS_futex, &linuxSemaphore->count, FUTEX_WAKE_PRIVATE, (int)count, nullptr, nullptr, 0);
+        }
+    }
+
+    void LinuxPlatform::WaitSemaphore(void* semaphore)
+    {
+        auto linuxSemaphore = reinterpret_cast<LinuxSemaphore*>(semaphore);
+
+        while (true)
+        {
+            auto current = AtomicRead(&linuxSemaphore->count);
+
+            if (current > 0u)
+            {
+                if (InterlockedCompareExchange(&linuxSemaphore->count, current - 1u, current) == current)
+                {
+                    return;
+                }
+
+                continue;
+            }
+
+            // Sleeps only if the count is still zero. A signal in between makes the call return immediately.
+            InterlockedIncrement(&linuxSemaphore->waiters);
+            syscall(SYS_futex, &linuxSemaphore->count, FUTEX_WAIT_PRIVATE, 0, nullptr, nullptr, 0);
+            InterlockedDecrement(&linuxSemaphore->waiters);
+        }
+    }
+}
+#endif
@@ -1,13 +1,107 @@
 #pragma once
 #if PK_IS_PLATFORM_HEADER && PK_PLATFORM_LINUX
 
-// @TODO add linux support.
+#if defined(__x86_64__)
 #define PK_PLATFORM_X64 1
-#define PK_PLATFORM_TEXT_IS_CHAR16 1
 #define PK_PLATFORM_DEBUG_BREAK __asm__ volatile("int $0x03")
+#endif
+
+#if defined(__aarch64__)
+#define PK_PLATFORM_ARM64 1
+#define PK_PLATFORM_DEBUG_BREAK __builtin_trap()
+#endif
+
+#define PK_PLATFORM_TEXT_IS_CHAR16 1
 #define PK_PLAFTORM_DRIVER_TYPE LinuxDriver
 #define VK_USE_PLATFORM_WAYLAND_KHR
 
-PK_DECLARE_PLATFORM_INTERFACE(PlatformLinux, PlatformResourcesLinux)
+namespace PK
+{
+    struct LinuxWindow;
+    struct LinuxResources;
+    struct InputDevice;
+    enum class InputKey;
+
+    // Headless platform backend. Windows have no native surface & input is never raised.
+    // Used for running & profiling the cpu side of the engine on machines without a display.
+    // Not part of any build target yet (see README). Keep this & the Core headers it pulls in gcc clean.
+    struct LinuxPlatform : public IPlatform
+    {
+        using IPlatform::PollEvents;
+        using IPlatform::WaitEvents;
+
+        static int Initialize();
+        static int Terminate();
+
+        PK_ALLOC_CALL static void* AllocateAligned(size_t size, size_t alignment) noexcept;
+        static void FreeAligned(void* block);
+        static PlatformMemoryInfo GetMemoryInfo();
+
+        static void PollEvents(bool wait);
+
+        static void* GetProcess();
+        static void* GetHelperWindow();
+        static void* GetProcAddress(void* handle, const char* name);
+        static bool  GetProcIsElevated();
+
+        static void* LoadLibrary(const char* path);
+        static void FreeLibrary(void* handle);
+
+        static void FindFiles(void* ctx, const char* directory, const char* pattern, bool recursive, void (*onFile)(void*, const char*));
+        static bool CreateDirectory(const char* path);
+        static bool DirectoryExists(const char* path);
+        static bool FileExists(const char* path);
+        static void* CreateFileWatcher(const char* directory, bool recursive);
+        static uint32_t PollFileWatcher(void* watcher, void* ctx, void (*onChange)(void*, const char*));
+        static void DestroyFileWatcher(void* watcher);
+
+        static double GetTimeSeconds();
+        static uint64_t GetTimeCycles();
+
+        static bool GetHasFocus();
+        static int2 GetDesktopSize();
+        static int4 GetMonitorRect(const int2& point, bool preferPrimary);
+        static void* GetNativeMonitorHandle(const int2& point, bool preferPrimary);
+
+        static PlatformWindow* CreateWindow(const PlatformWindowDescriptor& descriptor);
+        static void DestroyWindow(PlatformWindow* window);
+
+        static void SetInputHandler(InputHandler* handler);
+
+        static const char* GetClipboardString();
+        static void SetClipboardString(const char* str);
+
+        static void SetConsoleColor(uint32_t color);
+        static void SetConsoleVisible(bool value);
+        static uint32_t RemoteProcess(const char* executable, const char* arguments);
+        static void* RemoteProcessStart(const char* executable, const char* arguments);
+        static uint32_t RemoteProcessRead(void* process, char* buffer, uint32_t size);
+        static bool RemoteProcessPoll(void* process, uint32_t* outExitCode);
+        static void RemoteProcessTerminate(void* process);
+        static void RemoteProcessClose(void* process);
+
+        static uint32_t GetProcessorCount();
+        static void* CreateThread(void* ctx, void (*function)(void*));
+        static void JoinThread(void* thread);
+        static void* CreateSemaphore(uint32_t initialCount, uint32_t maxCount);
+        static void DestroySemaphore(void* semaphore);
+        static void SignalSemaphore(void* semaphore, uint32_t count);
+        static void WaitSemaphore(void* semaphore);
+
+        inline static uint32_t InterlockedExchange(volatile uint32_t* dst, uint32_t exchange) { return __atomic_exchange_n(dst, exchange, __ATOMIC_SEQ_CST); }
+        inline static uint32_t InterlockedCompareExchange(volatile uint32_t* dst, uint32_t exchange, uint32_t comperand) { return __sync_val_compare_and_swap(dst, comperand, exchange); }
+        inline static uint32_t InterlockedAdd(volatile uint32_t* dst, uint32_t value) { return __atomic_fetch_add(dst, value, __ATOMIC_SEQ_CST); }
+        inline static uint32_t InterlockedIncrement(volatile uint32_t* dst) { return __atomic_add_fetch(dst, 1u, __ATOMIC_SEQ_CST); }
+        inline static uint32_t InterlockedDecrement(volatile uint32_t* dst) { return __atomic_sub_fetch(dst, 1u, __ATOMIC_SEQ_CST); }
+        inline static int64_t InterlockedAdd64(volatile int64_t* dst, int64_t value) { return __atomic_fetch_add(dst, value, __ATOMIC_SEQ_CST); }
+        inline static uint32_t AtomicRead(const volatile uint32_t* dst) { return __atomic_load_n(dst, __ATOMIC_RELAXED); }
+        inline static void AtomicStore(uint32_t volatile* dst, uint32_t value) { __atomic_store_n(dst, value, __ATOMIC_RELAXED); }
+        inline static uint64_t BitScan64(uint64_t mask) { return mask ? (uint64_t)__builtin_ctzll(mask) : 64u; }
+
+    protected:
+        friend struct LinuxWindow;
+        inline static LinuxResources* resources;
+    };
+}
 
 #endif
@@ -0,0 +1,135 @@
+#include "PrecompiledHeader.h"
+
+#if PK_PLATFORM_LINUX
+#include "LinuxWindow.h"
+
+namespace PK
+{
+    LinuxWindow::LinuxWindow(const PlatformWindowDescriptor& descriptor)
+    {
+        m_sizeMin = descriptor.sizemin;
+        m_sizeMax = descriptor.sizemax;
+        m_rect.x = descriptor.position.x == -1 ? 0 : descriptor.position.x;
+        m_rect.y = descriptor.position.y == -1 ? 0 : descriptor.position.y;
+        m_rect.z = descriptor.size.x;
+        m_rect.w = descriptor.size.y;
+        m_restoreRect = m_rect;
+        m_isVisible = descriptor.isVisible;
+        m_isFocused = descriptor.autoActivate;
+    }
+
+    LinuxWindow::~LinuxWindow()
+    {
+        m_windowListener = nullptr;
+    }
+
+    int2 LinuxWindow::GetMonitorResolution() const
+    {
+        return Platform::GetDesktopSize();
+    }
+
+    void LinuxWindow::SetRect(const int4& rect)
+    {
+        int2 size = rect.zw;
+        if (m_sizeMin.x >= 0) size.x = math::max(size.x, m_sizeMin.x);
+        if (m_sizeMin.y >= 0) size.y = math::max(size.y, m_sizeMin.y);
+        if (m_sizeMax.x >= 0) size.x = math::min(size.x, m_sizeMax.x);
+        if (m_sizeMax.y >= 0) size.y = math::min(size.y, m_sizeMax.y);
+
+        auto isResized = m_rect.z != size.x || m_rect.w != size.y;
+        m_rect = int4(rect.x, rect.y, size.x, size.y);
+
+        if (isResized)
+        {
+            DispatchWindowOnEvent(PlatformWindowEvent::Resize);
+        }
+    }
+
+    void LinuxWindow::SetVisible(bool value)
+    {
+        if (value != m_isVisible)
+        {
+            m_isVisible = value;
+            DispatchWindowOnEvent(value ? PlatformWindowEvent::Visible : PlatformWindowEvent::Invisible);
+        }
+    }
+
+    void LinuxWindow::SetFullScreen(bool value)
+    {
+        if (m_isFullScreen == value)
+        {
+            return;
+        }
+
+        if (!value)
+        {
+            m_isFullScreen = false;
+            DispatchWindowOnEvent(PlatformWindowEvent::FullScreenExit);
+            SetRect(m_restoreRect);
+            return;
+        }
+
+        m_restoreRect = m_rect;
+        m_isFullScreen = true;
+        SetRect({ PK_INT2_ZERO, Platform::GetDesktopSize() });
+
+        if (!DispatchWindowOnEvent(PlatformWindowEvent::FullScreenRequest))
+        {
+            m_isFullScreen = false;
+            SetRect(m_restoreRect);
+        }
+    }
+
+    void LinuxWindow::Minimize()
+    {
+        m_isMinimized = true;
+        m_isMaximized = false;
+    }
+
+    void LinuxWindow::Maximize()
+    {
+        if (!m_isMaximized)
+        {
+            m_restoreRect = m_isMinimized ? m_restoreRect : m_rect;
+            m_isMinimized = false;
+            m_isMaximized = true;
+            SetRect({ PK_INT2_ZERO, Platform::GetDesktopSize() });
+        }
+    }
+
+    void LinuxWindow::Restore()
+    {
+        m_isMinimized = false;
+
+        if (m_isMaximized)
+        {
+            m_isMaximized = false;
+            SetRect(m_restoreRect);
+        }
+    }
+
+    void LinuxWindow::Focus()
+    {
+        if (!m_isFocused)
+        {
+            m_isFocused = true;
+            DispatchWindowOnEvent(PlatformWindowEvent::Focus);
+        }
+    }
+
+    void LinuxWindow::Close()
+    {
+        if (!m_isClosing)
+        {
+            m_isClosing = true;
+            DispatchWindowOnEvent(PlatformWindowEvent::Close);
+        }
+    }
+
+    bool LinuxWindow::DispatchWindowOnEvent(PlatformWindowEvent evt)
+    {
+        return m_windowListener ? m_windowListener->IPlatformWindow_OnEvent(this, evt) : false;
+    }
+}
+
+#endif
@@ -0,0 +1,70 @@
+#pragma once
+#include "Core/Platform/PlatformInterfaces.h"
+
+#if PK_PLATFORM_LINUX
+
+namespace PK
+{
+    // Headless window. Keeps the requested window state without a native surface.
+    // Lets the cpu side of the engine run on machines without a display server.
+    struct LinuxWindow : public PlatformWindow
+    {
+        LinuxWindow(const PlatformWindowDescriptor& descriptor);
+        ~LinuxWindow();
+
+        inline int4 GetRect() const final { return m_rect; }
+        int2 GetMonitorResolution() const final;
+        inline float2 GetCursorPosition() const final { return m_cursorpos; }
+        inline bool IsMinimized() const final { return m_isMinimized; }
+        inline bool IsMaximized() const final { return m_isMaximized; }
+        inline bool IsClosing() const final { return m_isClosing; }
+        inline bool IsFocused() const final { return m_isFocused; }
+        inline void* GetNativeWindowHandle() const final { return nullptr; }
+        inline void* GetNativeMonitorHandle() const final { return nullptr; }
+
+        float2 GetInputCursorPosition() final { return m_cursorpos; }
+        const InputKeyState& GetInputKeyState() final { return m_keyState; }
+        float GetInputAnalogAxis([[maybe_unused]] InputKey neg, [[maybe_unused]] InputKey pos) final { return 0.0f; }
+        void SetUseRawInput([[maybe_unused]] bool value) final {}
+
+        void SetRect(const int4& rect) final;
+        void SetCursorPosition(const float2& position) final { m_cursorpos = position; }
+        void SetCursorLock([[maybe_unused]] bool lock, [[maybe_unused]] bool visible) final {}
+        void SetIcon([[maybe_unused]] unsigned char* pixels, [[maybe_unused]] const int2& resolution) final {}
+
+        void SetVisible(bool value) final;
+        void SetFullScreen(bool value) final;
+        void Minimize() final;
+        void Maximize() final;
+        void Restore() final;
+        void Focus() final;
+        void Close() final;
+
+        inline LinuxWindow*& GetNext() { return m_nextWindow; }
+
+        inline void SetListener(IPlatformWindowListener* listener) final { m_windowListener = listener; }
+
+        private:
+            bool DispatchWindowOnEvent(PlatformWindowEvent evt);
+
+            bool m_isVisible = false;
+            bool m_isMinimized = false;
+            bool m_isMaximized = false;
+            bool m_isFocused = false;
+            bool m_isClosing = false;
+            bool m_isFullScreen = false;
+            int2 m_sizeMin = PK_INT2_ZERO;
+            int2 m_sizeMax = PK_INT2_ZERO;
+
+            int4 m_rect = PK_INT4_ZERO;
+            int4 m_restoreRect = PK_INT4_ZERO;
+            float2 m_cursorpos = PK_FLOAT2_ZERO;
+
+            InputKeyState m_keyState;
+
+            IPlatformWindowListener* m_windowListener = nullptr;
+            LinuxWindow* m_nextWindow = nullptr;
+    };
+}
+
+#endif
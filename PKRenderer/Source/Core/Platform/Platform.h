@@ -11,7 +11,11 @@
     #define PK_DLLEXPORT __attribute__ ((__visibility__ ("default")))
     #define PK_DLLIMPORT
     #define PK_THREADLOCAL __thread
-    #define PK_ALLOC_CALL __declspec(allocator)
+    #if defined(_MSC_VER)
+        #define PK_ALLOC_CALL __declspec(allocator)
+    #else
+        #define PK_ALLOC_CALL
+    #endif
     #define PK_STDCALL __attribute__((stdcall))
     #define PK_CDECL __attribute__((cdecl))
     #define PK_RESTRICT __restrict__
@@ -22,6 +26,24 @@
     #define PK_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
     #define PK_NO_SANITIZE_THREAD __attribute__((no_sanitize_thread))
     #define PK_OFFSET_OF(X, Y) __builtin_offsetof(X, Y)
+#elif defined(__GNUC__)
+    #if __cplusplus < 202002l
+        #error "C++ 20 support or newer required!"
+    #endif
+    #define PK_DLLEXPORT __attribute__ ((__visibility__ ("default")))
+    #define PK_DLLIMPORT
+    #define PK_THREADLOCAL __thread
+    #define PK_ALLOC_CALL
+    #define PK_STDCALL
+    #define PK_CDECL
+    #define PK_RESTRICT __restrict__
+    #define PK_INLINE inline
+    #define PK_FORCE_INLINE inline
+    #define PK_FORCE_NOINLINE __attribute__((noinline))
+    #define PK_NO_RETURN __attribute__((noreturn))
+    #define PK_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+    #define PK_NO_SANITIZE_THREAD __attribute__((no_sanitize_thread))
+    #define PK_OFFSET_OF(X, Y) __builtin_offsetof(X, Y)
 #elif defined(_MSC_VER)
     #if _MSVC_LANG < 202002l
         #error "MSVC with c++ 20 support or newer required!"
@@ -54,7 +76,7 @@
     #define PK_PLATFORM_WINDOWS 0
 #endif
 
-#if defined(__linux__) && defined(_LINUX64)
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
     #define PK_PLATFORM_LINUX 1
 #else
     #define PK_PLATFORM_LINUX 0
@@ -100,6 +122,10 @@ namespace PK
         static bool CreateDirectory(const char* path) = delete;
         static bool DirectoryExists(const char* path) = delete;
         static bool FileExists(const char* path) = delete;
+        static void* CreateFileWatcher(const char* directory, bool recursive) = delete;
+        // onChange receives a null path when changes were lost & the whole directory should be rescanned.
+        static uint32_t PollFileWatcher(void* watcher, void* ctx, void (*onChange)(void*, const char*)) = delete;
+        static void DestroyFileWatcher(void* watcher) = delete;
 
         static double GetTimeSeconds() = delete;
         static uint64_t GetTimeCycles() = delete;
@@ -120,12 +146,26 @@ namespace PK
         static void SetConsoleColor(uint32_t color) = delete;
         static void SetConsoleVisible(bool value) = delete;
         static uint32_t RemoteProcess(const char* executable, const char* arguments) = delete;
+        static void* RemoteProcessStart(const char* executable, const char* arguments) = delete;
+        static uint32_t RemoteProcessRead(void* process, char* buffer, uint32_t size) = delete;
+        static bool RemoteProcessPoll(void* process, uint32_t* outExitCode) = delete;
+        static void RemoteProcessTerminate(void* process) = delete;
+        static void RemoteProcessClose(void* process) = delete;
+
+        static uint32_t GetProcessorCount() = delete;
+        static void* CreateThread(void* ctx, void (*function)(void*)) = delete;
+        static void JoinThread(void* thread) = delete;
+        static void* CreateSemaphore(uint32_t initialCount, uint32_t maxCount) = delete;
+        static void DestroySemaphore(void* semaphore) = delete;
+        static void SignalSemaphore(void* semaphore, uint32_t count) = delete;
+        static void WaitSemaphore(void* semaphore) = delete;
 
         static uint32_t InterlockedExchange(volatile uint32_t* dst, uint32_t exchange) = delete;
         static uint32_t InterlockedCompareExchange(volatile uint32_t* dst, uint32_t exchange, uint32_t comperand) = delete;
         static uint32_t InterlockedAdd(volatile uint32_t* dst, uint32_t value) = delete;
         static uint32_t InterlockedIncrement(volatile uint32_t* dst) = delete;
         static uint32_t InterlockedDecrement(volatile uint32_t* dst) = delete;
+        static int64_t InterlockedAdd64(volatile int64_t* dst, int64_t value) = delete;
         static uint32_t AtomicRead(const volatile uint32_t* dst) = delete;
         static void AtomicStore(volatile uint32_t* dst, uint32_t value) = delete;
         static uint64_t BitScan64(uint64_t mask) = delete;
@@ -3,6 +3,7 @@
 #if PK_PLATFORM_WINDOWS
 #include "Win32Internal.h"
 #include "Core/Base/Containers/FixedString.h"
+#include "Core/Base/MemoryTracker.h"
 #include "Core/CLI/Log.h"
 
 PFN_DirectInput8Create pkfn_DirectInput8Create = nullptr;
@@ -386,7 +387,11 @@ namespace PK
 
     PK_ALLOC_CALL void* Win32Platform::AllocateAligned(size_t size, size_t alignment) noexcept
     {
+#if PK_MEMORY_TRACKING
+        auto ptr = _aligned_malloc(size + MemoryTracker::GetHeaderSize(alignment), alignment);
+#else
         auto ptr = _aligned_malloc(size, alignment);
+#endif
     
         if (!ptr)
         {
@@ -395,6 +400,10 @@ namespace PK
 
         _InlineInterlockedAdd64(reinterpret_cast<volatile int64_t*>(&s_programMemoryExclusive), size);
 
+#if PK_MEMORY_TRACKING
+        ptr = MemoryTracker::TrackAllocation(ptr, size, alignment);
+#endif
+
         return ptr;
     }
 
@@ -402,8 +411,14 @@ namespace PK
     {
         if (block)
         {
+#if PK_MEMORY_TRACKING
+            size_t size = 0ull;
+            block = MemoryTracker::TrackFree(block, &size);
+            _InlineInterlockedAdd64(reinterpret_cast<volatile int64_t*>(&s_programMemoryExclusive), -(int64_t)size);
+#else
             auto size = -(int64_t)_aligned_msize(block, 16ull, 0ull);
             _InlineInterlockedAdd64(reinterpret_cast<volatile int64_t*>(&s_programMemoryExclusive), size);
+#endif
             _aligned_free(block);
         }
     }
@@ -693,6 +708,153 @@ namespace PK
         return result != 0xFFFFFFFF && !(result & FILE_ATTRIBUTE_DIRECTORY);
     }
 
+    struct Win32FileWatcher
+    {
+        HANDLE directory;
+        OVERLAPPED overlapped;
+        BOOL recursive;
+        // Cleared if a read could not be issued. Eg. when the directory has been deleted.
+        bool isArmed;
+        char path[MAX_PATH];
+        size_t pathLength;
+        alignas(DWORD) uint8_t buffer[16384];
+    };
+
+    static bool ReadFileWatcherChanges(Win32FileWatcher* watcher)
+    {
+        const DWORD filter = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME;
+        ::ResetEvent(watcher->overlapped.hEvent);
+        watcher->isArmed = ::ReadDirectoryChangesW(watcher->directory, watcher->buffer, sizeof(watcher->buffer), watcher->recursive, filter, NULL, &watcher->overlapped, NULL) != 0;
+        return watcher->isArmed;
+    }
+
+    void* Win32Platform::CreateFileWatcher(const char* directory, bool recursive)
+    {
+        if (!directory || !directory[0])
+        {
+            return nullptr;
+        }
+
+        FixedWString512 wideDirectory(strlen(directory), directory);
+        const DWORD share = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+        auto handle = ::CreateFileW(wideDirectory, FILE_LIST_DIRECTORY, share, NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+
+        if (handle == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+
+        auto watcher = Memory::New<Win32FileWatcher>();
+        ZeroMemory(&watcher->overlapped, sizeof(OVERLAPPED));
+        watcher->overlapped.hEvent = ::CreateEventW(NULL, TRUE, FALSE, NULL);
+        watcher->directory = handle;
+        watcher->recursive = recursive ? TRUE : FALSE;
+
+        // Changes are reported relative to the directory. Match the path format of FindFiles.
+        strncpy(watcher->path, directory, MAX_PATH - 1u);
+        watcher->path[MAX_PATH - 1u] = '\0';
+        watcher->pathLength = strlen(watcher->path);
+
+        if (watcher->path[watcher->pathLength - 1u] != '/' && watcher->pathLength < MAX_PATH - 1u)
+        {
+            watcher->path[watcher->pathLength++] = '/';
+            watcher->path[watcher->pathLength] = '\0';
+        }
+
+        if (!ReadFileWatcherChanges(watcher))
+        {
+            DestroyFileWatcher(watcher);
+            return nullptr;
+        }
+
+        return watcher;
+    }
+
+    uint32_t Win32Platform::PollFileWatcher(void* watcher, void* ctx, void (*onChange)(void*, const char*))
+    {
+        auto fileWatcher = reinterpret_cast<Win32FileWatcher*>(watcher);
+        auto count = 0u;
+        DWORD size = 0u;
+
+        if (!fileWatcher->isArmed)
+        {
+            return 0u;
+        }
+
+        if (!::GetOverlappedResult(fileWatcher->directory, &fileWatcher->overlapped, &size, FALSE))
+        {
+            const auto error = ::GetLastError();
+
+            if (error == ERROR_IO_INCOMPLETE)
+            {
+                return 0u;
+            }
+
+            // The read has completed with an error (ERROR_NOTIFY_ENUM_DIR on overflow). Re-arm it or no further changes are reported.
+            onChange(ctx, nullptr);
+            ReadFileWatcherChanges(fileWatcher);
+            return 1u;
+        }
+
+        // Size is zero if the buffer overflowed. Those changes are lost & the directory needs a rescan.
+        if (size == 0u)
+        {
+            onChange(ctx, nullptr);
+            count++;
+        }
+
+        for (auto offset = 0u; size > 0u;)
+        {
+            auto info = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(fileWatcher->buffer + offset);
+
+            if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED || info->Action == FILE_ACTION_RENAMED_NEW_NAME)
+            {
+                auto path = fileWatcher->path + fileWatcher->pathLength;
+                auto capacity = MAX_PATH - fileWatcher->pathLength - 1u;
+                auto length = ::WideCharToMultiByte(CP_UTF8, 0, info->FileName, (int)(info->FileNameLength / sizeof(WCHAR)), path, (int)capacity, NULL, NULL);
+                path[length] = '\0';
+
+                for (auto i = 0; i < length; ++i)
+                {
+                    path[i] = path[i] == '\\' ? '/' : path[i];
+                }
+
+                onChange(ctx, fileWatcher->path);
+                count++;
+            }
+
+            if (info->NextEntryOffset == 0u)
+            {
+                break;
+            }
+
+            offset += info->NextEntryOffset;
+        }
+
+        fileWatcher->path[fileWatcher->pathLength] = '\0';
+        ReadFileWatcherChanges(fileWatcher);
+        return count;
+    }
+
+    void Win32Platform::DestroyFileWatcher(void* watcher)
+    {
+        if (watcher)
+        {
+            auto fileWatcher = reinterpret_cast<Win32FileWatcher*>(watcher);
+            DWORD size = 0u;
+
+            // Pending read writes into the buffer. Wait for the cancellation before releasing it.
+            if (::CancelIoEx(fileWatcher->directory, &fileWatcher->overlapped))
+            {
+                ::GetOverlappedResult(fileWatcher->directory, &fileWatcher->overlapped, &size, TRUE);
+            }
+
+            ::CloseHandle(fileWatcher->overlapped.hEvent);
+            ::CloseHandle(fileWatcher->directory);
+            Memory::Delete(fileWatcher);
+        }
+    }
+
 
 
     double Win32Platform::GetTimeSeconds()
@@ -900,11 +1062,17 @@ namespace PK
         ::ShowWindow(window, value ? SW_SHOW : SW_HIDE);
     }
 
-    uint32_t Win32Platform::RemoteProcess(const char* executable, const char* arguments)
+    struct Win32RemoteProcess
+    {
+        HANDLE process;
+        HANDLE outputRead;
+    };
+
+    static bool GetRemoteProcessPath(const char* executable, const char* arguments, FixedWString512* outExecutable, FixedWString512* outArguments)
     {
         if (!executable || !executable[0] || !arguments || !arguments[0])
         {
-            return 1u;
+            return false;
         }
 
         auto executableLen = strlen(executable);
@@ -924,11 +1092,23 @@ namespace PK
 
         if (executableLen == 0ull)
         {
-            return 1u;
+            return false;
         }
 
-        FixedWString512 wideExecutable(executableLen, executable);
-        FixedWString512 wideArguments(argumentsLen, arguments);
+        *outExecutable = FixedWString512(executableLen, executable);
+        *outArguments = FixedWString512(argumentsLen, arguments);
+        return true;
+    }
+
+    uint32_t Win32Platform::RemoteProcess(const char* executable, const char* arguments)
+    {
+        FixedWString512 wideExecutable;
+        FixedWString512 wideArguments;
+
+        if (!GetRemoteProcessPath(executable, arguments, &wideExecutable, &wideArguments))
+        {
+            return 1u;
+        }
 
         STARTUPINFO si;
         PROCESS_INFORMATION pi;
@@ -949,6 +1129,178 @@ namespace PK
         return 0u;
     }
 
+    void* Win32Platform::RemoteProcessStart(const char* executable, const char* arguments)
+    {
+        FixedWString512 wideExecutable;
+        FixedWString512 wideArguments;
+
+        if (!GetRemoteProcessPath(executable, arguments, &wideExecutable, &wideArguments))
+        {
+            return nullptr;
+        }
+
+        SECURITY_ATTRIBUTES sa{ sizeof(SECURITY_ATTRIBUTES), NULL, TRUE };
+        HANDLE outputRead = NULL;
+        HANDLE outputWrite = NULL;
+
+        if (!::CreatePipe(&outputRead, &outputWrite, &sa, 0))
+        {
+            return nullptr;
+        }
+
+        // Only the write end should be inherited by the child.
+        ::SetHandleInformation(outputRead, HANDLE_FLAG_INHERIT, 0);
+
+        STARTUPINFOW si;
+        PROCESS_INFORMATION pi;
+
+        ZeroMemory(&si, sizeof(si));
+        si.cb = sizeof(si);
+        si.dwFlags = STARTF_USESTDHANDLES;
+        si.hStdInput = ::GetStdHandle(STD_INPUT_HANDLE);
+        si.hStdOutput = outputWrite;
+        si.hStdError = outputWrite;
+        ZeroMemory(&pi, sizeof(pi));
+
+        auto result = ::CreateProcessW(wideExecutable, wideArguments, NULL, NULL, TRUE, CREATE_NO_WINDOW, NULL, NULL, &si, &pi);
+
+        // The child has its own copy. Closing ours lets the pipe break once the child exits.
+        ::CloseHandle(outputWrite);
+
+        if (result == 0)
+        {
+            ::CloseHandle(outputRead);
+            return nullptr;
+        }
+
+        ::CloseHandle(pi.hThread);
+
+        auto process = Memory::New<Win32RemoteProcess>();
+        process->process = pi.hProcess;
+        process->outputRead = outputRead;
+        return process;
+    }
+
+    uint32_t Win32Platform::RemoteProcessRead(void* process, char* buffer, uint32_t size)
+    {
+        auto remote = reinterpret_cast<Win32RemoteProcess*>(process);
+        DWORD available = 0u;
+        DWORD read = 0u;
+
+        // Peek first as ReadFile would block on an empty pipe.
+        if (!::PeekNamedPipe(remote->outputRead, NULL, 0u, NULL, &available, NULL) || available == 0u)
+        {
+            return 0u;
+        }
+
+        if (!::ReadFile(remote->outputRead, buffer, available < size ? available : size, &read, NULL))
+        {
+            return 0u;
+        }
+
+        return (uint32_t)read;
+    }
+
+    bool Win32Platform::RemoteProcessPoll(void* process, uint32_t* outExitCode)
+    {
+        auto remote = reinterpret_cast<Win32RemoteProcess*>(process);
+
+        if (::WaitForSingleObject(remote->process, 0u) != WAIT_OBJECT_0)
+        {
+            return false;
+        }
+
+        DWORD exitCode = 0u;
+        ::GetExitCodeProcess(remote->process, &exitCode);
+        *outExitCode = (uint32_t)exitCode;
+        return true;
+    }
+
+    void Win32Platform::RemoteProcessTerminate(void* process)
+    {
+        ::TerminateProcess(reinterpret_cast<Win32RemoteProcess*>(process)->process, 1u);
+    }
+
+    void Win32Platform::RemoteProcessClose(void* process)
+    {
+        if (process)
+        {
+            auto remote = reinterpret_cast<Win32RemoteProcess*>(process);
+            ::CloseHandle(remote->outputRead);
+            ::CloseHandle(remote->process);
+            Memory::Delete(remote);
+        }
+    }
+
+
+    uint32_t Win32Platform::GetProcessorCount()
+    {
+        SYSTEM_INFO info;
+        ::GetSystemInfo(&info);
+        return (uint32_t)info.dwNumberOfProcessors;
+    }
+
+    void* Win32Platform::CreateThread(void* ctx, void (*function)(void*))
+    {
+        struct ThreadStart
+        {
+            void* ctx;
+            void (*function)(void*);
+
+            static DWORD WINAPI Main(LPVOID parameter)
+            {
+                auto start = *reinterpret_cast<ThreadStart*>(parameter);
+                Memory::Delete(reinterpret_cast<ThreadStart*>(parameter));
+                start.function(start.ctx);
+                return 0u;
+            }
+        };
+
+        auto start = Memory::New<ThreadStart>();
+        start->ctx = ctx;
+        start->function = function;
+        auto thread = ::CreateThread(NULL, 0, ThreadStart::Main, start, 0, NULL);
+
+        if (thread == NULL)
+        {
+            Memory::Delete(start);
+        }
+
+        return thread;
+    }
+
+    void Win32Platform::JoinThread(void* thread)
+    {
+        if (thread)
+        {
+            ::WaitForSingleObject((HANDLE)thread, INFINITE);
+            ::CloseHandle((HANDLE)thread);
+        }
+    }
+
+    void* Win32Platform::CreateSemaphore(uint32_t initialCount, uint32_t maxCount)
+    {
+        return ::CreateSemaphoreW(NULL, (LONG)initialCount, (LONG)maxCount, NULL);
+    }
+
+    void Win32Platform::DestroySemaphore(void* semaphore)
+    {
+        if (semaphore)
+        {
+            ::CloseHandle((HANDLE)semaphore);
+        }
+    }
+
+    void Win32Platform::SignalSemaphore(void* semaphore, uint32_t count)
+    {
+        ::ReleaseSemaphore((HANDLE)semaphore, (LONG)count, NULL);
+    }
+
+    void Win32Platform::WaitSemaphore(void* semaphore)
+    {
+        ::WaitForSingleObject((HANDLE)semaphore, INFINITE);
+    }
+
 
     bool Win32Platform::IsGreaterOSVersion(WORD major, WORD minor, WORD sp)
     {
@@ -96,6 +96,7 @@
 #undef GetClassName
 #undef GetMessage
 #undef CreateMutex
+#undef CreateSemaphore
 #undef DrawState
 #undef LoadLibrary
 #undef GetEnvironmentVariable
@@ -139,6 +140,9 @@ namespace PK
         static bool CreateDirectory(const char* path);
         static bool DirectoryExists(const char* path);
         static bool FileExists(const char* path);
+        static void* CreateFileWatcher(const char* directory, bool recursive);
+        static uint32_t PollFileWatcher(void* watcher, void* ctx, void (*onChange)(void*, const char*));
+        static void DestroyFileWatcher(void* watcher);
 
         static double GetTimeSeconds();
         static uint64_t GetTimeCycles();
@@ -159,12 +163,26 @@ namespace PK
         static void SetConsoleColor(uint32_t color);
         static void SetConsoleVisible(bool value);
         static uint32_t RemoteProcess(const char* executable, const char* arguments);
+        static void* RemoteProcessStart(const char* executable, const char* arguments);
+        static uint32_t RemoteProcessRead(void* process, char* buffer, uint32_t size);
+        static bool RemoteProcessPoll(void* process, uint32_t* outExitCode);
+        static void RemoteProcessTerminate(void* process);
+        static void RemoteProcessClose(void* process);
+
+        static uint32_t GetProcessorCount();
+        static void* CreateThread(void* ctx, void (*function)(void*));
+        static void JoinThread(void* thread);
+        static void* CreateSemaphore(uint32_t initialCount, uint32_t maxCount);
+        static void DestroySemaphore(void* semaphore);
+        static void SignalSemaphore(void* semaphore, uint32_t count);
+        static void WaitSemaphore(void* semaphore);
 
         inline static uint32_t InterlockedExchange(volatile uint32_t* dst, uint32_t exchange) { return _InterlockedExchange(dst, exchange); }
         inline static uint32_t InterlockedCompareExchange(volatile uint32_t* dst, uint32_t exchange, uint32_t comperand) { return _InterlockedCompareExchange(dst, exchange, comperand); }
         inline static uint32_t InterlockedAdd(volatile uint32_t* dst, uint32_t value) { return _InterlockedExchangeAdd(dst, value); }
         inline static uint32_t InterlockedIncrement(volatile uint32_t* dst) { return _InterlockedIncrement(dst); }
         inline static uint32_t InterlockedDecrement(volatile uint32_t* dst) { return _InterlockedDecrement(dst); }
+        inline static int64_t InterlockedAdd64(volatile int64_t* dst, int64_t value) { return _InterlockedExchangeAdd64(dst, value); }
         inline static uint32_t AtomicRead(const volatile uint32_t* dst) { return static_cast<unsigned>(__iso_volatile_load32(reinterpret_cast<const volatile int32_t*>(dst))); }
         inline static void AtomicStore(uint32_t volatile* dst, uint32_t value) { __iso_volatile_store32(reinterpret_cast<volatile int32_t*>(dst), static_cast<int32_t>(value)); }
         inline static uint64_t BitScan64(uint64_t mask) { auto index = 0ul; return _BitScanForward64(&index, mask) ? index : 64u; }
@@ -0,0 +1,43 @@
+#include "PrecompiledHeader.h"
+#include "Core/CLI/Log.h"
+#include "Core/RHI/Null/NullDriver.h"
+#include "NullAccelerationStructure.h"
+
+namespace PK
+{
+    NullAccelerationStructure::NullAccelerationStructure(NullDriver* driver, const char* name) :
+        m_driver(driver),
+        m_name(name),
+        m_substructures(32u, 1u)
+    {
+    }
+
+    void NullAccelerationStructure::BeginWrite(QueueType queue, uint32_t instanceLimit)
+    {
+        m_queue = queue;
+        m_instanceCount = 0u;
+        m_instanceLimit = instanceLimit;
+    }
+
+    void NullAccelerationStructure::AddInstance(const RayTracingGeometryInfo& geometry, [[maybe_unused]] const float3x4& matrix)
+    {
+        PK_DEBUG_FATAL_ASSERT(m_instanceCount < m_instanceLimit, "Instance limit exceeded!");
+
+        // Same key as the vulkan structure. 16 & 32 bit index ranges can share a buffer.
+        struct StructureKey
+        {
+            const RHIBuffer* indexBuffer;
+            uint64_t range;
+        };
+
+        const auto indexByteOffset = (uint64_t)geometry.indexFirst * geometry.indexStride;
+        StructureKey key{ geometry.indexBuffer, (indexByteOffset & 0xFFFFFFFFu) | (((uint64_t)geometry.indexCount) << 32ull) };
+        m_substructures.Add(Hash::FNV1AHash(&key, sizeof(key)));
+        m_instanceCount++;
+    }
+
+    void NullAccelerationStructure::EndWrite()
+    {
+        m_lastBuildFence = m_driver->GetQueues()->GetFenceRef(m_queue);
+    }
+}
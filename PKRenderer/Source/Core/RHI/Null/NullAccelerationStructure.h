@@ -0,0 +1,29 @@
+#pragma once
+#include "Core/Base/Containers/HashMap.h"
+#include "Core/ControlFlow/FenceRef.h"
+#include "Core/RHI/RHInterfaces.h"
+
+namespace PK
+{
+    // Counts instances & unique geometries. Builds complete with the submit of the recording queue.
+    struct NullAccelerationStructure : public RHIAccelerationStructure
+    {
+        NullAccelerationStructure(struct NullDriver* driver, const char* name);
+
+        void BeginWrite(QueueType queue, uint32_t instanceLimit) final;
+        void AddInstance(const RayTracingGeometryInfo& geometry, const float3x4& matrix) final;
+        void EndWrite() final;
+        uint32_t GetInstanceCount() const final { return m_instanceCount; }
+        uint32_t GetSubStructureCount() const final { return m_substructures.GetCount(); }
+        FenceRef GetLastBuildFenceRef() const final { return m_lastBuildFence; }
+
+    private:
+        NullDriver* m_driver;
+        const FixedString128 m_name;
+        QueueType m_queue = QueueType::Graphics;
+        uint32_t m_instanceLimit = 0u;
+        uint32_t m_instanceCount = 0u;
+        HashSet<uint64_t> m_substructures;
+        FenceRef m_lastBuildFence{};
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "Core/Base/Containers/HashMap.h"
+#include "Core/RHI/RHInterfaces.h"
+
+namespace PK
+{
+    // View ranges are ignored. Resources are always bound as a whole.
+    struct NullBindSet : public RHIBindSet<RHITexture>,
+                         public RHIBindSet<RHIBuffer>
+    {
+        NullBindSet(size_t capacity) : m_textures((uint32_t)capacity, 1u), m_buffers((uint32_t)capacity, 1u) {}
+
+        int32_t Add(RHITexture* value, [[maybe_unused]] void* bindInfo) final { return Add(m_textures, value); }
+        int32_t Add(RHITexture* value) final { return Add(m_textures, value); }
+        int32_t Add(RHIBuffer* value, [[maybe_unused]] void* bindInfo) final { return Add(m_buffers, value); }
+        int32_t Add(RHIBuffer* value) final { return Add(m_buffers, value); }
+
+        uint3 GetBoundTextureSize(uint32_t index) const final
+        {
+            return index < m_textures.GetCount() ? m_textures[index]->GetResolution() : PK_UINT3_ZERO;
+        }
+
+        BufferIndexRange GetBoundBufferRange(uint32_t index) const final
+        {
+            return index < m_buffers.GetCount() ? m_buffers[index]->GetFullRange() : BufferIndexRange{ 0u, 0u };
+        }
+
+        void Clear() final 
+        {
+            m_textures.ClearFast();
+            m_buffers.ClearFast();
+        }
+
+    private:
+        template<typename T>
+        static int32_t Add(HashSet16<const T*>& set, const T* value)
+        {
+            if (value == nullptr || set.GetCount() >= set.GetCapacity())
+            {
+                return -1;
+            }
+
+            uint32_t index = 0u;
+            set.Add(value, &index);
+            return (int32_t)index;
+        }
+
+        HashSet16<const RHITexture*> m_textures;
+        HashSet16<const RHIBuffer*> m_buffers;
+    };
+}
@@ -0,0 +1,38 @@
+#include "PrecompiledHeader.h"
+#include "Core/CLI/Log.h"
+#include "Core/RHI/Null/NullDriver.h"
+#include "NullBuffer.h"
+
+namespace PK
+{
+    NullBuffer::NullBuffer(NullDriver* driver, size_t size, BufferUsage usage, const char* name) :
+        m_driver(driver),
+        m_name(name),
+        m_usage(usage),
+        m_size(size)
+    {
+        // Large sparse buffers are only touched up to their allocation head. Pages beyond that are never committed.
+        m_data = Memory::Allocate<uint8_t>(size);
+        m_driver->TrackAllocation((int64_t)size);
+    }
+
+    NullBuffer::~NullBuffer()
+    {
+        m_driver->TrackAllocation(-(int64_t)m_size);
+        Memory::Free(m_data);
+    }
+
+    void* NullBuffer::BeginMap(size_t offset, size_t readsize) const
+    {
+        PK_FATAL_ASSERT(offset + readsize <= m_size, "Buffer '%s' map range out of bounds!", m_name.c_str());
+        return m_data + offset;
+    }
+
+    size_t NullBuffer::SparseAllocate(const size_t size, [[maybe_unused]] QueueType type)
+    {
+        PK_FATAL_ASSERT(m_sparseHead + size <= m_size, "Sparse buffer '%s' capacity exceeded!", m_name.c_str());
+        auto offset = m_sparseHead;
+        m_sparseHead += size;
+        return offset;
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "Core/RHI/RHInterfaces.h"
+
+namespace PK
+{
+    // Host memory backed buffer. Device address is the host pointer.
+    struct NullBuffer : public RHIBuffer
+    {
+        NullBuffer(struct NullDriver* driver, size_t size, BufferUsage usage, const char* name);
+        ~NullBuffer();
+
+        size_t GetSize() const final { return m_size; }
+        BufferUsage GetUsage() const final { return m_usage; }
+        const char* GetDebugName() const final { return m_name.c_str(); }
+        void* GetNativeHandle() const final { return m_data; }
+        uint64_t GetDeviceAddress() const final { return reinterpret_cast<uint64_t>(m_data); }
+
+        void* BeginMap(size_t offset, size_t readsize) const final;
+        void EndMap([[maybe_unused]] size_t offset, [[maybe_unused]] size_t size) const final {}
+
+        size_t SparseAllocate(const size_t size, QueueType type) final;
+        void SparseAllocateRange([[maybe_unused]] const BufferIndexRange& range, [[maybe_unused]] QueueType type) final {}
+        void SparseDeallocate([[maybe_unused]] const BufferIndexRange& range) final {}
+
+    private:
+        NullDriver* m_driver;
+        const FixedString128 m_name;
+        BufferUsage m_usage = BufferUsage::None;
+        uint8_t* m_data = nullptr;
+        size_t m_size = 0ull;
+        size_t m_sparseHead = 0ull;
+    };
+}
@@ -0,0 +1,53 @@
+#include "PrecompiledHeader.h"
+#include "Core/RHI/Null/NullQueue.h"
+#include "NullCommandBuffer.h"
+
+namespace PK
+{
+    void NullCommandStats::Add(const NullCommandStats& other)
+    {
+        for (auto i = 0u; i < (uint32_t)NullCommandType::Count; ++i)
+        {
+            counts[i] += other.counts[i];
+        }
+
+        commandCount += other.commandCount;
+        submitCount += other.submitCount;
+        bytesUploaded += other.bytesUploaded;
+    }
+
+    FenceRef NullCommandBuffer::GetFenceRef() const
+    {
+        return m_queues->GetFenceRef(m_queue);
+    }
+
+    void NullCommandBuffer::Clear(RHIBuffer* dst, size_t offset, size_t size, uint32_t value)
+    {
+        Record(NullCommandType::Clear);
+
+        auto words = static_cast<uint32_t*>(dst->BeginMap(offset, size));
+
+        for (auto i = 0ull; i < size / sizeof(uint32_t); ++i)
+        {
+            words[i] = value;
+        }
+    }
+
+    void NullCommandBuffer::UpdateBuffer(RHIBuffer* dst, size_t offset, size_t size, const void* data)
+    {
+        Record(NullCommandType::UpdateBuffer, size);
+        memcpy(dst->BeginMap(offset, size), data, size);
+    }
+
+    void NullCommandBuffer::CopyBuffer(RHIBuffer* dst, RHIBuffer* src, size_t srcOffset, size_t dstOffset, size_t size)
+    {
+        Record(NullCommandType::CopyBuffer);
+        memmove(dst->BeginMap(dstOffset, size), src->BeginMap(srcOffset, size), size);
+    }
+
+    void* NullCommandBuffer::BeginBufferWrite(RHIBuffer* buffer, size_t offset, size_t size)
+    {
+        Record(NullCommandType::BufferWrite, size);
+        return buffer->BeginMap(offset, size);
+    }
+}
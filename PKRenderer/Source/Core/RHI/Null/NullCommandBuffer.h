@@ -0,0 +1,127 @@
+#pragma once
+#include "Core/ControlFlow/FenceRef.h"
+#include "Core/RHI/RHInterfaces.h"
+
+namespace PK
+{
+    enum class NullCommandType : uint32_t
+    {
+        SetRenderTarget,
+        SetViewPorts,
+        SetScissors,
+        SetState,
+        SetShader,
+        SetVertexBuffers,
+        SetIndexBuffer,
+        SetShaderBindingTable,
+        Draw,
+        DrawIndirect,
+        DrawMeshTasks,
+        Dispatch,
+        DispatchRays,
+        Blit,
+        Clear,
+        UpdateBuffer,
+        CopyBuffer,
+        BufferWrite,
+        CopyToTexture,
+        InvalidateTexture,
+        DebugScope,
+        Count
+    };
+
+    struct NullCommandStats
+    {
+        constexpr static const char* TYPE_NAMES[(uint32_t)NullCommandType::Count] =
+        {
+            "SetRenderTarget",
+            "SetViewPorts",
+            "SetScissors",
+            "SetState",
+            "SetShader",
+            "SetVertexBuffers",
+            "SetIndexBuffer",
+            "SetShaderBindingTable",
+            "Draw",
+            "DrawIndirect",
+            "DrawMeshTasks",
+            "Dispatch",
+            "DispatchRays",
+            "Blit",
+            "Clear",
+            "UpdateBuffer",
+            "CopyBuffer",
+            "BufferWrite",
+            "CopyToTexture",
+            "InvalidateTexture",
+            "DebugScope"
+        };
+
+        uint32_t counts[(uint32_t)NullCommandType::Count]{};
+        uint32_t commandCount = 0u;
+        uint32_t submitCount = 0u;
+        uint64_t bytesUploaded = 0ull;
+
+        void Add(const NullCommandStats& other);
+    };
+
+    // Commands are not executed. Each recorded command is counted by type until the next submit.
+    // Buffer writes resolve to host memory directly.
+    struct NullCommandBuffer : public RHICommandBuffer
+    {
+        NullCommandBuffer(struct NullQueueSet* queues, QueueType queue) : m_queues(queues), m_queue(queue) {}
+
+        FenceRef GetFenceRef() const final;
+        void SetRenderTarget(const RenderTargetBinding*, uint32_t, const uint4&, uint32_t) final { Record(NullCommandType::SetRenderTarget); }
+        void SetViewPorts(const uint4*, uint32_t) final { Record(NullCommandType::SetViewPorts); }
+        void SetScissors(const uint4*, uint32_t) final { Record(NullCommandType::SetScissors); }
+        void SetStageExcludeMask(const ShaderStageFlags) final { Record(NullCommandType::SetState); }
+        void SetBlending(const BlendParameters&) final { Record(NullCommandType::SetState); }
+        void SetRasterization(const RasterizationParameters&) final { Record(NullCommandType::SetState); }
+        void SetDepthStencil(const DepthStencilParameters&) final { Record(NullCommandType::SetState); }
+        void SetMultisampling(const MultisamplingParameters&) final { Record(NullCommandType::SetState); }
+        void SetShader(const RHIShader*) final { Record(NullCommandType::SetShader); }
+        void SetVertexBuffers(const RHIBuffer**, uint32_t) final { Record(NullCommandType::SetVertexBuffers); }
+        void SetVertexStreams(const VertexStreamElement*, uint32_t) final { Record(NullCommandType::SetVertexBuffers); }
+        void SetIndexBuffer(const RHIBuffer*, size_t) final { Record(NullCommandType::SetIndexBuffer); }
+        void SetShaderBindingTable(RayTracingShaderGroup, const RHIBuffer*, size_t, size_t, size_t) final { Record(NullCommandType::SetShaderBindingTable); }
+        void Draw(uint32_t, uint32_t, uint32_t, uint32_t) final { Record(NullCommandType::Draw); }
+        void DrawIndirect(const RHIBuffer*, size_t, uint32_t, uint32_t) final { Record(NullCommandType::DrawIndirect); }
+        void DrawIndexed(uint32_t, uint32_t, uint32_t, int32_t, uint32_t) final { Record(NullCommandType::Draw); }
+        void DrawIndexedIndirect(const RHIBuffer*, size_t, uint32_t, uint32_t) final { Record(NullCommandType::DrawIndirect); }
+        void DrawMeshTasks(const uint3&) final { Record(NullCommandType::DrawMeshTasks); }
+        void DrawMeshTasksIndirect(const RHIBuffer*, size_t, uint32_t, uint32_t) final { Record(NullCommandType::DrawMeshTasks); }
+        void DrawMeshTasksIndirectCount(const RHIBuffer*, size_t, const RHIBuffer*, size_t, uint32_t, uint32_t) final { Record(NullCommandType::DrawMeshTasks); }
+        void Dispatch(const uint3&) final { Record(NullCommandType::Dispatch); }
+        void DispatchRays(const uint3&) final { Record(NullCommandType::DispatchRays); }
+        void Blit(RHITexture*, RHISwapchain*, FilterMode) final { Record(NullCommandType::Blit); }
+        void Blit(RHISwapchain*, RHIBuffer*) final { Record(NullCommandType::Blit); }
+        void Blit(RHITexture*, RHITexture*, const TextureViewRange&, const TextureViewRange&, FilterMode) final { Record(NullCommandType::Blit); }
+        void Clear(RHIBuffer* dst, size_t offset, size_t size, uint32_t value) final;
+        void Clear(RHITexture*, const TextureViewRange&, const TextureClearValue&) final { Record(NullCommandType::Clear); }
+        void UpdateBuffer(RHIBuffer* dst, size_t offset, size_t size, const void* data) final;
+        void CopyBuffer(RHIBuffer* dst, RHIBuffer* src, size_t srcOffset, size_t dstOffset, size_t size) final;
+        void* BeginBufferWrite(RHIBuffer* buffer, size_t offset, size_t size) final;
+        void EndBufferWrite(RHIBuffer*) final {}
+        void CopyToTexture(RHITexture*, RHIBuffer*, TextureDataRegion*, uint32_t) final { Record(NullCommandType::CopyToTexture); }
+        void CopyToTexture(RHITexture*, const void*, size_t size, TextureDataRegion*, uint32_t) final { Record(NullCommandType::CopyToTexture, size); }
+        void InvalidateTexture(RHITexture*) final { Record(NullCommandType::InvalidateTexture); }
+        void BeginDebugScope(const char*, const color&) final { Record(NullCommandType::DebugScope); }
+        void EndDebugScope() final {}
+
+        constexpr const NullCommandStats& GetStats() const { return m_stats; }
+        inline void ResetStats() { m_stats = {}; }
+
+    private:
+        inline void Record(NullCommandType type, size_t bytesUploaded = 0ull)
+        {
+            m_stats.counts[(uint32_t)type]++;
+            m_stats.commandCount++;
+            m_stats.bytesUploaded += bytesUploaded;
+        }
+
+        NullQueueSet* m_queues;
+        QueueType m_queue;
+        NullCommandStats m_stats{};
+    };
+}
@@ -0,0 +1,101 @@
+#include "PrecompiledHeader.h"
+#include "Core/CLI/Log.h"
+#include "Core/CLI/CVariableRegister.h"
+#include "Core/Platform/Platform.h"
+#include "Core/RHI/Null/NullAccelerationStructure.h"
+#include "Core/RHI/Null/NullBindSet.h"
+#include "Core/RHI/Null/NullBuffer.h"
+#include "Core/RHI/Null/NullShader.h"
+#include "Core/RHI/Null/NullSwapchain.h"
+#include "Core/RHI/Null/NullTexture.h"
+#include "NullDriver.h"
+
+namespace PK
+{
+    NullDriver::NullDriver(const RHIDriverDescriptor& descriptor) : 
+        properties(descriptor),
+        globalResources(16384ull, 128u)
+    {
+        PK_LOG_INFO("Using null RHI. GPU work will not be executed.");
+        builtInResources.New();
+
+        CVariableRegister::Create<CVariableFuncSimple>("RHI.Null.Query.Stats", []()
+            {
+                auto driver = static_cast<NullDriver*>(RHIDriver::Get());
+                auto& stats = driver->GetFrameStats();
+                PK_LOG_HEADER("----------NULL RHI FRAME STATS----------");
+                PK_LOG_NEWLINE();
+                PK_LOG_INFO("Submits: %u", stats.submitCount);
+                PK_LOG_INFO("Commands: %u", stats.commandCount);
+                PK_LOG_INFO("Uploaded: %s", String::FormatBytes<16>(stats.bytesUploaded).c_str());
+
+                for (auto i = 0u; i < (uint32_t)NullCommandType::Count; ++i)
+                {
+                    if (stats.counts[i] > 0u)
+                    {
+                        PK_LOG_INFO("%-24s %u", NullCommandStats::TYPE_NAMES[i], stats.counts[i]);
+                    }
+                }
+
+                PK_LOG_NEWLINE();
+            });
+    }
+
+    NullDriver::~NullDriver()
+    {
+        builtInResources.Delete();
+        stage = nullptr;
+    }
+
+    RHIDriverMemoryInfo NullDriver::GetMemoryInfo() const
+    {
+        RHIDriverMemoryInfo info{};
+        info.blockCount = allocationCount;
+        info.allocationCount = allocationCount;
+        info.usedBytes = (size_t)allocatedBytes;
+        return info;
+    }
+
+    RHIAccelerationStructureRef NullDriver::CreateAccelerationStructure(const char* name) { return CreateRef<NullAccelerationStructure>(this, name); }
+    RHITextureBindSetRef NullDriver::CreateTextureBindSet(size_t capacity) { return CreateRef<NullBindSet>(capacity); }
+    RHIBufferBindSetRef NullDriver::CreateBufferBindSet(size_t capacity) { return CreateRef<NullBindSet>(capacity); }
+    RHIBufferRef NullDriver::CreateBuffer(size_t size, BufferUsage usage, const char* name) { return CreateRef<NullBuffer>(this, size, usage, name); }
+    RHITextureRef NullDriver::CreateTexture(const TextureDescriptor& descriptor, const char* name) { return CreateRef<NullTexture>(descriptor, name); }
+    RHIShaderRef NullDriver::CreateShader(void* base, PKAssets::PKShaderVariant* pVariant, const char* name) { return CreateRef<NullShader>(base, pVariant, name); }
+    RHISwapchainScope NullDriver::CreateSwapchain(const SwapchainDescriptor& descriptor) { return CreateUnique<NullSwapchain>(descriptor); }
+
+    RHIBuffer* NullDriver::AcquireStage(size_t size)
+    {
+        // Uploads complete immediately. A single stage can be reused.
+        if (stage == nullptr || stage->GetSize() < size)
+        {
+            stage = CreateBuffer(size, BufferUsage::DefaultStaging, "Null.Stage");
+        }
+
+        queues.AddBytesUploaded(size);
+        return stage.get();
+    }
+
+    void NullDriver::SetConstant(NameID name, const void* data, uint32_t size) { globalResources.Set<char>(name, static_cast<const char*>(data), size); }
+    void NullDriver::SetKeyword(NameID name, bool value) { globalResources.Set<bool>(name, value); }
+
+    void NullDriver::GC()
+    {
+        frameStats = queues.ResetFrameStats();
+        globalResources.NextFrame();
+    }
+
+    void NullDriver::TrackAllocation(int64_t size)
+    {
+        Platform::InterlockedAdd64(&allocatedBytes, size);
+
+        if (size >= 0ll)
+        {
+            Platform::InterlockedIncrement(&allocationCount);
+        }
+        else
+        {
+            Platform::InterlockedDecrement(&allocationCount);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Core/Base/Containers/VersionedPropertyBlock.h"
+#include "Core/Base/Types/Ref.h"
+#include "Core/RHI/RHInterfaces.h"
+#include "Core/RHI/BuiltInResources.h"
+#include "Core/RHI/Null/NullQueue.h"
+
+namespace PK
+{
+    // Device-less driver for measuring the cpu side of rendering.
+    // Buffers are backed by host memory, commands are counted instead of executed & fences complete immediately.
+    struct NullDriver : public RHIDriver
+    {
+        NullDriver(const RHIDriverDescriptor& descriptor);
+        ~NullDriver();
+
+        RHIAPI GetAPI() const final { return RHIAPI::Null; }
+        RHIQueueSet* GetQueues() const final { return &queues; }
+        RHIDriverMemoryInfo GetMemoryInfo() const final;
+        // Nothing is bound on the null backend.
+        RHIDriverBindStats GetBindStats() const final { return {}; }
+        FixedString32 GetDriverHeader() const final { return FixedString32(" - Null"); }
+        size_t GetBufferOffsetAlignment([[maybe_unused]] BufferUsage usage) const final { return 16ull; }
+        BuiltInResources* GetBuiltInResources() final { return builtInResources; }
+        VersionedPropertyBlock* GetResourceState() final { return &globalResources; }
+
+        RHIAccelerationStructureRef CreateAccelerationStructure(const char* name) final;
+        RHITextureBindSetRef CreateTextureBindSet(size_t capacity) final;
+        RHIBufferBindSetRef CreateBufferBindSet(size_t capacity) final;
+        RHIBufferRef CreateBuffer(size_t size, BufferUsage usage, const char* name) final;
+        RHITextureRef CreateTexture(const TextureDescriptor& descriptor, const char* name) final;
+        RHIShaderRef CreateShader(void* base, PKAssets::PKShaderVariant* pVariant, const char* name) final;
+        RHISwapchainScope CreateSwapchain(const SwapchainDescriptor& descriptor) final;
+
+        RHIBuffer* AcquireStage(size_t size) final;
+        void ReleaseStage([[maybe_unused]] RHIBuffer* buffer, [[maybe_unused]] const FenceRef& fence) final {}
+
+        void SetBuffers(NameID, RHIBuffer**, const BufferIndexRange*, size_t) final {}
+        void SetBufferSet(NameID, RHIBufferBindSet*) final {}
+        void SetTextures(NameID, RHITexture**, const TextureViewRange*, size_t) final {}
+        void SetTextureSet(NameID, RHITextureBindSet*) final {}
+        void SetImages(NameID, RHITexture**, const TextureViewRange*, size_t) final {}
+        void SetSamplers(NameID, const SamplerDescriptor*, size_t) final {}
+        void SetAccelerationStructures(NameID, RHIAccelerationStructure**, size_t) final {}
+        void SetConstant(NameID name, const void* data, uint32_t size) final;
+        void SetKeyword(NameID name, bool value) final;
+
+        void WaitForIdle() const final {}
+        void GC() final;
+
+        // Command counts of the last completed frame. Updated by GC.
+        constexpr const NullCommandStats& GetFrameStats() const { return frameStats; }
+        void TrackAllocation(int64_t size);
+
+        RHIDriverDescriptor properties;
+        mutable NullQueueSet queues;
+        FixedUnique<BuiltInResources> builtInResources;
+        VersionedPropertyBlock globalResources;
+        RHIBufferRef stage;
+        NullCommandStats frameStats{};
+        volatile int64_t allocatedBytes = 0ll;
+        volatile uint32_t allocationCount = 0u;
+    };
+}
@@ -0,0 +1,41 @@
+#include "PrecompiledHeader.h"
+#include "NullQueue.h"
+
+namespace PK
+{
+    NullQueueSet::NullQueueSet() : m_commandBuffers
+        {
+            { this, QueueType::Transfer },
+            { this, QueueType::Graphics },
+            { this, QueueType::Compute },
+            { this, QueueType::Present }
+        }
+    {
+    }
+
+    FenceRef NullQueueSet::GetFenceRef(QueueType type, int32_t submitOffset)
+    {
+        // Value of the next submit + offset.
+        auto timeline = &m_timelines[(uint32_t)type];
+        auto value = (int64_t)*timeline + 1ll + submitOffset;
+        return FenceRef(timeline, []([[maybe_unused]] const void* ctx, [[maybe_unused]] uint64_t value, [[maybe_unused]] uint64_t timeout) { return true; }, value > 0ll ? (uint64_t)value : 0ull);
+    }
+
+    RHICommandBuffer* NullQueueSet::Submit(QueueType type)
+    {
+        auto commandBuffer = &m_commandBuffers[(uint32_t)type];
+        m_frameStats.Add(commandBuffer->GetStats());
+        m_frameStats.submitCount++;
+        commandBuffer->ResetStats();
+        m_timelines[(uint32_t)type]++;
+        m_lastSubmitQueue = type;
+        return commandBuffer;
+    }
+
+    NullCommandStats NullQueueSet::ResetFrameStats()
+    {
+        auto stats = m_frameStats;
+        m_frameStats = {};
+        return stats;
+    }
+}
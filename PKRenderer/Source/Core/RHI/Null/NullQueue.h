@@ -0,0 +1,30 @@
+#pragma once
+#include "Core/ControlFlow/FenceRef.h"
+#include "Core/RHI/RHInterfaces.h"
+#include "Core/RHI/Null/NullCommandBuffer.h"
+
+namespace PK
+{
+    // Each queue keeps a timeline of submits. Fences are complete as soon as they are created.
+    // Values still increase per submit so that fence ordered consumers behave like they do with a device.
+    struct NullQueueSet : public RHIQueueSet
+    {
+        NullQueueSet();
+
+        RHICommandBuffer* GetCommandBuffer(QueueType type) final { return &m_commandBuffers[(uint32_t)type]; }
+        FenceRef GetFenceRef(QueueType type, int32_t submitOffset = 0) final;
+        FenceRef GetLastSubmitFenceRef() final { return GetFenceRef(m_lastSubmitQueue, -1); }
+        RHICommandBuffer* Submit(QueueType type) final;
+        void Wait([[maybe_unused]] QueueType to, [[maybe_unused]] QueueType from, [[maybe_unused]] int32_t submitOffset = 0) final {}
+
+        // Counts of submitted commands since the last call.
+        NullCommandStats ResetFrameStats();
+        inline void AddBytesUploaded(size_t size) { m_frameStats.bytesUploaded += size; }
+
+    private:
+        NullCommandBuffer m_commandBuffers[(uint32_t)QueueType::MaxCount];
+        uint64_t m_timelines[(uint32_t)QueueType::MaxCount]{};
+        QueueType m_lastSubmitQueue = QueueType::Graphics;
+        NullCommandStats m_frameStats{};
+    };
+}
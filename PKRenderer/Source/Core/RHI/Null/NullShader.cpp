@@ -0,0 +1,97 @@
+#include "PrecompiledHeader.h"
+#include <PKAssets/PKAssetLoader.h>
+#include "NullShader.h"
+
+namespace PK
+{
+    NullShader::NullShader(void* base, PKAssets::PKShaderVariant* variant, const char* name) : m_name(name)
+    {
+        m_groupSize = { variant->groupSize[0], variant->groupSize[1], variant->groupSize[2] };
+        m_stageFlags = (ShaderStageFlags)0u;
+
+        for (auto i = 0u; i < (uint32_t)ShaderStage::MaxCount; ++i)
+        {
+            if (variant->sprivSizes[i] > 0)
+            {
+                m_stageFlags = m_stageFlags | (ShaderStageFlags)(1u << i);
+            }
+        }
+
+        if (variant->vertexAttributeCount > 0)
+        {
+            m_vertexLayout.Clear();
+
+            auto* pVertexAttributes = variant->vertexAttributes.Get(base);
+
+            for (auto i = 0u; i < variant->vertexAttributeCount; ++i)
+            {
+                auto attribute = &pVertexAttributes[i];
+                m_vertexLayout.Add({ attribute->name, attribute->type, attribute->location });
+            }
+        }
+
+        if (variant->descriptorCount > 0)
+        {
+            auto pDescriptors = variant->descriptors.Get(base);
+            m_resourceLayout.ClearFast();
+
+            for (auto j = 0u; j < variant->descriptorCount; ++j)
+            {
+                m_resourceLayout.Add(pDescriptors[j].type, pDescriptors[j].name, pDescriptors[j].writeMask, pDescriptors[j].count);
+            }
+        }
+
+        if (variant->constantRange > 0u)
+        {
+            auto pVariables = variant->constants.Get(base);
+
+            m_pushConstantLayout.ClearFast();
+
+            for (auto i = 0u; i < variant->constantCount; ++i)
+            {
+                auto pVariable = pVariables + i;
+                auto constant = m_pushConstantLayout.Add();
+                constant->name = pVariable->name;
+                constant->offset = pVariable->offset;
+                constant->size = pVariable->size;
+            }
+        }
+    }
+
+    // Table layout matches a device with 32 byte handles. Handles are zeroed.
+    ShaderBindingTableInfo NullShader::GetShaderBindingTableInfo() const
+    {
+        constexpr uint16_t handleSize = 32u;
+        constexpr uint16_t tableAlignment = 64u;
+
+        ShaderBindingTableInfo info{};
+        info.handleSize = handleSize;
+        info.handleSizeAligned = handleSize;
+        info.tableAlignment = tableAlignment;
+        info.totalTableSize = 0u;
+
+        RayTracingShaderGroup currentGroup = RayTracingShaderGroup::MaxCount;
+
+        for (auto i = (uint32_t)ShaderStage::RayGeneration; i < (uint32_t)ShaderStage::MaxCount; ++i)
+        {
+            if ((m_stageFlags & (ShaderStageFlags)(1u << i)) != 0u)
+            {
+                if (PK_RHI_SHADER_STAGE_RAYTRACING_GROUP[i] != currentGroup)
+                {
+                    currentGroup = PK_RHI_SHADER_STAGE_RAYTRACING_GROUP[i];
+                    info.totalTableSize = math::align(info.totalTableSize, tableAlignment);
+                    info.byteOffsets[(uint32_t)currentGroup] = info.totalTableSize;
+                    info.byteStrides[(uint32_t)currentGroup] = info.handleSizeAligned;
+                    info.offsets[(uint32_t)currentGroup] = (uint8_t)info.totalHandleCount;
+                    info.layouts[(uint32_t)currentGroup] = nullptr;
+                }
+
+                info.counts[(uint32_t)currentGroup]++;
+                info.totalHandleCount++;
+                info.totalTableSize += info.handleSizeAligned;
+            }
+        }
+
+        return info;
+    }
+}
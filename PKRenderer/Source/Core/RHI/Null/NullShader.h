@@ -0,0 +1,27 @@
+#pragma once
+#include "Core/RHI/RHInterfaces.h"
+#include "Core/RHI/Layout.h"
+
+namespace PK
+{
+    // Layouts are read from the variant as usual. Stage binaries are not used.
+    struct NullShader : public RHIShader
+    {
+        NullShader(void* base, PKAssets::PKShaderVariant* variant, const char* name);
+
+        const ShaderVertexInputLayout& GetVertexLayout() const final { return m_vertexLayout; }
+        const ShaderPushConstantLayout& GetPushConstantLayout() const final { return m_pushConstantLayout; }
+        const ShaderResourceLayout& GetResourceLayout() const final { return m_resourceLayout; }
+        ShaderStageFlags GetStageFlags() const final { return m_stageFlags; }
+        const uint3& GetGroupSize() const final { return m_groupSize; }
+        ShaderBindingTableInfo GetShaderBindingTableInfo() const final;
+
+    private:
+        ShaderVertexInputLayout m_vertexLayout;
+        ShaderPushConstantLayout m_pushConstantLayout;
+        ShaderResourceLayout m_resourceLayout;
+        ShaderStageFlags m_stageFlags = ShaderStageFlags::None;
+        uint3 m_groupSize{};
+        const FixedString128 m_name;
+    };
+}
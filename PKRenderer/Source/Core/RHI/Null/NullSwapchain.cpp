@@ -0,0 +1,19 @@
+#include "PrecompiledHeader.h"
+#include "NullSwapchain.h"
+
+namespace PK
+{
+    NullSwapchain::NullSwapchain(const SwapchainDescriptor& descriptor) :
+        m_resolution(descriptor.desiredResolution),
+        m_format(descriptor.desiredFormat),
+        m_colorSpace(descriptor.desiredColorSpace),
+        m_vsyncMode(descriptor.desiredVSyncMode)
+    {
+    }
+
+    bool NullSwapchain::AcquireNextImage()
+    {
+        // Minimized windows report a zero size. Match the vulkan swapchain & skip the frame.
+        return m_resolution.x > 0u && m_resolution.y > 0u;
+    }
+}
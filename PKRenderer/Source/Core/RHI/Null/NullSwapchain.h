@@ -0,0 +1,35 @@
+#pragma once
+#include "Core/RHI/RHInterfaces.h"
+
+namespace PK
+{
+    // Keeps the desired swapchain state. Images are always available & presents complete immediately.
+    struct NullSwapchain : public RHISwapchain
+    {
+        NullSwapchain(const SwapchainDescriptor& descriptor);
+
+        void SetDesiredResolution(const uint2& resolution) final { m_resolution = resolution; }
+        void SetDesiredFormat(TextureFormat format) final { m_format = format; }
+        void SetDesiredColorSpace(ColorSpace colorSpace) final { m_colorSpace = colorSpace; }
+        void SetDesiredVSyncMode(VSyncMode vsyncMode) final { m_vsyncMode = vsyncMode; }
+        void SetFrameFence([[maybe_unused]] const FenceRef& fence) final {}
+        bool AcquireFullScreen([[maybe_unused]] const void* nativeMonitor) final { return false; }
+        bool AcquireNextImage() final;
+        void Present() final { m_presentCount++; }
+        void WaitForPresent([[maybe_unused]] uint32_t historyOffset, [[maybe_unused]] uint64_t timeoutNanos) final {}
+        bool IsFullScreen() const final { return false; }
+        uint3 GetResolution() const final { return { m_resolution.x, m_resolution.y, 1u }; }
+        TextureFormat GetFormat() const final { return m_format; }
+        ColorSpace GetColorSpace() const final { return m_colorSpace; }
+        VSyncMode GetVSyncMode() const final { return m_vsyncMode; }
+
+        constexpr uint64_t GetPresentCount() const { return m_presentCount; }
+
+    private:
+        uint2 m_resolution;
+        TextureFormat m_format;
+        ColorSpace m_colorSpace;
+        VSyncMode m_vsyncMode;
+        uint64_t m_presentCount = 0ull;
+    };
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "Core/RHI/RHInterfaces.h"
+
+namespace PK
+{
+    // Texel data is never stored. Uploads are only counted.
+    struct NullTexture : public RHITexture
+    {
+        NullTexture(const TextureDescriptor& descriptor, const char* name) : m_descriptor(descriptor), m_name(name) {}
+
+        void SetSampler(const SamplerDescriptor& sampler) final { m_descriptor.sampler = sampler; }
+        const TextureDescriptor& GetDescriptor() const final { return m_descriptor; }
+        const char* GetDebugName() const final { return m_name.c_str(); }
+        void* GetNativeHandle() const final { return nullptr; }
+
+    private:
+        TextureDescriptor m_descriptor;
+        const FixedString128 m_name;
+    };
+}
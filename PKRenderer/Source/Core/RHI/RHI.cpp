@@ -2,9 +2,18 @@
 #include "Core/CLI/Log.h"
 #include "Core/CLI/CVariableRegister.h"
 #include "Core/RHI/RHInterfaces.h"
-#include "Core/RHI/Vulkan/VulkanDriver.h"
+#include "Core/RHI/Null/NullDriver.h"
 #include "RHI.h"
 
+// The Vulkan driver depends on Win32 surface & full screen extensions. Other platforms only have the null driver for now.
+#ifndef PK_RHI_VULKAN
+    #define PK_RHI_VULKAN PK_PLATFORM_WINDOWS
+#endif
+
+#if PK_RHI_VULKAN
+#include "Core/RHI/Vulkan/VulkanDriver.h"
+#endif
+
 namespace PK
 {
     RHIAccelerationStructure::~RHIAccelerationStructure() = default;
@@ -23,12 +32,13 @@ namespace PK
     RHIQueueSet* RHI::GetQueues() { return RHIDriver::Get()->GetQueues(); }
     RHICommandBuffer* RHI::GetCommandBuffer(QueueType queue) { return RHIDriver::Get()->GetQueues()->GetCommandBuffer(queue); }
     RHIDriverMemoryInfo RHI::GetMemoryInfo() { return RHIDriver::Get()->GetMemoryInfo(); }
+    RHIDriverBindStats RHI::GetBindStats() { return RHIDriver::Get()->GetBindStats(); }
     size_t RHI::GetBufferOffsetAlignment(BufferUsage usage) { return RHIDriver::Get()->GetBufferOffsetAlignment(usage); }
     const BuiltInResources* RHI::GetBuiltInResources() { return RHIDriver::Get()->GetBuiltInResources(); }
     void RHI::WaitForIdle() { RHIDriver::Get()->WaitForIdle(); }
     void RHI::GC() { RHIDriver::Get()->GC(); }
 
-    RHIDriverScope RHI::CreateDriver(const char* workingDirectory, const RHIDriverDescriptor& descriptor)
+    RHIDriverScope RHI::CreateDriver([[maybe_unused]] const char* workingDirectory, const RHIDriverDescriptor& descriptor)
     {
         PK_LOG_NEWLINE();
         PK_LOG_HEADER_SCOPE("----------INITIALIZING RHI----------");
@@ -56,6 +66,7 @@ namespace PK
 
         switch (descriptor.api)
         {
+#if PK_RHI_VULKAN
             case RHIAPI::Vulkan:
             {
                 VulkanPhysicalDeviceFeatures features{};
@@ -163,6 +174,13 @@ namespace PK
                 ));
             }
             break;
+#endif
+
+            case RHIAPI::Null:
+            {
+                driver = CreateUnique<NullDriver>(descriptor);
+            }
+            break;
 
             default: PK_FATAL_ERROR("Unsupproted graphics API"); break;
         }
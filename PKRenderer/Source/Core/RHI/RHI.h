@@ -34,6 +34,7 @@ namespace PK
     struct NameID;
     struct FenceRef;
     class PropertyBlock;
+    class VersionedPropertyBlock;
 
     struct DrawIndexedIndirectCommand;
     struct DrawIndirectCommand;
@@ -50,6 +51,7 @@ namespace PK
     struct RenderTargetBinding;
     struct RayTracingGeometryInfo;
     struct RHIDriverMemoryInfo;
+    struct RHIDriverBindStats;
     struct RHIDriverDescriptor;
     struct SwapchainDescriptor;
     struct SamplerDescriptor;
@@ -130,6 +132,7 @@ namespace PK
         RHIQueueSet* GetQueues();
         RHICommandBuffer* GetCommandBuffer(QueueType queue);
         RHIDriverMemoryInfo GetMemoryInfo();
+        RHIDriverBindStats GetBindStats();
         size_t GetBufferOffsetAlignment(BufferUsage usage);
         const BuiltInResources* GetBuiltInResources();
         void WaitForIdle();
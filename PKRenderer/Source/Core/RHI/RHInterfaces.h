@@ -209,10 +209,11 @@ namespace PK
         virtual RHIAPI GetAPI() const = 0;
         virtual RHIQueueSet* GetQueues() const = 0;
         virtual RHIDriverMemoryInfo GetMemoryInfo() const = 0;
+        virtual RHIDriverBindStats GetBindStats() const = 0;
         virtual FixedString32 GetDriverHeader() const = 0;
         virtual size_t GetBufferOffsetAlignment(BufferUsage usage) const = 0;
         virtual BuiltInResources* GetBuiltInResources() = 0;
-        virtual PropertyBlock* GetResourceState() = 0;
+        virtual VersionedPropertyBlock* GetResourceState() = 0;
 
         virtual RHIAccelerationStructureRef CreateAccelerationStructure(const char* name) = 0;
         virtual RHITextureBindSetRef CreateTextureBindSet(size_t capacity) = 0;
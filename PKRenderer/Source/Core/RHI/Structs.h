@@ -37,7 +37,8 @@ namespace PK
     {
         None,
         Vulkan,
-        DX12
+        DX12,
+        Null
     };
 
     enum class QueueType
@@ -461,6 +462,10 @@ namespace PK
         uint32_t vertexStride;
         uint32_t vertexFirst;
         uint32_t vertexCount;
+        // Float3 or Short4. Short4 positions are snorm & dequantized as center + extents * position.
+        ElementType vertexFormat;
+        float3 vertexCenter;
+        float3 vertexExtents;
         uint32_t indexStride;
         uint32_t indexFirst;
         uint32_t indexCount;
@@ -483,6 +488,17 @@ namespace PK
         size_t unusedRangeSizeMax;
     };
 
+    // Render state bind counters of the previous frame.
+    struct RHIDriverBindStats
+    {
+        uint32_t pipelineBinds;
+        uint32_t descriptorSetBinds;
+        uint32_t descriptorSetLookups;
+        uint32_t descriptorSetCacheHits;
+        uint32_t descriptorResolves;
+        uint32_t descriptorResolveSkips;
+    };
+
     struct RHIDriverDescriptor
     {
         RHIAPI api;
@@ -35,7 +35,8 @@ namespace PK
         const DescriptorBinding* bindings,
         const uint32_t bindingCount,
         const FenceRef& fence,
-        const char* name)
+        const char* name,
+        bool* outIsCached)
     {
         SetKey key;
         key.bindings = bindings;
@@ -45,7 +46,14 @@ namespace PK
 
         uint32_t index = 0u;
 
-        if (!m_sets.AddKey(key, &index))
+        const auto isCached = !m_sets.AddKey(key, &index);
+
+        if (outIsCached != nullptr)
+        {
+            *outIsCached = isCached;
+        }
+
+        if (isCached)
         {
             auto set = m_sets[index].value;
             set->pruneTick = m_currentPruneTick + m_pruneDelay;
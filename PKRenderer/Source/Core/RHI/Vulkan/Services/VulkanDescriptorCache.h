@@ -40,7 +40,8 @@ namespace PK
             const DescriptorBinding* bindings,
             const uint32_t bindingCount,
             const FenceRef& fence, 
-            const char* name);
+            const char* name,
+            bool* outIsCached = nullptr);
 
         void SetDescriptorSetFence(const VulkanDescriptorSet* set, const FenceRef& fence) const;
         void Prune();
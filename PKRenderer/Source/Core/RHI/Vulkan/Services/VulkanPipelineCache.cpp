@@ -1,6 +1,7 @@
 #include "PrecompiledHeader.h"
 #include "Core/Base/FileIO.h"
 #include "Core/CLI/Log.h"
+#include "Core/Platform/Platform.h"
 #include "VulkanPipelineCache.h"
 
 namespace PK
@@ -27,11 +28,21 @@ namespace PK
             cacheCreateInfo.pInitialData = cacheData;
             VK_ASSERT_RESULT_CTX(vkCreatePipelineCache(device, &cacheCreateInfo, nullptr, &m_pipelineCache), "Failed to create pipeline cache!");
             Memory::Free(cacheData);
+
+            m_prewarmThread.New();
+            LoadManifest();
         }
     }
 
     VulkanPipelineCache::~VulkanPipelineCache()
     {
+        if (m_prewarmThread)
+        {
+            FlushPrewarm();
+            SaveManifest();
+            m_prewarmThread.Delete();
+        }
+
         if (m_pipelineCache != VK_NULL_HANDLE && m_workingDirectory.Length() != 0)
         {
             size_t size = 0ull;
@@ -47,6 +58,7 @@ namespace PK
         m_vertexPipelines.Clear();
         m_meshPipelines.Clear();
         m_otherPipelines.Clear();
+        m_manifest.Clear();
     }
 
     const VulkanPipeline* VulkanPipelineCache::GetPipeline(const PipelineKey& key)
@@ -73,6 +85,56 @@ namespace PK
     }
 
     const VulkanPipeline* VulkanPipelineCache::GetGraphicsPipeline(const PipelineKey& key)
+    {
+        auto value = GetGraphicsPipelineValue(key);
+
+        if (value->pipeline == nullptr)
+        {
+            auto begin = Platform::GetTimeSeconds();
+            auto manifestIndex = RecordManifestKey(key);
+            auto manifestValue = manifestIndex != -1 ? &m_manifest[manifestIndex].value : nullptr;
+
+            // Already being compiled in the background. Waiting for it is cheaper than compiling it twice.
+            if (manifestValue && manifestValue->state == PrewarmState::Compiling)
+            {
+                FlushPrewarm();
+            }
+
+            if (value->pipeline == nullptr)
+            {
+                value->pipeline = m_pipelinePool.New(m_device, CreateGraphicsPipeline(key), key.shader->GetName());
+                value->isPrewarmed = false;
+                m_prewarmStats.onDemandCompiles++;
+                m_prewarmStats.onDemandManifestMisses += manifestValue && manifestValue->isLoaded ? 1u : 0u;
+            }
+
+            if (manifestValue)
+            {
+                m_prewarmQueuedCount -= manifestValue->state == PrewarmState::Queued ? 1u : 0u;
+                manifestValue->state = PrewarmState::Done;
+            }
+
+            auto stall = Platform::GetTimeSeconds() - begin;
+            m_prewarmStats.stallSeconds += stall;
+
+            if (stall > m_prewarmStats.maxStallSeconds)
+            {
+                m_prewarmStats.maxStallSeconds = stall;
+                m_prewarmStats.maxStallShader = FixedString128({ key.shader->GetName() });
+            }
+        }
+
+        if (value->isPrewarmed)
+        {
+            m_prewarmStats.prewarmHits++;
+            value->isPrewarmed = false;
+        }
+
+        value->pruneTick = m_currentPruneTick + m_pruneDelay;
+        return value->pipeline;
+    }
+
+    VulkanPipelineCache::PipelineValue* VulkanPipelineCache::GetGraphicsPipelineValue(const PipelineKey& key)
     {
         const auto stageFlags = key.shader->GetStageFlags();
         PipelineValue* value = nullptr;
@@ -92,153 +154,156 @@ namespace PK
             value = &m_vertexPipelines[m_vertexPipelines.AddKey(key)].value;
         }
 
-        if (value->pipeline == nullptr)
-        {
-            auto stageCount = 0u;
-            VkPipelineShaderStageCreateInfo shaderStages[(uint32_t)ShaderStage::MaxCount];
+        return value;
+    }
 
-            for (auto i = 0u; i < (uint32_t)ShaderStage::MaxCount; ++i)
-            {
-                const auto module = key.shader->GetModule(i);
-                const auto stageFlag = (ShaderStageFlags)(1u << i);
+    // Only reads immutable state. Called from the prewarm thread as well.
+    VkPipeline VulkanPipelineCache::CreateGraphicsPipeline(const PipelineKey& key) const
+    {
+        const auto stageFlags = key.shader->GetStageFlags();
+        auto stageCount = 0u;
+        VkPipelineShaderStageCreateInfo shaderStages[(uint32_t)ShaderStage::MaxCount];
 
-                if (module != VK_NULL_HANDLE && (stageFlag & stageFlags) != 0u && (stageFlag & key.fixed.excludeStageMask) == 0u)
-                {
-                    VkPipelineShaderStageCreateInfo stageInfo{ VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
-                    stageInfo.stage = VulkanEnumConvert::GetShaderStage((ShaderStage)i);
-                    stageInfo.module = module;
-                    stageInfo.pName = PK_RHI_SHADER_ENTRY_POINT_NAME;
-                    shaderStages[stageCount++] = stageInfo;
-                }
-            }
+        for (auto i = 0u; i < (uint32_t)ShaderStage::MaxCount; ++i)
+        {
+            const auto module = key.shader->GetModule(i);
+            const auto stageFlag = (ShaderStageFlags)(1u << i);
 
-            VkPipelineRenderingCreateInfo renderingInfo{ VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR };
-            renderingInfo.viewMask = 0u;
-            renderingInfo.colorAttachmentCount = 0u;
-            renderingInfo.pColorAttachmentFormats = key.fixed.colorFormats;
-            renderingInfo.depthAttachmentFormat = key.fixed.depthFormat;
-            renderingInfo.stencilAttachmentFormat = VulkanEnumConvert::IsDepthStencilFormat(key.fixed.depthFormat) ? key.fixed.depthFormat : VK_FORMAT_UNDEFINED;
-            for (; renderingInfo.colorAttachmentCount < PK_RHI_MAX_RENDER_TARGETS && key.fixed.colorFormats[renderingInfo.colorAttachmentCount] != VK_FORMAT_UNDEFINED; ++renderingInfo.colorAttachmentCount) {}
-
-            VkPipelineRasterizationStateCreateInfo rasterizer{ VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO };
-            rasterizer.depthClampEnable = key.fixed.rasterization.depthClampEnable;
-            rasterizer.rasterizerDiscardEnable = key.fixed.rasterization.rasterizerDiscardEnable;
-            rasterizer.polygonMode = VulkanEnumConvert::GetPolygonMode(key.fixed.rasterization.polygonMode);
-            rasterizer.lineWidth = key.fixed.rasterization.lineWidth;
-            rasterizer.cullMode = VulkanEnumConvert::GetCullMode(key.fixed.rasterization.cullMode);
-            rasterizer.frontFace = VulkanEnumConvert::GetFrontFace(key.fixed.rasterization.frontFace);
-            rasterizer.depthBiasEnable = key.fixed.rasterization.depthBiasEnable;
-            rasterizer.depthBiasConstantFactor = key.fixed.rasterization.depthBiasConstantFactor;
-            rasterizer.depthBiasClamp = key.fixed.rasterization.depthBiasClamp;
-            rasterizer.depthBiasSlopeFactor = key.fixed.rasterization.depthBiasSlopeFactor;
-
-            VkPipelineRasterizationConservativeStateCreateInfoEXT conservativeRaster{ VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT };
-            conservativeRaster.conservativeRasterizationMode = VulkanEnumConvert::GetRasterMode(key.fixed.rasterization.rasterMode, m_allowUnderEstimation);
-            conservativeRaster.extraPrimitiveOverestimationSize = fminf(m_maxOverEstimation, key.fixed.rasterization.overEstimation);
-            rasterizer.pNext = key.fixed.rasterization.rasterMode != RasterMode::Default ? &conservativeRaster : nullptr;
-
-            VkPipelineRasterizationLineStateCreateInfo lineRaster{ VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_LINE_STATE_CREATE_INFO };
-            lineRaster.lineRasterizationMode = VK_LINE_RASTERIZATION_MODE_RECTANGULAR_SMOOTH;
-            auto rasterPnext = rasterizer.pNext ? &conservativeRaster.pNext : &rasterizer.pNext;
-            *rasterPnext = rasterizer.polygonMode == VK_POLYGON_MODE_LINE ? &lineRaster : nullptr;
-
-            VkPipelineMultisampleStateCreateInfo multisampling{ VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO };
-            multisampling.sampleShadingEnable = key.fixed.multisampling.sampleShadingEnable;
-            multisampling.rasterizationSamples = VulkanEnumConvert::GetSampleCountFlags(key.fixed.multisampling.rasterizationSamples);
-            multisampling.minSampleShading = key.fixed.multisampling.minSampleShading;
-            multisampling.pSampleMask = nullptr;
-            multisampling.alphaToCoverageEnable = key.fixed.multisampling.alphaToCoverageEnable;
-            multisampling.alphaToOneEnable = key.fixed.multisampling.alphaToOneEnable;
-
-            VkPipelineDepthStencilStateCreateInfo depthStencil{ VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO };
-            depthStencil.depthTestEnable = key.fixed.depthStencil.depthCompareOp != Comparison::Off;
-            depthStencil.depthWriteEnable = key.fixed.depthStencil.depthWriteEnable;
-            depthStencil.depthCompareOp = VulkanEnumConvert::GetCompareOp(key.fixed.depthStencil.depthCompareOp);
-            depthStencil.depthBoundsTestEnable = key.fixed.depthStencil.depthBoundsTestEnable;
-            depthStencil.stencilTestEnable = key.fixed.depthStencil.stencilTestEnable;
-            depthStencil.minDepthBounds = key.fixed.depthStencil.minDepthBounds;
-            depthStencil.maxDepthBounds = key.fixed.depthStencil.maxDepthBounds;
-
-            VkPipelineColorBlendAttachmentState blendAttachments[PK_RHI_MAX_RENDER_TARGETS];
-
-            for (auto i = 0u; i < renderingInfo.colorAttachmentCount; ++i)
+            if (module != VK_NULL_HANDLE && (stageFlag & stageFlags) != 0u && (stageFlag & key.fixed.excludeStageMask) == 0u)
             {
-                blendAttachments[i].blendEnable = key.fixed.blending.isBlendEnabled();
-                blendAttachments[i].srcColorBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.srcColorFactor, VK_BLEND_FACTOR_ONE);
-                blendAttachments[i].dstColorBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.dstColorFactor, VK_BLEND_FACTOR_ZERO);
-                blendAttachments[i].colorBlendOp = VulkanEnumConvert::GetBlendOp(key.fixed.blending.colorOp);
-                blendAttachments[i].srcAlphaBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.srcAlphaFactor, VK_BLEND_FACTOR_ONE);
-                blendAttachments[i].dstAlphaBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.dstAlphaFactor, VK_BLEND_FACTOR_ZERO);
-                blendAttachments[i].alphaBlendOp = VulkanEnumConvert::GetBlendOp(key.fixed.blending.alphaOp);
-                blendAttachments[i].colorWriteMask = (VkColorComponentFlagBits)key.fixed.blending.colorMask & 0xF;
+                VkPipelineShaderStageCreateInfo stageInfo{ VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+                stageInfo.stage = VulkanEnumConvert::GetShaderStage((ShaderStage)i);
+                stageInfo.module = module;
+                stageInfo.pName = PK_RHI_SHADER_ENTRY_POINT_NAME;
+                shaderStages[stageCount++] = stageInfo;
             }
+        }
 
-            VkPipelineColorBlendStateCreateInfo colorBlending{ VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
-            colorBlending.logicOpEnable = key.fixed.blending.isLogicOpEnabled();
-            colorBlending.logicOp = VulkanEnumConvert::GetLogicOp(key.fixed.blending.logicOp);
-            colorBlending.attachmentCount = renderingInfo.colorAttachmentCount;
-            colorBlending.pAttachments = blendAttachments;
-            colorBlending.blendConstants[0] = 0.0f;
-            colorBlending.blendConstants[1] = 0.0f;
-            colorBlending.blendConstants[2] = 0.0f;
-            colorBlending.blendConstants[3] = 0.0f;
-
-            VkDynamicState dynamicStates[] =
-            {
-                VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT,
-                VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT,
-            };
+        VkPipelineRenderingCreateInfo renderingInfo{ VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR };
+        renderingInfo.viewMask = 0u;
+        renderingInfo.colorAttachmentCount = 0u;
+        renderingInfo.pColorAttachmentFormats = key.fixed.colorFormats;
+        renderingInfo.depthAttachmentFormat = key.fixed.depthFormat;
+        renderingInfo.stencilAttachmentFormat = VulkanEnumConvert::IsDepthStencilFormat(key.fixed.depthFormat) ? key.fixed.depthFormat : VK_FORMAT_UNDEFINED;
+        for (; renderingInfo.colorAttachmentCount < PK_RHI_MAX_RENDER_TARGETS && key.fixed.colorFormats[renderingInfo.colorAttachmentCount] != VK_FORMAT_UNDEFINED; ++renderingInfo.colorAttachmentCount) {}
+
+        VkPipelineRasterizationStateCreateInfo rasterizer{ VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO };
+        rasterizer.depthClampEnable = key.fixed.rasterization.depthClampEnable;
+        rasterizer.rasterizerDiscardEnable = key.fixed.rasterization.rasterizerDiscardEnable;
+        rasterizer.polygonMode = VulkanEnumConvert::GetPolygonMode(key.fixed.rasterization.polygonMode);
+        rasterizer.lineWidth = key.fixed.rasterization.lineWidth;
+        rasterizer.cullMode = VulkanEnumConvert::GetCullMode(key.fixed.rasterization.cullMode);
+        rasterizer.frontFace = VulkanEnumConvert::GetFrontFace(key.fixed.rasterization.frontFace);
+        rasterizer.depthBiasEnable = key.fixed.rasterization.depthBiasEnable;
+        rasterizer.depthBiasConstantFactor = key.fixed.rasterization.depthBiasConstantFactor;
+        rasterizer.depthBiasClamp = key.fixed.rasterization.depthBiasClamp;
+        rasterizer.depthBiasSlopeFactor = key.fixed.rasterization.depthBiasSlopeFactor;
+
+        VkPipelineRasterizationConservativeStateCreateInfoEXT conservativeRaster{ VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_CONSERVATIVE_STATE_CREATE_INFO_EXT };
+        conservativeRaster.conservativeRasterizationMode = VulkanEnumConvert::GetRasterMode(key.fixed.rasterization.rasterMode, m_allowUnderEstimation);
+        conservativeRaster.extraPrimitiveOverestimationSize = fminf(m_maxOverEstimation, key.fixed.rasterization.overEstimation);
+        rasterizer.pNext = key.fixed.rasterization.rasterMode != RasterMode::Default ? &conservativeRaster : nullptr;
+
+        VkPipelineRasterizationLineStateCreateInfo lineRaster{ VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_LINE_STATE_CREATE_INFO };
+        lineRaster.lineRasterizationMode = VK_LINE_RASTERIZATION_MODE_RECTANGULAR_SMOOTH;
+        auto rasterPnext = rasterizer.pNext ? &conservativeRaster.pNext : &rasterizer.pNext;
+        *rasterPnext = rasterizer.polygonMode == VK_POLYGON_MODE_LINE ? &lineRaster : nullptr;
+
+        VkPipelineMultisampleStateCreateInfo multisampling{ VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO };
+        multisampling.sampleShadingEnable = key.fixed.multisampling.sampleShadingEnable;
+        multisampling.rasterizationSamples = VulkanEnumConvert::GetSampleCountFlags(key.fixed.multisampling.rasterizationSamples);
+        multisampling.minSampleShading = key.fixed.multisampling.minSampleShading;
+        multisampling.pSampleMask = nullptr;
+        multisampling.alphaToCoverageEnable = key.fixed.multisampling.alphaToCoverageEnable;
+        multisampling.alphaToOneEnable = key.fixed.multisampling.alphaToOneEnable;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencil{ VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO };
+        depthStencil.depthTestEnable = key.fixed.depthStencil.depthCompareOp != Comparison::Off;
+        depthStencil.depthWriteEnable = key.fixed.depthStencil.depthWriteEnable;
+        depthStencil.depthCompareOp = VulkanEnumConvert::GetCompareOp(key.fixed.depthStencil.depthCompareOp);
+        depthStencil.depthBoundsTestEnable = key.fixed.depthStencil.depthBoundsTestEnable;
+        depthStencil.stencilTestEnable = key.fixed.depthStencil.stencilTestEnable;
+        depthStencil.minDepthBounds = key.fixed.depthStencil.minDepthBounds;
+        depthStencil.maxDepthBounds = key.fixed.depthStencil.maxDepthBounds;
+
+        VkPipelineColorBlendAttachmentState blendAttachments[PK_RHI_MAX_RENDER_TARGETS];
+
+        for (auto i = 0u; i < renderingInfo.colorAttachmentCount; ++i)
+        {
+            blendAttachments[i].blendEnable = key.fixed.blending.isBlendEnabled();
+            blendAttachments[i].srcColorBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.srcColorFactor, VK_BLEND_FACTOR_ONE);
+            blendAttachments[i].dstColorBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.dstColorFactor, VK_BLEND_FACTOR_ZERO);
+            blendAttachments[i].colorBlendOp = VulkanEnumConvert::GetBlendOp(key.fixed.blending.colorOp);
+            blendAttachments[i].srcAlphaBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.srcAlphaFactor, VK_BLEND_FACTOR_ONE);
+            blendAttachments[i].dstAlphaBlendFactor = VulkanEnumConvert::GetBlendFactor(key.fixed.blending.dstAlphaFactor, VK_BLEND_FACTOR_ZERO);
+            blendAttachments[i].alphaBlendOp = VulkanEnumConvert::GetBlendOp(key.fixed.blending.alphaOp);
+            blendAttachments[i].colorWriteMask = (VkColorComponentFlagBits)key.fixed.blending.colorMask & 0xF;
+        }
 
-            VkPipelineDynamicStateCreateInfo dynamicState{ VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
-            dynamicState.dynamicStateCount = 2;
-            dynamicState.pDynamicStates = dynamicStates;
+        VkPipelineColorBlendStateCreateInfo colorBlending{ VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
+        colorBlending.logicOpEnable = key.fixed.blending.isLogicOpEnabled();
+        colorBlending.logicOp = VulkanEnumConvert::GetLogicOp(key.fixed.blending.logicOp);
+        colorBlending.attachmentCount = renderingInfo.colorAttachmentCount;
+        colorBlending.pAttachments = blendAttachments;
+        colorBlending.blendConstants[0] = 0.0f;
+        colorBlending.blendConstants[1] = 0.0f;
+        colorBlending.blendConstants[2] = 0.0f;
+        colorBlending.blendConstants[3] = 0.0f;
+
+        VkDynamicState dynamicStates[] =
+        {
+            VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT,
+            VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT,
+        };
+
+        VkPipelineDynamicStateCreateInfo dynamicState{ VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
+        dynamicState.dynamicStateCount = 2;
+        dynamicState.pDynamicStates = dynamicStates;
+
+        VkPipelineViewportStateCreateInfo viewportState{ VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO };
+        VkPipelineVertexInputStateCreateInfo vertexInputInfo{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly{ VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
+
+        VkGraphicsPipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
+        pipelineInfo.pNext = &renderingInfo;
+        pipelineInfo.stageCount = stageCount;
+        pipelineInfo.pStages = shaderStages;
+        pipelineInfo.pVertexInputState = nullptr;
+        pipelineInfo.pInputAssemblyState = nullptr;
+        pipelineInfo.pViewportState = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterizer;
+        pipelineInfo.pMultisampleState = &multisampling;
+        pipelineInfo.pDepthStencilState = &depthStencil;
+        pipelineInfo.pColorBlendState = &colorBlending;
+        pipelineInfo.pDynamicState = &dynamicState;
+        pipelineInfo.layout = key.shader->GetPipelineLayout()->layout;
+        pipelineInfo.renderPass = VK_NULL_HANDLE;
+        pipelineInfo.subpass = 0;
+        pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+        pipelineInfo.basePipelineIndex = -1;
 
-            VkPipelineViewportStateCreateInfo viewportState{ VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO };
-            VkPipelineVertexInputStateCreateInfo vertexInputInfo{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
-            VkPipelineInputAssemblyStateCreateInfo inputAssembly{ VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
+        if ((ShaderStageFlags::StagesVertex & stageFlags) != 0u)
+        {
+            vertexInputInfo.vertexBindingDescriptionCount = 0u;
+            vertexInputInfo.vertexAttributeDescriptionCount = 0u;
+            vertexInputInfo.pVertexBindingDescriptions = key.vertexStreams;
+            vertexInputInfo.pVertexAttributeDescriptions = key.vertexAttributes;
 
-            VkGraphicsPipelineCreateInfo pipelineInfo{ VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
-            pipelineInfo.pNext = &renderingInfo;
-            pipelineInfo.stageCount = stageCount;
-            pipelineInfo.pStages = shaderStages;
-            pipelineInfo.pVertexInputState = nullptr;
-            pipelineInfo.pInputAssemblyState = nullptr;
-            pipelineInfo.pViewportState = &viewportState;
-            pipelineInfo.pRasterizationState = &rasterizer;
-            pipelineInfo.pMultisampleState = &multisampling;
-            pipelineInfo.pDepthStencilState = &depthStencil;
-            pipelineInfo.pColorBlendState = &colorBlending;
-            pipelineInfo.pDynamicState = &dynamicState;
-            pipelineInfo.layout = key.shader->GetPipelineLayout()->layout;
-            pipelineInfo.renderPass = VK_NULL_HANDLE;
-            pipelineInfo.subpass = 0;
-            pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-            pipelineInfo.basePipelineIndex = -1;
-
-            if ((ShaderStageFlags::StagesVertex & stageFlags) != 0u)
+            for (auto i = 0u; i < PK_RHI_MAX_VERTEX_ATTRIBUTES; ++i)
             {
-                vertexInputInfo.vertexBindingDescriptionCount = 0u;
-                vertexInputInfo.vertexAttributeDescriptionCount = 0u;
-                vertexInputInfo.pVertexBindingDescriptions = key.vertexStreams;
-                vertexInputInfo.pVertexAttributeDescriptions = key.vertexAttributes;
-
-                for (auto i = 0u; i < PK_RHI_MAX_VERTEX_ATTRIBUTES; ++i)
-                {
-                    vertexInputInfo.vertexBindingDescriptionCount += key.vertexStreams[i].stride != 0;
-                    vertexInputInfo.vertexAttributeDescriptionCount += key.vertexAttributes[i].format != VK_FORMAT_UNDEFINED;
-                }
-
-                inputAssembly.topology = VulkanEnumConvert::GetTopology(key.fixed.rasterization.topology);
-                inputAssembly.primitiveRestartEnable = key.primitiveRestart;
-                pipelineInfo.pVertexInputState = &vertexInputInfo;
-                pipelineInfo.pInputAssemblyState = &inputAssembly;
+                vertexInputInfo.vertexBindingDescriptionCount += key.vertexStreams[i].stride != 0;
+                vertexInputInfo.vertexAttributeDescriptionCount += key.vertexAttributes[i].format != VK_FORMAT_UNDEFINED;
             }
 
-            value->pipeline = m_pipelinePool.New(m_device, m_pipelineCache, pipelineInfo, key.shader->GetName());
+            inputAssembly.topology = VulkanEnumConvert::GetTopology(key.fixed.rasterization.topology);
+            inputAssembly.primitiveRestartEnable = key.primitiveRestart;
+            pipelineInfo.pVertexInputState = &vertexInputInfo;
+            pipelineInfo.pInputAssemblyState = &inputAssembly;
         }
 
-        value->pruneTick = m_currentPruneTick + m_pruneDelay;
-        return value->pipeline;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VK_ASSERT_RESULT_CTX(vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1, &pipelineInfo, nullptr, &pipeline), "failed to create a graphics pipeline!");
+        return pipeline;
     }
 
     const VulkanPipeline* VulkanPipelineCache::GetComputePipeline(const VersionHandle<VulkanShader>& shader)
@@ -328,6 +393,16 @@ namespace PK
     {
         m_currentPruneTick++;
 
+        if (m_prewarmThread)
+        {
+            if (m_prewarmTaskCount > 0u && Platform::AtomicRead(&m_prewarmIsDone) != 0u)
+            {
+                FlushPrewarm();
+            }
+
+            DispatchPrewarm();
+        }
+
         for (auto i = (int32_t)m_vertexPipelines.GetCount() - 1; i >= 0; --i)
         {
             auto value = &m_vertexPipelines[i].value;
@@ -364,4 +439,230 @@ namespace PK
             }
         }
     }
+
+    void VulkanPipelineCache::QueuePrewarm(const VulkanShader* shader)
+    {
+        if (!m_prewarmThread || m_manifest.GetCount() == 0u)
+        {
+            return;
+        }
+
+        const auto nameHash = Hash::FNV1AHash(shader->GetName(), strlen(shader->GetName()));
+
+        for (auto i = 0u; i < m_manifest.GetCount(); ++i)
+        {
+            auto entry = m_manifest[i];
+
+            if (entry.value.state == PrewarmState::Waiting && entry.key.shaderNameHash == nameHash)
+            {
+                entry.value.shader = shader;
+                entry.value.state = PrewarmState::Queued;
+                m_prewarmQueuedCount++;
+            }
+        }
+
+        // Start compiling while the rest of the assets are still loading.
+        DispatchPrewarm();
+    }
+
+    void VulkanPipelineCache::ReleasePrewarm(const VulkanShader* shader)
+    {
+        if (!m_prewarmThread)
+        {
+            return;
+        }
+
+        for (auto i = 0u; i < m_prewarmTaskCount; ++i)
+        {
+            if (m_prewarmTasks[i].key.shader == shader)
+            {
+                FlushPrewarm();
+                break;
+            }
+        }
+
+        // Reloaded variants get prewarmed again.
+        for (auto i = 0u; i < m_manifest.GetCount(); ++i)
+        {
+            auto entry = m_manifest[i];
+
+            if (entry.value.shader == shader)
+            {
+                m_prewarmQueuedCount -= entry.value.state == PrewarmState::Queued ? 1u : 0u;
+                entry.value.shader = {};
+                entry.value.state = PrewarmState::Waiting;
+            }
+        }
+    }
+
+    int32_t VulkanPipelineCache::RecordManifestKey(const PipelineKey& key)
+    {
+        if (!m_prewarmThread)
+        {
+            return -1;
+        }
+
+        ManifestKey manifestKey{};
+        manifestKey.shaderNameHash = Hash::FNV1AHash(key.shader->GetName(), strlen(key.shader->GetName()));
+        manifestKey.fixed = key.fixed;
+
+        // Match the deduplication of mesh pipeline keys.
+        if ((ShaderStageFlags::StagesMesh & key.shader->GetStageFlags()) != 0u)
+        {
+            manifestKey.fixed.rasterization.topology = Topology::PointList;
+        }
+        else
+        {
+            manifestKey.primitiveRestart = key.primitiveRestart;
+            memcpy(manifestKey.vertexAttributes, key.vertexAttributes, sizeof(key.vertexAttributes));
+            memcpy(manifestKey.vertexStreams, key.vertexStreams, sizeof(key.vertexStreams));
+        }
+
+        auto index = m_manifest.GetIndex(manifestKey);
+
+        if (index == -1 && m_manifest.GetCount() < m_manifest.GetCapacity())
+        {
+            index = (int32_t)m_manifest.AddKey(manifestKey);
+            m_manifest[index].value = { key.shader, PrewarmState::Done, false };
+        }
+
+        return index;
+    }
+
+    void VulkanPipelineCache::LoadManifest()
+    {
+        void* fileData = nullptr;
+        size_t fileSize = 0ull;
+
+        if (FileIO::ReadBinary(FixedString256({ m_workingDirectory, PIPELINE_MANIFEST_FILENAME }), false, &fileData, &fileSize) != 0)
+        {
+            return;
+        }
+
+        // Header: magic, key size, key count, padding. Keys are discarded if their layout has changed.
+        auto header = static_cast<const uint32_t*>(fileData);
+        auto headerSize = sizeof(uint32_t) * 4ull;
+
+        if (fileSize >= headerSize && 
+            header[0] == PIPELINE_MANIFEST_MAGIC && 
+            header[1] == sizeof(ManifestKey) && 
+            fileSize >= headerSize + header[2] * sizeof(ManifestKey))
+        {
+            auto keys = reinterpret_cast<const ManifestKey*>(header + 4);
+            auto count = header[2] < m_manifest.GetCapacity() ? header[2] : (uint32_t)m_manifest.GetCapacity();
+
+            for (auto i = 0u; i < count; ++i)
+            {
+                m_manifest.AddValue(keys[i], { {}, PrewarmState::Waiting, true });
+            }
+        }
+
+        Memory::Free(fileData);
+        m_prewarmStats.manifestKeys = m_manifest.GetCount();
+        PK_LOG_INFO("VulkanPipelineCache.LoadManifest: %u pipeline keys", m_manifest.GetCount());
+    }
+
+    void VulkanPipelineCache::SaveManifest()
+    {
+        const auto count = m_manifest.GetCount();
+        const auto headerSize = sizeof(uint32_t) * 4ull;
+        const auto size = headerSize + sizeof(ManifestKey) * count;
+
+        auto fileData = Memory::Allocate<uint8_t>(size);
+        auto header = reinterpret_cast<uint32_t*>(fileData);
+        header[0] = PIPELINE_MANIFEST_MAGIC;
+        header[1] = sizeof(ManifestKey);
+        header[2] = count;
+        header[3] = 0u;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            memcpy(fileData + headerSize + sizeof(ManifestKey) * i, &m_manifest[i].key, sizeof(ManifestKey));
+        }
+
+        FileIO::WriteBinary(FixedString256({ m_workingDirectory, PIPELINE_MANIFEST_FILENAME }), false, fileData, size);
+        Memory::Free(fileData);
+    }
+
+    void VulkanPipelineCache::DispatchPrewarm()
+    {
+        if (m_prewarmTaskCount > 0u || m_prewarmQueuedCount == 0u)
+        {
+            return;
+        }
+
+        for (auto i = 0u; i < m_manifest.GetCount() && m_prewarmTaskCount < PK_VK_PIPELINE_PREWARM_BATCH_SIZE; ++i)
+        {
+            auto entry = m_manifest[i];
+
+            if (entry.value.state != PrewarmState::Queued)
+            {
+                continue;
+            }
+
+            auto task = &m_prewarmTasks[m_prewarmTaskCount++];
+            task->key = {};
+            task->key.shader = entry.value.shader;
+            task->key.fixed = entry.key.fixed;
+            task->key.primitiveRestart = entry.key.primitiveRestart;
+            memcpy(task->key.vertexAttributes, entry.key.vertexAttributes, sizeof(entry.key.vertexAttributes));
+            memcpy(task->key.vertexStreams, entry.key.vertexStreams, sizeof(entry.key.vertexStreams));
+            task->manifestIndex = i;
+            task->pipeline = VK_NULL_HANDLE;
+            entry.value.state = PrewarmState::Compiling;
+            m_prewarmQueuedCount--;
+        }
+
+        if (m_prewarmTaskCount > 0u)
+        {
+            Platform::AtomicStore(&m_prewarmIsDone, 0u);
+            m_prewarmThread->Dispatch(this, ExecutePrewarm);
+        }
+    }
+
+    void VulkanPipelineCache::FlushPrewarm()
+    {
+        if (m_prewarmTaskCount == 0u)
+        {
+            return;
+        }
+
+        m_prewarmThread->Wait();
+
+        for (auto i = 0u; i < m_prewarmTaskCount; ++i)
+        {
+            auto task = &m_prewarmTasks[i];
+            m_manifest[task->manifestIndex].value.state = PrewarmState::Done;
+
+            const auto isMesh = (ShaderStageFlags::StagesMesh & task->key.shader->GetStageFlags()) != 0u;
+            const auto isFull = isMesh ? m_meshPipelines.GetCount() >= m_meshPipelines.GetCapacity() : m_vertexPipelines.GetCount() >= m_vertexPipelines.GetCapacity();
+            auto value = !isFull ? GetGraphicsPipelineValue(task->key) : nullptr;
+
+            if (value == nullptr || value->pipeline != nullptr)
+            {
+                vkDestroyPipeline(m_device, task->pipeline, nullptr);
+                continue;
+            }
+
+            // First request might be many frames away. Keep these around longer than on demand pipelines.
+            value->pipeline = m_pipelinePool.New(m_device, task->pipeline, task->key.shader->GetName());
+            value->pruneTick = m_currentPruneTick + PK_VK_PIPELINE_PREWARM_PRUNE_DELAY;
+            value->isPrewarmed = true;
+            m_prewarmStats.prewarmed++;
+        }
+
+        m_prewarmTaskCount = 0u;
+    }
+
+    void VulkanPipelineCache::ExecutePrewarm(void* ctx)
+    {
+        auto cache = static_cast<VulkanPipelineCache*>(ctx);
+
+        for (auto i = 0u; i < cache->m_prewarmTaskCount; ++i)
+        {
+            cache->m_prewarmTasks[i].pipeline = cache->CreateGraphicsPipeline(cache->m_prewarmTasks[i].key);
+        }
+
+        Platform::AtomicStore(&cache->m_prewarmIsDone, 1u);
+    }
 }
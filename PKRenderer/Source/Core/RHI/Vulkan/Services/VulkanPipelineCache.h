@@ -3,6 +3,7 @@
 #include "Core/Base/Containers/Pool.h"
 #include "Core/Base/Types/Ref.h"
 #include "Core/Base/NoCopy.h"
+#include "Core/ControlFlow/WorkerThread.h"
 #include "Core/RHI/Vulkan/VulkanLimits.h"
 #include "Core/RHI/Vulkan/VulkanShader.h"
 
@@ -41,16 +42,59 @@ namespace PK
             inline bool operator == (const MeshPipelineKey& r) const noexcept { return memcmp(this, &r, sizeof(MeshPipelineKey)) == 0; }
         };
 
+        // Persistent form of a graphics pipeline key. Shader variants are identified by a hash of their name (asset name & variant index).
+        struct ManifestKey
+        {
+            uint64_t shaderNameHash = 0ull;
+            FixedFunctionState fixed{};
+            VkBool32 primitiveRestart = VK_FALSE;
+            VkVertexInputAttributeDescription vertexAttributes[PK_RHI_MAX_VERTEX_ATTRIBUTES]{};
+            VkVertexInputBindingDescription vertexStreams[PK_RHI_MAX_VERTEX_ATTRIBUTES]{};
+
+            inline bool operator == (const ManifestKey& r) const noexcept { return memcmp(this, &r, sizeof(ManifestKey)) == 0; }
+        };
+
+        enum class PrewarmState : uint8_t
+        {
+            Waiting,    // Shader variant has not been created yet.
+            Queued,
+            Compiling,
+            Done
+        };
+
+        struct ManifestValue
+        {
+            VersionHandle<VulkanShader> shader;
+            PrewarmState state = PrewarmState::Done;
+            bool isLoaded = false;
+        };
+
         struct PipelineValue
         {
             VulkanPipeline* pipeline = nullptr;
             uint64_t pruneTick = 0;
+            bool isPrewarmed = false;
+        };
+
+        struct PrewarmStats
+        {
+            uint32_t manifestKeys = 0u;
+            uint32_t prewarmed = 0u;
+            uint32_t prewarmHits = 0u;
+            uint32_t onDemandCompiles = 0u;
+            uint32_t onDemandManifestMisses = 0u;
+            double stallSeconds = 0.0;
+            double maxStallSeconds = 0.0;
+            FixedString128 maxStallShader;
         };
 
         using PipelineKeyHash = Hash::TMurmurHash<PipelineKey>;
         using MeshPipelineKeyHash = Hash::TMurmurHash<MeshPipelineKey>;
+        using ManifestKeyHash = Hash::TMurmurHash<ManifestKey>;
 
         constexpr const static char* PIPELINE_CACHE_FILENAME = "shadercache.cache";
+        constexpr const static char* PIPELINE_MANIFEST_FILENAME = "shaderpipelines.cache";
+        constexpr const static uint32_t PIPELINE_MANIFEST_MAGIC = 0x504B504Du;
 
         VulkanPipelineCache(VkDevice device, 
             const VulkanPhysicalDeviceProperties& physicalDeviceProperties, 
@@ -66,7 +110,28 @@ namespace PK
         const VulkanPipeline* GetRayTracingPipeline(const VersionHandle<VulkanShader>& shader);
         void Prune();
 
+        // Manifest keys recorded during previous runs are compiled on a background thread once their shader variant is created.
+        void QueuePrewarm(const VulkanShader* shader);
+        void ReleasePrewarm(const VulkanShader* shader);
+        constexpr const PrewarmStats& GetPrewarmStats() const { return m_prewarmStats; }
+
     private:
+        struct PrewarmTask
+        {
+            PipelineKey key{};
+            uint32_t manifestIndex = 0u;
+            VkPipeline pipeline = VK_NULL_HANDLE;
+        };
+
+        PipelineValue* GetGraphicsPipelineValue(const PipelineKey& key);
+        VkPipeline CreateGraphicsPipeline(const PipelineKey& key) const;
+        int32_t RecordManifestKey(const PipelineKey& key);
+        void LoadManifest();
+        void SaveManifest();
+        void DispatchPrewarm();
+        void FlushPrewarm();
+        static void ExecutePrewarm(void* ctx);
+
         const VkDevice m_device;
         const float m_maxOverEstimation;
         const bool m_allowUnderEstimation;
@@ -79,5 +144,13 @@ namespace PK
         FixedMap16<VersionHandle<VulkanShader>, PipelineValue, PK_VK_MAX_PIPELINES_GENERIC> m_otherPipelines;
         uint64_t m_currentPruneTick = 0;
         uint64_t m_pruneDelay = 0;
+
+        FixedMap16<ManifestKey, ManifestValue, PK_VK_MAX_PIPELINE_MANIFEST_KEYS, ManifestKeyHash> m_manifest;
+        FixedUnique<WorkerThread> m_prewarmThread;
+        PrewarmTask m_prewarmTasks[PK_VK_PIPELINE_PREWARM_BATCH_SIZE]{};
+        uint32_t m_prewarmTaskCount = 0u;
+        uint32_t m_prewarmQueuedCount = 0u;
+        volatile uint32_t m_prewarmIsDone = 0u;
+        PrewarmStats m_prewarmStats{};
     };
 }
@@ -6,6 +6,11 @@
 
 namespace PK
 {
+    static bool IsSameFence(const FenceRef& a, const FenceRef& b)
+    {
+        return a.GetContext() == b.GetContext() && a.GetWaitFunction() == b.GetWaitFunction() && a.GetUserdata() == b.GetUserdata();
+    }
+
     VulkanStagingBufferCache::VulkanStagingBufferCache(Disposer* disposer, VkDevice device, VmaAllocator allocator, uint64_t pruneDelay) :
         m_allocator(allocator),
         m_device(device),
@@ -16,6 +21,12 @@ namespace PK
 
     VulkanStagingBufferCache::~VulkanStagingBufferCache()
     {
+        for (auto i = 0u; i < m_ringCount; ++i)
+        {
+            m_bufferPool.Delete(m_rings[i].buffer);
+            m_rings[i] = {};
+        }
+
         while (m_freeBufferHead)
         {
             auto next = m_freeBufferHead->next;
@@ -71,7 +82,8 @@ namespace PK
 
     void VulkanStagingBufferCache::Release(VulkanStagingBuffer* buffer, const FenceRef& fence)
     {
-        if (buffer)
+        // Ring ranges are tracked by their allocation fence.
+        if (buffer && !buffer->isRing)
         {
             auto nextPruneTick = m_currentPruneTick + 1;
             buffer->pruneTick = nextPruneTick;
@@ -97,6 +109,22 @@ namespace PK
     {
         ++m_currentPruneTick;
 
+        // Keep the first ring alive. Release idle overflow rings.
+        for (auto i = (int32_t)m_ringCount - 1; i >= 0; --i)
+        {
+            auto ring = &m_rings[i];
+            ReclaimRing(ring);
+
+            if (i > 0 && ring->markerCount == 0u && ring->pruneTick < m_currentPruneTick)
+            {
+                m_bufferPool.Delete(ring->buffer);
+                *ring = m_rings[--m_ringCount];
+                m_rings[m_ringCount] = {};
+                m_currentRing = m_currentRing == m_ringCount ? (uint32_t)i : m_currentRing;
+                m_currentRing = m_currentRing < m_ringCount ? m_currentRing : 0u;
+            }
+        }
+
         for (auto headLive = &m_liveBufferHead; *headLive;)
         {
             auto buffer = *headLive;
@@ -144,4 +172,105 @@ namespace PK
             headFree = &(*headFree)->next;
         }
     }
+
+    VulkanStageAllocation VulkanStagingBufferCache::Allocate(size_t size, const FenceRef& fence)
+    {
+        VulkanStageAllocation allocation{};
+
+        // Large uploads would stall the rings for several frames.
+        if (size <= PK_VK_STAGING_RING_SIZE / 4ull)
+        {
+            for (auto i = 0u; i < m_ringCount; ++i)
+            {
+                auto index = (m_currentRing + i) % m_ringCount;
+
+                if (AllocateFromRing(&m_rings[index], size, fence, &allocation))
+                {
+                    m_currentRing = index;
+                    return allocation;
+                }
+            }
+
+            if (m_ringCount < PK_VK_STAGING_RING_MAX_COUNT)
+            {
+                auto ring = &m_rings[m_ringCount];
+                FixedString64 bufferName("StagingRing%u", m_ringCount);
+                VulkanBufferCreateInfo createInfo(BufferUsage::DefaultStaging | BufferUsage::PersistentStage, PK_VK_STAGING_RING_SIZE);
+                ring->buffer = m_bufferPool.New(m_device, m_allocator, createInfo, bufferName.c_str());
+                ring->buffer->isRing = true;
+                ring->mapped = static_cast<char*>(ring->buffer->BeginMap(0ull, 0ull));
+                m_currentRing = m_ringCount++;
+
+                if (AllocateFromRing(ring, size, fence, &allocation))
+                {
+                    return allocation;
+                }
+            }
+        }
+
+        allocation.buffer = Acquire(size, false, nullptr);
+        allocation.offset = 0ull;
+        allocation.mapped = allocation.buffer->BeginMap(0ull, 0ull);
+        return allocation;
+    }
+
+    bool VulkanStagingBufferCache::AllocateFromRing(Ring* ring, size_t size, const FenceRef& fence, VulkanStageAllocation* outAllocation)
+    {
+        const auto alignedSize = (size + PK_VK_STAGING_RING_ALIGNMENT - 1ull) & ~(PK_VK_STAGING_RING_ALIGNMENT - 1ull);
+
+        for (auto attempt = 0u; attempt < 2u; ++attempt)
+        {
+            // Allocations are contiguous. Skip the end of the ring if the allocation would wrap.
+            auto offset = ring->head % PK_VK_STAGING_RING_SIZE;
+            auto padding = offset + alignedSize > PK_VK_STAGING_RING_SIZE ? PK_VK_STAGING_RING_SIZE - offset : 0ull;
+            auto lastMarker = ring->markerCount > 0u ? &ring->markers[(ring->firstMarker + ring->markerCount - 1u) % PK_VK_STAGING_RING_MAX_MARKERS] : nullptr;
+            auto isSameFence = lastMarker != nullptr && IsSameFence(lastMarker->fence, fence);
+
+            if ((isSameFence || ring->markerCount < PK_VK_STAGING_RING_MAX_MARKERS) && 
+                ring->head + padding + alignedSize - ring->tail <= PK_VK_STAGING_RING_SIZE)
+            {
+                ring->head += padding;
+                outAllocation->buffer = ring->buffer;
+                outAllocation->offset = ring->head % PK_VK_STAGING_RING_SIZE;
+                outAllocation->mapped = ring->mapped + outAllocation->offset;
+                ring->head += alignedSize;
+                ring->pruneTick = m_currentPruneTick + m_pruneDelay;
+
+                // Consecutive uploads from the same submission share a marker.
+                if (isSameFence)
+                {
+                    lastMarker->end = ring->head;
+                }
+                else
+                {
+                    ring->markers[(ring->firstMarker + ring->markerCount++) % PK_VK_STAGING_RING_MAX_MARKERS] = { fence, ring->head };
+                }
+
+                return true;
+            }
+
+            ReclaimRing(ring);
+        }
+
+        return false;
+    }
+
+    void VulkanStagingBufferCache::ReclaimRing(Ring* ring)
+    {
+        // Markers are reclaimed in allocation order. A pending fence blocks the ones after it.
+        while (ring->markerCount > 0u)
+        {
+            auto marker = &ring->markers[ring->firstMarker];
+
+            if (!marker->fence.IsComplete())
+            {
+                break;
+            }
+
+            ring->tail = marker->end;
+            marker->fence.Invalidate();
+            ring->firstMarker = (ring->firstMarker + 1u) % PK_VK_STAGING_RING_MAX_MARKERS;
+            ring->markerCount--;
+        }
+    }
 }
@@ -29,6 +29,14 @@ namespace PK
         FenceRef fence;
         uint64_t pruneTick = 0ull;
         VulkanStagingBuffer* next = nullptr;
+        bool isRing = false;
+    };
+
+    struct VulkanStageAllocation
+    {
+        VulkanStagingBuffer* buffer = nullptr;
+        size_t offset = 0ull;
+        void* mapped = nullptr;
     };
 
     struct VulkanStagingBufferCache : public NoCopy
@@ -40,7 +48,33 @@ namespace PK
         void Release(VulkanStagingBuffer* buffer, const FenceRef& fence);
         void Prune();
 
+        // Transient upload memory from persistently mapped rings. Ranges are reclaimed once their fence has completed.
+        // Uploads too large for a ring get a dedicated buffer. Release the allocation buffer in either case, rings ignore it.
+        VulkanStageAllocation Allocate(size_t size, const FenceRef& fence);
+
     private:
+        struct RingMarker
+        {
+            FenceRef fence;
+            uint64_t end = 0ull;
+        };
+
+        // Head & tail are linear byte positions. Ring offset is the position modulo ring size.
+        struct Ring
+        {
+            VulkanStagingBuffer* buffer = nullptr;
+            char* mapped = nullptr;
+            uint64_t head = 0ull;
+            uint64_t tail = 0ull;
+            uint64_t pruneTick = 0ull;
+            RingMarker markers[PK_VK_STAGING_RING_MAX_MARKERS]{};
+            uint32_t firstMarker = 0u;
+            uint32_t markerCount = 0u;
+        };
+
+        bool AllocateFromRing(Ring* ring, size_t size, const FenceRef& fence, VulkanStageAllocation* outAllocation);
+        static void ReclaimRing(Ring* ring);
+
         const VmaAllocator m_allocator;
         const VkDevice m_device;
         Disposer* m_disposer;
@@ -49,5 +83,8 @@ namespace PK
         FixedPool<VulkanStagingBuffer, PK_VK_MAX_STAGING_BUFFERS> m_bufferPool;
         uint64_t m_currentPruneTick = 0ull;
         uint64_t m_pruneDelay = 0ull;
+        Ring m_rings[PK_VK_STAGING_RING_MAX_COUNT]{};
+        uint32_t m_ringCount = 0u;
+        uint32_t m_currentRing = 0u;
     };
 }
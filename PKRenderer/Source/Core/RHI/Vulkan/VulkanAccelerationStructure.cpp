@@ -40,7 +40,7 @@ namespace PK
     {
         if (handle != VK_NULL_HANDLE)
         {
-            m_driver->disposer->Dispose(m_driver->device, handle, 
+            m_driver->disposer->DisposeAsync(m_driver->device, handle, 
             [](void* c, void* v)
             {
                 vkDestroyAccelerationStructureKHR(static_cast<VkDevice>(c), static_cast<VkAccelerationStructureKHR>(v), nullptr);
@@ -93,7 +93,9 @@ namespace PK
     {
         PK_DEBUG_FATAL_ASSERT(m_instanceCount < m_instanceLimit, "Instance limit exceeded!");
 
-        StructureKey key{ geometry.indexBuffer, ((uint64_t)geometry.indexFirst & 0xFFFFFFFFu) | (((uint64_t)geometry.indexCount) << 32ull) };
+        // Keyed by byte offset. 16 & 32 bit index ranges can share a buffer.
+        const auto indexByteOffset = (uint64_t)geometry.indexFirst * geometry.indexStride;
+        StructureKey key{ geometry.indexBuffer, (indexByteOffset & 0xFFFFFFFFu) | (((uint64_t)geometry.indexCount) << 32ull) };
         uint32_t index = 0u;
 
         if (m_substructures.AddKey(key, &index))
@@ -109,7 +111,7 @@ namespace PK
             structure->geometry = VkAccelerationStructureGeometryKHR{ VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_KHR };
             structure->geometry.geometryType = VK_GEOMETRY_TYPE_TRIANGLES_KHR;
             structure->geometry.geometry.triangles.sType = VK_STRUCTURE_TYPE_ACCELERATION_STRUCTURE_GEOMETRY_TRIANGLES_DATA_KHR;
-            structure->geometry.geometry.triangles.vertexFormat = VK_FORMAT_R32G32B32_SFLOAT;
+            structure->geometry.geometry.triangles.vertexFormat = geometry.vertexFormat == ElementType::Short4 ? VK_FORMAT_R16G16B16A16_SNORM : VK_FORMAT_R32G32B32_SFLOAT;
             structure->geometry.geometry.triangles.vertexStride = geometry.vertexStride;
             structure->geometry.geometry.triangles.vertexData.deviceAddress = addressVertex + geometry.vertexOffset;
             structure->geometry.geometry.triangles.maxVertex = geometry.vertexFirst + geometry.vertexCount - 1u;
@@ -131,7 +133,19 @@ namespace PK
         }
 
         VkAccelerationStructureInstanceKHR* instance = m_writeBuffer + m_instanceCount++;
-        instance->transform = Memory::BitCast<float3x4, VkTransformMatrixKHR>(matrix);
+        auto transform = matrix;
+
+        // Fold snorm position dequantization into the instance transform.
+        if (geometry.vertexFormat == ElementType::Short4)
+        {
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                const auto row = transform[i];
+                transform[i] = float4(row.xyz() * geometry.vertexExtents, math::dot(row.xyz(), geometry.vertexCenter) + row.w);
+            }
+        }
+
+        instance->transform = Memory::BitCast<float3x4, VkTransformMatrixKHR>(transform);
         instance->instanceCustomIndex = geometry.customIndex;
         instance->mask = 0xFF;
         instance->instanceShaderBindingTableRecordOffset = geometry.recordOffset;
@@ -101,20 +101,24 @@ namespace PK
     }
 
 
-    void* VulkanBuffer::BeginStagedWrite(size_t offset, size_t size)
+    void* VulkanBuffer::BeginStagedWrite(size_t offset, size_t size, const FenceRef& fence)
     {
         PK_DEBUG_FATAL_ASSERT((offset + size) <= GetSize(), "Map buffer range exceeds buffer bounds, map size: %i, buffer size: %i", offset + size, GetSize());
 
-        if (m_stage == nullptr || !m_stage->isPersistentMap)
+        m_stageRegion.dstOffset = offset;
+        m_stageRegion.size = size;
+
+        if ((m_usage & BufferUsage::PersistentStage) != 0)
         {
-            PK_DEBUG_FATAL_ASSERT(m_stage == nullptr, "Trying to begin a new mapping for a buffer that is already being mapped!");
-            m_stage = m_driver->stagingBufferCache->Acquire(size, false, nullptr);
+            m_stageRegion.srcOffset = m_stageRegion.ringOffset + offset;
+            return m_stage->BeginMap(m_stageRegion.srcOffset, 0ull);
         }
 
-        m_stageRegion.srcOffset = m_stage->isPersistentMap ? m_stageRegion.ringOffset + offset : 0ull;
-        m_stageRegion.dstOffset = offset;
-        m_stageRegion.size = size;
-        return m_stage->BeginMap(m_stageRegion.srcOffset, 0ull);
+        PK_DEBUG_FATAL_ASSERT(m_stage == nullptr, "Trying to begin a new mapping for a buffer that is already being mapped!");
+        auto allocation = m_driver->stagingBufferCache->Allocate(size, fence);
+        m_stage = allocation.buffer;
+        m_stageRegion.srcOffset = allocation.offset;
+        return allocation.mapped;
     }
 
     void VulkanBuffer::EndStagedWrite(RHIBuffer** dst, RHIBuffer** src, VkBufferCopy* region, const FenceRef& fence)
@@ -128,9 +132,12 @@ namespace PK
         region->size = m_stageRegion.size;
 
         m_stage->EndMap(m_stageRegion.srcOffset, m_stageRegion.size);
-        m_stageRegion.ringOffset = (m_stageRegion.ringOffset + m_buffer->size) % m_stage->size;
 
-        if (!m_stage->isPersistentMap)
+        if ((m_usage & BufferUsage::PersistentStage) != 0)
+        {
+            m_stageRegion.ringOffset = (m_stageRegion.ringOffset + m_buffer->size) % m_stage->size;
+        }
+        else
         {
             m_driver->stagingBufferCache->Release(m_stage, fence);
             m_stage = nullptr;
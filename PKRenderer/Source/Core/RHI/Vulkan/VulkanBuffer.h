@@ -23,7 +23,8 @@ namespace PK
         void SparseDeallocate(const BufferIndexRange& range) final;
 
         // @TODO bad pattern. Difficult to inline into begin/end map as user wont know the necessary flush context.
-        void* BeginStagedWrite(size_t offset, size_t size);
+        // Transient writes are sub allocated from the staging rings. Begin & end within the same command buffer recording.
+        void* BeginStagedWrite(size_t offset, size_t size, const FenceRef& fence);
         void EndStagedWrite(RHIBuffer** dst, RHIBuffer** src, VkBufferCopy* region, const FenceRef& fence);
 
         constexpr const VulkanBindHandle* GetBindHandle() const { return m_defaultView; }
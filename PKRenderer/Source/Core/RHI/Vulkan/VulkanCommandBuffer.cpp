@@ -431,7 +431,7 @@ namespace PK
 
     void* VulkanCommandBuffer::BeginBufferWrite(RHIBuffer* buffer, size_t offset, size_t size)
     {
-        return static_cast<VulkanBuffer*>(buffer)->BeginStagedWrite(offset, size);
+        return static_cast<VulkanBuffer*>(buffer)->BeginStagedWrite(offset, size, GetFenceRef());
     }
 
     void VulkanCommandBuffer::EndBufferWrite(RHIBuffer* buffer)
@@ -694,6 +694,7 @@ namespace PK
         if ((flags & PK_RENDER_STATE_DIRTY_PIPELINE) != 0)
         {
             vkCmdBindPipeline(m_commandBuffer, m_renderState->GetPipelineBindPoint(), m_renderState->GetPipeline());
+            m_renderState->GetServices()->bindCounters->frame.pipelineBinds++;
         }
 
         if ((flags & PK_RENDER_STATE_DIRTY_VERTEXBUFFERS) != 0)
@@ -719,6 +720,7 @@ namespace PK
             const auto layout = m_renderState->GetPipelineLayout();
             const auto bindPoint = m_renderState->GetPipelineBindPoint();
             vkCmdBindDescriptorSets(m_commandBuffer, bindPoint, layout, 0u, 1u, &descriptorSet, 0, nullptr);
+            m_renderState->GetServices()->bindCounters->frame.descriptorSetBinds++;
         }
 
         if (m_renderState->HasPipeline())
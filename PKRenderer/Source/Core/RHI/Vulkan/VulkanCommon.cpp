@@ -480,9 +480,8 @@ namespace PK
         }
     }
 
-    VulkanPipeline::VulkanPipeline(VkDevice device, VkPipelineCache pipelineCache, const VkGraphicsPipelineCreateInfo& createInfo, const char* name) : device(device)
+    VulkanPipeline::VulkanPipeline(VkDevice device, VkPipeline pipeline, const char* name) : device(device), pipeline(pipeline)
     {
-        VK_ASSERT_RESULT_CTX(vkCreateGraphicsPipelines(device, pipelineCache, 1, &createInfo, nullptr, &pipeline), "failed to create a graphics pipeline!");
         VulkanSetObjectDebugName(device, VK_OBJECT_TYPE_PIPELINE, (uint64_t)pipeline, name);
     }
 
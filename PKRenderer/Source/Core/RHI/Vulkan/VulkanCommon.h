@@ -343,7 +343,7 @@ namespace PK
 
     struct VulkanPipeline : public NoCopy
     {
-        VulkanPipeline(VkDevice device, VkPipelineCache pipelineCache, const VkGraphicsPipelineCreateInfo& createInfo, const char* name);
+        VulkanPipeline(VkDevice device, VkPipeline pipeline, const char* name);
         VulkanPipeline(VkDevice device, VkPipelineCache pipelineCache, const VkComputePipelineCreateInfo& createInfo, const char* name);
         VulkanPipeline(VkDevice device, VkPipelineCache pipelineCache, const VkRayTracingPipelineCreateInfoKHR& createInfo, const char* name);
         ~VulkanPipeline();
@@ -1,5 +1,6 @@
 #include "PrecompiledHeader.h"
 #include "Core/CLI/Log.h"
+#include "Core/CLI/CVariableRegister.h"
 #include "Core/RHI/Vulkan/VulkanBuffer.h"
 #include "Core/RHI/Vulkan/VulkanTexture.h"
 #include "Core/RHI/Vulkan/VulkanAccelerationStructure.h"
@@ -179,11 +180,27 @@ namespace PK
                 samplerCache.get(),
                 stagingBufferCache.get(),
                 nullptr, // Assigned by queues
-                disposer.get()
+                disposer.get(),
+                &bindCounters
             }
         );
 
         builtInResources.New();
+
+        CVariableRegister::Create<CVariableFuncSimple>("RHI.Vulkan.Query.PipelinePrewarm", []()
+            {
+                auto driver = static_cast<VulkanDriver*>(RHIDriver::Get());
+                auto& stats = driver->pipelineCache->GetPrewarmStats();
+                auto requests = stats.prewarmHits + stats.onDemandCompiles;
+                PK_LOG_HEADER("----------VULKAN PIPELINE PREWARM----------");
+                PK_LOG_NEWLINE();
+                PK_LOG_INFO("Manifest keys: %u", stats.manifestKeys);
+                PK_LOG_INFO("Prewarmed: %u", stats.prewarmed);
+                PK_LOG_INFO("Coverage: %4.1f%% (%u/%u first requests)", requests > 0u ? 100.0f * stats.prewarmHits / requests : 0.0f, stats.prewarmHits, requests);
+                PK_LOG_INFO("On demand compiles: %u (%u in manifest)", stats.onDemandCompiles, stats.onDemandManifestMisses);
+                PK_LOG_INFO("On demand stall: %4.2fms total, %4.2fms max (%s)", stats.stallSeconds * 1000.0, stats.maxStallSeconds * 1000.0, stats.maxStallShader.c_str());
+                PK_LOG_NEWLINE();
+            });
     }
 
     VulkanDriver::~VulkanDriver()
@@ -281,12 +298,12 @@ namespace PK
     #define PK_VK_BIND_HANDLES(name, assigner, count)\
         auto handles = PK_STACK_ALLOC(const VulkanBindHandle*, count);\
         for (auto i = 0u; i < (uint32_t)count; ++i) handles[i] = assigner;\
-        globalResources.Set(name, handles, (uint32_t)count)                   
+        SetBinding(name, handles, (uint32_t)count)
 
     void VulkanDriver::SetBuffers(NameID name, RHIBuffer** buffers, const BufferIndexRange* ranges, size_t count) { PK_VK_BIND_HANDLES(name, static_cast<VulkanBuffer*>(buffers[i])->GetBindHandle(ranges[i]), count); }
-    void VulkanDriver::SetBufferSet(NameID name, RHIBindSet<RHIBuffer>* bufferArray) { globalResources.Set(name, static_cast<const VulkanBindSet*>(bufferArray)); }
+    void VulkanDriver::SetBufferSet(NameID name, RHIBindSet<RHIBuffer>* bufferArray) { auto set = static_cast<const VulkanBindSet*>(bufferArray); SetBinding(name, &set, 1u); }
     void VulkanDriver::SetTextures(NameID name, RHITexture** textures, const TextureViewRange* ranges, size_t count) { PK_VK_BIND_HANDLES(name, static_cast<VulkanTexture*>(textures[i])->GetBindHandle(ranges[i], TextureBindMode::SampledTexture), count); }
-    void VulkanDriver::SetTextureSet(NameID name, RHIBindSet<RHITexture>* textureArray) { globalResources.Set(name, static_cast<const VulkanBindSet*>(textureArray)); }
+    void VulkanDriver::SetTextureSet(NameID name, RHIBindSet<RHITexture>* textureArray) { auto set = static_cast<const VulkanBindSet*>(textureArray); SetBinding(name, &set, 1u); }
     void VulkanDriver::SetImages(NameID name, RHITexture** images, const TextureViewRange* ranges, size_t count) { PK_VK_BIND_HANDLES(name, static_cast<VulkanTexture*>(images[i])->GetBindHandle(ranges[i], TextureBindMode::Image), count); }
     void VulkanDriver::SetSamplers(NameID name, const SamplerDescriptor* samplers, size_t count) { PK_VK_BIND_HANDLES(name, samplerCache->GetBindHandle(samplers[i]), count); }
     void VulkanDriver::SetAccelerationStructures(NameID name, RHIAccelerationStructure** structures, size_t count) { PK_VK_BIND_HANDLES(name, static_cast<VulkanAccelerationStructure*>(structures[i])->GetBindHandle(), count); }
@@ -303,7 +320,10 @@ namespace PK
         disposer->Prune();
         queues->Prune();
         layoutCache->Prune();
+        globalResources.NextFrame();
         arena.Clear();
+        bindStats = bindCounters.frame;
+        bindCounters.frame = {};
     }
 
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Base/Containers/TypeSet.h"
+#include "Core/Base/Containers/VersionedPropertyBlock.h"
 #include "Core/Base/Types/Ref.h"
 #include "Core/Base/NoCopy.h"
 #include "Core/ControlFlow/Disposer.h"
@@ -54,9 +55,10 @@ namespace PK
         RHIQueueSet* GetQueues() const final { return queues.get(); }
         FixedString32 GetDriverHeader() const final;
         RHIDriverMemoryInfo GetMemoryInfo() const final;
+        RHIDriverBindStats GetBindStats() const final { return bindStats; }
         size_t GetBufferOffsetAlignment(BufferUsage usage) const final;
         BuiltInResources* GetBuiltInResources() final { return builtInResources; }
-        PropertyBlock* GetResourceState() final { return &globalResources; }
+        VersionedPropertyBlock* GetResourceState() final { return &globalResources; }
 
         RHIBufferRef CreateBuffer(size_t size, BufferUsage usage, const char* name) final;
         RHITextureRef CreateTexture(const TextureDescriptor& descriptor, const char* name) final;
@@ -104,6 +106,15 @@ namespace PK
             fence);
         }
 
+        // Descriptor resource writes advance the binding version only if the value changed.
+        template<typename T>
+        void SetBinding(NameID name, const T* values, uint32_t count)
+        {
+            const auto version = globalResources.GetVersion();
+            globalResources.Set(name, values, count);
+            bindCounters.bindingVersion += globalResources.GetVersion() != version ? 1u : 0u;
+        }
+
         template<typename T>
         void DeletePooled(T* object) const
         {
@@ -131,7 +142,9 @@ namespace PK
         
         FixedUnique<BuiltInResources> builtInResources;
         
-        PropertyBlock globalResources;
+        VersionedPropertyBlock globalResources;
+        VulkanBindCounters bindCounters;
+        RHIDriverBindStats bindStats{};
 
         FixedRefPool<VulkanTexture, PK_VK_MAX_IMAGES> texturePool;
         FixedRefPool<VulkanShader, PK_VK_MAX_SHADERS> shaderPool;
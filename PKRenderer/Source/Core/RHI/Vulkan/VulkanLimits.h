@@ -38,6 +38,10 @@ namespace PK
     constexpr static const uint64_t PK_VK_MAX_SPARSE_RANGES = 1024ull;
     
     constexpr static const uint64_t PK_VK_MAX_STAGING_BUFFERS = 512ull;
+    constexpr static const uint64_t PK_VK_STAGING_RING_SIZE = 16777216ull;
+    constexpr static const uint64_t PK_VK_STAGING_RING_ALIGNMENT = 16ull;
+    constexpr static const uint32_t PK_VK_STAGING_RING_MAX_COUNT = 4u;
+    constexpr static const uint32_t PK_VK_STAGING_RING_MAX_MARKERS = 64u;
     
     constexpr static const uint64_t PK_VK_MAX_SAMPLERS = 32ull;
     
@@ -45,6 +49,9 @@ namespace PK
     constexpr static const uint64_t PK_VK_MAX_PIPELINES_VERTEX = 1024ull;
     constexpr static const uint64_t PK_VK_MAX_PIPELINES_MESH = 1024ull;
     constexpr static const uint64_t PK_VK_MAX_PIPELINES_GENERIC = 1024ull;
+    constexpr static const uint64_t PK_VK_MAX_PIPELINE_MANIFEST_KEYS = 2048ull;
+    constexpr static const uint32_t PK_VK_PIPELINE_PREWARM_BATCH_SIZE = 16u;
+    constexpr static const uint64_t PK_VK_PIPELINE_PREWARM_PRUNE_DELAY = 4096ull;
 
     constexpr static const uint64_t PK_VK_MAX_DESCRIPTOR_SET_LAYOUTS = 1024ull;
     constexpr static const uint64_t PK_VK_MAX_PIPELINE_LAYOUTS = 1024ull;
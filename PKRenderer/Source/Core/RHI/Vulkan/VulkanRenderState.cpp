@@ -540,6 +540,21 @@ namespace PK
 
         // Validate descriptors
         {
+            const auto counters = m_services.bindCounters;
+
+            // Same shader, no binding writes & no value moves since the last resolve. Fixed size bindings can skip the property lookup.
+            // Handles can be modified without being rebound. Their versions are always rehashed.
+            // Variable size sets track their modifications locally & are always revalidated.
+            const auto bindingsUnchanged = (m_dirtyFlags & PK_RENDER_STATE_DIRTY_SHADER) == 0u &&
+                m_descritorState.bindingCount == resourceLayout.GetCount() &&
+                m_descritorState.bindingVersion == counters->bindingVersion &&
+                m_descritorState.storageVersion == resources->GetStorageVersion();
+
+            auto isDirty = m_descritorState.bindingCount != resourceLayout.GetCount();
+
+            counters->frame.descriptorResolves++;
+            counters->frame.descriptorResolveSkips += bindingsUnchanged ? 1u : 0u;
+
             for (auto index = 0u; index < resourceLayout.GetCount(); ++index)
             {
                 const auto& element = resourceLayout[index];
@@ -559,24 +574,32 @@ namespace PK
                 }
                 else
                 {
-                    auto size = 0ull;
-                    PK_FATAL_ASSERT(resources->TryGet<const VulkanBindHandle*>(element.name, &handles, &size), "Descriptor '%s' not bound!", element.name.c_str());
-                    PK_FATAL_ASSERT(size == sizeof(void*) * element.count, "Descriptor '%s' bound array size '%u' doesn't match size '%u' in shader", element.name.c_str(), size / sizeof(void*), element.count);
-                    version = (uint32_t)handles[0]->Version();
+                    if (bindingsUnchanged)
+                    {
+                        handles = binding.handles;
+                    }
+                    else
+                    {
+                        auto size = 0ull;
+                        PK_FATAL_ASSERT(resources->TryGet<const VulkanBindHandle*>(element.name, &handles, &size), "Descriptor '%s' not bound!", element.name.c_str());
+                        PK_FATAL_ASSERT(size == sizeof(void*) * element.count, "Descriptor '%s' bound array size '%u' doesn't match size '%u' in shader", element.name.c_str(), size / sizeof(void*), element.count);
+                    }
+
                     count = element.count;
-                }
+                    version = (uint32_t)handles[0]->Version();
 
-                // Hash fixed size array version.
-                for (auto i = 1u; i < count && !isVariableSize; ++i)
-                {
-                    auto hash = (uint32_t)handles[i]->Version();
-                    hash += 0x9e3779b9u + (version << 6u) + (version >> 2u);
-                    version ^= hash;
+                    // Hash fixed size array version.
+                    for (auto i = 1u; i < count; ++i)
+                    {
+                        auto hash = (uint32_t)handles[i]->Version();
+                        hash += 0x9e3779b9u + (version << 6u) + (version >> 2u);
+                        version ^= hash;
+                    }
                 }
 
                 if (binding.handles != handles || binding.count != count || binding.type != element.type || binding.version != version)
                 {
-                    m_dirtyFlags |= PK_RENDER_STATE_DIRTY_DESCRIPTORS;
+                    isDirty = true;
                     binding.handles = handles;
                     binding.count = (uint16_t)count;
                     binding.type = element.type;
@@ -605,16 +628,24 @@ namespace PK
                 }
             }
 
-            if (m_descritorState.bindingCount != resourceLayout.GetCount())
-            {
-                m_dirtyFlags |= PK_RENDER_STATE_DIRTY_DESCRIPTORS;
-                m_descritorState.bindingCount = (uint32_t)resourceLayout.GetCount();
-            }
+            m_descritorState.bindingVersion = counters->bindingVersion;
+            m_descritorState.storageVersion = resources->GetStorageVersion();
+            m_descritorState.bindingCount = (uint32_t)resourceLayout.GetCount();
 
-            if (m_dirtyFlags & PK_RENDER_STATE_DIRTY_DESCRIPTORS)
+            if (isDirty)
             {
                 auto name = shader->GetName();
-                m_descritorState.descriptorSet = m_services.descriptorCache->GetDescriptorSet(descriptorLayout, m_descritorState.bindings, m_descritorState.bindingCount, fence, name);
+                auto isCached = false;
+                auto previousSet = m_descritorState.descriptorSet;
+                m_descritorState.descriptorSet = m_services.descriptorCache->GetDescriptorSet(descriptorLayout, m_descritorState.bindings, m_descritorState.bindingCount, fence, name, &isCached);
+                counters->frame.descriptorSetLookups++;
+                counters->frame.descriptorSetCacheHits += isCached ? 1u : 0u;
+
+                // Bindings can return to a previously bound combination. Skip the rebind if the set is the same.
+                if (m_descritorState.descriptorSet != previousSet)
+                {
+                    m_dirtyFlags |= PK_RENDER_STATE_DIRTY_DESCRIPTORS;
+                }
             }
 
             // @TODO Technically we should maintain different sets for different bind points but...
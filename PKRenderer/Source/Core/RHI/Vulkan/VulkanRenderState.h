@@ -1,5 +1,5 @@
 #pragma once
-#include "Core/Base/Containers/PropertyBlock.h"
+#include "Core/Base/Containers/VersionedPropertyBlock.h"
 #include "Core/ControlFlow/Disposer.h"
 #include "Core/RHI/Vulkan/VulkanCommon.h"
 #include "Core/RHI/Vulkan/Services/VulkanDescriptorCache.h"
@@ -20,22 +20,32 @@ namespace PK
         PK_RENDER_STATE_DIRTY_DESCRIPTORS = 1 << 5
     };
 
+    // Shared by all render states. Binding version advances when a descriptor resource binding changes value.
+    // Constants & keywords share the resource block but don't advance it.
+    struct VulkanBindCounters
+    {
+        uint32_t bindingVersion = 0u;
+        RHIDriverBindStats frame{};
+    };
+
     struct VulkanServiceContext
     {
-        PropertyBlock* globalResources = nullptr;
+        VersionedPropertyBlock* globalResources = nullptr;
         VulkanDescriptorCache* descriptorCache = nullptr;
         VulkanPipelineCache* pipelineCache = nullptr;
         VulkanSamplerCache* samplerCache = nullptr;
         VulkanStagingBufferCache* stagingBufferCache = nullptr;
         VulkanBarrierHandler* barrierHandler = nullptr;
         Disposer* disposer = nullptr;
-        VulkanServiceContext& SetGlobalResources(PropertyBlock* value) { globalResources = value; return *this; }
+        VulkanBindCounters* bindCounters = nullptr;
+        VulkanServiceContext& SetGlobalResources(VersionedPropertyBlock* value) { globalResources = value; return *this; }
         VulkanServiceContext& SetDescriptorCache(VulkanDescriptorCache* value) { descriptorCache = value; return *this; }
         VulkanServiceContext& SetPipelineCache(VulkanPipelineCache* value) { pipelineCache = value; return *this; }
         VulkanServiceContext& SetSamplerCache(VulkanSamplerCache* value) { samplerCache = value; return *this; }
         VulkanServiceContext& SetStagingBufferCache(VulkanStagingBufferCache* value) { stagingBufferCache = value; return *this; }
         VulkanServiceContext& SetBarrierHandler(VulkanBarrierHandler* value) { barrierHandler = value; return *this; }
         VulkanServiceContext& SetDisposer(Disposer* value) { disposer = value; return *this; }
+        VulkanServiceContext& SetBindCounters(VulkanBindCounters* value) { bindCounters = value; return *this; }
     };
 
     struct VulkanVertexBufferBundle
@@ -48,6 +58,8 @@ namespace PK
     struct VulkanDescriptorState
     {
         VulkanDescriptorCache::DescriptorBinding bindings[PK_RHI_MAX_DESCRIPTORS_PER_SET]{};
+        uint32_t bindingVersion = 0u;
+        uint32_t storageVersion = 0u;
         const VulkanDescriptorSet* descriptorSet = nullptr;
         VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
         VkShaderStageFlagBits stageFlags = (VkShaderStageFlagBits)0;
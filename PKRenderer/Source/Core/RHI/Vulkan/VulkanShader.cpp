@@ -91,10 +91,12 @@ namespace PK
         }
 
         m_pipelineLayout = m_driver->layoutCache->GetPipelineLayout(pipelineKey, name);
+        m_driver->pipelineCache->QueuePrewarm(this);
     }
 
     VulkanShader::~VulkanShader()
     {
+        m_driver->pipelineCache->ReleasePrewarm(this);
         auto fence = m_driver->GetQueues()->GetLastSubmitFenceRef();
 
         m_driver->layoutCache->ReleasePipelineLayout(m_pipelineLayout, fence);
@@ -104,7 +106,7 @@ namespace PK
         {
             if (module != VK_NULL_HANDLE)
             {
-                m_driver->disposer->Dispose(m_driver->device, module, [](void* c, void* v)
+                m_driver->disposer->DisposeAsync(m_driver->device, module, [](void* c, void* v)
                 {
                     vkDestroyShaderModule(static_cast<VkDevice>(c), static_cast<VkShaderModule>(v), nullptr);
                 }, 
@@ -126,20 +126,20 @@ namespace PK
 
         if (m_imageAlias != VK_NULL_HANDLE)
         {
-            m_driver->disposer->Dispose(m_driver->device, m_imageAlias, [](void* c, void* v)
+            m_driver->disposer->DisposeAsync(m_driver->device, m_imageAlias, [](void* c, void* v)
             {
                 vkDestroyImage(static_cast<VkDevice>(c), static_cast<VkImage>(v), nullptr);
             },
             fence);
         }
 
-        m_driver->disposer->Dispose(m_driver->device, m_image, [](void* c, void* v)
+        m_driver->disposer->DisposeAsync(m_driver->device, m_image, [](void* c, void* v)
         {
             vkDestroyImage(static_cast<VkDevice>(c), static_cast<VkImage>(v), nullptr);
         },
         fence);
 
-        m_driver->disposer->Dispose(m_driver->allocator, m_memory, [](void* c, void* v)
+        m_driver->disposer->DisposeAsync(m_driver->allocator, m_memory, [](void* c, void* v)
         {
             vmaFreeMemory(static_cast<VmaAllocator>(c), static_cast<VmaAllocation>(v));
         },
@@ -0,0 +1,304 @@
+#include "PrecompiledHeader.h"
+#include "Core/CLI/Log.h"
+#include "Core/RHI/RHInterfaces.h"
+#include "Core/Rendering/CommandBufferExt.h"
+#include "Core/Rendering/ShaderAsset.h"
+#include "CommandList.h"
+
+namespace PK
+{
+    namespace
+    {
+        struct CmdSetShader { const ShaderAsset* shader; int32_t variantIndex; };
+        struct CmdSetKeyword { NameID name; bool value; };
+        struct CmdSetConstant { NameID name; uint32_t size; };
+        struct CmdSetBuffer { NameID name; uint32_t hasRange; RHIBuffer* buffer; BufferIndexRange range; };
+        struct CmdDraw { uint32_t vertexCount; uint32_t instanceCount; uint32_t firstVertex; uint32_t firstInstance; };
+        struct CmdDrawIndexed { uint32_t indexCount; uint32_t instanceCount; uint32_t firstIndex; int32_t vertexOffset; uint32_t firstInstance; };
+        struct CmdDrawIndirect { const RHIBuffer* buffer; size_t offset; uint32_t drawCount; uint32_t stride; };
+        struct CmdDebugScope { color debugColor; };
+    }
+
+    CommandList::CommandList(size_t initialCapacity)
+    {
+        m_data.Reserve(initialCapacity, false);
+    }
+
+    void CommandList::Reset()
+    {
+        m_head = 0ull;
+        m_lastCommand = 0ull;
+        m_commandCount = 0u;
+        m_filteredCount = 0u;
+        m_shader = nullptr;
+        m_variantIndex = -1;
+        m_hasFixedState = false;
+        m_bindingCount = 0u;
+    }
+
+    void CommandList::Replay(CommandBufferExt cmd) const
+    {
+        auto head = m_data.GetData();
+        auto end = head + m_head;
+
+        while (head < end)
+        {
+            auto header = reinterpret_cast<const CommandHeader*>(head);
+            auto payload = head + sizeof(CommandHeader);
+
+            switch (header->type)
+            {
+                case CommandType::SetShader:
+                {
+                    auto args = reinterpret_cast<const CmdSetShader*>(payload);
+                    cmd.SetShader(args->shader, args->variantIndex);
+                }
+                break;
+                case CommandType::SetFixedStateAttributes:
+                {
+                    cmd.SetFixedStateAttributes(reinterpret_cast<const FixedFunctionShaderAttributes*>(payload));
+                }
+                break;
+                case CommandType::SetKeyword:
+                {
+                    auto args = reinterpret_cast<const CmdSetKeyword*>(payload);
+                    RHI::SetKeyword(args->name, args->value);
+                }
+                break;
+                case CommandType::SetConstant:
+                {
+                    auto args = reinterpret_cast<const CmdSetConstant*>(payload);
+                    RHI::SetConstant(args->name, args + 1, args->size);
+                }
+                break;
+                case CommandType::SetBuffer:
+                {
+                    auto args = reinterpret_cast<const CmdSetBuffer*>(payload);
+
+                    if (args->hasRange != 0u)
+                    {
+                        RHI::SetBuffer(args->name, args->buffer, args->range);
+                    }
+                    else
+                    {
+                        RHI::SetBuffer(args->name, args->buffer);
+                    }
+                }
+                break;
+                case CommandType::Draw:
+                {
+                    auto args = reinterpret_cast<const CmdDraw*>(payload);
+                    cmd->Draw(args->vertexCount, args->instanceCount, args->firstVertex, args->firstInstance);
+                }
+                break;
+                case CommandType::DrawIndexed:
+                {
+                    auto args = reinterpret_cast<const CmdDrawIndexed*>(payload);
+                    cmd->DrawIndexed(args->indexCount, args->instanceCount, args->firstIndex, args->vertexOffset, args->firstInstance);
+                }
+                break;
+                case CommandType::DrawMeshTasks:
+                {
+                    cmd->DrawMeshTasks(*reinterpret_cast<const uint3*>(payload));
+                }
+                break;
+                case CommandType::DrawMeshTasksIndirect:
+                {
+                    auto args = reinterpret_cast<const CmdDrawIndirect*>(payload);
+                    cmd->DrawMeshTasksIndirect(args->buffer, args->offset, args->drawCount, args->stride);
+                }
+                break;
+                case CommandType::Dispatch:
+                {
+                    cmd->Dispatch(*reinterpret_cast<const uint3*>(payload));
+                }
+                break;
+                case CommandType::BeginDebugScope:
+                {
+                    auto args = reinterpret_cast<const CmdDebugScope*>(payload);
+                    cmd->BeginDebugScope(reinterpret_cast<const char*>(args + 1), args->debugColor);
+                }
+                break;
+                case CommandType::EndDebugScope:
+                {
+                    cmd->EndDebugScope();
+                }
+                break;
+                default: PK_FATAL_ERROR("Unknown command type %u", (uint32_t)header->type);
+            }
+
+            head += header->size;
+        }
+    }
+
+    void CommandList::SetShader(const ShaderAsset* shader, int32_t variantIndex)
+    {
+        if (m_shader == shader && m_variantIndex == variantIndex)
+        {
+            m_filteredCount++;
+            return;
+        }
+
+        auto args = reinterpret_cast<CmdSetShader*>(Write(CommandType::SetShader, sizeof(CmdSetShader)));
+        args->shader = shader;
+        args->variantIndex = variantIndex;
+        m_shader = shader;
+        m_variantIndex = variantIndex;
+
+        // Graphics shaders also apply their own fixed state at replay.
+        m_hasFixedState = false;
+    }
+
+    void CommandList::SetFixedStateAttributes(const FixedFunctionShaderAttributes* attribs)
+    {
+        if (attribs == nullptr)
+        {
+            return;
+        }
+
+        if (m_hasFixedState && memcmp(&m_fixedState, attribs, sizeof(FixedFunctionShaderAttributes)) == 0)
+        {
+            m_filteredCount++;
+            return;
+        }
+
+        auto args = Write(CommandType::SetFixedStateAttributes, sizeof(FixedFunctionShaderAttributes));
+        memcpy(args, attribs, sizeof(FixedFunctionShaderAttributes));
+        m_fixedState = *attribs;
+        m_hasFixedState = true;
+    }
+
+    void CommandList::SetKeyword(NameID name, bool value)
+    {
+        auto args = reinterpret_cast<CmdSetKeyword*>(Write(CommandType::SetKeyword, sizeof(CmdSetKeyword)));
+        args->name = name;
+        args->value = value;
+
+        if (!TrackBinding(name, (size_t)(reinterpret_cast<uint8_t*>(&args->value) - m_data.GetData()), sizeof(bool)))
+        {
+            // Unresolved variants depend on the keyword state at replay.
+            m_shader = nullptr;
+        }
+    }
+
+    void CommandList::SetConstant(NameID name, const void* data, uint32_t size)
+    {
+        auto args = reinterpret_cast<CmdSetConstant*>(Write(CommandType::SetConstant, sizeof(CmdSetConstant) + size));
+        args->name = name;
+        args->size = size;
+        memcpy(reinterpret_cast<uint8_t*>(args + 1), data, size);
+        TrackBinding(name, (size_t)(reinterpret_cast<uint8_t*>(args + 1) - m_data.GetData()), size);
+    }
+
+    void CommandList::SetBuffer(NameID name, RHIBuffer* buffer, const BufferIndexRange& range)
+    {
+        auto args = reinterpret_cast<CmdSetBuffer*>(Write(CommandType::SetBuffer, sizeof(CmdSetBuffer)));
+        args->name = name;
+        args->hasRange = 1u;
+        args->buffer = buffer;
+        args->range = range;
+        TrackBinding(name, (size_t)(reinterpret_cast<uint8_t*>(&args->hasRange) - m_data.GetData()), sizeof(CmdSetBuffer) - offsetof(CmdSetBuffer, hasRange));
+    }
+
+    void CommandList::SetBuffer(NameID name, RHIBuffer* buffer)
+    {
+        auto args = reinterpret_cast<CmdSetBuffer*>(Write(CommandType::SetBuffer, sizeof(CmdSetBuffer)));
+        args->name = name;
+        args->hasRange = 0u;
+        args->buffer = buffer;
+        args->range = {};
+        TrackBinding(name, (size_t)(reinterpret_cast<uint8_t*>(&args->hasRange) - m_data.GetData()), sizeof(CmdSetBuffer) - offsetof(CmdSetBuffer, hasRange));
+    }
+
+    void CommandList::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+    {
+        *reinterpret_cast<CmdDraw*>(Write(CommandType::Draw, sizeof(CmdDraw))) = { vertexCount, instanceCount, firstVertex, firstInstance };
+    }
+
+    void CommandList::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+    {
+        *reinterpret_cast<CmdDrawIndexed*>(Write(CommandType::DrawIndexed, sizeof(CmdDrawIndexed))) = { indexCount, instanceCount, firstIndex, vertexOffset, firstInstance };
+    }
+
+    void CommandList::DrawMeshTasks(const uint3& dimensions)
+    {
+        *reinterpret_cast<uint3*>(Write(CommandType::DrawMeshTasks, sizeof(uint3))) = dimensions;
+    }
+
+    void CommandList::DrawMeshTasksIndirect(const RHIBuffer* indirectArguments, size_t offset, uint32_t drawCount, uint32_t stride)
+    {
+        *reinterpret_cast<CmdDrawIndirect*>(Write(CommandType::DrawMeshTasksIndirect, sizeof(CmdDrawIndirect))) = { indirectArguments, offset, drawCount, stride };
+    }
+
+    void CommandList::Dispatch(const uint3& dimensions)
+    {
+        *reinterpret_cast<uint3*>(Write(CommandType::Dispatch, sizeof(uint3))) = dimensions;
+    }
+
+    void CommandList::BeginDebugScope(const char* name, const color& color)
+    {
+        // Name is copied as recording threads might not own it until replay.
+        auto length = strlen(name) + 1ull;
+        auto args = reinterpret_cast<CmdDebugScope*>(Write(CommandType::BeginDebugScope, sizeof(CmdDebugScope) + length));
+        args->debugColor = color;
+        memcpy(args + 1, name, length);
+    }
+
+    void CommandList::EndDebugScope()
+    {
+        Write(CommandType::EndDebugScope, 0ull);
+    }
+
+    void* CommandList::Write(CommandType type, size_t size)
+    {
+        auto commandSize = Memory::AlignSize<uint64_t>(sizeof(CommandHeader) + size);
+
+        if (m_head + commandSize > m_data.GetCount())
+        {
+            m_data.Reserve((m_head + commandSize) * 2ull, true);
+        }
+
+        auto header = reinterpret_cast<CommandHeader*>(m_data.GetData() + m_head);
+        header->type = type;
+        header->padding = 0u;
+        header->size = (uint32_t)commandSize;
+        m_lastCommand = m_head;
+        m_head += commandSize;
+        m_commandCount++;
+        return header + 1;
+    }
+
+    bool CommandList::TrackBinding(NameID name, size_t offset, uint32_t size)
+    {
+        for (auto i = 0u; i < m_bindingCount; ++i)
+        {
+            auto binding = &m_bindings[i];
+
+            if (binding->name != name)
+            {
+                continue;
+            }
+
+            if (binding->size == size && memcmp(m_data.GetData() + binding->offset, m_data.GetData() + offset, size) == 0)
+            {
+                // Same value as the previous write. Drop the command that was just written.
+                m_head = m_lastCommand;
+                m_commandCount--;
+                m_filteredCount++;
+                return true;
+            }
+
+            binding->offset = offset;
+            binding->size = size;
+            return false;
+        }
+
+        // Untracked names are always written. Lists usually touch only a handful of bindings.
+        if (m_bindingCount < MAX_TRACKED_BINDINGS)
+        {
+            m_bindings[m_bindingCount++] = { name, size, offset };
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include "Core/Base/Containers/ArrayList.h"
+#include "Core/Base/NoCopy.h"
+#include "Core/Rendering/RenderingFwd.h"
+
+namespace PK
+{
+    // Compact linear command stream that is backend agnostic & safe to record off the render thread.
+    // Lists are replayed in submission order on the render thread. Redundant state is filtered while recording.
+    // Shader variants & global resource writes are resolved at replay, so recording only reads immutable asset data.
+    class CommandList : public NoCopy
+    {
+        public:
+            enum class CommandType : uint16_t
+            {
+                SetShader,
+                SetFixedStateAttributes,
+                SetKeyword,
+                SetConstant,
+                SetBuffer,
+                Draw,
+                DrawIndexed,
+                DrawMeshTasks,
+                DrawMeshTasksIndirect,
+                Dispatch,
+                BeginDebugScope,
+                EndDebugScope
+            };
+
+            CommandList(size_t initialCapacity = 4096ull);
+
+            constexpr uint32_t GetCommandCount() const { return m_commandCount; }
+            constexpr uint32_t GetFilteredCount() const { return m_filteredCount; }
+            constexpr size_t GetSize() const { return m_head; }
+
+            void Reset();
+            void Replay(CommandBufferExt cmd) const;
+
+            void SetShader(const ShaderAsset* shader, int32_t variantIndex = -1);
+            void SetFixedStateAttributes(const FixedFunctionShaderAttributes* attribs);
+            void SetKeyword(NameID name, bool value);
+            void SetConstant(NameID name, const void* data, uint32_t size);
+            void SetBuffer(NameID name, RHIBuffer* buffer, const BufferIndexRange& range);
+            void SetBuffer(NameID name, RHIBuffer* buffer);
+            void Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+            void DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+            void DrawMeshTasks(const uint3& dimensions);
+            void DrawMeshTasksIndirect(const RHIBuffer* indirectArguments, size_t offset, uint32_t drawCount, uint32_t stride);
+            void Dispatch(const uint3& dimensions);
+            void BeginDebugScope(const char* name, const color& color);
+            void EndDebugScope();
+
+            template<typename T>
+            void SetConstant(NameID name, const T& value) { SetConstant(name, &value, (uint32_t)sizeof(T)); }
+
+        private:
+            constexpr static const uint32_t MAX_TRACKED_BINDINGS = 16u;
+
+            struct CommandHeader
+            {
+                CommandType type;
+                uint16_t padding;
+                uint32_t size;
+            };
+
+            struct TrackedBinding
+            {
+                NameID name;
+                uint32_t size;
+                size_t offset;
+            };
+
+            void* Write(CommandType type, size_t size);
+            // Returns true & drops the last command if the binding has the same value as when it was last written by this list.
+            bool TrackBinding(NameID name, size_t offset, uint32_t size);
+
+            HeapArray<uint8_t> m_data;
+            size_t m_head = 0ull;
+            size_t m_lastCommand = 0ull;
+            uint32_t m_commandCount = 0u;
+            uint32_t m_filteredCount = 0u;
+
+            const ShaderAsset* m_shader = nullptr;
+            int32_t m_variantIndex = -1;
+            bool m_hasFixedState = false;
+            FixedFunctionShaderAttributes m_fixedState{};
+            TrackedBinding m_bindings[MAX_TRACKED_BINDINGS]{};
+            uint32_t m_bindingCount = 0u;
+    };
+}
@@ -13,7 +13,7 @@ namespace PK
     IRayTracingGeometry::~IRayTracingGeometry() = default;
 
 
-    MeshStaticAllocator::MeshStaticAllocator()
+    MeshStaticAllocator::MeshStaticAllocator(bool quantize) : m_isQuantized(quantize)
     {
         // @TODO refactor these into a descriptor
         const auto maxSubmeshes = 65535u;
@@ -23,19 +23,36 @@ namespace PK
         const auto flags = BufferUsage::GPUOnly | BufferUsage::TransferDst | BufferUsage::Storage | BufferUsage::Sparse;
 
         static_assert((maxTriangles * 3ull) % 4ull == 0ull, "Input triangle count x3 must be divisible by 4");
+        static_assert(sizeof(MeshUtilities::VertexQuantizedAttributes) == 12ull, "Quantized attribute size missmatch!");
+        static_assert(sizeof(MeshUtilities::VertexQuantizedPosition) == 8ull, "Quantized position size missmatch!");
 
-        m_streamLayout = VertexStreamLayout(
+        if (m_isQuantized)
         {
-            { ElementType::Half4, PK_RHI_VS_NORMAL, 0 },
-            { ElementType::Half4, PK_RHI_VS_TANGENT, 0 },
-            { ElementType::Half2, PK_RHI_VS_TEXCOORD0, 0 },
-            { ElementType::Float3, PK_RHI_VS_POSITION, 1 },
-        });
+            // See MeshUtilities::VertexQuantizedAttributes & VertexQuantizedPosition.
+            // Positions are read as R16G16B16A16_SNORM by acceleration structure builds.
+            m_streamLayout = VertexStreamLayout(
+            {
+                { ElementType::Short2, PK_RHI_VS_NORMAL, 0 },
+                { ElementType::Short2, PK_RHI_VS_TANGENT, 0 },
+                { ElementType::Half2, PK_RHI_VS_TEXCOORD0, 0 },
+                { ElementType::Short4, PK_RHI_VS_POSITION, 1 },
+            });
+        }
+        else
+        {
+            m_streamLayout = VertexStreamLayout(
+            {
+                { ElementType::Half4, PK_RHI_VS_NORMAL, 0 },
+                { ElementType::Half4, PK_RHI_VS_TANGENT, 0 },
+                { ElementType::Half2, PK_RHI_VS_TEXCOORD0, 0 },
+                { ElementType::Float3, PK_RHI_VS_POSITION, 1 },
+            });
+        }
 
         m_vertexBuffers.ClearFast();
         m_vertexBuffers.Add(RHI::CreateBuffer(m_streamLayout.GetStride(0u) * 2000000u, BufferUsage::SparseVertex, "MeshStaticCollection.VertexAttributes"));
         m_vertexBuffers.Add(RHI::CreateBuffer(m_streamLayout.GetStride(1u) * 2000000u, BufferUsage::SparseVertex | BufferUsage::Storage, "MeshStaticCollection.VertexPositions"));
-        m_indexBuffer = RHI::CreateBuffer(m_indexSize * 2000000u, BufferUsage::SparseIndex | BufferUsage::Storage, "MeshStaticCollection.IndexBuffer");
+        m_indexBuffer = RHI::CreateBuffer(sizeof(uint32_t) * 2000000u, BufferUsage::SparseIndex | BufferUsage::Storage, "MeshStaticCollection.IndexBuffer");
         m_submeshBuffer = RHI::CreateBuffer<PKAssets::PKMeshletSubmesh>(maxSubmeshes, flags, "Meshlet.SubmeshBuffer");
         m_meshletBuffer = RHI::CreateBuffer<PKAssets::PKMeshlet>(maxMeshlets, flags, "Meshlet.MeshletBuffer");
         m_meshletVertexBuffer = RHI::CreateBuffer<uint4>(maxVertices, flags, "Meshlet.VertexBuffer");
@@ -52,7 +69,7 @@ namespace PK
             desc.regular.vertexCount,
             desc.regular.indexCount);
 
-        PK_FATAL_ASSERT(desc.meshlets.submeshCount == desc.regular.submeshCount, "Submesh count missmatch");
+        PK_FATAL_ASSERT(desc.meshlets.submeshCount == desc.regular.submeshCount + desc.regular.lodSubmeshCount, "Submesh count missmatch");
 
         MeshStaticAllocator::Allocation* allocation = nullptr;
 
@@ -74,6 +91,8 @@ namespace PK
         const auto meshletVertexStride = sizeof(PKAssets::PKMeshletVertex);
         const auto positionsStride = m_streamLayout.GetStride(1u);
         const auto attributesStride = m_streamLayout.GetStride(0u);
+        // Index 0xFFFF is reserved for primitive restart.
+        const auto indexSize = m_isQuantized && desc.regular.vertexCount < 0xFFFFu ? sizeof(uint16_t) : sizeof(uint32_t);
 
         const auto submeshesSize = desc.meshlets.submeshCount * submeshStride;
         const auto meshletsSize = desc.meshlets.meshletCount * meshletStride;
@@ -81,7 +100,8 @@ namespace PK
         const auto meshletIndicesSize = (size_t)desc.meshlets.triangleCount * 3ull;
         const auto positionsSize = desc.regular.vertexCount * positionsStride;
         const auto attributesSize = desc.regular.vertexCount * attributesStride;
-        const auto indicesSize = desc.regular.indexCount * m_indexSize;
+        // Padded so that 16 & 32 bit ranges can share the index buffer.
+        const auto indicesSize = Memory::AlignSize<uint32_t>(desc.regular.indexCount * indexSize);
 
         PK_FATAL_ASSERT((meshletIndicesSize % 4ull) == 0ull, "Index counts must be aligned to 4!");
 
@@ -98,7 +118,8 @@ namespace PK
         // Used accross mesh types
         // Leverage submesh buffer offset by using it on cpu side submesh index as well.
         allocation->submeshFirst = (uint32_t)(submeshOffset / submeshStride);
-        allocation->submeshCount = desc.meshlets.submeshCount;
+        allocation->submeshCount = desc.regular.submeshCount;
+        allocation->lodSubmeshCount = desc.regular.lodSubmeshCount;
 
         allocation->meshletFirst = (uint32_t)(meshletOffset / meshletStride);
         allocation->meshletCount = desc.meshlets.meshletCount;
@@ -109,11 +130,30 @@ namespace PK
 
         allocation->vertexFirst = (uint32_t)(positionsOffset / positionsStride);
         allocation->vertexCount = (uint32_t)(positionsSize / positionsStride);
-        allocation->indexFirst = (uint32_t)(indexOffset / m_indexSize);
-        allocation->indexCount = (uint32_t)(indicesSize / m_indexSize);
+        allocation->indexFirst = (uint32_t)(indexOffset / indexSize);
+        allocation->indexCount = desc.regular.indexCount;
+        allocation->indexSize = (uint32_t)indexSize;
         allocation->name = desc.name;
 
-        for (auto i = 0u; i < allocation->submeshCount; ++i)
+        MeshUtilities::VertexDefault* vertices = nullptr;
+        auto vertexBounds = PK_STACK_ALLOC(AABB<float3>, desc.meshlets.submeshCount);
+
+        if (m_isQuantized)
+        {
+            // Missing normals, tangents & texcoords are filled with defaults.
+            vertices = MeshUtilities::ConvertToVertexDefault(desc.regular.pVertices, desc.regular.vertexCount, desc.regular.streamLayout, true);
+            PK_FATAL_ASSERT(vertices, "Mesh '%s' has no vertex positions!", desc.name.c_str());
+            MeshUtilities::CalculateQuantizationBounds(vertices, desc.regular.vertexCount, desc.regular.pSubmeshes, desc.meshlets.submeshCount, vertexBounds);
+        }
+        else
+        {
+            for (auto i = 0u; i < desc.meshlets.submeshCount; ++i)
+            {
+                vertexBounds[i] = PK_FLOAT3_MIN_AABB;
+            }
+        }
+
+        for (auto i = 0u; i < desc.meshlets.submeshCount; ++i)
         {
             desc.meshlets.pSubmeshes[i].firstMeshlet += allocation->meshletFirst;
             auto submesh = m_submeshes.NewAt(allocation->submeshFirst + i);
@@ -123,10 +163,59 @@ namespace PK
             submesh->vertexCount = desc.regular.pSubmeshes[i].vertexCount;
             submesh->indexFirst = desc.regular.pSubmeshes[i].indexFirst + allocation->indexFirst;
             submesh->indexCount = desc.regular.pSubmeshes[i].indexCount;
+            submesh->lodFirst = desc.regular.pSubmeshes[i].lodFirst;
+            submesh->lodCount = desc.regular.pSubmeshes[i].lodCount;
+            submesh->lodError = desc.regular.pSubmeshes[i].lodError;
             submesh->bounds = desc.regular.pSubmeshes[i].bounds;
+            submesh->vertexBounds = vertexBounds[i];
             submesh->name = FixedString128("%s.Submesh%u", desc.name.c_str(), i).c_str();
         }
 
+        if (desc.meshlets.pHierarchies && desc.meshlets.groupCount > 0u)
+        {
+            size_t size = 0ull;
+            const auto offsetHierarchies = Memory::AlignSize<MeshletHierarchy>(size);
+            size = offsetHierarchies + sizeof(MeshletHierarchy) * desc.meshlets.submeshCount;
+            const auto offsetGroups = Memory::AlignSize<PKAssets::PKMeshletGroup>(size);
+            size = offsetGroups + sizeof(PKAssets::PKMeshletGroup) * desc.meshlets.groupCount;
+            const auto offsetGroupIndices = Memory::AlignSize<uint32_t>(size);
+            size = offsetGroupIndices + sizeof(uint32_t) * desc.meshlets.groupIndexCount;
+            const auto offsetParents = Memory::AlignSize<float4>(size);
+            size = offsetParents + sizeof(float4) * desc.meshlets.meshletCount;
+
+            allocation->hierarchyBuffer = Memory::AllocateClear<uint8_t>(size);
+            auto hierarchies = Memory::CastOffsetPtr<MeshletHierarchy>(allocation->hierarchyBuffer, offsetHierarchies);
+            auto groups = Memory::CastOffsetPtr<PKAssets::PKMeshletGroup>(allocation->hierarchyBuffer, offsetGroups);
+            auto groupIndices = Memory::CastOffsetPtr<uint32_t>(allocation->hierarchyBuffer, offsetGroupIndices);
+            auto parents = Memory::CastOffsetPtr<float4>(allocation->hierarchyBuffer, offsetParents);
+            Memory::Memcpy(groups, desc.meshlets.pGroups, desc.meshlets.groupCount);
+            Memory::Memcpy(groupIndices, desc.meshlets.pGroupIndices, desc.meshlets.groupIndexCount);
+
+            // Decoded from the uploaded halfs so that cpu side cuts see the same values as the task shader.
+            for (auto i = 0u; i < desc.meshlets.meshletCount; ++i)
+            {
+                const auto& lod = desc.meshlets.pMeshlets[i].lodCenterErrorParent;
+                parents[i] = float4(math::f16tof32(lod[0]), math::f16tof32(lod[1]), math::f16tof32(lod[2]), math::f16tof32(lod[3]));
+            }
+
+            for (auto i = 0u; i < desc.meshlets.submeshCount; ++i)
+            {
+                const auto& source = desc.meshlets.pHierarchies[i];
+
+                if (source.groupCount > 0u)
+                {
+                    auto submesh = m_submeshes[allocation->submeshFirst + i];
+                    hierarchies[i].pGroups = groups + source.groupFirst;
+                    hierarchies[i].pGroupIndices = groupIndices;
+                    hierarchies[i].pRoots = groupIndices + source.rootFirst;
+                    hierarchies[i].pMeshletParents = parents + (submesh->meshletFirst - allocation->meshletFirst);
+                    hierarchies[i].groupCount = source.groupCount;
+                    hierarchies[i].rootCount = source.rootCount;
+                    submesh->hierarchy = hierarchies + i;
+                }
+            }
+        }
+
         for (auto i = 0u; i < allocation->meshletCount; ++i)
         {
             desc.meshlets.pMeshlets[i].vertexFirst += allocation->meshletVertexFirst;
@@ -140,14 +229,50 @@ namespace PK
         commandBuffer.UploadBufferSubData(m_meshletIndexBuffer.get(), desc.meshlets.pIndices, meshletIndexOffset, meshletIndicesSize);
 
         auto pIndices = commandBuffer->BeginBufferWrite(m_indexBuffer.get(), indexOffset, indicesSize);
-        MeshUtilities::CopyIndexBuffer(pIndices, desc.regular.pIndices, desc.regular.indexCount, desc.regular.indexSize, m_indexSize);
+        MeshUtilities::CopyIndexBuffer(pIndices, desc.regular.pIndices, desc.regular.indexCount, desc.regular.indexSize, indexSize);
         commandBuffer->EndBufferWrite(m_indexBuffer.get());
 
-        // Align vertices into split layout if necessary
-        MeshUtilities::AlignVertexStreams(desc.regular.pVertices, desc.regular.vertexCount, desc.regular.streamLayout, m_streamLayout);
+        if (m_isQuantized)
+        {
+            // Ranges shared by several submeshes are encoded once. Vertices outside of all ranges are left zeroed.
+            auto pAttributes = reinterpret_cast<MeshUtilities::VertexQuantizedAttributes*>(commandBuffer->BeginBufferWrite(m_vertexBuffers[0].get(), attributesOffset, attributesSize));
+            auto pPositions = Memory::AllocateClear<MeshUtilities::VertexQuantizedPosition>(desc.regular.vertexCount);
+            Memory::Memset(pAttributes, 0, desc.regular.vertexCount);
 
-        commandBuffer.UploadBufferSubData(m_vertexBuffers[0].get(), (char*)desc.regular.pVertices, attributesOffset, attributesSize);
-        commandBuffer.UploadBufferSubData(m_vertexBuffers[1].get(), (char*)desc.regular.pVertices + attributesSize, positionsOffset, positionsSize);
+            for (auto i = 0u; i < desc.meshlets.submeshCount; ++i)
+            {
+                const auto& submesh = desc.regular.pSubmeshes[i];
+                auto isEncoded = false;
+
+                for (auto j = 0u; j < i && !isEncoded; ++j)
+                {
+                    isEncoded = desc.regular.pSubmeshes[j].vertexFirst == submesh.vertexFirst && desc.regular.pSubmeshes[j].vertexCount == submesh.vertexCount;
+                }
+
+                if (!isEncoded)
+                {
+                    const auto count = math::min(submesh.vertexCount, desc.regular.vertexCount - math::min(submesh.vertexFirst, desc.regular.vertexCount));
+                    const auto errorCount = MeshUtilities::QuantizeVertices(vertices + submesh.vertexFirst, count, vertexBounds[i], pAttributes + submesh.vertexFirst, pPositions + submesh.vertexFirst);
+
+                    if (errorCount > 0u)
+                    {
+                        PK_LOG_WARNING("Mesh '%s' submesh %u: %u vertices exceed the quantization tolerance!", desc.name.c_str(), i, errorCount);
+                    }
+                }
+            }
+
+            commandBuffer->EndBufferWrite(m_vertexBuffers[0].get());
+            commandBuffer.UploadBufferSubData(m_vertexBuffers[1].get(), pPositions, positionsOffset, positionsSize);
+            Memory::Free(pPositions);
+            Memory::Free(vertices);
+        }
+        else
+        {
+            // Align vertices into split layout if necessary
+            MeshUtilities::AlignVertexStreams(desc.regular.pVertices, desc.regular.vertexCount, desc.regular.streamLayout, m_streamLayout);
+            commandBuffer.UploadBufferSubData(m_vertexBuffers[0].get(), (char*)desc.regular.pVertices, attributesOffset, attributesSize);
+            commandBuffer.UploadBufferSubData(m_vertexBuffers[1].get(), (char*)desc.regular.pVertices + attributesSize, positionsOffset, positionsSize);
+        }
 
         m_uploadFence = commandBuffer->GetFenceRef();
 
@@ -168,15 +293,15 @@ namespace PK
         auto meshletIndexOffset = ((size_t)allocation->meshletTriangleFirst * 3ull);
         auto positionsOffset = allocation->vertexFirst * positionsStride;
         auto attributesOffset = allocation->vertexFirst * attributesStride;
-        auto indexOffset = allocation->indexFirst * m_indexSize;
+        auto indexOffset = allocation->indexFirst * allocation->indexSize;
 
-        auto submeshesSize = allocation->submeshCount * submeshStride;
+        auto submeshesSize = (allocation->submeshCount + allocation->lodSubmeshCount) * submeshStride;
         auto meshletsSize = allocation->meshletCount * meshletStride;
         auto meshletVerticesSize = allocation->meshletVertexCount * meshletVertexStride;
         auto meshletIndicesSize = ((size_t)allocation->meshletTriangleCount * 3ull);
         auto positionsSize = allocation->vertexCount * positionsStride;
         auto attributesSize = allocation->vertexCount * attributesStride;
-        auto indicesSize = allocation->indexCount * m_indexSize;
+        auto indicesSize = Memory::AlignSize<uint32_t>(allocation->indexCount * allocation->indexSize);
 
         m_submeshBuffer->SparseDeallocate({ submeshOffset, submeshesSize });
         m_meshletBuffer->SparseDeallocate({ meshletOffset, meshletsSize });
@@ -186,7 +311,7 @@ namespace PK
         m_vertexBuffers[1]->SparseDeallocate({ positionsOffset, positionsSize });
         m_indexBuffer->SparseDeallocate({ indexOffset, indicesSize });
 
-        m_submeshCount -= allocation->submeshCount;
+        m_submeshCount -= allocation->submeshCount + allocation->lodSubmeshCount;
         m_meshletCount -= allocation->meshletCount;
         m_meshletVertexCount -= allocation->meshletVertexCount;
         m_meshletTriangleCount -= allocation->meshletTriangleCount;
@@ -194,16 +319,17 @@ namespace PK
         m_indexCount -= allocation->indexCount;
         m_preferredIndex = m_allocations.GetIndex(allocation);
 
-        for (auto i = 0u; i < allocation->submeshCount; ++i)
+        for (auto i = 0u; i < allocation->submeshCount + allocation->lodSubmeshCount; ++i)
         {
             auto submeshIndex = allocation->submeshFirst + i;
             m_submeshes.Delete(submeshIndex);
         }
 
+        Memory::Free(allocation->hierarchyBuffer);
         m_allocations.Delete(allocation);
     }
 
-    bool MeshStaticAllocator::GatherRayTracingGeometry(uint32_t globalSubmeshIndex, RayTracingGeometryInfo* outInfo) const
+    bool MeshStaticAllocator::GatherRayTracingGeometry(const Allocation* allocation, uint32_t globalSubmeshIndex, RayTracingGeometryInfo* outInfo) const
     {
         if (!HasPendingUpload())
         {
@@ -215,7 +341,10 @@ namespace PK
             outInfo->vertexStride = m_streamLayout.GetStride(1u);
             outInfo->vertexFirst = sm.vertexFirst;
             outInfo->vertexCount = sm.vertexCount;
-            outInfo->indexStride = m_indexSize;
+            outInfo->vertexFormat = m_isQuantized ? ElementType::Short4 : ElementType::Float3;
+            outInfo->vertexCenter = m_isQuantized ? sm.vertexBounds.center() : PK_FLOAT3_ZERO;
+            outInfo->vertexExtents = m_isQuantized ? sm.vertexBounds.extents() : PK_FLOAT3_ONE;
+            outInfo->indexStride = allocation->indexSize;
             outInfo->indexFirst = sm.indexFirst;
             outInfo->indexCount = sm.indexCount;
             outInfo->customIndex = 0u;
@@ -245,7 +374,14 @@ namespace PK
         auto pIndices = mesh->indexBuffer.Get(base);
         auto pSubmeshes = mesh->submeshes.Get(base);
 
-        auto* submeshes = PK_STACK_ALLOC(SubMesh, mesh->submeshCount);
+        // Options are read from the source model meta that the asset tools also consume.
+        const auto directoryLength = String::ToFilePathDirectoryLength(filepath);
+        const auto metaPath = FixedString256("%.*s%s.mdl.pkmeta", (int)directoryLength, filepath, String::ToFilePathStem<64>(filepath).c_str());
+        MeshUtilities::MeshOptimizeOptions optimizeOptions{};
+        const auto hasOptions = MeshUtilities::ReadMeshOptimizeOptions(metaPath.c_str(), &optimizeOptions);
+        const auto lodCapacity = hasOptions ? optimizeOptions.lodCount + 1u : 1u;
+
+        auto* submeshes = PK_STACK_ALLOC(SubMesh, mesh->submeshCount * lodCapacity);
 
         for (auto i = 0u; i < mesh->submeshCount; ++i)
         {
@@ -256,6 +392,9 @@ namespace PK
             submeshes[i].indexCount = pSubmeshes[i].indexCount;
             submeshes[i].meshletFirst = 0u;
             submeshes[i].meshletCount = 0u;
+            submeshes[i].lodFirst = 0u;
+            submeshes[i].lodCount = 0u;
+            submeshes[i].lodError = 0.0f;
             submeshes[i].bounds = AABB<float3>(float3(pSubmeshes[i].bbmin), float3(pSubmeshes[i].bbmax));
         }
 
@@ -273,6 +412,39 @@ namespace PK
 
         streamLayout.CalculateOffsetsAndStride();
 
+        // Optional load time reordering & lod generation.
+        // Source meshlets are built by the asset tools & are not affected. Lod meshlets are built here.
+        // Assets written before version 1 have no meshlet hierarchy. One can be built here when requested by the meta file.
+        auto meshletMesh = mesh->meshletMesh.Get(base);
+        const auto hasAssetHierarchy = PKAssets::GetAssetVersion(*asset.header) >= 1u && meshletMesh->groupCount > 0u;
+        uint32_t* indices = nullptr;
+        MeshUtilities::VertexDefault* lodVertices = nullptr;
+        auto indexCount = mesh->indexCount;
+        auto lodSubmeshCount = 0u;
+        auto buildHierarchy = false;
+
+        if (hasOptions)
+        {
+            indices = Memory::Allocate<uint32_t>((size_t)mesh->indexCount * lodCapacity);
+            MeshUtilities::CopyIndexBuffer(indices, pIndices, mesh->indexCount, mesh->indexSize, sizeof(uint32_t));
+            MeshUtilities::OptimizeMesh(optimizeOptions, filepath, pVertices, mesh->vertexCount, streamLayout, indices, mesh->indexCount, submeshes, mesh->submeshCount, FixedString256("%s.cache", filepath).c_str());
+
+            if (optimizeOptions.lodCount > 0u || (optimizeOptions.meshletHierarchy && !hasAssetHierarchy))
+            {
+                lodVertices = MeshUtilities::ConvertToVertexDefault(pVertices, mesh->vertexCount, streamLayout);
+
+                if (lodVertices)
+                {
+                    lodSubmeshCount = MeshUtilities::BuildMeshLods(optimizeOptions, filepath, pVertices, mesh->vertexCount, streamLayout, indices, &indexCount, submeshes, mesh->submeshCount);
+                    buildHierarchy = optimizeOptions.meshletHierarchy && !hasAssetHierarchy;
+                }
+                else
+                {
+                    PK_LOG_WARNING("Mesh '%s' is missing vertex elements required for meshlets. Skipped lod generation.", filepath);
+                }
+            }
+        }
+
         {
             PK_FATAL_ASSERT(allocator, "Cannot create a virtual mesh without an allocator!");
 
@@ -280,15 +452,15 @@ namespace PK
             desc.name = String::ToFilePathStem<64>(filepath).c_str();
 
             desc.regular.pVertices = pVertices;
-            desc.regular.pIndices = pIndices;
+            desc.regular.pIndices = indices ? indices : pIndices;
             desc.regular.streamLayout = streamLayout;
             desc.regular.pSubmeshes = submeshes;
-            desc.regular.indexSize = mesh->indexSize;
+            desc.regular.indexSize = indices ? sizeof(uint32_t) : mesh->indexSize;
             desc.regular.vertexCount = mesh->vertexCount;
-            desc.regular.indexCount = mesh->indexCount;
+            desc.regular.indexCount = indexCount;
             desc.regular.submeshCount = mesh->submeshCount;
+            desc.regular.lodSubmeshCount = lodSubmeshCount;
 
-            auto meshletMesh = mesh->meshletMesh.Get(base);
             desc.meshlets.pSubmeshes = meshletMesh->submeshes.Get(base);
             desc.meshlets.submeshCount = meshletMesh->submeshCount;
             desc.meshlets.pMeshlets = meshletMesh->meshlets.Get(base);
@@ -297,9 +469,50 @@ namespace PK
             desc.meshlets.vertexCount = meshletMesh->vertexCount;
             desc.meshlets.pIndices = meshletMesh->indices.Get(base);
             desc.meshlets.triangleCount = meshletMesh->triangleCount;
+
+            if (hasAssetHierarchy)
+            {
+                desc.meshlets.pHierarchies = meshletMesh->hierarchies.Get(base);
+                desc.meshlets.pGroups = meshletMesh->groups.Get(base);
+                desc.meshlets.groupCount = meshletMesh->groupCount;
+                desc.meshlets.pGroupIndices = meshletMesh->groupIndices.Get(base);
+                desc.meshlets.groupIndexCount = meshletMesh->groupIndexCount;
+            }
+
+            void* hierarchyMeshletBuffer = nullptr;
+            void* lodMeshletBuffer = nullptr;
+            void* mergedMeshletBuffer = nullptr;
+
+            if (lodSubmeshCount > 0u || buildHierarchy)
+            {
+                MeshUtilities::GeometryContext ctx{};
+                ctx.pVertices = lodVertices;
+                ctx.pIndices = indices;
+                ctx.countVertex = mesh->vertexCount;
+                ctx.countIndex = indexCount;
+
+                MeshletsDescriptor meshlets[2];
+                meshlets[0] = desc.meshlets;
+
+                // Replaces the source meshlets of the asset.
+                if (buildHierarchy)
+                {
+                    hierarchyMeshletBuffer = MeshUtilities::BuildMeshletsHierarchy(&ctx, submeshes, mesh->submeshCount, filepath, &meshlets[0]);
+                }
+
+                lodMeshletBuffer = MeshUtilities::BuildMeshletsSpatial(&ctx, submeshes + mesh->submeshCount, lodSubmeshCount, &meshlets[1]);
+                mergedMeshletBuffer = MeshUtilities::MergeMeshlets(meshlets, 2u, &desc.meshlets);
+            }
+
             m_allocation = allocator->Allocate(desc);
+
+            Memory::Free(mergedMeshletBuffer);
+            Memory::Free(lodMeshletBuffer);
+            Memory::Free(hierarchyMeshletBuffer);
         }
 
+        Memory::Free(lodVertices);
+        Memory::Free(indices);
         PKAssets::CloseAsset(&asset);
     }
 
@@ -323,7 +536,7 @@ namespace PK
 
     bool MeshStatic::GatherRayTracingGeometry(uint32_t localIndex, RayTracingGeometryInfo* outInfo) const
     {
-        return m_allocation->allocator->GatherRayTracingGeometry(GetGlobalSubmeshIndex(localIndex), outInfo);
+        return m_allocation->allocator->GatherRayTracingGeometry(m_allocation, GetGlobalSubmeshIndex(localIndex), outInfo);
     }
 
 
@@ -364,6 +577,9 @@ namespace PK
             descriptor.pSubmeshes[i].indexCount = pSubmeshes[i].indexCount;
             descriptor.pSubmeshes[i].meshletFirst = 0u;
             descriptor.pSubmeshes[i].meshletCount = 0u;
+            descriptor.pSubmeshes[i].lodFirst = 0u;
+            descriptor.pSubmeshes[i].lodCount = 0u;
+            descriptor.pSubmeshes[i].lodError = 0.0f;
             descriptor.pSubmeshes[i].bounds = AABB<float3>(float3(pSubmeshes[i].bbmin), float3(pSubmeshes[i].bbmax));
         }
 
@@ -497,6 +713,9 @@ namespace PK
             outInfo->vertexStride = positionStream->stride;
             outInfo->vertexFirst = sm.vertexFirst;
             outInfo->vertexCount = sm.vertexCount;
+            outInfo->vertexFormat = positionStream->format;
+            outInfo->vertexCenter = PK_FLOAT3_ZERO;
+            outInfo->vertexExtents = PK_FLOAT3_ONE;
             outInfo->indexStride = m_indexSize;
             outInfo->indexFirst = sm.indexFirst;
             outInfo->indexCount = sm.indexCount;
@@ -10,6 +10,19 @@ namespace PK
 {
     typedef FixedList<RHIBufferRef, PK_RHI_MAX_VERTEX_ATTRIBUTES> VertexBuffers;
 
+    // Cpu side view of a submesh cluster lod hierarchy. Meshlet indices are relative to the submesh meshletFirst.
+    struct MeshletHierarchy
+    {
+        const PKAssets::PKMeshletGroup* pGroups = nullptr;
+        // Group children & roots. Relative to pGroups.
+        const uint32_t* pGroupIndices = nullptr;
+        const uint32_t* pRoots = nullptr;
+        // Parent lod center & error of each meshlet.
+        const float4* pMeshletParents = nullptr;
+        uint32_t groupCount = 0u;
+        uint32_t rootCount = 0u;
+    };
+
     struct SubMesh
     {
         NameID name = 0u;
@@ -19,7 +32,16 @@ namespace PK
         uint32_t indexCount = 0u;
         uint32_t meshletFirst = 0u;
         uint32_t meshletCount = 0u;
+        // Local index of the first simplified submesh. Lods are ordered from finest to coarsest.
+        uint32_t lodFirst = 0u;
+        uint32_t lodCount = 0u;
+        // Simplification error relative to the bounds radius. Zero for source submeshes.
+        float lodError = 0.0f;
         AABB<float3> bounds = PK_FLOAT3_MIN_AABB;
+        // Bounds the snorm16 positions of the vertex range are quantized against. Only used by quantized static mesh allocators.
+        AABB<float3> vertexBounds = PK_FLOAT3_MIN_AABB;
+        // Owned by the mesh allocation. Null if the submesh has no cluster lod hierarchy.
+        const MeshletHierarchy* hierarchy = nullptr;
     };
     
     struct MeshDescriptor
@@ -32,6 +54,8 @@ namespace PK
         uint32_t vertexCount;
         uint32_t indexCount;
         uint32_t submeshCount;
+        // Lod submeshes follow the source submeshes in pSubmeshes.
+        uint32_t lodSubmeshCount;
     };
 
     struct MeshletsDescriptor
@@ -44,6 +68,12 @@ namespace PK
         uint32_t vertexCount;
         uint8_t* pIndices;
         uint32_t triangleCount;
+        // Optional cluster lod hierarchy. One entry per submesh when present.
+        PKAssets::PKMeshletHierarchy* pHierarchies;
+        PKAssets::PKMeshletGroup* pGroups;
+        uint32_t groupCount;
+        uint32_t* pGroupIndices;
+        uint32_t groupIndexCount;
     };
 
     struct MeshStaticDescriptor
@@ -91,6 +121,7 @@ namespace PK
             NameID name = 0u;
             uint32_t submeshFirst = 0u;
             uint32_t submeshCount = 0u;
+            uint32_t lodSubmeshCount = 0u;
             uint32_t meshletFirst = 0u;
             uint32_t meshletCount = 0u;
             uint32_t meshletVertexFirst = 0u;
@@ -101,9 +132,13 @@ namespace PK
             uint32_t vertexCount = 0u;
             uint32_t indexFirst = 0u;
             uint32_t indexCount = 0u;
+            // 16 bit indices are used when the vertex count allows it.
+            uint32_t indexSize = sizeof(uint32_t);
+            void* hierarchyBuffer = nullptr;
         };
 
-        MeshStaticAllocator();
+        // Quantized allocators store snorm16 positions, octahedral tangent frames & 16 bit indices where possible.
+        MeshStaticAllocator(bool quantize);
 
         constexpr RHIBuffer* GetMeshletVertexBuffer() const { return m_meshletVertexBuffer.get(); }
         constexpr RHIBuffer* GetMeshletIndexBuffer() const { return m_meshletIndexBuffer.get(); }
@@ -113,13 +148,13 @@ namespace PK
         constexpr RHIBuffer* GetIndexBuffer() const { return m_indexBuffer.get(); }
         inline const SubMesh& GetSubmesh(uint32_t index) const { return *m_submeshes[index]; }
         constexpr const VertexStreamLayout& GetVertexStreamLayout() const { return m_streamLayout; }
-        constexpr uint32_t GetIndexSize() const { return m_indexSize; }
         inline bool HasPendingUpload() const { return !m_uploadFence.WaitInvalidate(0ull); }
+        constexpr bool IsQuantized() const { return m_isQuantized; }
 
         Allocation* Allocate(const MeshStaticDescriptor& desc);
         void Deallocate(Allocation* allocation);
 
-        bool GatherRayTracingGeometry(uint32_t globalSubmeshIndex, RayTracingGeometryInfo* outInfo) const;
+        bool GatherRayTracingGeometry(const Allocation* allocation, uint32_t globalSubmeshIndex, RayTracingGeometryInfo* outInfo) const;
 
     private:
         VertexBuffers m_vertexBuffers;
@@ -131,7 +166,6 @@ namespace PK
         FixedPool<Allocation, 4096ull> m_allocations;
         FixedPool<SubMesh, 8192ull> m_submeshes;
         VertexStreamLayout m_streamLayout;
-        uint32_t m_indexSize = sizeof(uint32_t);
         uint32_t m_submeshCount = 0u;
         uint32_t m_meshletCount = 0u;
         uint32_t m_meshletVertexCount = 0u;
@@ -139,6 +173,7 @@ namespace PK
         uint32_t m_vertexCount = 0u;
         uint32_t m_indexCount = 0u;
         int64_t m_preferredIndex = -1;
+        bool m_isQuantized = true;
         mutable FenceRef m_uploadFence;
     };
 
@@ -152,7 +187,12 @@ namespace PK
         ~MeshStatic();
 
         constexpr MeshStaticAllocator* GetAllocator() const { return m_allocation->allocator; }
-        inline uint32_t GetGlobalSubmeshIndex(uint32_t local) const { return m_allocation->submeshFirst + math::min(local, m_allocation->submeshCount - 1u); }
+        inline uint32_t GetGlobalSubmeshIndex(uint32_t local) const { return m_allocation->submeshFirst + math::min(local, m_allocation->submeshCount + m_allocation->lodSubmeshCount - 1u); }
+        inline uint32_t GetLodSubmeshIndex(uint32_t local, uint32_t lod) const
+        {
+            const auto& submesh = GetSubmesh((int32_t)local);
+            return lod == 0u || submesh.lodCount == 0u ? local : submesh.lodFirst + math::min(lod, submesh.lodCount) - 1u;
+        }
         inline RHIBuffer* GetMeshletVertexBuffer() const final { return m_allocation->allocator->GetMeshletVertexBuffer(); }
         inline RHIBuffer* GetMeshletIndexBuffer() const final { return m_allocation->allocator->GetMeshletIndexBuffer(); }
         inline RHIBuffer* GetMeshletSubmeshBuffer() const final { return m_allocation->allocator->GetMeshletSubmeshBuffer(); }
@@ -160,7 +200,7 @@ namespace PK
         inline const VertexBuffers& GetVertexBuffers() const final { return m_allocation->allocator->GetVertexBuffers(); }
         inline const RHIBuffer* GetIndexBuffer() const final { return m_allocation->allocator->GetIndexBuffer(); }
         inline const VertexStreamLayout& GetVertexStreamLayout() const final { return m_allocation->allocator->GetVertexStreamLayout(); }
-        inline uint32_t GetIndexSize() const final { return m_allocation->allocator->GetIndexSize(); }
+        inline uint32_t GetIndexSize() const final { return m_allocation->indexSize; }
         inline uint32_t GetSubmeshCount() const final { return m_allocation->submeshCount; }
         inline const SubMesh& GetSubmesh(int32_t localIndex) const final { return m_allocation->allocator->GetSubmesh(GetGlobalSubmeshIndex((unsigned)localIndex)); }
         inline bool HasPendingUpload() const final { return m_allocation->allocator->HasPendingUpload(); }
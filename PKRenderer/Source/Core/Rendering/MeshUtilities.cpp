@@ -1,7 +1,10 @@
 #include "PrecompiledHeader.h"
 #include <assert.h>
 #include <mikktspace/mikktspace.h>
+#include "Core/Base/FileIO.h"
+#include "Core/Base/Hash.h"
 #include "Core/Base/Memory.h"
+#include "Core/Base/Sort.h"
 #include "Core/CLI/Log.h"
 #include "Core/Math/Extended.h"
 #include "Core/Rendering/Mesh.h"
@@ -170,6 +173,8 @@ namespace PK::MeshUtilities
         for (auto i = 0u; i < dst.GetCount(); ++i)
         {
             const auto& vdst = dst[i];
+            // Elements missing from the source are left zeroed.
+            remap[i] = ~0u;
 
             for (auto j = 0u; j < src.GetCount(); ++j)
             {
@@ -183,6 +188,8 @@ namespace PK::MeshUtilities
                     break;
                 }
             }
+
+            needsAlignment |= remap[i] == ~0u;
         }
 
         if (needsAlignment)
@@ -192,6 +199,11 @@ namespace PK::MeshUtilities
 
             for (auto i = 0u; i < dst.GetCount(); ++i)
             {
+                if (remap[i] == ~0u)
+                {
+                    continue;
+                }
+
                 const auto& vdst = dst[i];
                 const auto& vsrc = src[remap[i]];
                 const auto srcOffset = vsrc.stream == 0 ? 0ull : src.GetStride(vsrc.stream - 1) * count;
@@ -231,6 +243,109 @@ namespace PK::MeshUtilities
         PK_FATAL_ASSERT(false, "Unsupported index size");
     }
 
+    void EncodeVertexQuantized(const VertexDefault& vertex, const AABB<float3>& bounds, VertexQuantizedAttributes* outAttributes, VertexQuantizedPosition* outPosition)
+    {
+        const auto position = math::packSnorm16((vertex.in_POSITION - bounds.center()) / bounds.extents());
+        auto tangent = math::packSnorm16(math::octaencode(vertex.in_TANGENT.xyz()) * 2.0f - 1.0f);
+        tangent.x = (int16_t)((tangent.x & ~1) | (vertex.in_TANGENT.w < 0.0f ? 1 : 0));
+
+        outAttributes->in_NORMAL = math::packSnorm16(math::octaencode(vertex.in_NORMAL) * 2.0f - 1.0f);
+        outAttributes->in_TANGENT = tangent;
+        outAttributes->in_TEXCOORD0 = math::f32tof16(vertex.in_TEXCOORD0);
+        outPosition->in_POSITION = short4(position.x, position.y, position.z, (int16_t)0);
+    }
+
+    VertexDefault DecodeVertexQuantized(const VertexQuantizedAttributes& attributes, const VertexQuantizedPosition& position, const AABB<float3>& bounds)
+    {
+        const auto tangentSign = (attributes.in_TANGENT.x & 1) != 0 ? -1.0f : 1.0f;
+        VertexDefault vertex{};
+        vertex.in_POSITION = bounds.center() + math::unpackSnorm16(position.in_POSITION.xyz()) * bounds.extents();
+        vertex.in_NORMAL = math::octadecode(math::unpackSnorm16(attributes.in_NORMAL) * 0.5f + 0.5f);
+        vertex.in_TANGENT = float4(math::octadecode(math::unpackSnorm16(attributes.in_TANGENT) * 0.5f + 0.5f), tangentSign);
+        vertex.in_TEXCOORD0 = math::f16tof32(attributes.in_TEXCOORD0);
+        return vertex;
+    }
+
+    void CalculateQuantizationBounds(const VertexDefault* vertices, uint32_t vertexCount, const SubMesh* submeshes, uint32_t submeshCount, AABB<float3>* outBounds)
+    {
+        // Degenerate axes would divide by zero when encoding.
+        constexpr auto minSize = 1e-5f;
+        auto overlaps = false;
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            const auto& a = submeshes[i];
+            auto shared = ~0u;
+
+            for (auto j = 0u; j < i; ++j)
+            {
+                const auto& b = submeshes[j];
+                const auto identical = a.vertexFirst == b.vertexFirst && a.vertexCount == b.vertexCount;
+                const auto intersects = a.vertexFirst < b.vertexFirst + b.vertexCount && b.vertexFirst < a.vertexFirst + a.vertexCount;
+                overlaps |= intersects && !identical;
+                shared = identical ? j : shared;
+            }
+
+            if (shared != ~0u)
+            {
+                outBounds[i] = outBounds[shared];
+                continue;
+            }
+
+            outBounds[i] = PK_FLOAT3_MIN_AABB;
+
+            for (auto j = a.vertexFirst; j < a.vertexFirst + a.vertexCount && j < vertexCount; ++j)
+            {
+                outBounds[i] |= vertices[j].in_POSITION;
+            }
+
+            outBounds[i].max = math::max(outBounds[i].max, outBounds[i].min + minSize);
+        }
+
+        if (overlaps)
+        {
+            auto bounds = PK_FLOAT3_MIN_AABB;
+
+            for (auto i = 0u; i < vertexCount; ++i)
+            {
+                bounds |= vertices[i].in_POSITION;
+            }
+
+            bounds.max = math::max(bounds.max, bounds.min + minSize);
+
+            for (auto i = 0u; i < submeshCount; ++i)
+            {
+                outBounds[i] = bounds;
+            }
+        }
+    }
+
+    bool IsQuantizedVertexWithinTolerance(const VertexDefault& source, const VertexDefault& decoded, const AABB<float3>& bounds)
+    {
+        // Half a snorm16 step plus float rounding of the dequantization.
+        const auto positionTolerance = bounds.extents() * (0.5f / 32767.0f) + (math::abs(bounds.center()) + bounds.extents()) * QUANTIZATION_POSITION_EPSILON;
+        const auto positionError = math::abs(decoded.in_POSITION - source.in_POSITION);
+        const auto normalValid = math::dot(source.in_NORMAL, source.in_NORMAL) <= 0.0f || math::dot(decoded.in_NORMAL, math::normalize(source.in_NORMAL)) >= QUANTIZATION_MIN_DIRECTION_DOT;
+        const auto tangentValid = math::dot(source.in_TANGENT.xyz(), source.in_TANGENT.xyz()) <= 0.0f || math::dot(decoded.in_TANGENT.xyz(), math::normalize(source.in_TANGENT.xyz())) >= QUANTIZATION_MIN_DIRECTION_DOT;
+        const auto signValid = (decoded.in_TANGENT.w < 0.0f) == (source.in_TANGENT.w < 0.0f);
+        const auto texcoordValid = math::all(math::abs(decoded.in_TEXCOORD0 - source.in_TEXCOORD0) <= math::abs(source.in_TEXCOORD0) * QUANTIZATION_TEXCOORD_RELATIVE_ERROR + 1e-7f);
+        return math::all(positionError <= positionTolerance) && normalValid && tangentValid && signValid && texcoordValid;
+    }
+
+    uint32_t QuantizeVertices(const VertexDefault* vertices, uint32_t vertexCount, const AABB<float3>& bounds, VertexQuantizedAttributes* outAttributes, VertexQuantizedPosition* outPositions)
+    {
+        auto errorCount = 0u;
+
+        for (auto i = 0u; i < vertexCount; ++i)
+        {
+            EncodeVertexQuantized(vertices[i], bounds, outAttributes + i, outPositions + i);
+            const auto decoded = DecodeVertexQuantized(outAttributes[i], outPositions[i], bounds);
+            errorCount += IsQuantizedVertexWithinTolerance(vertices[i], decoded, bounds) ? 0u : 1u;
+        }
+
+        return errorCount;
+    }
+
     void CalculateNormals(GeometryContext* ctx, float sign)
     {
         for (auto i = 0u; i < ctx->countIndex; i += 3u)
@@ -274,238 +389,2579 @@ namespace PK::MeshUtilities
         PK_FATAL_ASSERT(genTangSpaceDefault(&context), "Failed to calculate tangents");
     }
 
-
-    MeshletBuildData::MeshletBuildData(size_t count_meshlet)
+    namespace VertexCacheOptimizer
     {
-        const auto count_index = count_meshlet * PKAssets::PK_MESHLET_MAX_TRIANGLES * 3ull;
-        const auto count_vertex = count_meshlet * PKAssets::PK_MESHLET_MAX_VERTICES;
+        // Scoring constants from Tom Forsyth's linear-speed vertex cache optimisation.
+        constexpr static const uint32_t CACHE_SIZE = 32u;
+        constexpr static const float CACHE_DECAY_POWER = 1.5f;
+        constexpr static const float LAST_TRIANGLE_SCORE = 0.75f;
+        constexpr static const float VALENCE_BOOST_SCALE = 2.0f;
+        constexpr static const float VALENCE_BOOST_POWER = 0.5f;
+        // Size of the fifo cache used for analysis & overdraw cluster splitting.
+        constexpr static const uint32_t ANALYZE_CACHE_SIZE = 16u;
+
+        static float GetVertexScore(int32_t cachePosition, uint32_t liveTriangles)
+        {
+            if (liveTriangles == 0u)
+            {
+                return -1.0f;
+            }
 
-        size_t size = 0ull;
-        const auto offset_indices = Memory::AlignSize<uint8_t>(size);
-        size = offset_indices + sizeof(uint8_t) * count_index;
-        const auto offset_vertices = Memory::AlignSize<PKAssets::PKMeshletVertex>(size);
-        size = offset_vertices + sizeof(PKAssets::PKMeshletVertex) * count_vertex;
-        const auto offset_meshlets = Memory::AlignSize<PKAssets::PKMeshlet>(size);
-        size = offset_meshlets + sizeof(PKAssets::PKMeshlet) * count_meshlet;
+            auto score = 0.0f;
 
-        buffer = Memory::AllocateClear<uint8_t>(size);
-        indices = Memory::CastOffsetPtr<uint8_t>(buffer, offset_indices);
-        vertices = Memory::CastOffsetPtr<PKAssets::PKMeshletVertex>(buffer, offset_vertices);
-        meshlets = Memory::CastOffsetPtr<PKAssets::PKMeshlet>(buffer, offset_meshlets);
-    }
+            if (cachePosition >= 0)
+            {
+                score = cachePosition < 3 ? LAST_TRIANGLE_SCORE : powf(1.0f - (cachePosition - 3) / (float)(CACHE_SIZE - 3u), CACHE_DECAY_POWER);
+            }
 
-    MeshletBuildData::MeshletBuildData(MeshletBuildData&& other)
-    {
-        if (&other != this)
+            return score + VALENCE_BOOST_SCALE * powf((float)liveTriangles, -VALENCE_BOOST_POWER);
+        }
+
+        static uint32_t CountCacheMisses(const uint32_t* indices, uint32_t triangleCount, uint32_t* timestamps, uint32_t* timestamp)
         {
-            submesh = other.submesh;
-            meshlet_count = other.meshlet_count;
-            vertex_count = other.vertex_count;
-            index_count = other.index_count;
-            buffer = other.buffer;
-            indices = other.indices;
-            vertices = other.vertices;
-            meshlets = other.meshlets;
-            other.buffer = nullptr;
+            auto misses = 0u;
+
+            for (auto i = 0u; i < triangleCount * 3u; ++i)
+            {
+                if (*timestamp - timestamps[indices[i]] > ANALYZE_CACHE_SIZE)
+                {
+                    timestamps[indices[i]] = (*timestamp)++;
+                    misses++;
+                }
+            }
+
+            return misses;
         }
     }
 
-    MeshletBuildData::~MeshletBuildData()
+    VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount)
     {
-        Memory::Free(buffer);
-        buffer = nullptr;
+        using namespace VertexCacheOptimizer;
+
+        VertexCacheStats stats{};
+        auto timestamps = Memory::AllocateClear<uint32_t>(vertexCount);
+        auto referenced = Memory::AllocateClear<uint8_t>(vertexCount);
+        auto uniqueCount = 0u;
+        // Offset by cache size so that initial zero timestamps count as misses.
+        auto timestamp = ANALYZE_CACHE_SIZE + 1u;
+
+        for (auto i = 0u; i < indexCount; ++i)
+        {
+            uniqueCount += referenced[indices[i]] == 0u ? 1u : 0u;
+            referenced[indices[i]] = 1u;
+        }
+
+        const auto misses = CountCacheMisses(indices, indexCount / 3u, timestamps, &timestamp);
+        stats.acmr = indexCount >= 3u ? misses / (float)(indexCount / 3u) : 0.0f;
+        stats.atvr = uniqueCount > 0u ? misses / (float)uniqueCount : 0.0f;
+
+        Memory::Free(timestamps);
+        Memory::Free(referenced);
+        return stats;
     }
 
-    MeshletBuildData BuildMeshletsMonotone(GeometryContext* ctx)
+    void OptimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount)
     {
-        struct MeshletIndexInfo
+        using namespace VertexCacheOptimizer;
+
+        const auto triangleCount = indexCount / 3u;
+
+        if (triangleCount == 0u)
         {
-            uint32_t vertex_offset;
-            uint32_t triangle_offset;
-            uint32_t vertex_count;
-            uint32_t triangle_count;
-        };
+            return;
+        }
 
-        assert(ctx->countIndex % 3 == 0);
+        auto liveCounts = Memory::AllocateClear<uint32_t>(vertexCount);
+        auto offsets = Memory::Allocate<uint32_t>(vertexCount);
+        auto adjacency = Memory::Allocate<uint32_t>(indexCount);
+        auto cachePositions = Memory::Allocate<int32_t>(vertexCount);
+        auto vertexScores = Memory::Allocate<float>(vertexCount);
+        auto triangleScores = Memory::Allocate<float>(triangleCount);
+        auto emitted = Memory::AllocateClear<uint8_t>(triangleCount);
+        auto output = Memory::Allocate<uint32_t>(indexCount);
 
-        const auto max_vertices = PKAssets::PK_MESHLET_MAX_VERTICES;
-        const auto max_triangles = PKAssets::PK_MESHLET_MAX_TRIANGLES;
-        const auto max_vertices_conservative = PKAssets::PK_MESHLET_MAX_VERTICES - 2;
+        for (auto i = 0u; i < indexCount; ++i)
+        {
+            liveCounts[indices[i]]++;
+        }
 
-        auto meshlet_limit_vertices = (ctx->countIndex + max_vertices_conservative - 1) / max_vertices_conservative;
-        auto meshlet_limit_triangles = (ctx->countIndex / 3 + PKAssets::PK_MESHLET_MAX_TRIANGLES - 1) / PKAssets::PK_MESHLET_MAX_TRIANGLES;
-        auto max_meshlets = meshlet_limit_vertices > meshlet_limit_triangles ? meshlet_limit_vertices : meshlet_limit_triangles;
+        for (auto i = 0u, offset = 0u; i < vertexCount; ++i)
+        {
+            offsets[i] = offset;
+            offset += liveCounts[i];
+            liveCounts[i] = 0u;
+            cachePositions[i] = -1;
+        }
 
-        MeshletBuildData output(max_meshlets);
+        for (auto i = 0u; i < indexCount; ++i)
+        {
+            const auto vertex = indices[i];
+            adjacency[offsets[vertex] + liveCounts[vertex]++] = i / 3u;
+        }
 
-        auto* meshlet_vertices = Memory::Allocate<uint32_t>(max_meshlets * PKAssets::PK_MESHLET_MAX_VERTICES);
-        auto* meshlet_indices = output.indices;
-        auto* used = Memory::Allocate<uint8_t>(ctx->countVertex);
-        
-        memset(used, -1, ctx->countVertex);
+        for (auto i = 0u; i < vertexCount; ++i)
+        {
+            vertexScores[i] = GetVertexScore(-1, liveCounts[i]);
+        }
 
-        memcpy(output.submesh.bbmin, &ctx->aabb.min.x, sizeof(float3));
-        memcpy(output.submesh.bbmax, &ctx->aabb.max.x, sizeof(float3));
+        auto bestTriangle = 0u;
 
-        auto pack_meshlet_vertex = [](GeometryContext* ctx, PKAssets::PKMeshletVertex* out_vertex, uint32_t index)
+        for (auto i = 0u; i < triangleCount; ++i)
         {
-            *out_vertex = PKAssets::PackPKMeshletVertex(
-                &ctx->pVertices[index].in_POSITION.x,
-                &ctx->pVertices[index].in_TEXCOORD0.x,
-                &ctx->pVertices[index].in_NORMAL.x,
-                &ctx->pVertices[index].in_TANGENT.x,
-                nullptr,
-                &ctx->aabb.min.x,
-                &ctx->aabb.max.x);
-        };
+            triangleScores[i] = vertexScores[indices[i * 3u + 0u]] + vertexScores[indices[i * 3u + 1u]] + vertexScores[indices[i * 3u + 2u]];
+            bestTriangle = triangleScores[i] > triangleScores[bestTriangle] ? i : bestTriangle;
+        }
+
+        uint32_t cache[CACHE_SIZE + 3u];
+        uint32_t cacheNext[CACHE_SIZE + 3u];
+        auto cacheCount = 0u;
+        auto cursor = 0u;
 
-        auto pack_meshlet = [](GeometryContext* ctx, PKAssets::PKMeshlet* out_meshlet, MeshletIndexInfo meshlet, const uint32_t* meshlet_vertices, const uint8_t* meshlet_indices)
+        for (auto outTriangle = 0u; outTriangle < triangleCount; ++outTriangle)
         {
-            float3 center = PK_FLOAT3_ZERO, extents = PK_FLOAT3_ZERO, cone_apex = PK_FLOAT3_ZERO;
-            sbyte3 cone_axis_s8{};
-            sbyte cone_cutoff_s8 = 0;
+            // No scored candidates in cache. Continue from the first remaining triangle.
+            if (bestTriangle == ~0u)
+            {
+                while (emitted[cursor])
+                {
+                    cursor++;
+                }
 
-            // Compute bounds
+                bestTriangle = cursor;
+            }
+
+            const auto* triangle = indices + bestTriangle * 3u;
+            auto cacheNextCount = 0u;
+            emitted[bestTriangle] = 1u;
+
+            for (auto i = 0u; i < 3u; ++i)
             {
-                const auto index_count = meshlet.triangle_count * 3;
-                float3 normals[PKAssets::PK_MESHLET_MAX_TRIANGLES * 3];
-                float3 corners[PKAssets::PK_MESHLET_MAX_TRIANGLES * 3][3];
-                uint32_t valid_tri_count = 0u;
+                const auto vertex = triangle[i];
+                output[outTriangle * 3u + i] = vertex;
+                cacheNext[cacheNextCount++] = vertex;
 
-                for (auto i = 0u; i < index_count; i += 3u)
+                // Swap remove the emitted triangle from the live adjacency range.
+                auto* neighbours = adjacency + offsets[vertex];
+
+                for (auto j = 0u; j < liveCounts[vertex]; ++j)
                 {
-                    bool isValid = false;
-                    const auto a = &ctx->pVertices[meshlet_vertices[meshlet.vertex_offset + meshlet_indices[meshlet.triangle_offset + i + 0]]].in_POSITION.x;
-                    const auto b = &ctx->pVertices[meshlet_vertices[meshlet.vertex_offset + meshlet_indices[meshlet.triangle_offset + i + 1]]].in_POSITION.x;
-                    const auto c = &ctx->pVertices[meshlet_vertices[meshlet.vertex_offset + meshlet_indices[meshlet.triangle_offset + i + 2]]].in_POSITION.x;
-                    normals[valid_tri_count] = math::triangleNormal(a, b, c, isValid);
-                    corners[valid_tri_count][0] = float3(a);
-                    corners[valid_tri_count][1] = float3(b);
-                    corners[valid_tri_count][2] = float3(c);
-                    valid_tri_count += (uint32_t)isValid;
+                    if (neighbours[j] == bestTriangle)
+                    {
+                        neighbours[j] = neighbours[--liveCounts[vertex]];
+                        break;
+                    }
                 }
+            }
 
-                // degenerate cluster, no valid triangles => trivial reject (cone data is 0)
-                if (valid_tri_count > 0u)
+            for (auto i = 0u; i < cacheCount; ++i)
+            {
+                const auto vertex = cache[i];
+
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
                 {
-                    const auto psphere = math::pointsToSphere(corners[0], valid_tri_count * 3u);
-                    const auto nsphere = math::pointsToSphere(normals, valid_tri_count);
-                    const auto axis = math::safenormalize(nsphere.xyz());
-                    auto aabb = math::pointsToAABB(corners[0], valid_tri_count * 3u);
-                    center = aabb.center();
-                    extents = aabb.extents();
-                    cone_cutoff_s8 = 127;
+                    cacheNext[cacheNextCount++] = vertex;
+                }
+            }
 
-                    auto minCosA = 1.0f;
+            bestTriangle = ~0u;
+            auto bestScore = -FLT_MAX;
 
-                    for (auto i = 0u; i < valid_tri_count; ++i)
-                    {
-                        minCosA = math::min(minCosA, math::dot(normals[i], axis));
-                    }
+            for (auto i = 0u; i < cacheNextCount; ++i)
+            {
+                const auto vertex = cacheNext[i];
+                const auto position = i < CACHE_SIZE ? (int32_t)i : -1;
+                const auto score = GetVertexScore(position, liveCounts[vertex]);
+                const auto delta = score - vertexScores[vertex];
+                const auto* neighbours = adjacency + offsets[vertex];
 
-                    if (minCosA > 0.1f)
-                    {
-                        auto maxt = 0.0f;
+                cachePositions[vertex] = position;
+                vertexScores[vertex] = score;
 
-                        for (auto i = 0u; i < valid_tri_count; ++i)
-                        {
-                            maxt = math::max(maxt, math::dot(psphere.xyz - corners[i][0], normals[i]) / math::dot(axis, normals[i]));
-                        }
+                for (auto j = 0u; j < liveCounts[vertex]; ++j)
+                {
+                    const auto neighbour = neighbours[j];
+                    triangleScores[neighbour] += delta;
 
-                        cone_apex = (psphere.xyz - axis) * maxt;
-                        cone_axis_s8 = math::packSnorm8(axis);
-                        const auto cone_axis_s8_e = math::abs(float3(cone_axis_s8) / 127.0f - axis);
-                        const auto cone_cutoff = int(127 * (sqrtf(1.0f - minCosA * minCosA) + cone_axis_s8_e.x + cone_axis_s8_e.y + cone_axis_s8_e.z) + 1);
-                        cone_cutoff_s8 = (cone_cutoff > 127) ? 127 : (signed char)cone_cutoff;
+                    if (triangleScores[neighbour] > bestScore)
+                    {
+                        bestScore = triangleScores[neighbour];
+                        bestTriangle = neighbour;
                     }
                 }
             }
 
-            *out_meshlet = PKAssets::PackPKMeshlet(
-                meshlet.vertex_offset,
-                meshlet.triangle_offset / 3u,
-                meshlet.vertex_count,
-                meshlet.triangle_count,
-                &cone_axis_s8.x,
-                cone_cutoff_s8,
-                &cone_apex.x,
-                &center.x,
-                &extents.x,
-                &center.x,
-                -1.0f,
-                &center.x,
-                PKAssets::PK_MESHLET_LOD_MAX_ERROR);
+            cacheCount = math::min(cacheNextCount, CACHE_SIZE);
+            memcpy(cache, cacheNext, sizeof(uint32_t) * cacheCount);
+        }
+
+        memcpy(indices, output, sizeof(uint32_t) * indexCount);
+
+        Memory::Free(liveCounts);
+        Memory::Free(offsets);
+        Memory::Free(adjacency);
+        Memory::Free(cachePositions);
+        Memory::Free(vertexScores);
+        Memory::Free(triangleScores);
+        Memory::Free(emitted);
+        Memory::Free(output);
+    }
+
+    void OptimizeOverdraw(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, const float* positions, size_t positionStride, float threshold)
+    {
+        using namespace VertexCacheOptimizer;
+
+        struct Cluster
+        {
+            float sortKey;
+            uint32_t first;
+            uint32_t count;
+            float area;
+            float3 centroid;
+            float3 normal;
         };
 
-        MeshletIndexInfo meshlet = {};
+        const auto triangleCount = indexCount / 3u;
 
-        for (size_t i = 0; i < ctx->countIndex; i += 3)
+        if (triangleCount == 0u)
         {
-            uint32_t a = ctx->pIndices[i + 0], b = ctx->pIndices[i + 1], c = ctx->pIndices[i + 2];
-            assert(a < ctx->countVertex && b < ctx->countVertex && c < ctx->countVertex);
+            return;
+        }
 
-            // appends triangle to the meshlet and writes previous meshlet to the output if full
-            uint32_t used_extra = (used[a] == 0xff) + (used[b] == 0xff) + (used[c] == 0xff);
+        auto timestamps = Memory::AllocateClear<uint32_t>(vertexCount);
+        auto clusters = Memory::Allocate<Cluster>(triangleCount);
+        auto output = Memory::Allocate<uint32_t>(indexCount);
+        auto timestamp = ANALYZE_CACHE_SIZE + 1u;
+        auto clusterCount = 0u;
 
-            if (meshlet.vertex_count + used_extra > max_vertices || meshlet.triangle_count >= max_triangles)
-            {
-                pack_meshlet(ctx, &output.meshlets[output.meshlet_count++], meshlet, meshlet_vertices, meshlet_indices);
-                meshlet.vertex_offset += meshlet.vertex_count;
-                meshlet.triangle_offset += meshlet.triangle_count * 3;
-                meshlet.vertex_count = 0;
-                meshlet.triangle_count = 0;
-                memset(used, -1, ctx->countVertex);
-            }
+        // Hard boundaries are where the cache optimized order restarts from a triangle with no cached vertices.
+        // Hard clusters are further split where the running miss ratio drops within the threshold of the cluster average.
+        for (auto first = 0u; first < triangleCount;)
+        {
+            auto end = first + 1u;
+            CountCacheMisses(indices + first * 3u, 1u, timestamps, &timestamp);
 
-            if (used[a] == 0xff)
+            while (end < triangleCount && CountCacheMisses(indices + end * 3u, 1u, timestamps, &timestamp) < 3u)
             {
-                used[a] = (uint8_t)meshlet.vertex_count;
-                pack_meshlet_vertex(ctx, &output.vertices[meshlet.vertex_offset + meshlet.vertex_count], a);
-                meshlet_vertices[meshlet.vertex_offset + meshlet.vertex_count++] = a;
+                end++;
             }
 
-            if (used[b] == 0xff)
-            {
-                used[b] = (uint8_t)meshlet.vertex_count;
-                pack_meshlet_vertex(ctx, &output.vertices[meshlet.vertex_offset + meshlet.vertex_count], b);
-                meshlet_vertices[meshlet.vertex_offset + meshlet.vertex_count++] = b;
-            }
+            timestamp += ANALYZE_CACHE_SIZE + 1u;
+            const auto hardMisses = CountCacheMisses(indices + first * 3u, end - first, timestamps, &timestamp);
+            const auto hardAcmr = hardMisses / (float)(end - first);
+            timestamp += ANALYZE_CACHE_SIZE + 1u;
 
-            if (used[c] == 0xff)
+            for (auto softFirst = first, misses = 0u, i = first; i < end; ++i)
             {
-                used[c] = (uint8_t)meshlet.vertex_count;
-                pack_meshlet_vertex(ctx, &output.vertices[meshlet.vertex_offset + meshlet.vertex_count], c);
-                meshlet_vertices[meshlet.vertex_offset + meshlet.vertex_count++] = c;
+                misses += CountCacheMisses(indices + i * 3u, 1u, timestamps, &timestamp);
+
+                if (i + 1u == end || misses / (float)(i + 1u - softFirst) <= hardAcmr * threshold)
+                {
+                    clusters[clusterCount++] = { 0.0f, softFirst, i + 1u - softFirst, 0.0f, PK_FLOAT3_ZERO, PK_FLOAT3_ZERO };
+                    softFirst = i + 1u;
+                    misses = 0u;
+                    timestamp += ANALYZE_CACHE_SIZE + 1u;
+                }
             }
 
-            meshlet_indices[meshlet.triangle_offset + meshlet.triangle_count * 3 + 0] = used[a];
-            meshlet_indices[meshlet.triangle_offset + meshlet.triangle_count * 3 + 1] = used[b];
-            meshlet_indices[meshlet.triangle_offset + meshlet.triangle_count * 3 + 2] = used[c];
-            meshlet.triangle_count++;
+            first = end;
+        }
+
+        auto getPosition = [positions, positionStride](uint32_t index)
+        {
+            return float3(reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + index * positionStride));
+        };
+
+        auto meshCentroid = PK_FLOAT3_ZERO;
+        auto meshArea = 0.0f;
+
+        for (auto i = 0u; i < clusterCount; ++i)
+        {
+            auto& cluster = clusters[i];
+
+            for (auto j = cluster.first; j < cluster.first + cluster.count; ++j)
+            {
+                const auto a = getPosition(indices[j * 3u + 0u]);
+                const auto b = getPosition(indices[j * 3u + 1u]);
+                const auto c = getPosition(indices[j * 3u + 2u]);
+                const auto normal = math::cross(b - a, c - a);
+                const auto area = math::length(normal);
+                cluster.centroid += (a + b + c) * (area / 3.0f);
+                cluster.normal += normal;
+                cluster.area += area;
+            }
+
+            meshCentroid += cluster.centroid;
+            meshArea += cluster.area;
+        }
+
+        meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : PK_FLOAT3_ZERO;
+
+        for (auto i = 0u; i < clusterCount; ++i)
+        {
+            auto& cluster = clusters[i];
+            const auto centroid = cluster.area > 0.0f ? cluster.centroid / cluster.area : cluster.centroid;
+            // Clusters facing away from the mesh center are likely to occlude the rest. Draw them first.
+            cluster.sortKey = -math::dot(centroid - meshCentroid, math::safenormalize(cluster.normal));
+        }
+
+        IntroSort(clusters, clusters + clusterCount, [](const Cluster& a, const Cluster& b) { return a.sortKey < b.sortKey; });
+
+        for (auto i = 0u, offset = 0u; i < clusterCount; ++i)
+        {
+            memcpy(output + offset, indices + clusters[i].first * 3u, sizeof(uint32_t) * clusters[i].count * 3u);
+            offset += clusters[i].count * 3u;
+        }
+
+        memcpy(indices, output, sizeof(uint32_t) * indexCount);
+
+        Memory::Free(timestamps);
+        Memory::Free(clusters);
+        Memory::Free(output);
+    }
+
+    void RemapVertices(void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, const uint32_t* remap)
+    {
+        auto streamCount = 0u;
+
+        for (auto i = 0u; i < layout.GetCount(); ++i)
+        {
+            streamCount = math::max(streamCount, layout[i].stream + 1u);
+        }
+
+        // Streams are stored as consecutive non interleaved blocks.
+        auto buffer = Memory::Allocate<char>((size_t)layout.GetStride() * vertexCount);
+        auto pverts = reinterpret_cast<char*>(vertices);
+
+        for (auto stream = 0u, streamOffset = 0u; stream < streamCount; ++stream)
+        {
+            const size_t stride = layout.GetStride(stream);
+
+            for (auto i = 0u; i < vertexCount; ++i)
+            {
+                memcpy(buffer + streamOffset + remap[i] * stride, pverts + streamOffset + i * stride, stride);
+            }
+
+            streamOffset += stride * vertexCount;
+        }
+
+        Memory::Memcpy(pverts, buffer, (size_t)layout.GetStride() * vertexCount);
+        Memory::Free(buffer);
+    }
+
+    void OptimizeVertexFetch(void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, uint32_t* indices, uint32_t indexCount, uint32_t* outRemap)
+    {
+        auto remap = outRemap ? outRemap : Memory::Allocate<uint32_t>(vertexCount);
+        auto nextVertex = 0u;
+
+        memset(remap, 0xFF, sizeof(uint32_t) * vertexCount);
+
+        // Vertices are placed in the order of first reference. Unreferenced vertices retain their relative order at the end.
+        for (auto i = 0u; i < indexCount; ++i)
+        {
+            auto& index = remap[indices[i]];
+            index = index == ~0u ? nextVertex++ : index;
+            indices[i] = index;
+        }
+
+        for (auto i = 0u; i < vertexCount; ++i)
+        {
+            remap[i] = remap[i] == ~0u ? nextVertex++ : remap[i];
+        }
+
+        RemapVertices(vertices, vertexCount, layout, remap);
+
+        if (remap != outRemap)
+        {
+            Memory::Free(remap);
+        }
+    }
+
+    bool ReadMeshOptimizeOptions(const char* filepath, MeshOptimizeOptions* outOptions)
+    {
+        void* fileData = nullptr;
+        size_t fileSize = 0ull;
+
+        if (FileIO::ReadBinary(filepath, false, &fileData, &fileSize) != 0)
+        {
+            return false;
+        }
+
+        // Meta files are plain 'key:value' lines. Unknown keys are consumed by the asset tools.
+        auto text = static_cast<const char*>(fileData);
+        auto end = text + fileSize;
+
+        while (text < end)
+        {
+            auto lineEnd = text;
+
+            while (lineEnd < end && *lineEnd != '\n' && *lineEnd != '\r')
+            {
+                lineEnd++;
+            }
+
+            char line[256];
+            const auto length = math::min((size_t)(lineEnd - text), sizeof(line) - 1u);
+            memcpy(line, text, length);
+            line[length] = '\0';
+
+            auto separator = strchr(line, ':');
+
+            if (separator)
+            {
+                *separator = '\0';
+                const auto value = separator + 1;
+
+                if (strcmp(line, "mesh_optimizeVertexCache") == 0) outOptions->vertexCache = atoi(value) != 0;
+                else if (strcmp(line, "mesh_optimizeVertexFetch") == 0) outOptions->vertexFetch = atoi(value) != 0;
+                else if (strcmp(line, "mesh_optimizeOverdraw") == 0) outOptions->overdraw = atoi(value) != 0;
+                else if (strcmp(line, "mesh_optimizeOverdrawThreshold") == 0) outOptions->overdrawThreshold = (float)atof(value);
+                else if (strcmp(line, "mesh_lodCount") == 0) outOptions->lodCount = (uint32_t)math::max(0, atoi(value));
+                else if (strcmp(line, "mesh_lodReduction") == 0) outOptions->lodReduction = (float)atof(value);
+                else if (strcmp(line, "mesh_lodMaxError") == 0) outOptions->lodMaxError = (float)atof(value);
+                else if (strcmp(line, "mesh_meshletHierarchy") == 0) outOptions->meshletHierarchy = atoi(value) != 0;
+            }
+
+            text = lineEnd + 1;
+        }
+
+        Memory::Free(fileData);
+        return true;
+    }
+
+    // Returns a pointer to the first vertex of a float element or nullptr if the layout has no matching element.
+    static const float* GetFloatElement(const void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, NameID name, ElementType format, size_t* outStride)
+    {
+        for (auto i = 0u; i < layout.GetCount(); ++i)
+        {
+            if (layout[i].name == name && layout[i].format == format)
+            {
+                auto streamOffset = 0ull;
+
+                for (auto j = 0u; j < layout[i].stream; ++j)
+                {
+                    streamOffset += (size_t)layout.GetStride(j) * vertexCount;
+                }
+
+                *outStride = layout.GetStride(layout[i].stream);
+                return reinterpret_cast<const float*>(reinterpret_cast<const char*>(vertices) + streamOffset + layout[i].offset);
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Header: magic, version, vertex count, index count, source key (2 words), has remap, padding.
+    // Followed by the optimized indices & the vertex remap when vertex fetch optimization is enabled.
+    constexpr static const uint32_t MESH_OPTIMIZE_CACHE_MAGIC = 0x504B4F43u;
+    constexpr static const uint32_t MESH_OPTIMIZE_CACHE_VERSION = 1u;
+    constexpr static const size_t MESH_OPTIMIZE_CACHE_HEADER_SIZE = sizeof(uint32_t) * 8ull;
+
+    // Hashes everything that affects the output of OptimizeMesh. Fields are hashed individually as structs may contain uninitialized padding.
+    static uint64_t GetMeshOptimizeKey(const MeshOptimizeOptions& options, const void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, const uint32_t* indices, uint32_t indexCount, const SubMesh* submeshes, uint32_t submeshCount)
+    {
+        const uint32_t optionBits = (options.vertexCache ? 1u : 0u) | (options.vertexFetch ? 2u : 0u) | (options.overdraw ? 4u : 0u);
+        auto key = Hash::MurmurHash(&optionBits, sizeof(optionBits), MESH_OPTIMIZE_CACHE_VERSION);
+        key = Hash::MurmurHash(&options.overdrawThreshold, sizeof(float), key);
+        key = Hash::MurmurHash(vertices, (size_t)layout.GetStride() * vertexCount, key);
+        key = Hash::MurmurHash(indices, sizeof(uint32_t) * indexCount, key);
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            const uint32_t range[2] = { submeshes[i].indexFirst, submeshes[i].indexCount };
+            key = Hash::MurmurHash(range, sizeof(range), key);
+        }
+
+        return key;
+    }
+
+    static bool ReadMeshOptimizeCache(const char* cachePath, uint64_t key, void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, uint32_t* indices, uint32_t indexCount)
+    {
+        void* fileData = nullptr;
+        size_t fileSize = 0ull;
+
+        if (FileIO::ReadBinary(cachePath, false, &fileData, &fileSize) != 0)
+        {
+            return false;
+        }
+
+        auto header = static_cast<const uint32_t*>(fileData);
+        auto pIndices = reinterpret_cast<const uint32_t*>(static_cast<const char*>(fileData) + MESH_OPTIMIZE_CACHE_HEADER_SIZE);
+        auto isValid = fileSize >= MESH_OPTIMIZE_CACHE_HEADER_SIZE &&
+            header[0] == MESH_OPTIMIZE_CACHE_MAGIC &&
+            header[1] == MESH_OPTIMIZE_CACHE_VERSION &&
+            header[2] == vertexCount &&
+            header[3] == indexCount &&
+            header[4] == (uint32_t)key &&
+            header[5] == (uint32_t)(key >> 32ull) &&
+            fileSize == MESH_OPTIMIZE_CACHE_HEADER_SIZE + sizeof(uint32_t) * ((size_t)indexCount + (header[6] != 0u ? vertexCount : 0u));
+
+        if (isValid)
+        {
+            memcpy(indices, pIndices, sizeof(uint32_t) * indexCount);
+
+            if (header[6] != 0u)
+            {
+                RemapVertices(vertices, vertexCount, layout, pIndices + indexCount);
+            }
+        }
+
+        Memory::Free(fileData);
+        return isValid;
+    }
+
+    static void WriteMeshOptimizeCache(const char* cachePath, uint64_t key, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const uint32_t* remap)
+    {
+        const auto size = MESH_OPTIMIZE_CACHE_HEADER_SIZE + sizeof(uint32_t) * ((size_t)indexCount + (remap ? vertexCount : 0u));
+        auto fileData = Memory::Allocate<uint8_t>(size);
+        auto header = reinterpret_cast<uint32_t*>(fileData);
+        header[0] = MESH_OPTIMIZE_CACHE_MAGIC;
+        header[1] = MESH_OPTIMIZE_CACHE_VERSION;
+        header[2] = vertexCount;
+        header[3] = indexCount;
+        header[4] = (uint32_t)key;
+        header[5] = (uint32_t)(key >> 32ull);
+        header[6] = remap ? 1u : 0u;
+        header[7] = 0u;
+
+        memcpy(fileData + MESH_OPTIMIZE_CACHE_HEADER_SIZE, indices, sizeof(uint32_t) * indexCount);
+
+        if (remap)
+        {
+            memcpy(fileData + MESH_OPTIMIZE_CACHE_HEADER_SIZE + sizeof(uint32_t) * indexCount, remap, sizeof(uint32_t) * vertexCount);
+        }
+
+        // Content directories may be read only. A missing cache only costs load time.
+        if (FileIO::WriteBinary(cachePath, false, fileData, size) != 0)
+        {
+            PK_LOG_WARNING("Failed to write mesh optimization cache '%s'", cachePath);
+        }
+
+        Memory::Free(fileData);
+    }
+
+    void OptimizeMesh(const MeshOptimizeOptions& options, const char* name, void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, uint32_t* indices, uint32_t indexCount, const SubMesh* submeshes, uint32_t submeshCount, const char* cachePath)
+    {
+        if (!options.vertexCache && !options.vertexFetch && !options.overdraw)
+        {
+            return;
+        }
+
+        const auto cacheKey = cachePath ? GetMeshOptimizeKey(options, vertices, vertexCount, layout, indices, indexCount, submeshes, submeshCount) : 0ull;
+
+        if (cachePath && ReadMeshOptimizeCache(cachePath, cacheKey, vertices, vertexCount, layout, indices, indexCount))
+        {
+            PK_LOG_INFO("Optimized mesh '%s': restored from '%s'", name, cachePath);
+            return;
+        }
+
+        size_t positionStride = 0ull;
+        const auto positions = GetFloatElement(vertices, vertexCount, layout, NameID(PK_RHI_VS_POSITION), ElementType::Float3, &positionStride);
+
+        const auto statsBefore = AnalyzeVertexCache(indices, indexCount, vertexCount);
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            auto submeshIndices = indices + submeshes[i].indexFirst;
+
+            if (options.vertexCache)
+            {
+                OptimizeVertexCache(submeshIndices, submeshes[i].indexCount, vertexCount);
+            }
+
+            if (options.overdraw && positions)
+            {
+                OptimizeOverdraw(submeshIndices, submeshes[i].indexCount, vertexCount, positions, positionStride, options.overdrawThreshold);
+            }
+        }
+
+        uint32_t* remap = nullptr;
+
+        // Fetch order only depends on the final index order. Run last.
+        if (options.vertexFetch)
+        {
+            remap = cachePath ? Memory::Allocate<uint32_t>(vertexCount) : nullptr;
+            OptimizeVertexFetch(vertices, vertexCount, layout, indices, indexCount, remap);
+        }
+
+        const auto statsAfter = AnalyzeVertexCache(indices, indexCount, vertexCount);
+
+        PK_LOG_INFO("Optimized mesh '%s': ACMR: %.3f -> %.3f, ATVR: %.3f -> %.3f", name, statsBefore.acmr, statsAfter.acmr, statsBefore.atvr, statsAfter.atvr);
+
+        if (options.overdraw && !positions)
+        {
+            PK_LOG_WARNING("Mesh '%s' has no float3 positions. Skipped overdraw optimization.", name);
+        }
+
+        if (cachePath)
+        {
+            WriteMeshOptimizeCache(cachePath, cacheKey, vertexCount, indices, indexCount, remap);
+        }
+
+        Memory::Free(remap);
+    }
+
+    namespace MeshSimplifier
+    {
+        // Collapses are applied in passes. Each pass only touches independent vertex neighbourhoods.
+        constexpr static const uint32_t MAX_PASSES = 64u;
+        // Collapses that rotate a triangle normal by more than ~75 degrees are rejected.
+        constexpr static const float FLIP_THRESHOLD = 0.25f;
+        constexpr static const float LOD_NORMAL_WEIGHT = 0.5f;
+        constexpr static const float LOD_TEXCOORD_WEIGHT = 1.0f;
+        constexpr static const uint32_t LOD_MIN_TRIANGLES = 16u;
+        // Lods that do not reduce the triangle count by at least this much end the chain.
+        constexpr static const float LOD_MIN_REDUCTION = 0.9f;
+
+        struct Quadric
+        {
+            float a00, a11, a22;
+            float a10, a20, a21;
+            float b0, b1, b2;
+            float c;
+            float w;
+        };
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            float error;
+        };
+
+        // Area weighted plane quadric.
+        static Quadric GetTriangleQuadric(const float3& p0, const float3& p1, const float3& p2)
+        {
+            Quadric q{};
+            auto normal = math::cross(p1 - p0, p2 - p0);
+            const auto area = math::length(normal);
+
+            if (area > 0.0f)
+            {
+                normal /= area;
+                const auto d = -math::dot(normal, p0);
+                q.a00 = normal.x * normal.x * area;
+                q.a11 = normal.y * normal.y * area;
+                q.a22 = normal.z * normal.z * area;
+                q.a10 = normal.y * normal.x * area;
+                q.a20 = normal.z * normal.x * area;
+                q.a21 = normal.z * normal.y * area;
+                q.b0 = normal.x * d * area;
+                q.b1 = normal.y * d * area;
+                q.b2 = normal.z * d * area;
+                q.c = d * d * area;
+                q.w = area;
+            }
+
+            return q;
+        }
+
+        static void AddQuadric(Quadric* q, const Quadric& r)
+        {
+            q->a00 += r.a00;
+            q->a11 += r.a11;
+            q->a22 += r.a22;
+            q->a10 += r.a10;
+            q->a20 += r.a20;
+            q->a21 += r.a21;
+            q->b0 += r.b0;
+            q->b1 += r.b1;
+            q->b2 += r.b2;
+            q->c += r.c;
+            q->w += r.w;
+        }
+
+        // Evaluates p'Ap + 2b'p + c.
+        static float GetQuadricError(const Quadric& q, const float3& p)
+        {
+            auto rx = q.b0 + q.a10 * p.y;
+            auto ry = q.b1 + q.a21 * p.z;
+            auto rz = q.b2 + q.a20 * p.x;
+            rx = rx * 2.0f + q.a00 * p.x;
+            ry = ry * 2.0f + q.a11 * p.y;
+            rz = rz * 2.0f + q.a22 * p.z;
+            return math::abs(q.c + rx * p.x + ry * p.y + rz * p.z);
+        }
+
+        static bool HasFlippedTriangles(const float3* positions, const uint32_t* indices, const uint32_t* adjacency, uint32_t adjacencyFirst, uint32_t adjacencyLast, uint32_t from, uint32_t to)
+        {
+            for (auto i = adjacencyFirst; i < adjacencyLast; ++i)
+            {
+                const auto triangle = indices + adjacency[i] * 3u;
+
+                // Triangles containing the edge become degenerate & are removed.
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                {
+                    continue;
+                }
+
+                const auto p0 = positions[triangle[0]];
+                const auto p1 = positions[triangle[1]];
+                const auto p2 = positions[triangle[2]];
+                const auto q0 = triangle[0] == from ? positions[to] : p0;
+                const auto q1 = triangle[1] == from ? positions[to] : p1;
+                const auto q2 = triangle[2] == from ? positions[to] : p2;
+                const auto n0 = math::cross(p1 - p0, p2 - p0);
+                const auto n1 = math::cross(q1 - q0, q2 - q0);
+
+                if (math::dot(n0, n1) < FLIP_THRESHOLD * math::length(n0) * math::length(n1))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    uint32_t SimplifyMesh(uint32_t* destination,
+        const uint32_t* indices,
+        uint32_t indexCount,
+        const float* positions,
+        size_t positionStride,
+        uint32_t vertexCount,
+        const float* attributes,
+        size_t attributeStride,
+        const float* attributeWeights,
+        uint32_t attributeCount,
+        uint32_t targetIndexCount,
+        float targetError,
+        float* outError)
+    {
+        using namespace MeshSimplifier;
+
+        assert(indexCount % 3 == 0);
+
+        auto resultCount = 0u;
+
+        // Drop degenerate input triangles. They would otherwise lock their vertices.
+        for (auto i = 0u; i < indexCount; i += 3u)
+        {
+            const auto a = indices[i + 0u], b = indices[i + 1u], c = indices[i + 2u];
+
+            if (a != b && b != c && a != c)
+            {
+                destination[resultCount++] = a;
+                destination[resultCount++] = b;
+                destination[resultCount++] = c;
+            }
+        }
+
+        if (outError)
+        {
+            *outError = 0.0f;
+        }
+
+        if (resultCount <= targetIndexCount)
+        {
+            return resultCount;
+        }
+
+        // Positions are normalized to the bounds radius so that errors are scale independent.
+        auto boundsMin = PK_FLOAT3_ZERO;
+        auto boundsMax = PK_FLOAT3_ZERO;
+
+        for (auto i = 0u; i < resultCount; ++i)
+        {
+            const auto position = float3(reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + destination[i] * positionStride));
+            boundsMin = i == 0u ? position : math::min(boundsMin, position);
+            boundsMax = i == 0u ? position : math::max(boundsMax, position);
+        }
+
+        const auto boundsCenter = (boundsMin + boundsMax) * 0.5f;
+        const auto boundsRadius = math::length(boundsMax - boundsMin) * 0.5f;
+        const auto invBoundsRadius = boundsRadius > 0.0f ? 1.0f / boundsRadius : 0.0f;
+
+        auto vertices = Memory::Allocate<float3>(vertexCount);
+        auto quadrics = Memory::AllocateClear<Quadric>(vertexCount);
+        auto locked = Memory::AllocateClear<uint8_t>(vertexCount);
+        auto touched = Memory::Allocate<uint8_t>(vertexCount);
+        auto remap = Memory::Allocate<uint32_t>(vertexCount);
+        auto adjacencyOffsets = Memory::Allocate<uint32_t>(vertexCount + 1u);
+        auto adjacency = Memory::Allocate<uint32_t>(resultCount);
+        auto edges = Memory::Allocate<uint64_t>(resultCount);
+        auto collapses = Memory::Allocate<Collapse>(resultCount);
+
+        for (auto i = 0u; i < vertexCount; ++i)
+        {
+            const auto position = float3(reinterpret_cast<const float*>(reinterpret_cast<const char*>(positions) + i * positionStride));
+            vertices[i] = (position - boundsCenter) * invBoundsRadius;
+        }
+
+        // Edges referenced by a single triangle are either borders or attribute seams (split vertices).
+        // Non manifold edges are treated the same. Vertices of these edges are locked.
+        for (auto i = 0u; i < resultCount; i += 3u)
+        {
+            for (auto j = 0u; j < 3u; ++j)
+            {
+                const auto a = (uint64_t)destination[i + j];
+                const auto b = (uint64_t)destination[i + (j + 1u) % 3u];
+                edges[i + j] = a < b ? (a << 32ull) | b : (b << 32ull) | a;
+            }
+
+            const auto quadric = GetTriangleQuadric(vertices[destination[i + 0u]], vertices[destination[i + 1u]], vertices[destination[i + 2u]]);
+            AddQuadric(&quadrics[destination[i + 0u]], quadric);
+            AddQuadric(&quadrics[destination[i + 1u]], quadric);
+            AddQuadric(&quadrics[destination[i + 2u]], quadric);
+        }
+
+        IntroSort(edges, edges + resultCount);
+
+        for (auto i = 0u; i < resultCount;)
+        {
+            auto j = i + 1u;
+
+            while (j < resultCount && edges[j] == edges[i])
+            {
+                ++j;
+            }
+
+            if (j - i != 2u)
+            {
+                locked[edges[i] >> 32ull] = 1u;
+                locked[edges[i] & 0xFFFFFFFFull] = 1u;
+            }
+
+            i = j;
+        }
+
+        // Attribute error is measured against the target vertex only. Merged quadrics carry the positional history.
+        auto getCollapseError = [&](uint32_t from, uint32_t to)
+        {
+            const auto& quadric = quadrics[from];
+            auto error = quadric.w > 0.0f ? GetQuadricError(quadric, vertices[to]) / quadric.w : 0.0f;
+
+            if (attributes)
+            {
+                const auto attributesFrom = reinterpret_cast<const float*>(reinterpret_cast<const char*>(attributes) + from * attributeStride);
+                const auto attributesTo = reinterpret_cast<const float*>(reinterpret_cast<const char*>(attributes) + to * attributeStride);
+
+                for (auto i = 0u; i < attributeCount; ++i)
+                {
+                    const auto delta = attributesFrom[i] - attributesTo[i];
+                    error += delta * delta * attributeWeights[i];
+                }
+            }
+
+            return error;
+        };
+
+        const auto targetErrorSq = targetError * targetError;
+        const auto targetTriangleCount = targetIndexCount / 3u;
+        auto maxErrorSq = 0.0f;
+
+        for (auto pass = 0u; pass < MAX_PASSES && resultCount > targetIndexCount; ++pass)
+        {
+            const auto triangleCount = resultCount / 3u;
+
+            // Vertex to triangle adjacency. Remap doubles as the fill cursor.
+            memset(adjacencyOffsets, 0, sizeof(uint32_t) * (vertexCount + 1u));
+
+            for (auto i = 0u; i < resultCount; ++i)
+            {
+                adjacencyOffsets[destination[i] + 1u]++;
+            }
+
+            for (auto i = 0u; i < vertexCount; ++i)
+            {
+                adjacencyOffsets[i + 1u] += adjacencyOffsets[i];
+                remap[i] = adjacencyOffsets[i];
+            }
+
+            for (auto i = 0u; i < resultCount; ++i)
+            {
+                adjacency[remap[destination[i]]++] = i / 3u;
+            }
+
+            // Interior edges are seen from both of their triangles in opposite winding. Evaluate them once.
+            auto collapseCount = 0u;
+
+            for (auto i = 0u; i < resultCount; i += 3u)
+            {
+                for (auto j = 0u; j < 3u; ++j)
+                {
+                    const auto a = destination[i + j];
+                    const auto b = destination[i + (j + 1u) % 3u];
+
+                    if (a > b || (locked[a] && locked[b]))
+                    {
+                        continue;
+                    }
+
+                    const auto errorAB = locked[a] ? FLT_MAX : getCollapseError(a, b);
+                    const auto errorBA = locked[b] ? FLT_MAX : getCollapseError(b, a);
+                    collapses[collapseCount++] = errorAB <= errorBA ? Collapse{ a, b, errorAB } : Collapse{ b, a, errorBA };
+                }
+            }
+
+            IntroSort(collapses, collapses + collapseCount, [](const Collapse& a, const Collapse& b) { return a.error < b.error; });
+
+            memset(touched, 0, sizeof(uint8_t) * vertexCount);
+
+            for (auto i = 0u; i < vertexCount; ++i)
+            {
+                remap[i] = i;
+            }
+
+            // Each collapse removes roughly two triangles.
+            const auto collapseGoal = math::max(1u, (triangleCount - targetTriangleCount) / 2u);
+            auto collapseApplied = 0u;
+
+            for (auto i = 0u; i < collapseCount && collapseApplied < collapseGoal; ++i)
+            {
+                const auto& collapse = collapses[i];
+
+                if (collapse.error > targetErrorSq)
+                {
+                    break;
+                }
+
+                if (touched[collapse.from] || touched[collapse.to])
+                {
+                    continue;
+                }
+
+                const auto adjacencyFirst = adjacencyOffsets[collapse.from];
+                const auto adjacencyLast = adjacencyOffsets[collapse.from + 1u];
+
+                if (HasFlippedTriangles(vertices, destination, adjacency, adjacencyFirst, adjacencyLast, collapse.from, collapse.to))
+                {
+                    continue;
+                }
+
+                // Touching the whole one ring keeps flip checks of later collapses in this pass valid.
+                for (auto j = adjacencyFirst; j < adjacencyLast; ++j)
+                {
+                    const auto triangle = destination + adjacency[j] * 3u;
+                    touched[triangle[0]] = 1u;
+                    touched[triangle[1]] = 1u;
+                    touched[triangle[2]] = 1u;
+                }
+
+                remap[collapse.from] = collapse.to;
+                AddQuadric(&quadrics[collapse.to], quadrics[collapse.from]);
+                maxErrorSq = math::max(maxErrorSq, collapse.error);
+                collapseApplied++;
+            }
+
+            if (collapseApplied == 0u)
+            {
+                break;
+            }
+
+            auto writeCount = 0u;
+
+            for (auto i = 0u; i < resultCount; i += 3u)
+            {
+                const auto a = remap[destination[i + 0u]];
+                const auto b = remap[destination[i + 1u]];
+                const auto c = remap[destination[i + 2u]];
+
+                if (a != b && b != c && a != c)
+                {
+                    destination[writeCount++] = a;
+                    destination[writeCount++] = b;
+                    destination[writeCount++] = c;
+                }
+            }
+
+            resultCount = writeCount;
+        }
+
+        if (outError)
+        {
+            *outError = sqrtf(maxErrorSq);
+        }
+
+        Memory::Free(vertices);
+        Memory::Free(quadrics);
+        Memory::Free(locked);
+        Memory::Free(touched);
+        Memory::Free(remap);
+        Memory::Free(adjacencyOffsets);
+        Memory::Free(adjacency);
+        Memory::Free(edges);
+        Memory::Free(collapses);
+        return resultCount;
+    }
+
+    uint32_t BuildMeshLods(const MeshOptimizeOptions& options, const char* name, const void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, uint32_t* indices, uint32_t* inoutIndexCount, SubMesh* submeshes, uint32_t submeshCount)
+    {
+        using namespace MeshSimplifier;
+
+        if (options.lodCount == 0u)
+        {
+            return 0u;
+        }
+
+        size_t positionStride = 0ull;
+        size_t normalStride = 0ull;
+        size_t texcoordStride = 0ull;
+        const auto positions = GetFloatElement(vertices, vertexCount, layout, NameID(PK_RHI_VS_POSITION), ElementType::Float3, &positionStride);
+        const auto normals = GetFloatElement(vertices, vertexCount, layout, NameID(PK_RHI_VS_NORMAL), ElementType::Float3, &normalStride);
+        const auto texcoords = GetFloatElement(vertices, vertexCount, layout, NameID(PK_RHI_VS_TEXCOORD0), ElementType::Float2, &texcoordStride);
+
+        if (!positions)
+        {
+            PK_LOG_WARNING("Mesh '%s' has no float3 positions. Skipped lod generation.", name);
+            return 0u;
+        }
+
+        // Normals & uvs are packed into a single attribute stream. Missing elements stay zero & contribute no error.
+        constexpr auto attributeCount = 5u;
+        const float attributeWeights[attributeCount] = { LOD_NORMAL_WEIGHT, LOD_NORMAL_WEIGHT, LOD_NORMAL_WEIGHT, LOD_TEXCOORD_WEIGHT, LOD_TEXCOORD_WEIGHT };
+        auto attributes = Memory::AllocateClear<float>((size_t)vertexCount * attributeCount);
+
+        for (auto i = 0u; i < vertexCount; ++i)
+        {
+            if (normals)
+            {
+                memcpy(attributes + i * attributeCount, reinterpret_cast<const char*>(normals) + i * normalStride, sizeof(float3));
+            }
+
+            if (texcoords)
+            {
+                memcpy(attributes + i * attributeCount + 3u, reinterpret_cast<const char*>(texcoords) + i * texcoordStride, sizeof(float2));
+            }
+        }
+
+        auto indexHead = *inoutIndexCount;
+        auto lodSubmeshCount = 0u;
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            auto& submesh = submeshes[i];
+            submesh.lodFirst = submeshCount + lodSubmeshCount;
+            submesh.lodCount = 0u;
+
+            auto sourceFirst = submesh.indexFirst;
+            auto sourceCount = submesh.indexCount;
+            auto lodError = 0.0f;
+
+            for (auto lod = 0u; lod < options.lodCount; ++lod)
+            {
+                const auto targetCount = (uint32_t)((sourceCount / 3u) * options.lodReduction) * 3u;
+
+                if (targetCount < LOD_MIN_TRIANGLES * 3u)
+                {
+                    break;
+                }
+
+                auto error = 0.0f;
+                const auto count = SimplifyMesh(indices + indexHead,
+                    indices + sourceFirst,
+                    sourceCount,
+                    positions,
+                    positionStride,
+                    vertexCount,
+                    attributes,
+                    sizeof(float) * attributeCount,
+                    attributeWeights,
+                    attributeCount,
+                    targetCount,
+                    options.lodMaxError,
+                    &error);
+
+                // Simplification stalled on locked borders or the error limit.
+                if (count == 0u || count > (uint32_t)(sourceCount * LOD_MIN_REDUCTION))
+                {
+                    break;
+                }
+
+                // Each lod is simplified from the previous one. Errors accumulate along the chain.
+                lodError += error;
+
+                auto& lodSubmesh = submeshes[submeshCount + lodSubmeshCount++];
+                lodSubmesh = submesh;
+                lodSubmesh.indexFirst = indexHead;
+                lodSubmesh.indexCount = count;
+                lodSubmesh.meshletFirst = 0u;
+                lodSubmesh.meshletCount = 0u;
+                lodSubmesh.lodFirst = 0u;
+                lodSubmesh.lodCount = 0u;
+                lodSubmesh.lodError = lodError;
+                submesh.lodCount++;
+
+                sourceFirst = indexHead;
+                sourceCount = count;
+                indexHead += count;
+            }
+
+            PK_LOG_INFO("Mesh '%s' submesh %u: %u lods, triangles: %u -> %u, error: %.4f", name, i, submesh.lodCount, submesh.indexCount / 3u, sourceCount / 3u, lodError);
+        }
+
+        *inoutIndexCount = indexHead;
+        Memory::Free(attributes);
+        return lodSubmeshCount;
+    }
+
+
+    MeshletBuildData::MeshletBuildData(size_t count_meshlet)
+    {
+        const auto count_index = count_meshlet * PKAssets::PK_MESHLET_MAX_TRIANGLES * 3ull;
+        const auto count_vertex = count_meshlet * PKAssets::PK_MESHLET_MAX_VERTICES;
+
+        size_t size = 0ull;
+        const auto offset_indices = Memory::AlignSize<uint8_t>(size);
+        size = offset_indices + sizeof(uint8_t) * count_index;
+        const auto offset_vertices = Memory::AlignSize<PKAssets::PKMeshletVertex>(size);
+        size = offset_vertices + sizeof(PKAssets::PKMeshletVertex) * count_vertex;
+        const auto offset_meshlets = Memory::AlignSize<PKAssets::PKMeshlet>(size);
+        size = offset_meshlets + sizeof(PKAssets::PKMeshlet) * count_meshlet;
+
+        buffer = Memory::AllocateClear<uint8_t>(size);
+        indices = Memory::CastOffsetPtr<uint8_t>(buffer, offset_indices);
+        vertices = Memory::CastOffsetPtr<PKAssets::PKMeshletVertex>(buffer, offset_vertices);
+        meshlets = Memory::CastOffsetPtr<PKAssets::PKMeshlet>(buffer, offset_meshlets);
+    }
+
+    MeshletBuildData::MeshletBuildData(MeshletBuildData&& other)
+    {
+        if (&other != this)
+        {
+            submesh = other.submesh;
+            meshlet_count = other.meshlet_count;
+            vertex_count = other.vertex_count;
+            index_count = other.index_count;
+            metrics = other.metrics;
+            buffer = other.buffer;
+            indices = other.indices;
+            vertices = other.vertices;
+            meshlets = other.meshlets;
+            other.buffer = nullptr;
+        }
+    }
+
+    MeshletBuildData::~MeshletBuildData()
+    {
+        Memory::Free(buffer);
+        buffer = nullptr;
+    }
+
+    namespace MeshletBuilder
+    {
+        struct MeshletIndexInfo
+        {
+            uint32_t vertex_offset;
+            uint32_t triangle_offset;
+            uint32_t vertex_count;
+            uint32_t triangle_count;
+        };
+
+        // Static kd-tree over triangle centroids used to find seed triangles for new meshlets.
+        // Consumed triangles are not removed. Instead subtrees with no remaining triangles are lazily marked empty during queries.
+        struct KDTree
+        {
+            constexpr static const uint32_t LEAF_SIZE = 8u;
+            constexpr static const uint32_t AXIS_LEAF = 3u;
+
+            struct Node
+            {
+                float split;
+                uint32_t axis;
+                // Leaf: first item. Inner: index of the right child. Left child is always the next node.
+                uint32_t child;
+                // Leaf: item count. Inner: 0 if the subtree is exhausted.
+                uint32_t count;
+            };
+
+            Node* nodes = nullptr;
+            uint32_t* items = nullptr;
+            const float3* points = nullptr;
+            uint32_t nodeCount = 0u;
+
+            KDTree(const float3* pPoints, uint32_t count) : points(pPoints)
+            {
+                nodes = Memory::Allocate<Node>(count * 2u + 1u);
+                items = Memory::Allocate<uint32_t>(count);
+
+                for (auto i = 0u; i < count; ++i)
+                {
+                    items[i] = i;
+                }
+
+                Build(0u, count);
+            }
+
+            ~KDTree()
+            {
+                Memory::Free(nodes);
+                Memory::Free(items);
+            }
+
+            uint32_t Build(uint32_t first, uint32_t count)
+            {
+                const auto index = nodeCount++;
+                auto& node = nodes[index];
+
+                if (count <= LEAF_SIZE)
+                {
+                    node = { 0.0f, AXIS_LEAF, first, count };
+                    return index;
+                }
+
+                auto aabb = AABB<float3>(points[items[first]], points[items[first]]);
+
+                for (auto i = 1u; i < count; ++i)
+                {
+                    aabb |= points[items[first + i]];
+                }
+
+                const auto extents = aabb.extents();
+                const auto axis = extents.x >= extents.y && extents.x >= extents.z ? 0u : extents.y >= extents.z ? 1u : 2u;
+                const auto half = count / 2u;
+                const auto pts = points;
+
+                IntroSort(items + first, items + first + count, [pts, axis](const uint32_t& a, const uint32_t& b) { return pts[a][axis] < pts[b][axis]; });
+
+                node.split = points[items[first + half]][axis];
+                node.axis = axis;
+                node.count = 1u;
+                Build(first, half);
+                node.child = Build(first + half, count - half);
+                return index;
+            }
+
+            bool FindNearest(uint32_t index, const float3& point, const uint8_t* emitted, uint32_t* outItem, float* outDistanceSq)
+            {
+                auto& node = nodes[index];
+
+                if (node.count == 0u)
+                {
+                    return false;
+                }
+
+                if (node.axis == AXIS_LEAF)
+                {
+                    auto hasLive = false;
+
+                    for (auto i = 0u; i < node.count; ++i)
+                    {
+                        const auto item = items[node.child + i];
+
+                        if (!emitted[item])
+                        {
+                            const auto offset = points[item] - point;
+                            const auto distanceSq = math::dot(offset, offset);
+                            hasLive = true;
+
+                            if (distanceSq < *outDistanceSq)
+                            {
+                                *outItem = item;
+                                *outDistanceSq = distanceSq;
+                            }
+                        }
+                    }
+
+                    node.count = hasLive ? node.count : 0u;
+                    return hasLive;
+                }
+
+                const auto delta = point[node.axis] - node.split;
+                const auto nodeNear = delta <= 0.0f ? index + 1u : node.child;
+                const auto nodeFar = delta <= 0.0f ? node.child : index + 1u;
+                const auto hasLiveNear = FindNearest(nodeNear, point, emitted, outItem, outDistanceSq);
+                // Far side is only known to be exhausted if it was visited.
+                auto hasLiveFar = true;
+
+                if (delta * delta <= *outDistanceSq)
+                {
+                    hasLiveFar = FindNearest(nodeFar, point, emitted, outItem, outDistanceSq);
+                }
+
+                node.count = hasLiveNear || hasLiveFar ? 1u : 0u;
+                return node.count != 0u;
+            }
+
+            uint32_t FindNearest(const float3& point, const uint8_t* emitted)
+            {
+                auto item = ~0u;
+                auto distanceSq = FLT_MAX;
+                FindNearest(0u, point, emitted, &item, &distanceSq);
+                return item;
+            }
+        };
+
+        static void PackVertex(GeometryContext* ctx, PKAssets::PKMeshletVertex* out_vertex, uint32_t index)
+        {
+            *out_vertex = PKAssets::PackPKMeshletVertex(
+                &ctx->pVertices[index].in_POSITION.x,
+                &ctx->pVertices[index].in_TEXCOORD0.x,
+                &ctx->pVertices[index].in_NORMAL.x,
+                &ctx->pVertices[index].in_TANGENT.x,
+                nullptr,
+                &ctx->aabb.min.x,
+                &ctx->aabb.max.x);
+        }
+
+        static void PackMeshlet(GeometryContext* ctx, PKAssets::PKMeshlet* out_meshlet, MeshletIndexInfo meshlet, const uint32_t* meshlet_vertices, const uint8_t* meshlet_indices, MeshletMetrics* metrics)
+        {
+            float3 center = PK_FLOAT3_ZERO, extents = PK_FLOAT3_ZERO, cone_apex = PK_FLOAT3_ZERO;
+            sbyte3 cone_axis_s8{};
+            sbyte cone_cutoff_s8 = 0;
+
+            // Compute bounds
+            {
+                const auto index_count = meshlet.triangle_count * 3;
+                float3 normals[PKAssets::PK_MESHLET_MAX_TRIANGLES * 3];
+                float3 corners[PKAssets::PK_MESHLET_MAX_TRIANGLES * 3][3];
+                uint32_t valid_tri_count = 0u;
+
+                for (auto i = 0u; i < index_count; i += 3u)
+                {
+                    bool isValid = false;
+                    const auto a = &ctx->pVertices[meshlet_vertices[meshlet.vertex_offset + meshlet_indices[meshlet.triangle_offset + i + 0]]].in_POSITION.x;
+                    const auto b = &ctx->pVertices[meshlet_vertices[meshlet.vertex_offset + meshlet_indices[meshlet.triangle_offset + i + 1]]].in_POSITION.x;
+                    const auto c = &ctx->pVertices[meshlet_vertices[meshlet.vertex_offset + meshlet_indices[meshlet.triangle_offset + i + 2]]].in_POSITION.x;
+                    normals[valid_tri_count] = math::triangleNormal(a, b, c, isValid);
+                    corners[valid_tri_count][0] = float3(a);
+                    corners[valid_tri_count][1] = float3(b);
+                    corners[valid_tri_count][2] = float3(c);
+                    valid_tri_count += (uint32_t)isValid;
+                }
+
+                // degenerate cluster, no valid triangles => trivial reject (cone data is 0)
+                if (valid_tri_count > 0u)
+                {
+                    const auto psphere = math::pointsToSphere(corners[0], valid_tri_count * 3u);
+                    const auto nsphere = math::pointsToSphere(normals, valid_tri_count);
+                    const auto axis = math::safenormalize(nsphere.xyz());
+                    auto aabb = math::pointsToAABB(corners[0], valid_tri_count * 3u);
+                    center = aabb.center();
+                    extents = aabb.extents();
+                    cone_cutoff_s8 = 127;
+
+                    auto minCosA = 1.0f;
+
+                    for (auto i = 0u; i < valid_tri_count; ++i)
+                    {
+                        minCosA = math::min(minCosA, math::dot(normals[i], axis));
+                    }
+
+                    if (minCosA > 0.1f)
+                    {
+                        auto maxt = 0.0f;
+
+                        for (auto i = 0u; i < valid_tri_count; ++i)
+                        {
+                            maxt = math::max(maxt, math::dot(psphere.xyz - corners[i][0], normals[i]) / math::dot(axis, normals[i]));
+                        }
+
+                        cone_apex = (psphere.xyz - axis) * maxt;
+                        cone_axis_s8 = math::packSnorm8(axis);
+                        const auto cone_axis_s8_e = math::abs(float3(cone_axis_s8) / 127.0f - axis);
+                        const auto cone_cutoff = int(127 * (sqrtf(1.0f - minCosA * minCosA) + cone_axis_s8_e.x + cone_axis_s8_e.y + cone_axis_s8_e.z) + 1);
+                        cone_cutoff_s8 = (cone_cutoff > 127) ? 127 : (signed char)cone_cutoff;
+                        metrics->coneCullableRatio += 1.0f;
+                    }
+
+                    metrics->avgBoundsRadius += psphere.w;
+                    metrics->avgConeAngle += math::acos(math::max(-1.0f, minCosA)) * PK_FLOAT_RAD2DEG;
+                }
+            }
+
+            metrics->avgVertexCount += meshlet.vertex_count;
+            metrics->avgTriangleCount += meshlet.triangle_count;
+
+            *out_meshlet = PKAssets::PackPKMeshlet(
+                meshlet.vertex_offset,
+                meshlet.triangle_offset / 3u,
+                meshlet.vertex_count,
+                meshlet.triangle_count,
+                &cone_axis_s8.x,
+                cone_cutoff_s8,
+                &cone_apex.x,
+                &center.x,
+                &extents.x,
+                &center.x,
+                -1.0f,
+                &center.x,
+                PKAssets::PK_MESHLET_LOD_MAX_ERROR);
+        }
+
+        static void ResolveMetrics(MeshletMetrics* metrics, uint32_t meshletCount)
+        {
+            if (meshletCount > 0u)
+            {
+                // Vertex reuse is the number of triangle corners per unique meshlet vertex.
+                metrics->vertexReuse = metrics->avgVertexCount > 0.0f ? (metrics->avgTriangleCount * 3.0f) / metrics->avgVertexCount : 0.0f;
+                metrics->avgBoundsRadius /= meshletCount;
+                metrics->avgConeAngle /= meshletCount;
+                metrics->coneCullableRatio /= meshletCount;
+                metrics->avgVertexCount /= meshletCount;
+                metrics->avgTriangleCount /= meshletCount;
+            }
+
+            metrics->meshletCount = meshletCount;
+        }
+
+        static uint32_t GetMaxMeshletCount(GeometryContext* ctx)
+        {
+            // Meshlets are only closed when no triangle fits. As such each contains either max triangles or at least max vertices - 2.
+            const auto max_vertices_conservative = PKAssets::PK_MESHLET_MAX_VERTICES - 2;
+            auto meshlet_limit_vertices = (ctx->countIndex + max_vertices_conservative - 1) / max_vertices_conservative;
+            auto meshlet_limit_triangles = (ctx->countIndex / 3 + PKAssets::PK_MESHLET_MAX_TRIANGLES - 1) / PKAssets::PK_MESHLET_MAX_TRIANGLES;
+            return meshlet_limit_vertices > meshlet_limit_triangles ? meshlet_limit_vertices : meshlet_limit_triangles;
+        }
+    }
+
+    MeshletBuildData BuildMeshletsMonotone(GeometryContext* ctx)
+    {
+        using namespace MeshletBuilder;
+
+        assert(ctx->countIndex % 3 == 0);
+
+        const auto max_vertices = PKAssets::PK_MESHLET_MAX_VERTICES;
+        const auto max_triangles = PKAssets::PK_MESHLET_MAX_TRIANGLES;
+        const auto max_meshlets = GetMaxMeshletCount(ctx);
+
+        MeshletBuildData output(max_meshlets);
+
+        auto* meshlet_vertices = Memory::Allocate<uint32_t>(max_meshlets * PKAssets::PK_MESHLET_MAX_VERTICES);
+        auto* meshlet_indices = output.indices;
+        auto* used = Memory::Allocate<uint8_t>(ctx->countVertex);
+        
+        memset(used, -1, ctx->countVertex);
+
+        memcpy(output.submesh.bbmin, &ctx->aabb.min.x, sizeof(float3));
+        memcpy(output.submesh.bbmax, &ctx->aabb.max.x, sizeof(float3));
+
+        MeshletIndexInfo meshlet = {};
+
+        for (size_t i = 0; i < ctx->countIndex; i += 3)
+        {
+            uint32_t a = ctx->pIndices[i + 0], b = ctx->pIndices[i + 1], c = ctx->pIndices[i + 2];
+            assert(a < ctx->countVertex && b < ctx->countVertex && c < ctx->countVertex);
+
+            // appends triangle to the meshlet and writes previous meshlet to the output if full
+            uint32_t used_extra = (used[a] == 0xff) + (used[b] == 0xff) + (used[c] == 0xff);
+
+            if (meshlet.vertex_count + used_extra > max_vertices || meshlet.triangle_count >= max_triangles)
+            {
+                PackMeshlet(ctx, &output.meshlets[output.meshlet_count++], meshlet, meshlet_vertices, meshlet_indices, &output.metrics);
+                meshlet.vertex_offset += meshlet.vertex_count;
+                meshlet.triangle_offset += meshlet.triangle_count * 3;
+                meshlet.vertex_count = 0;
+                meshlet.triangle_count = 0;
+                memset(used, -1, ctx->countVertex);
+            }
+
+            if (used[a] == 0xff)
+            {
+                used[a] = (uint8_t)meshlet.vertex_count;
+                PackVertex(ctx, &output.vertices[meshlet.vertex_offset + meshlet.vertex_count], a);
+                meshlet_vertices[meshlet.vertex_offset + meshlet.vertex_count++] = a;
+            }
+
+            if (used[b] == 0xff)
+            {
+                used[b] = (uint8_t)meshlet.vertex_count;
+                PackVertex(ctx, &output.vertices[meshlet.vertex_offset + meshlet.vertex_count], b);
+                meshlet_vertices[meshlet.vertex_offset + meshlet.vertex_count++] = b;
+            }
+
+            if (used[c] == 0xff)
+            {
+                used[c] = (uint8_t)meshlet.vertex_count;
+                PackVertex(ctx, &output.vertices[meshlet.vertex_offset + meshlet.vertex_count], c);
+                meshlet_vertices[meshlet.vertex_offset + meshlet.vertex_count++] = c;
+            }
+
+            meshlet_indices[meshlet.triangle_offset + meshlet.triangle_count * 3 + 0] = used[a];
+            meshlet_indices[meshlet.triangle_offset + meshlet.triangle_count * 3 + 1] = used[b];
+            meshlet_indices[meshlet.triangle_offset + meshlet.triangle_count * 3 + 2] = used[c];
+            meshlet.triangle_count++;
+        }
+
+        if (meshlet.triangle_count)
+        {
+            PackMeshlet(ctx, &output.meshlets[output.meshlet_count++], meshlet, meshlet_vertices, meshlet_indices, &output.metrics);
+        }
+
+        // Align triangles array size to 4bytes
+        output.index_count = 12u * ((meshlet.triangle_offset + meshlet.triangle_count * 3u + 11u) / 12u);
+        output.vertex_count = meshlet.vertex_offset + meshlet.vertex_count;
+        output.submesh.firstMeshlet = 0u;
+        output.submesh.meshletCount = output.meshlet_count;
+        ResolveMetrics(&output.metrics, output.meshlet_count);
+
+        Memory::Free(meshlet_vertices);
+        Memory::Free(used);
+
+        return output;
+    }
+
+    MeshletBuildData BuildMeshletsSpatial(GeometryContext* ctx, uint32_t** outMeshletVertices)
+    {
+        using namespace MeshletBuilder;
+
+        assert(ctx->countIndex % 3 == 0);
+
+        const auto max_vertices = PKAssets::PK_MESHLET_MAX_VERTICES;
+        const auto max_triangles = PKAssets::PK_MESHLET_MAX_TRIANGLES;
+        const auto cone_weight = PKAssets::PK_MESHLET_CONE_WEIGHT;
+        const auto max_meshlets = GetMaxMeshletCount(ctx);
+        const auto triangle_count = ctx->countIndex / 3u;
+
+        MeshletBuildData output(max_meshlets);
+
+        memcpy(output.submesh.bbmin, &ctx->aabb.min.x, sizeof(float3));
+        memcpy(output.submesh.bbmax, &ctx->aabb.max.x, sizeof(float3));
+
+        if (triangle_count == 0u)
+        {
+            if (outMeshletVertices)
+            {
+                *outMeshletVertices = nullptr;
+            }
+
+            return output;
+        }
+
+        auto* meshlet_vertices = Memory::Allocate<uint32_t>(max_meshlets * PKAssets::PK_MESHLET_MAX_VERTICES);
+        auto* meshlet_indices = output.indices;
+        auto* used = Memory::Allocate<uint8_t>(ctx->countVertex);
+        auto* emitted = Memory::AllocateClear<uint8_t>(triangle_count);
+        auto* centroids = Memory::Allocate<float3>(triangle_count);
+        auto* normals = Memory::Allocate<float3>(triangle_count);
+        // Vertex to triangle adjacency & the number of triangles not yet emitted per vertex.
+        auto* adjacency_counts = Memory::AllocateClear<uint32_t>(ctx->countVertex);
+        auto* adjacency_offsets = Memory::Allocate<uint32_t>(ctx->countVertex);
+        auto* adjacency_live = Memory::Allocate<uint32_t>(ctx->countVertex);
+        auto* adjacency = Memory::Allocate<uint32_t>(ctx->countIndex);
+
+        memset(used, -1, ctx->countVertex);
+
+        auto total_area = 0.0f;
+
+        for (auto i = 0u; i < triangle_count; ++i)
+        {
+            const auto& a = ctx->pVertices[ctx->pIndices[i * 3u + 0u]].in_POSITION;
+            const auto& b = ctx->pVertices[ctx->pIndices[i * 3u + 1u]].in_POSITION;
+            const auto& c = ctx->pVertices[ctx->pIndices[i * 3u + 2u]].in_POSITION;
+            const auto normal = math::cross(b - a, c - a);
+            const auto area = math::length(normal);
+            centroids[i] = (a + b + c) / 3.0f;
+            normals[i] = area > 0.0f ? normal / area : PK_FLOAT3_ZERO;
+            total_area += area * 0.5f;
+        }
+
+        for (auto i = 0u; i < ctx->countIndex; ++i)
+        {
+            assert(ctx->pIndices[i] < ctx->countVertex);
+            adjacency_counts[ctx->pIndices[i]]++;
+        }
+
+        for (auto i = 0u, offset = 0u; i < ctx->countVertex; ++i)
+        {
+            adjacency_offsets[i] = offset;
+            adjacency_live[i] = 0u;
+            offset += adjacency_counts[i];
+        }
+
+        // Live counts act as the fill cursor & end up equal to the adjacency counts.
+        for (auto i = 0u; i < ctx->countIndex; ++i)
+        {
+            const auto vertex = ctx->pIndices[i];
+            adjacency[adjacency_offsets[vertex] + adjacency_live[vertex]++] = i / 3u;
+        }
+
+        KDTree tree(centroids, triangle_count);
+
+        // Radius of a disc covering a full meshlet worth of average sized triangles.
+        // Used to make the compactness score independent of mesh scale.
+        const auto expected_radius = math::max(1e-6f, sqrtf(total_area * max_triangles / (triangle_count * PK_FLOAT_PI)));
+
+        MeshletIndexInfo meshlet = {};
+        auto meshlet_center_sum = PK_FLOAT3_ZERO;
+        auto meshlet_normal_sum = PK_FLOAT3_ZERO;
+        auto seed_point = ctx->aabb.min;
+        auto emitted_count = 0u;
+
+        auto get_extra_vertices = [used, ctx](uint32_t triangle)
+        {
+            return (uint32_t)(used[ctx->pIndices[triangle * 3u + 0u]] == 0xff) +
+                   (uint32_t)(used[ctx->pIndices[triangle * 3u + 1u]] == 0xff) +
+                   (uint32_t)(used[ctx->pIndices[triangle * 3u + 2u]] == 0xff);
+        };
+
+        auto flush_meshlet = [&]()
+        {
+            PackMeshlet(ctx, &output.meshlets[output.meshlet_count++], meshlet, meshlet_vertices, meshlet_indices, &output.metrics);
+
+            for (auto i = 0u; i < meshlet.vertex_count; ++i)
+            {
+                used[meshlet_vertices[meshlet.vertex_offset + i]] = 0xff;
+            }
+
+            seed_point = meshlet_center_sum / (float)meshlet.triangle_count;
+            meshlet.vertex_offset += meshlet.vertex_count;
+            meshlet.triangle_offset += meshlet.triangle_count * 3;
+            meshlet.vertex_count = 0;
+            meshlet.triangle_count = 0;
+            meshlet_center_sum = PK_FLOAT3_ZERO;
+            meshlet_normal_sum = PK_FLOAT3_ZERO;
+        };
+
+        while (emitted_count < triangle_count)
+        {
+            auto best_triangle = ~0u;
+
+            // Grow along triangles that share a vertex with the current meshlet.
+            if (meshlet.triangle_count > 0u)
+            {
+                const auto meshlet_center = meshlet_center_sum / (float)meshlet.triangle_count;
+                const auto meshlet_axis = math::safenormalize(meshlet_normal_sum);
+                auto best_score = FLT_MAX;
+
+                for (auto i = 0u; i < meshlet.vertex_count; ++i)
+                {
+                    const auto vertex = meshlet_vertices[meshlet.vertex_offset + i];
+
+                    if (adjacency_live[vertex] == 0u)
+                    {
+                        continue;
+                    }
+
+                    const auto* neighbours = adjacency + adjacency_offsets[vertex];
+
+                    for (auto j = 0u; j < adjacency_counts[vertex]; ++j)
+                    {
+                        const auto triangle = neighbours[j];
+                        const auto extra = get_extra_vertices(triangle);
+
+                        if (emitted[triangle] || meshlet.vertex_count + extra > max_vertices)
+                        {
+                            continue;
+                        }
+
+                        // Prefer triangles that add no vertices, stay close to the meshlet center & align with its average normal.
+                        // Triangles whose vertices have few remaining neighbours are favored to avoid leaving isolated triangles behind.
+                        const auto live = adjacency_live[ctx->pIndices[triangle * 3u + 0u]] + 
+                                          adjacency_live[ctx->pIndices[triangle * 3u + 1u]] + 
+                                          adjacency_live[ctx->pIndices[triangle * 3u + 2u]];
+                        const auto spread = math::distance(centroids[triangle], meshlet_center) / expected_radius;
+                        const auto cone = 1.0f - math::dot(normals[triangle], meshlet_axis);
+                        const auto score = (1.0f + extra) * (1.0f + spread * (1.0f - cone_weight) + cone * cone_weight) * (1.0f + live * 0.01f);
+
+                        if (score < best_score)
+                        {
+                            best_score = score;
+                            best_triangle = triangle;
+                        }
+                    }
+                }
+            }
+
+            // No connected triangles left. Continue from the closest remaining triangle.
+            if (best_triangle == ~0u)
+            {
+                const auto point = meshlet.triangle_count > 0u ? meshlet_center_sum / (float)meshlet.triangle_count : seed_point;
+                best_triangle = tree.FindNearest(point, emitted);
+                assert(best_triangle != ~0u);
+
+                if (meshlet.triangle_count > 0u && meshlet.vertex_count + get_extra_vertices(best_triangle) > max_vertices)
+                {
+                    flush_meshlet();
+                    continue;
+                }
+            }
+
+            for (auto i = 0u; i < 3u; ++i)
+            {
+                const auto vertex = ctx->pIndices[best_triangle * 3u + i];
+
+                if (used[vertex] == 0xff)
+                {
+                    used[vertex] = (uint8_t)meshlet.vertex_count;
+                    PackVertex(ctx, &output.vertices[meshlet.vertex_offset + meshlet.vertex_count], vertex);
+                    meshlet_vertices[meshlet.vertex_offset + meshlet.vertex_count++] = vertex;
+                }
+
+                meshlet_indices[meshlet.triangle_offset + meshlet.triangle_count * 3 + i] = used[vertex];
+                adjacency_live[vertex]--;
+            }
+
+            emitted[best_triangle] = 1u;
+            emitted_count++;
+            meshlet.triangle_count++;
+            meshlet_center_sum += centroids[best_triangle];
+            meshlet_normal_sum += normals[best_triangle];
+
+            if (meshlet.triangle_count >= max_triangles)
+            {
+                flush_meshlet();
+            }
         }
 
         if (meshlet.triangle_count)
         {
-            pack_meshlet(ctx, &output.meshlets[output.meshlet_count++], meshlet, meshlet_vertices, meshlet_indices);
+            flush_meshlet();
+        }
+
+        // Align triangles array size to 4bytes
+        output.index_count = 12u * ((meshlet.triangle_offset + 11u) / 12u);
+        output.vertex_count = meshlet.vertex_offset;
+        output.submesh.firstMeshlet = 0u;
+        output.submesh.meshletCount = output.meshlet_count;
+        ResolveMetrics(&output.metrics, output.meshlet_count);
+
+        if (outMeshletVertices)
+        {
+            *outMeshletVertices = meshlet_vertices;
+            meshlet_vertices = nullptr;
+        }
+
+        Memory::Free(meshlet_vertices);
+        Memory::Free(used);
+        Memory::Free(emitted);
+        Memory::Free(centroids);
+        Memory::Free(normals);
+        Memory::Free(adjacency_counts);
+        Memory::Free(adjacency_offsets);
+        Memory::Free(adjacency_live);
+        Memory::Free(adjacency);
+
+        return output;
+    }
+
+    namespace MeshletBuilder
+    {
+        static void* AllocateMeshlets(uint32_t submeshCount, uint32_t meshletCount, uint32_t vertexCount, uint32_t triangleCount, uint32_t groupCount, uint32_t groupIndexCount, MeshletsDescriptor* outMeshlets)
+        {
+            size_t size = 0ull;
+            const auto offsetHierarchies = Memory::AlignSize<PKAssets::PKMeshletHierarchy>(size);
+            size = offsetHierarchies + sizeof(PKAssets::PKMeshletHierarchy) * submeshCount;
+            const auto offsetGroups = Memory::AlignSize<PKAssets::PKMeshletGroup>(size);
+            size = offsetGroups + sizeof(PKAssets::PKMeshletGroup) * groupCount;
+            const auto offsetGroupIndices = Memory::AlignSize<uint32_t>(size);
+            size = offsetGroupIndices + sizeof(uint32_t) * groupIndexCount;
+            const auto offsetSubmeshes = Memory::AlignSize<PKAssets::PKMeshletSubmesh>(size);
+            size = offsetSubmeshes + sizeof(PKAssets::PKMeshletSubmesh) * submeshCount;
+            const auto offsetMeshlets = Memory::AlignSize<PKAssets::PKMeshlet>(size);
+            size = offsetMeshlets + sizeof(PKAssets::PKMeshlet) * meshletCount;
+            const auto offsetVertices = Memory::AlignSize<PKAssets::PKMeshletVertex>(size);
+            size = offsetVertices + sizeof(PKAssets::PKMeshletVertex) * vertexCount;
+            const auto offsetIndices = Memory::AlignSize<uint32_t>(size);
+            size = offsetIndices + sizeof(uint8_t) * triangleCount * 3ull;
+
+            auto buffer = Memory::AllocateClear<uint8_t>(size);
+            *outMeshlets = {};
+            outMeshlets->pSubmeshes = Memory::CastOffsetPtr<PKAssets::PKMeshletSubmesh>(buffer, offsetSubmeshes);
+            outMeshlets->pMeshlets = Memory::CastOffsetPtr<PKAssets::PKMeshlet>(buffer, offsetMeshlets);
+            outMeshlets->pVertices = Memory::CastOffsetPtr<PKAssets::PKMeshletVertex>(buffer, offsetVertices);
+            outMeshlets->pIndices = Memory::CastOffsetPtr<uint8_t>(buffer, offsetIndices);
+            outMeshlets->pHierarchies = Memory::CastOffsetPtr<PKAssets::PKMeshletHierarchy>(buffer, offsetHierarchies);
+            outMeshlets->pGroups = Memory::CastOffsetPtr<PKAssets::PKMeshletGroup>(buffer, offsetGroups);
+            outMeshlets->pGroupIndices = Memory::CastOffsetPtr<uint32_t>(buffer, offsetGroupIndices);
+            return buffer;
+        }
+
+        // Triangle counts of sources are aligned to 4. Rebased triangle offsets keep the alignment.
+        // Sources without a hierarchy append empty hierarchy entries.
+        static void AppendMeshlets(MeshletsDescriptor* dst, const MeshletsDescriptor& src)
+        {
+            for (auto i = 0u; i < src.submeshCount; ++i)
+            {
+                auto submesh = src.pSubmeshes[i];
+                submesh.firstMeshlet += dst->meshletCount;
+                dst->pSubmeshes[dst->submeshCount + i] = submesh;
+
+                auto hierarchy = src.pHierarchies ? src.pHierarchies[i] : PKAssets::PKMeshletHierarchy{};
+                hierarchy.groupFirst += dst->groupCount;
+                hierarchy.rootFirst += dst->groupIndexCount;
+                dst->pHierarchies[dst->submeshCount + i] = hierarchy;
+            }
+
+            for (auto i = 0u; i < src.groupCount; ++i)
+            {
+                auto group = src.pGroups[i];
+                group.childFirst += dst->groupIndexCount;
+                dst->pGroups[dst->groupCount + i] = group;
+            }
+
+            Memory::Memcpy(dst->pGroupIndices + dst->groupIndexCount, src.pGroupIndices, src.groupIndexCount);
+            dst->groupCount += src.groupCount;
+            dst->groupIndexCount += src.groupIndexCount;
+
+            for (auto i = 0u; i < src.meshletCount; ++i)
+            {
+                auto meshlet = src.pMeshlets[i];
+                meshlet.vertexFirst += dst->vertexCount;
+                meshlet.triangleFirst += dst->triangleCount;
+                dst->pMeshlets[dst->meshletCount + i] = meshlet;
+            }
+
+            memcpy(dst->pVertices + dst->vertexCount, src.pVertices, sizeof(PKAssets::PKMeshletVertex) * src.vertexCount);
+            memcpy(dst->pIndices + dst->triangleCount * 3ull, src.pIndices, src.triangleCount * 3ull);
+            dst->submeshCount += src.submeshCount;
+            dst->meshletCount += src.meshletCount;
+            dst->vertexCount += src.vertexCount;
+            dst->triangleCount += src.triangleCount;
+        }
+    }
+
+    void* BuildMeshletsSpatial(GeometryContext* ctx, const SubMesh* submeshes, uint32_t submeshCount, MeshletsDescriptor* outMeshlets)
+    {
+        using namespace MeshletBuilder;
+
+        auto maxMeshletCount = 0u;
+        auto maxTriangleCount = 0u;
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            GeometryContext submeshCtx = *ctx;
+            submeshCtx.countIndex = submeshes[i].indexCount;
+            const auto meshletCount = GetMaxMeshletCount(&submeshCtx);
+            maxMeshletCount += meshletCount;
+            // Padding for 4 triangle alignment.
+            maxTriangleCount += meshletCount * PKAssets::PK_MESHLET_MAX_TRIANGLES + 4u;
+        }
+
+        auto buffer = AllocateMeshlets(submeshCount, maxMeshletCount, maxMeshletCount * PKAssets::PK_MESHLET_MAX_VERTICES, maxTriangleCount, 0u, 0u, outMeshlets);
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            // Submesh indices are absolute. Vertex quantization uses the submesh bounds.
+            GeometryContext submeshCtx = *ctx;
+            submeshCtx.pIndices = ctx->pIndices + submeshes[i].indexFirst;
+            submeshCtx.countIndex = submeshes[i].indexCount;
+            submeshCtx.aabb = submeshes[i].bounds;
+
+            auto meshlets = BuildMeshletsSpatial(&submeshCtx);
+
+            MeshletsDescriptor source{};
+            source.pSubmeshes = &meshlets.submesh;
+            source.submeshCount = 1u;
+            source.pMeshlets = meshlets.meshlets;
+            source.meshletCount = meshlets.meshlet_count;
+            source.pVertices = meshlets.vertices;
+            source.vertexCount = meshlets.vertex_count;
+            source.pIndices = meshlets.indices;
+            source.triangleCount = meshlets.index_count / 3u;
+            AppendMeshlets(outMeshlets, source);
+        }
+
+        return buffer;
+    }
+
+    void* MergeMeshlets(const MeshletsDescriptor* sources, uint32_t sourceCount, MeshletsDescriptor* outMeshlets)
+    {
+        using namespace MeshletBuilder;
+
+        auto submeshCount = 0u;
+        auto meshletCount = 0u;
+        auto vertexCount = 0u;
+        auto triangleCount = 0u;
+        auto groupCount = 0u;
+        auto groupIndexCount = 0u;
+
+        for (auto i = 0u; i < sourceCount; ++i)
+        {
+            submeshCount += sources[i].submeshCount;
+            meshletCount += sources[i].meshletCount;
+            vertexCount += sources[i].vertexCount;
+            triangleCount += sources[i].triangleCount;
+            groupCount += sources[i].groupCount;
+            groupIndexCount += sources[i].groupIndexCount;
+        }
+
+        auto buffer = AllocateMeshlets(submeshCount, meshletCount, vertexCount, triangleCount, groupCount, groupIndexCount, outMeshlets);
+
+        for (auto i = 0u; i < sourceCount; ++i)
+        {
+            AppendMeshlets(outMeshlets, sources[i]);
+        }
+
+        return buffer;
+    }
+
+    namespace MeshletBuilder
+    {
+        constexpr static const uint32_t HIERARCHY_GROUP_SIZE = 4u;
+        constexpr static const uint32_t HIERARCHY_MAX_LEVELS = 16u;
+        // Groups that do not reduce the triangle count by at least this much are carried over to the next level.
+        constexpr static const float HIERARCHY_MIN_REDUCTION = 0.85f;
+        // Max simplification error per group relative to the group bounds radius.
+        constexpr static const float HIERARCHY_MAX_ERROR = 0.5f;
+
+        struct HierarchyCluster
+        {
+            uint32_t indexFirst;
+            uint32_t indexCount;
+            // Lod sphere & error of the cluster & of the group that consumed it.
+            float4 current;
+            float4 parent;
+            // Group indices. ~0u for source clusters & clusters that were not consumed.
+            uint32_t producer;
+            uint32_t consumer;
+            uint32_t sortKey;
+        };
+
+        struct HierarchyContext
+        {
+            GeometryContext* ctx = nullptr;
+            HierarchyCluster* clusters = nullptr;
+            uint32_t clusterCount = 0u;
+            uint32_t clusterCapacity = 0u;
+            // Global vertex indices of cluster triangles.
+            uint32_t* indices = nullptr;
+            uint32_t indexCount = 0u;
+            uint32_t indexCapacity = 0u;
+            float4* groups = nullptr;
+            uint32_t groupCount = 0u;
+            uint32_t groupCapacity = 0u;
+            // Global to group local vertex remap. Reset after each group.
+            uint32_t* remap = nullptr;
+        };
+
+        template<typename T>
+        static void ReserveItems(T** items, uint32_t* capacity, uint32_t count, uint32_t required)
+        {
+            if (required > *capacity)
+            {
+                const auto newCapacity = math::max(required, *capacity * 2u);
+                auto newItems = Memory::Allocate<T>(newCapacity);
+
+                if (*items)
+                {
+                    Memory::Memcpy(newItems, *items, count);
+                    Memory::Free(*items);
+                }
+
+                *items = newItems;
+                *capacity = newCapacity;
+            }
+        }
+
+        static uint32_t ExpandBits10(uint32_t v)
+        {
+            v &= 0x3FFu;
+            v = (v | (v << 16u)) & 0x030000FFu;
+            v = (v | (v << 8u)) & 0x0300F00Fu;
+            v = (v | (v << 4u)) & 0x030C30C3u;
+            v = (v | (v << 2u)) & 0x09249249u;
+            return v;
+        }
+
+        static uint32_t GetMortonCode(const float3& position, const AABB<float3>& aabb)
+        {
+            const auto size = math::max(aabb.max - aabb.min, float3(1e-6f));
+            const auto uvw = math::clamp((position - aabb.min) / size, PK_FLOAT3_ZERO, PK_FLOAT3_ONE) * 1023.0f;
+            return ExpandBits10((uint32_t)uvw.x) | (ExpandBits10((uint32_t)uvw.y) << 1u) | (ExpandBits10((uint32_t)uvw.z) << 2u);
+        }
+
+        // Lod spheres are stored as halfs. Centers are rounded & errors rounded up so that parent spheres keep enclosing their children.
+        static float QuantizeError(float error)
+        {
+            error = math::min(error, PKAssets::PK_MESHLET_LOD_MAX_ERROR);
+            auto half = math::f32tof16(error);
+            half += math::f16tof32(half) < error ? 1u : 0u;
+            return math::f16tof32(half);
+        }
+
+        static float3 QuantizeCenter(const float3& center)
+        {
+            return float3(math::f16tof32(math::f32tof16(center.x)), math::f16tof32(math::f32tof16(center.y)), math::f16tof32(math::f32tof16(center.z)));
+        }
+
+        static uint32_t AddCluster(HierarchyContext* hctx, const uint32_t* indices, uint32_t indexCount, const float4& current, uint32_t producer)
+        {
+            ReserveItems(&hctx->clusters, &hctx->clusterCapacity, hctx->clusterCount, hctx->clusterCount + 1u);
+            ReserveItems(&hctx->indices, &hctx->indexCapacity, hctx->indexCount, hctx->indexCount + indexCount);
+
+            auto& cluster = hctx->clusters[hctx->clusterCount];
+            cluster.indexFirst = hctx->indexCount;
+            cluster.indexCount = indexCount;
+            cluster.current = current;
+            cluster.parent = float4(current.xyz, PKAssets::PK_MESHLET_LOD_MAX_ERROR);
+            cluster.producer = producer;
+            cluster.consumer = ~0u;
+            cluster.sortKey = 0u;
+            Memory::Memcpy(hctx->indices + hctx->indexCount, indices, indexCount);
+            hctx->indexCount += indexCount;
+            return hctx->clusterCount++;
+        }
+
+        // Simplifies the clusters as one mesh with locked group borders & re-splits the result.
+        // Returns false if the group could not be reduced. Produced cluster indices are written to outClusters.
+        static bool SimplifyClusterGroup(HierarchyContext* hctx, const uint32_t* group, uint32_t groupSize, uint32_t* outClusters, uint32_t* outClusterCount)
+        {
+            constexpr auto maxVertices = HIERARCHY_GROUP_SIZE * PKAssets::PK_MESHLET_MAX_VERTICES;
+            constexpr auto maxIndices = HIERARCHY_GROUP_SIZE * PKAssets::PK_MESHLET_MAX_TRIANGLES * 3u;
+            constexpr auto attributeCount = 5u;
+            const float attributeWeights[attributeCount] =
+            {
+                MeshSimplifier::LOD_NORMAL_WEIGHT,
+                MeshSimplifier::LOD_NORMAL_WEIGHT,
+                MeshSimplifier::LOD_NORMAL_WEIGHT,
+                MeshSimplifier::LOD_TEXCOORD_WEIGHT,
+                MeshSimplifier::LOD_TEXCOORD_WEIGHT
+            };
+
+            VertexDefault localVertices[maxVertices];
+            float localAttributes[maxVertices * attributeCount];
+            uint32_t localToGlobal[maxVertices];
+            uint32_t localIndices[maxIndices];
+            uint32_t simplifiedIndices[maxIndices];
+            auto localVertexCount = 0u;
+            auto localIndexCount = 0u;
+            auto childErrorMax = 0.0f;
+
+            for (auto i = 0u; i < groupSize; ++i)
+            {
+                const auto& cluster = hctx->clusters[group[i]];
+                childErrorMax = math::max(childErrorMax, cluster.current.w);
+
+                for (auto j = 0u; j < cluster.indexCount; ++j)
+                {
+                    const auto vertex = hctx->indices[cluster.indexFirst + j];
+
+                    if (hctx->remap[vertex] == ~0u)
+                    {
+                        hctx->remap[vertex] = localVertexCount;
+                        localToGlobal[localVertexCount++] = vertex;
+                    }
+
+                    localIndices[localIndexCount++] = hctx->remap[vertex];
+                }
+            }
+
+            auto bounds = PK_FLOAT3_MIN_AABB;
+
+            for (auto i = 0u; i < localVertexCount; ++i)
+            {
+                const auto& vertex = hctx->ctx->pVertices[localToGlobal[i]];
+                localVertices[i] = vertex;
+                memcpy(localAttributes + i * attributeCount, &vertex.in_NORMAL.x, sizeof(float3));
+                memcpy(localAttributes + i * attributeCount + 3u, &vertex.in_TEXCOORD0.x, sizeof(float2));
+                bounds |= vertex.in_POSITION;
+                hctx->remap[localToGlobal[i]] = ~0u;
+            }
+
+            auto error = 0.0f;
+            const auto targetCount = (localIndexCount / 6u) * 3u;
+            const auto simplifiedCount = SimplifyMesh(simplifiedIndices,
+                localIndices,
+                localIndexCount,
+                &localVertices[0].in_POSITION.x,
+                sizeof(VertexDefault),
+                localVertexCount,
+                localAttributes,
+                sizeof(float) * attributeCount,
+                attributeWeights,
+                attributeCount,
+                targetCount,
+                HIERARCHY_MAX_ERROR,
+                &error);
+
+            if (simplifiedCount == 0u || simplifiedCount > (uint32_t)(localIndexCount * HIERARCHY_MIN_REDUCTION))
+            {
+                return false;
+            }
+
+            GeometryContext localCtx{};
+            localCtx.pVertices = localVertices;
+            localCtx.pIndices = simplifiedIndices;
+            localCtx.countVertex = localVertexCount;
+            localCtx.countIndex = simplifiedCount;
+            localCtx.aabb = hctx->ctx->aabb;
+
+            uint32_t* meshletVertices = nullptr;
+            auto meshlets = BuildMeshletsSpatial(&localCtx, &meshletVertices);
+
+            if (meshlets.meshlet_count >= groupSize)
+            {
+                Memory::Free(meshletVertices);
+                return false;
+            }
+
+            // Group sphere encloses the spheres of the consumed clusters so that projected errors are monotonic along the hierarchy.
+            const auto center = QuantizeCenter(bounds.center());
+            auto groupError = error * math::length(bounds.extents()) + childErrorMax;
+
+            for (auto i = 0u; i < groupSize; ++i)
+            {
+                const auto& current = hctx->clusters[group[i]].current;
+                groupError = math::max(groupError, current.w + math::length(current.xyz - center));
+            }
+
+            const auto sphere = float4(center, QuantizeError(groupError));
+            const auto groupIndex = hctx->groupCount;
+            ReserveItems(&hctx->groups, &hctx->groupCapacity, hctx->groupCount, hctx->groupCount + 1u);
+            hctx->groups[hctx->groupCount++] = sphere;
+
+            for (auto i = 0u; i < groupSize; ++i)
+            {
+                hctx->clusters[group[i]].parent = sphere;
+                hctx->clusters[group[i]].consumer = groupIndex;
+            }
+
+            for (auto i = 0u; i < meshlets.meshlet_count; ++i)
+            {
+                const auto& meshlet = meshlets.meshlets[i];
+                uint32_t clusterIndices[PKAssets::PK_MESHLET_MAX_TRIANGLES * 3u];
+
+                for (auto j = 0u; j < meshlet.triangleCount * 3u; ++j)
+                {
+                    clusterIndices[j] = localToGlobal[meshletVertices[meshlet.vertexFirst + meshlets.indices[meshlet.triangleFirst * 3u + j]]];
+                }
+
+                outClusters[(*outClusterCount)++] = AddCluster(hctx, clusterIndices, meshlet.triangleCount * 3u, sphere, groupIndex);
+            }
+
+            Memory::Free(meshletVertices);
+            return true;
+        }
+
+        static void PackCluster(GeometryContext* ctx, const HierarchyCluster& cluster, const uint32_t* indices, uint32_t* remap, uint32_t* meshletVertices, MeshletsDescriptor* out, MeshletMetrics* metrics)
+        {
+            MeshletIndexInfo info{ out->vertexCount, out->triangleCount * 3u, 0u, cluster.indexCount / 3u };
+
+            for (auto i = 0u; i < cluster.indexCount; ++i)
+            {
+                const auto vertex = indices[cluster.indexFirst + i];
+
+                if (remap[vertex] == ~0u)
+                {
+                    remap[vertex] = info.vertex_count;
+                    meshletVertices[info.vertex_offset + info.vertex_count] = vertex;
+                    PackVertex(ctx, &out->pVertices[info.vertex_offset + info.vertex_count], vertex);
+                    info.vertex_count++;
+                }
+
+                out->pIndices[info.triangle_offset + i] = (uint8_t)remap[vertex];
+            }
+
+            for (auto i = 0u; i < info.vertex_count; ++i)
+            {
+                remap[meshletVertices[info.vertex_offset + i]] = ~0u;
+            }
+
+            auto& meshlet = out->pMeshlets[out->meshletCount++];
+            PackMeshlet(ctx, &meshlet, info, meshletVertices, out->pIndices, metrics);
+
+            for (auto i = 0u; i < 4u; ++i)
+            {
+                meshlet.lodCenterErrorCurrent[i] = math::f32tof16(cluster.current[i]);
+                meshlet.lodCenterErrorParent[i] = math::f32tof16(cluster.parent[i]);
+            }
+
+            out->vertexCount += info.vertex_count;
+            out->triangleCount += info.triangle_count;
         }
 
-        // Align triangles array size to 4bytes
-        output.index_count = 12u * ((meshlet.triangle_offset + meshlet.triangle_count * 3u + 11u) / 12u);
-        output.vertex_count = meshlet.vertex_offset + meshlet.vertex_count;
-        output.submesh.firstMeshlet = 0u;
-        output.submesh.meshletCount = output.meshlet_count;
+        static void* BuildSubmeshHierarchy(GeometryContext* ctx, const SubMesh& submesh, const char* name, uint32_t submeshIndex, MeshletsDescriptor* outMeshlets)
+        {
+            GeometryContext submeshCtx = *ctx;
+            submeshCtx.pIndices = ctx->pIndices + submesh.indexFirst;
+            submeshCtx.countIndex = submesh.indexCount;
+            submeshCtx.aabb = submesh.bounds;
 
-        Memory::Free(meshlet_vertices);
-        Memory::Free(used);
+            HierarchyContext hctx{};
+            hctx.ctx = &submeshCtx;
+            hctx.remap = Memory::Allocate<uint32_t>(ctx->countVertex);
+            Memory::Memset(hctx.remap, 0xFF, ctx->countVertex);
 
-        return output;
+            // Source clusters. Meshlet vertices are global vertex indices as the submesh context shares the vertex buffer.
+            {
+                uint32_t* sourceVertices = nullptr;
+                auto source = BuildMeshletsSpatial(&submeshCtx, &sourceVertices);
+                uint32_t clusterIndices[PKAssets::PK_MESHLET_MAX_TRIANGLES * 3u];
+
+                for (auto i = 0u; i < source.meshlet_count; ++i)
+                {
+                    const auto& meshlet = source.meshlets[i];
+                    auto bounds = PK_FLOAT3_MIN_AABB;
+
+                    for (auto j = 0u; j < meshlet.triangleCount * 3u; ++j)
+                    {
+                        clusterIndices[j] = sourceVertices[meshlet.vertexFirst + source.indices[meshlet.triangleFirst * 3u + j]];
+                        bounds |= ctx->pVertices[clusterIndices[j]].in_POSITION;
+                    }
+
+                    AddCluster(&hctx, clusterIndices, meshlet.triangleCount * 3u, float4(QuantizeCenter(bounds.center()), 0.0f), ~0u);
+                }
+
+                Memory::Free(sourceVertices);
+            }
+
+            const auto sourceClusterCount = hctx.clusterCount;
+            auto pending = Memory::Allocate<uint32_t>(sourceClusterCount);
+            auto next = Memory::Allocate<uint32_t>(sourceClusterCount);
+            auto pendingCount = sourceClusterCount;
+            auto levelCount = 0u;
+
+            for (auto i = 0u; i < pendingCount; ++i)
+            {
+                pending[i] = i;
+            }
+
+            // Clusters are grouped along a morton curve. Groups that fail to reduce are carried over & regrouped on the next level.
+            while (levelCount < HIERARCHY_MAX_LEVELS && pendingCount > 1u)
+            {
+                for (auto i = 0u; i < pendingCount; ++i)
+                {
+                    auto& cluster = hctx.clusters[pending[i]];
+                    cluster.sortKey = GetMortonCode(cluster.current.xyz, submeshCtx.aabb);
+                }
+
+                const auto clusters = hctx.clusters;
+                IntroSort(pending, pending + pendingCount, [clusters](const uint32_t& a, const uint32_t& b) { return clusters[a].sortKey < clusters[b].sortKey; });
+
+                auto nextCount = 0u;
+                auto progressed = false;
+
+                for (auto first = 0u; first < pendingCount; first += HIERARCHY_GROUP_SIZE)
+                {
+                    const auto groupSize = math::min(HIERARCHY_GROUP_SIZE, pendingCount - first);
+
+                    if (groupSize >= 2u && SimplifyClusterGroup(&hctx, pending + first, groupSize, next, &nextCount))
+                    {
+                        progressed = true;
+                        continue;
+                    }
+
+                    Memory::Memcpy(next + nextCount, pending + first, groupSize);
+                    nextCount += groupSize;
+                }
+
+                auto swap = pending;
+                pending = next;
+                next = swap;
+                pendingCount = nextCount;
+
+                if (!progressed)
+                {
+                    break;
+                }
+
+                levelCount++;
+            }
+
+            // Source clusters are owned by leaf groups. One per consumer & one for clusters that were never consumed.
+            // Leaf groups are placed before the simplified groups.
+            const auto realGroupCount = hctx.groupCount;
+            auto leafIndices = Memory::Allocate<uint32_t>(realGroupCount + 1u);
+            auto owners = Memory::Allocate<uint32_t>(hctx.clusterCount);
+            auto leafCount = 0u;
+            Memory::Memset(leafIndices, 0xFF, realGroupCount + 1u);
+
+            for (auto i = 0u; i < sourceClusterCount; ++i)
+            {
+                const auto consumer = hctx.clusters[i].consumer;
+                const auto key = consumer == ~0u ? realGroupCount : consumer;
+                leafIndices[key] = leafIndices[key] == ~0u ? leafCount++ : leafIndices[key];
+                owners[i] = leafIndices[key];
+            }
+
+            for (auto i = sourceClusterCount; i < hctx.clusterCount; ++i)
+            {
+                owners[i] = leafCount + hctx.clusters[i].producer;
+            }
+
+            const auto groupCount = leafCount + realGroupCount;
+            const auto meshletCount = hctx.clusterCount;
+            auto triangleCount = 0u;
+
+            for (auto i = 0u; i < meshletCount; ++i)
+            {
+                triangleCount += hctx.clusters[i].indexCount / 3u;
+            }
+
+            // Each cluster is referenced at most once as a child or a root.
+            auto buffer = AllocateMeshlets(1u, meshletCount, meshletCount * PKAssets::PK_MESHLET_MAX_VERTICES, triangleCount + 4u, groupCount, meshletCount, outMeshlets);
+            auto groups = outMeshlets->pGroups;
+            auto groupIndices = outMeshlets->pGroupIndices;
+            auto order = Memory::Allocate<uint32_t>(meshletCount);
+            auto offsets = Memory::AllocateClear<uint32_t>(groupCount + 1u);
+
+            // Counting sort clusters by owner so that each group references a contiguous meshlet range.
+            for (auto i = 0u; i < meshletCount; ++i)
+            {
+                offsets[owners[i] + 1u]++;
+            }
+
+            for (auto i = 0u; i < groupCount; ++i)
+            {
+                offsets[i + 1u] += offsets[i];
+                groups[i].meshletFirst = offsets[i];
+                groups[i].meshletCount = offsets[i + 1u] - offsets[i];
+                groups[i].childFirst = 0u;
+                groups[i].childCount = 0u;
+            }
+
+            for (auto i = 0u; i < meshletCount; ++i)
+            {
+                order[offsets[owners[i]]++] = i;
+            }
+
+            for (auto i = 0u; i < groupCount; ++i)
+            {
+                const auto sphere = i < leafCount ? float4(hctx.clusters[order[groups[i].meshletFirst]].current.xyz, 0.0f) : hctx.groups[i - leafCount];
+                memcpy(groups[i].lodCenterError, &sphere.x, sizeof(float4));
+            }
+
+            // Children are the distinct owners of consumed clusters. Roots are the distinct owners of clusters that were never consumed.
+            {
+                auto lastParent = Memory::Allocate<uint32_t>(groupCount);
+                auto consumed = Memory::Allocate<uint32_t>(meshletCount);
+                auto consumedOffsets = Memory::AllocateClear<uint32_t>(realGroupCount + 2u);
+                Memory::Memset(lastParent, 0xFF, groupCount);
+
+                for (auto i = 0u; i < meshletCount; ++i)
+                {
+                    const auto consumer = hctx.clusters[i].consumer;
+                    consumedOffsets[(consumer == ~0u ? realGroupCount : consumer) + 1u]++;
+                }
+
+                for (auto i = 0u; i <= realGroupCount; ++i)
+                {
+                    consumedOffsets[i + 1u] += consumedOffsets[i];
+                }
+
+                for (auto i = 0u; i < meshletCount; ++i)
+                {
+                    const auto consumer = hctx.clusters[i].consumer;
+                    consumed[consumedOffsets[consumer == ~0u ? realGroupCount : consumer]++] = i;
+                }
+
+                auto consumedFirst = 0u;
+
+                for (auto i = 0u; i <= realGroupCount; ++i)
+                {
+                    const auto indexFirst = outMeshlets->groupIndexCount;
+
+                    for (auto j = consumedFirst; j < consumedOffsets[i]; ++j)
+                    {
+                        const auto owner = owners[consumed[j]];
+
+                        if (lastParent[owner] != i)
+                        {
+                            lastParent[owner] = i;
+                            groupIndices[outMeshlets->groupIndexCount++] = owner;
+                        }
+                    }
+
+                    if (i < realGroupCount)
+                    {
+                        groups[leafCount + i].childFirst = indexFirst;
+                        groups[leafCount + i].childCount = outMeshlets->groupIndexCount - indexFirst;
+                    }
+                    else
+                    {
+                        outMeshlets->pHierarchies[0].rootFirst = indexFirst;
+                        outMeshlets->pHierarchies[0].rootCount = outMeshlets->groupIndexCount - indexFirst;
+                    }
+
+                    consumedFirst = consumedOffsets[i];
+                }
+
+                Memory::Free(lastParent);
+                Memory::Free(consumed);
+                Memory::Free(consumedOffsets);
+            }
+
+            MeshletMetrics metrics{};
+            auto meshletVertices = Memory::Allocate<uint32_t>(meshletCount * PKAssets::PK_MESHLET_MAX_VERTICES);
+
+            for (auto i = 0u; i < meshletCount; ++i)
+            {
+                PackCluster(&submeshCtx, hctx.clusters[order[i]], hctx.indices, hctx.remap, meshletVertices, outMeshlets, &metrics);
+            }
+
+            // Align triangles array size to 4bytes
+            outMeshlets->triangleCount = 4u * ((outMeshlets->triangleCount + 3u) / 4u);
+            outMeshlets->groupCount = groupCount;
+            outMeshlets->submeshCount = 1u;
+            outMeshlets->pHierarchies[0].groupFirst = 0u;
+            outMeshlets->pHierarchies[0].groupCount = groupCount;
+            memcpy(outMeshlets->pSubmeshes[0].bbmin, &submeshCtx.aabb.min.x, sizeof(float3));
+            memcpy(outMeshlets->pSubmeshes[0].bbmax, &submeshCtx.aabb.max.x, sizeof(float3));
+            outMeshlets->pSubmeshes[0].firstMeshlet = 0u;
+            outMeshlets->pSubmeshes[0].meshletCount = meshletCount;
+            ResolveMetrics(&metrics, meshletCount);
+
+            PK_LOG_INFO("Mesh '%s' submesh %u: meshlet hierarchy levels: %u, groups: %u, roots: %u, meshlets: %u -> %u", 
+                name, 
+                submeshIndex, 
+                levelCount, 
+                groupCount, 
+                outMeshlets->pHierarchies[0].rootCount, 
+                sourceClusterCount, 
+                meshletCount);
+
+            Memory::Free(meshletVertices);
+            Memory::Free(order);
+            Memory::Free(offsets);
+            Memory::Free(owners);
+            Memory::Free(leafIndices);
+            Memory::Free(pending);
+            Memory::Free(next);
+            Memory::Free(hctx.remap);
+            Memory::Free(hctx.groups);
+            Memory::Free(hctx.indices);
+            Memory::Free(hctx.clusters);
+            return buffer;
+        }
     }
 
-    MeshStatic CreateMeshStatic(MeshStaticAllocator* allocator, GeometryContext* ctx, const char* name)
+    void* BuildMeshletsHierarchy(GeometryContext* ctx, const SubMesh* submeshes, uint32_t submeshCount, const char* name, MeshletsDescriptor* outMeshlets)
     {
-        CalculateTangents(ctx);
+        auto parts = Memory::Allocate<MeshletsDescriptor>(submeshCount);
+        auto buffers = Memory::Allocate<void*>(submeshCount);
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            buffers[i] = MeshletBuilder::BuildSubmeshHierarchy(ctx, submeshes[i], name, i, parts + i);
+        }
+
+        auto buffer = MergeMeshlets(parts, submeshCount, outMeshlets);
+
+        for (auto i = 0u; i < submeshCount; ++i)
+        {
+            Memory::Free(buffers[i]);
+        }
+
+        Memory::Free(buffers);
+        Memory::Free(parts);
+        return buffer;
+    }
+
+    uint32_t GetMeshletCutScratchSize(const MeshletHierarchy& hierarchy)
+    {
+        // Traversal stack & visited bitmask. Groups are pushed at most once.
+        return hierarchy.groupCount + (hierarchy.groupCount + 31u) / 32u;
+    }
+
+    uint32_t SelectMeshletCut(const MeshletHierarchy& hierarchy, const float3x4& localToWorld, const float4x4& worldToClip, float uniformScale, float errorMin, float errorMax, uint32_t* scratch, uint32_t* outMeshlets)
+    {
+        auto stack = scratch;
+        auto visited = scratch + hierarchy.groupCount;
+        auto stackCount = 0u;
+        auto outCount = 0u;
+        Memory::Memset(visited, 0, (hierarchy.groupCount + 31u) / 32u);
+
+        // Matches Meshlet_Cull_Lod in Meshlets.glsl.
+        auto projectError = [&](const float4& centerError)
+        {
+            const auto clip = worldToClip * float4(float4(centerError.xyz, 1.0f) * localToWorld, 1.0f);
+            const auto error = uniformScale * centerError.w;
+            return error * math::rsqrt(math::max(1e-6f, math::dot(clip, clip) - error * error));
+        };
+
+        for (auto i = 0u; i < hierarchy.rootCount; ++i)
+        {
+            const auto root = hierarchy.pRoots[i];
+            visited[root >> 5u] |= 1u << (root & 31u);
+            stack[stackCount++] = root;
+        }
+
+        while (stackCount > 0u)
+        {
+            const auto& group = hierarchy.pGroups[stack[--stackCount]];
+            const auto error = projectError(float4(group.lodCenterError));
+
+            if (error <= errorMax)
+            {
+                for (auto i = 0u; i < group.meshletCount; ++i)
+                {
+                    const auto meshlet = group.meshletFirst + i;
+
+                    if (projectError(hierarchy.pMeshletParents[meshlet]) > errorMin)
+                    {
+                        outMeshlets[outCount++] = meshlet;
+                    }
+                }
+            }
+
+            // Parent spheres enclose their children. Subtrees below the min error cannot contribute.
+            if (error > errorMin)
+            {
+                for (auto i = 0u; i < group.childCount; ++i)
+                {
+                    const auto child = hierarchy.pGroupIndices[group.childFirst + i];
+
+                    if ((visited[child >> 5u] & (1u << (child & 31u))) == 0u)
+                    {
+                        visited[child >> 5u] |= 1u << (child & 31u);
+                        stack[stackCount++] = child;
+                    }
+                }
+            }
+        }
+
+        IntroSort(outMeshlets, outMeshlets + outCount, [](const uint32_t& a, const uint32_t& b) { return a < b; });
+        return outCount;
+    }
 
-        auto meshlets = BuildMeshletsMonotone(ctx);
+    VertexDefault* ConvertToVertexDefault(const void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, bool fillMissing)
+    {
+        const VertexStreamLayout defaultLayout =
+        {
+            { ElementType::Float3, PK_RHI_VS_POSITION, 0 },
+            { ElementType::Float3, PK_RHI_VS_NORMAL, 0 },
+            { ElementType::Float2, PK_RHI_VS_TEXCOORD0, 0 },
+            { ElementType::Float4, PK_RHI_VS_TANGENT, 0 },
+        };
+
+        bool isMissing[4]{};
+
+        for (auto i = 0u; i < defaultLayout.GetCount(); ++i)
+        {
+            auto found = false;
+
+            for (auto j = 0u; j < layout.GetCount() && !found; ++j)
+            {
+                found = layout[j].name == defaultLayout[i].name;
+            }
+
+            // Positions cannot be substituted.
+            if (!found && (!fillMissing || i == 0u))
+            {
+                return nullptr;
+            }
+
+            isMissing[i] = !found;
+        }
+
+        // Conversion happens in place. Reserve space for the larger of the two layouts.
+        const auto stride = math::max((size_t)layout.GetStride(), sizeof(VertexDefault));
+        auto buffer = Memory::AllocateClear<uint8_t>(stride * vertexCount);
+        memcpy(buffer, vertices, (size_t)layout.GetStride() * vertexCount);
+        AlignVertexStreams(buffer, vertexCount, layout, defaultLayout);
+        auto pVertices = reinterpret_cast<VertexDefault*>(buffer);
+
+        if (isMissing[1] || isMissing[2] || isMissing[3])
+        {
+            PK_LOG_WARNING("Vertex layout is missing elements. Filling with defaults. normal: %i, texcoord: %i, tangent: %i", isMissing[1], isMissing[2], isMissing[3]);
+
+            for (auto i = 0u; i < vertexCount; ++i)
+            {
+                pVertices[i].in_NORMAL = isMissing[1] ? PK_FLOAT3_UP : pVertices[i].in_NORMAL;
+                pVertices[i].in_TEXCOORD0 = isMissing[2] ? PK_FLOAT2_ZERO : pVertices[i].in_TEXCOORD0;
+                pVertices[i].in_TANGENT = isMissing[3] ? float4(1.0f, 0.0f, 0.0f, 1.0f) : pVertices[i].in_TANGENT;
+            }
+        }
+
+        return pVertices;
+    }
+
+    void LogMeshletMetrics(const char* name, const MeshletMetrics& metrics)
+    {
+        PK_LOG_INFO("Meshlets '%s': count: %u, avg verts: %.1f, avg tris: %.1f, vertex reuse: %.2f, avg radius: %.4f, avg cone angle: %.1f, cone cullable: %.1f%%",
+            name,
+            metrics.meshletCount,
+            metrics.avgVertexCount,
+            metrics.avgTriangleCount,
+            metrics.vertexReuse,
+            metrics.avgBoundsRadius,
+            metrics.avgConeAngle,
+            metrics.coneCullableRatio * 100.0f);
+    }
+
+    MeshStatic CreateMeshStatic(MeshStaticAllocator* allocator, GeometryContext* ctx, const char* name, const MeshOptimizeOptions* options)
+    {
+        CalculateTangents(ctx);
 
         SubMesh submesh;
         submesh.name = 0u;
@@ -517,16 +2973,7 @@ namespace PK::MeshUtilities
         submesh.meshletCount = 0u;
         submesh.bounds = ctx->aabb;
 
-        MeshStaticDescriptor desc{};
-        desc.name = name;
-        desc.regular.pVertices = ctx->pVertices;
-        desc.regular.pIndices = ctx->pIndices;
-        desc.regular.pSubmeshes = &submesh;
-        desc.regular.indexSize = sizeof(uint32_t);
-        desc.regular.vertexCount = ctx->countVertex;
-        desc.regular.indexCount = ctx->countIndex;
-        desc.regular.submeshCount = 1u;
-        desc.regular.streamLayout =
+        const VertexStreamLayout streamLayout =
         {
             // VertexDefault layout. allocator will rearrange & pack vertices if needed.
             { ElementType::Float3, PK_RHI_VS_POSITION, 0 },
@@ -534,16 +2981,63 @@ namespace PK::MeshUtilities
             { ElementType::Float2, PK_RHI_VS_TEXCOORD0, 0 },
             { ElementType::Float4, PK_RHI_VS_TANGENT, 0 },
         };
-        desc.meshlets.pSubmeshes = &meshlets.submesh;
-        desc.meshlets.submeshCount = 1u;
-        desc.meshlets.pMeshlets = meshlets.meshlets;
-        desc.meshlets.meshletCount = meshlets.meshlet_count;
-        desc.meshlets.pVertices = meshlets.vertices;
-        desc.meshlets.vertexCount = meshlets.vertex_count;
-        desc.meshlets.pIndices = meshlets.indices;
-        desc.meshlets.triangleCount = meshlets.index_count / 3u;
+
+        auto lodCapacity = options ? options->lodCount + 1u : 1u;
+        auto submeshes = PK_STACK_ALLOC(SubMesh, lodCapacity);
+        submeshes[0] = submesh;
+
+        GeometryContext lodCtx = *ctx;
+        auto lodSubmeshCount = 0u;
+
+        if (options)
+        {
+            OptimizeMesh(*options, name, ctx->pVertices, ctx->countVertex, streamLayout, ctx->pIndices, ctx->countIndex, submeshes, 1u);
+
+            if (options->lodCount > 0u)
+            {
+                lodCtx.pIndices = Memory::Allocate<uint32_t>((size_t)ctx->countIndex * lodCapacity);
+                Memory::Memcpy(lodCtx.pIndices, ctx->pIndices, ctx->countIndex);
+                lodSubmeshCount = BuildMeshLods(*options, name, ctx->pVertices, ctx->countVertex, streamLayout, lodCtx.pIndices, &lodCtx.countIndex, submeshes, 1u);
+            }
+        }
+
+        MeshStaticDescriptor desc{};
+        void* meshletBuffer = nullptr;
+
+        if (options && options->meshletHierarchy)
+        {
+            // Lod submeshes are not part of the hierarchy & use regular spatial meshlets.
+            MeshletsDescriptor meshlets[2]{};
+            auto hierarchyBuffer = BuildMeshletsHierarchy(&lodCtx, submeshes, 1u, name, &meshlets[0]);
+            auto lodBuffer = BuildMeshletsSpatial(&lodCtx, submeshes + 1u, lodSubmeshCount, &meshlets[1]);
+            meshletBuffer = MergeMeshlets(meshlets, 2u, &desc.meshlets);
+            Memory::Free(hierarchyBuffer);
+            Memory::Free(lodBuffer);
+        }
+        else
+        {
+            meshletBuffer = BuildMeshletsSpatial(&lodCtx, submeshes, 1u + lodSubmeshCount, &desc.meshlets);
+        }
+
+        desc.name = name;
+        desc.regular.pVertices = ctx->pVertices;
+        desc.regular.pIndices = lodCtx.pIndices;
+        desc.regular.pSubmeshes = submeshes;
+        desc.regular.indexSize = sizeof(uint32_t);
+        desc.regular.vertexCount = ctx->countVertex;
+        desc.regular.indexCount = lodCtx.countIndex;
+        desc.regular.submeshCount = 1u;
+        desc.regular.lodSubmeshCount = lodSubmeshCount;
+        desc.regular.streamLayout = streamLayout;
 
         MeshStatic mesh(allocator, desc);
+
+        if (lodCtx.pIndices != ctx->pIndices)
+        {
+            Memory::Free(lodCtx.pIndices);
+        }
+
+        Memory::Free(meshletBuffer);
         return mesh;
     }
 
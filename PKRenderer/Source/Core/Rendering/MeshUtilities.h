@@ -7,12 +7,27 @@ namespace PK { class AssetDatabase; }
 
 namespace PK::MeshUtilities
 {
+    struct MeshletMetrics
+    {
+        uint32_t meshletCount = 0u;
+        float avgVertexCount = 0.0f;
+        float avgTriangleCount = 0.0f;
+        // Triangle corners per unique meshlet vertex.
+        float vertexReuse = 0.0f;
+        float avgBoundsRadius = 0.0f;
+        // Normal cone half angle in degrees.
+        float avgConeAngle = 0.0f;
+        // Ratio of meshlets with a cone narrow enough for backface cone culling.
+        float coneCullableRatio = 0.0f;
+    };
+
     struct MeshletBuildData
     {
         PKAssets::PKMeshletSubmesh submesh;
         uint32_t meshlet_count = 0u;
         uint32_t vertex_count = 0u;
         uint32_t index_count = 0u;
+        MeshletMetrics metrics;
         
         void* buffer = nullptr;
         uint8_t* indices;
@@ -36,6 +51,21 @@ namespace PK::MeshUtilities
         float4 in_TANGENT;
     };
 
+    // Regular static mesh vertex streams.
+    // Normals & tangents are octahedral snorm16. The tangent sign is stored in the lowest bit of the tangent x.
+    // Positions are snorm16 relative to the quantization bounds of the vertex range. w is unused.
+    struct VertexQuantizedAttributes
+    {
+        short2 in_NORMAL;
+        short2 in_TANGENT;
+        ushort2 in_TEXCOORD0;
+    };
+
+    struct VertexQuantizedPosition
+    {
+        short4 in_POSITION;
+    };
+
     struct GeometryContext
     {
         VertexDefault* pVertices = nullptr;
@@ -45,16 +75,117 @@ namespace PK::MeshUtilities
         AABB<float3> aabb;
     };
 
+    struct VertexCacheStats
+    {
+        // Average cache miss ratio. Vertex transforms per triangle.
+        float acmr = 0.0f;
+        // Average transform to vertex ratio. 1.0 is optimal.
+        float atvr = 0.0f;
+    };
+
+    struct MeshOptimizeOptions
+    {
+        bool vertexCache = false;
+        bool vertexFetch = false;
+        bool overdraw = false;
+        // Relative cache miss ratio increase allowed when splitting clusters for overdraw sorting.
+        float overdrawThreshold = 1.05f;
+        // Number of simplified submeshes generated per source submesh.
+        uint32_t lodCount = 0u;
+        // Target triangle ratio of each lod relative to the previous one.
+        float lodReduction = 0.5f;
+        // Max simplification error per lod relative to the submesh bounds radius.
+        float lodMaxError = 0.1f;
+        // Replaces source meshlets with a cluster lod hierarchy.
+        bool meshletHierarchy = false;
+    };
+
     void AlignVertexStreams(void* vertices, size_t count, const VertexStreamLayout& src, const VertexStreamLayout& dst);
 
     void CopyIndexBuffer(void* dst, const void* src, size_t count, size_t sizeSrc, size_t sizeDst);
 
+    void EncodeVertexQuantized(const VertexDefault& vertex, const AABB<float3>& bounds, VertexQuantizedAttributes* outAttributes, VertexQuantizedPosition* outPosition);
+    VertexDefault DecodeVertexQuantized(const VertexQuantizedAttributes& attributes, const VertexQuantizedPosition& position, const AABB<float3>& bounds);
+    // Bounds of each submesh vertex range. Submeshes sharing a range share bounds.
+    // Partially overlapping ranges cannot be quantized separately & fall back to the bounds of all vertices.
+    void CalculateQuantizationBounds(const VertexDefault* vertices, uint32_t vertexCount, const SubMesh* submeshes, uint32_t submeshCount, AABB<float3>* outBounds);
+    // Round trip tolerances of the quantized layout.
+    // Positions are allowed half a snorm16 step of the bounds extents plus this fraction of the bounds magnitude for float rounding.
+    constexpr static const float QUANTIZATION_POSITION_EPSILON = 1e-6f;
+    // Minimum cosine between source & decoded normals & tangents.
+    constexpr static const float QUANTIZATION_MIN_DIRECTION_DOT = 0.999f;
+    // Half precision texcoords.
+    constexpr static const float QUANTIZATION_TEXCOORD_RELATIVE_ERROR = 1.0f / 1024.0f;
+    bool IsQuantizedVertexWithinTolerance(const VertexDefault& source, const VertexDefault& decoded, const AABB<float3>& bounds);
+    // Encodes a vertex range against the bounds & validates the decoded round trip.
+    // Returns the number of vertices that exceed the quantization tolerances.
+    uint32_t QuantizeVertices(const VertexDefault* vertices, uint32_t vertexCount, const AABB<float3>& bounds, VertexQuantizedAttributes* outAttributes, VertexQuantizedPosition* outPositions);
+
     void CalculateNormals(GeometryContext* ctx, float sign = 1.0f);
 
     void CalculateTangents(GeometryContext* ctx);
 
+    VertexCacheStats AnalyzeVertexCache(const uint32_t* indices, uint32_t indexCount, uint32_t vertexCount);
+    // Reorders triangles for post transform cache hits. Uses Tom Forsyth's linear-speed scoring.
+    void OptimizeVertexCache(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount);
+    // Splits a cache optimized triangle list into clusters & sorts them front to back relative to the mesh center.
+    void OptimizeOverdraw(uint32_t* indices, uint32_t indexCount, uint32_t vertexCount, const float* positions, size_t positionStride, float threshold);
+    // Moves vertex i of all streams to remap[i].
+    void RemapVertices(void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, const uint32_t* remap);
+    // Reorders vertices of all streams in the order of first reference & remaps indices. Optionally outputs the applied remap.
+    void OptimizeVertexFetch(void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, uint32_t* indices, uint32_t indexCount, uint32_t* outRemap = nullptr);
+    bool ReadMeshOptimizeOptions(const char* filepath, MeshOptimizeOptions* outOptions);
+    // Results are restored from cachePath when it was written for identical source geometry & options. Otherwise they are written to it.
+    void OptimizeMesh(const MeshOptimizeOptions& options, const char* name, void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, uint32_t* indices, uint32_t indexCount, const SubMesh* submeshes, uint32_t submeshCount, const char* cachePath = nullptr);
+
+    // Quadric error edge collapse. Vertices are collapsed onto existing neighbours so that the output can share the source vertex buffer.
+    // Border & attribute seam vertices are locked. Attribute error is weighted per component.
+    // Errors are relative to the bounds radius of the input. Returns the output index count.
+    uint32_t SimplifyMesh(uint32_t* destination,
+        const uint32_t* indices,
+        uint32_t indexCount,
+        const float* positions,
+        size_t positionStride,
+        uint32_t vertexCount,
+        const float* attributes,
+        size_t attributeStride,
+        const float* attributeWeights,
+        uint32_t attributeCount,
+        uint32_t targetIndexCount,
+        float targetError,
+        float* outError);
+
+    // Appends simplified index ranges for each submesh after the source indices.
+    // Lod submeshes are appended after the source submeshes & referenced through lodFirst & lodCount.
+    // Indices must have capacity for indexCount * (lodCount + 1) & submeshes for submeshCount * (lodCount + 1).
+    // Returns the number of lod submeshes.
+    uint32_t BuildMeshLods(const MeshOptimizeOptions& options, const char* name, const void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, uint32_t* indices, uint32_t* inoutIndexCount, SubMesh* submeshes, uint32_t submeshCount);
+
+    // Fills meshlets in index order. Fast but produces sprawling meshlets for meshes with poor index locality.
     MeshletBuildData BuildMeshletsMonotone(GeometryContext* ctx);
-    MeshStatic CreateMeshStatic(MeshStaticAllocator* allocator, GeometryContext* ctx, const char* name);
+    // Grows meshlets along triangle adjacency scored by spatial compactness & normal coherence.
+    // Optionally outputs the source vertex index of each meshlet vertex. Free with Memory::Free.
+    MeshletBuildData BuildMeshletsSpatial(GeometryContext* ctx, uint32_t** outMeshletVertices = nullptr);
+    // Builds spatial meshlets for each submesh index range. Meshlet vertices are quantized against the submesh bounds.
+    // Returns the buffer backing the output descriptor arrays.
+    void* BuildMeshletsSpatial(GeometryContext* ctx, const SubMesh* submeshes, uint32_t submeshCount, MeshletsDescriptor* outMeshlets);
+    // Concatenates meshlet sets. Meshlet, vertex & triangle offsets are rebased. Returns the buffer backing the output descriptor arrays.
+    void* MergeMeshlets(const MeshletsDescriptor* sources, uint32_t sourceCount, MeshletsDescriptor* outMeshlets);
+    // Builds a cluster lod hierarchy for each submesh index range. Spatial meshlets are grouped, simplified & re-split level by level.
+    // Group errors include the errors of their children so that a single error threshold yields a watertight cut.
+    // Returns the buffer backing the output descriptor arrays.
+    void* BuildMeshletsHierarchy(GeometryContext* ctx, const SubMesh* submeshes, uint32_t submeshCount, const char* name, MeshletsDescriptor* outMeshlets);
+    // Scratch size in uint32 words required by SelectMeshletCut.
+    uint32_t GetMeshletCutScratchSize(const MeshletHierarchy& hierarchy);
+    // Traverses the hierarchy from its roots & outputs meshlets whose parent error is above errorMin & own error is at most errorMax.
+    // Errors are projected the same way as in the task shader lod test. Output is sorted & relative to the submesh meshletFirst.
+    // Output capacity must be at least the submesh meshlet count. Returns the number of selected meshlets.
+    uint32_t SelectMeshletCut(const MeshletHierarchy& hierarchy, const float3x4& localToWorld, const float4x4& worldToClip, float uniformScale, float errorMin, float errorMax, uint32_t* scratch, uint32_t* outMeshlets);
+    // Converts vertices into the VertexDefault layout. Returns nullptr if the layout is missing positions.
+    // Other missing elements are filled with defaults when requested. Otherwise nullptr is returned.
+    VertexDefault* ConvertToVertexDefault(const void* vertices, uint32_t vertexCount, const VertexStreamLayout& layout, bool fillMissing = false);
+    void LogMeshletMetrics(const char* name, const MeshletMetrics& metrics);
+    MeshStatic CreateMeshStatic(MeshStaticAllocator* allocator, GeometryContext* ctx, const char* name, const MeshOptimizeOptions* options = nullptr);
     MeshStatic CreateBoxMeshStatic(MeshStaticAllocator* allocator, const float3& offset, const float3& extents);
     MeshStatic CreateQuadMeshStatic(MeshStaticAllocator* allocator, const float2& min, const float2& max);
     MeshStatic CreatePlaneMeshStatic(MeshStaticAllocator* allocator, const float2& center, const float2& extents, uint2 resolution);
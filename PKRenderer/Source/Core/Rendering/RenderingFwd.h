@@ -11,6 +11,7 @@ namespace PK
     struct Font;
     struct FontStyle;
     struct SubMesh;
+    struct MeshletHierarchy;
     struct MeshDescriptor;
     struct MeshletsDescriptor;
     struct MeshStaticDescriptor;
@@ -24,6 +25,7 @@ namespace PK
     struct IESProfile;
     struct ConstantBuffer;
     struct CommandBufferExt;
+    class CommandList;
     struct ShaderBindingTable;
     struct ShaderProperty;
     struct ShaderPropertyLayout;
@@ -1,14 +1,35 @@
 #include "PrecompiledHeader.h"
 #include <PKAssets/PKAssetLoader.h>
-#include "Core/Base/Containers/PropertyBlock.h"
+#include "Core/Base/Containers/VersionedPropertyBlock.h"
+#include "Core/Base/Containers/HashMap.h"
 #include "Core/Base/Reflect.h"
+#include "Core/Base/FileIO.h"
 #include "Core/CLI/Log.h"
+#include "Core/CLI/CVariableRegister.h"
 #include "Core/RHI/RHInterfaces.h"
 #include "Core/RHI/Layout.h"
 #include "ShaderAsset.h"
 
 namespace PK
 {
+    namespace
+    {
+        struct VariantRegistry
+        {
+            ShaderAsset* loaded = nullptr;
+            // Variants requested during the previous run.
+            HashSet<FixedString128> warmup;
+            // Variants requested by shaders that have since been released.
+            HashSet<FixedString128> requested;
+        };
+
+        static VariantRegistry& GetVariantRegistry()
+        {
+            static VariantRegistry registry;
+            return registry;
+        }
+    }
+
     void ShaderAsset::Map::AddKeyword(const NameID name, uint8_t directive, uint8_t value)
     {
         if (keywordCount == 0u)
@@ -82,7 +103,7 @@ namespace PK
         return GetIndex(flags);
     }
 
-    uint32_t ShaderAsset::Map::GetIndex(const PropertyBlock* nameblock) const
+    uint32_t ShaderAsset::Map::GetIndex(const VersionedPropertyBlock* nameblock) const
     {
         uint8_t flags[MAX_DIRECTIVES]{};
 
@@ -116,12 +137,11 @@ namespace PK
     {
         ReleaseVariants();
 
-        PKAssets::PKAsset asset{};
-        PK_FATAL_ASSERT(PKAssets::OpenAsset(filepath, &asset) == 0, "Failed to open asset at path: %s", filepath);
-        PK_FATAL_ASSERT(asset.header->type == PKAssets::PKAssetType::Shader, "Trying to read a shader from a non shader file!")
+        PK_FATAL_ASSERT(PKAssets::OpenAsset(filepath, &m_asset) == 0, "Failed to open asset at path: %s", filepath);
+        PK_FATAL_ASSERT(m_asset.header->type == PKAssets::PKAssetType::Shader, "Trying to read a shader from a non shader file!")
 
-        auto shader = PKAssets::ReadAsShader(&asset);
-        auto base = asset.rawData;
+        auto shader = PKAssets::ReadAsShader(&m_asset);
+        auto base = m_asset.rawData;
 
         if (shader->variantcount == 0)
         {
@@ -176,17 +196,62 @@ namespace PK
             m_materialPropertyLayout.CalculateOffsetsAndStride();
         }
 
-        auto pVariants = shader->variants.Get(base);
-        auto fileName = String::ToFilePathStem<64>(filepath);
-
+        m_variants = shader->variants.Get(base);
+        m_variantName = String::ToFilePathStem<64>(filepath);
         m_shaders.Reserve(shader->variantcount, false);
+        m_variantRequests.Reserve(shader->variantcount, false);
+        m_variantRequests.Clear();
+
+        auto& registry = GetVariantRegistry();
+        m_nextLoaded = registry.loaded;
+        m_prevLoaded = nullptr;
+
+        if (m_nextLoaded)
+        {
+            m_nextLoaded->m_prevLoaded = this;
+        }
+
+        registry.loaded = this;
+
+        // Stage flags, group size & shader binding table layouts are read from the first variant.
+        CreateVariant(0u);
+
+        for (auto i = 1u; i < shader->variantcount && registry.warmup.GetCount() > 0u; ++i)
+        {
+            if (registry.warmup.Contains(FixedString128("%s %u", m_variantName.c_str(), i)))
+            {
+                CreateVariant(i);
+            }
+        }
+    }
+
+    ShaderAsset::~ShaderAsset()
+    {
+        auto& registry = GetVariantRegistry();
+
+        for (auto i = 0u; i < m_map.variantcount; ++i)
+        {
+            if (m_variantRequests[i] > 0u)
+            {
+                registry.requested.Add(FixedString128("%s %u", m_variantName.c_str(), i));
+            }
+        }
+
+        if (m_prevLoaded)
+        {
+            m_prevLoaded->m_nextLoaded = m_nextLoaded;
+        }
+        else
+        {
+            registry.loaded = m_nextLoaded;
+        }
 
-        for (auto i = 0u; i < shader->variantcount; ++i)
+        if (m_nextLoaded)
         {
-            m_shaders[i] = RHI::CreateShader(base, pVariants + i, FixedString128("%s%u", fileName, i));
+            m_nextLoaded->m_prevLoaded = m_prevLoaded;
         }
 
-        PKAssets::CloseAsset(&asset);
+        ReleaseVariants();
     }
 
     const char* ShaderAsset::GetMetaInfo() const
@@ -244,9 +309,16 @@ namespace PK
             }
 
             meta.Append('\n');
+            meta.AppendFormat("       Requests: %u\n", m_variantRequests[j]);
 
             const auto& shader = m_shaders[j].get();
 
+            if (shader == nullptr)
+            {
+                meta.Append("       Not instantiated\n");
+                continue;
+            }
+
             meta.Append("       Vertex Attributes:\n");
 
             for (const auto& element : shader->GetVertexLayout())
@@ -272,6 +344,25 @@ namespace PK
         return meta.c_str();
     }
 
+    const RHIShader* ShaderAsset::CreateVariant(uint32_t index) const
+    {
+        if (m_shaders[index].get() == nullptr)
+        {
+            PK_FATAL_ASSERT(m_asset.rawData != nullptr, "Trying to create a variant of a shader that has been released!");
+            m_shaders[index] = RHI::CreateShader(m_asset.rawData, m_variants + index, FixedString128("%s%u", m_variantName.c_str(), index));
+
+            // All modules have been created. Source is no longer needed.
+            if (++m_variantsCreated == m_map.variantcount)
+            {
+                PKAssets::CloseAsset(&m_asset);
+                m_asset = {};
+                m_variants = nullptr;
+            }
+        }
+
+        return m_shaders[index].get();
+    }
+
     void ShaderAsset::ReleaseVariants()
     {
         for (auto i = 0u; i < m_shaders.GetCount(); ++i)
@@ -280,5 +371,123 @@ namespace PK
         }
 
         m_shaders.Clear();
+        m_variantsCreated = 0u;
+
+        PKAssets::CloseAsset(&m_asset);
+        m_asset = {};
+        m_variants = nullptr;
+    }
+
+
+    void ShaderAsset::LoadVariantWarmupList(const char* workingDirectory)
+    {
+        auto& registry = GetVariantRegistry();
+        registry.warmup.Clear();
+
+        void* fileData = nullptr;
+        size_t fileSize = 0ull;
+
+        if (FileIO::ReadBinary(FixedString256({ workingDirectory, VARIANT_WARMUP_FILENAME }), true, &fileData, &fileSize) != 0)
+        {
+            return;
+        }
+
+        // One "<shader> <variant>" entry per line.
+        auto head = static_cast<char*>(fileData);
+        auto end = head + fileSize;
+
+        while (head < end)
+        {
+            auto length = 0ull;
+
+            while (head + length < end && head[length] != '\n' && head[length] != '\r')
+            {
+                ++length;
+            }
+
+            if (length > 0ull && length <= FixedString128::max_length)
+            {
+                registry.warmup.Add(FixedString128(length, head));
+            }
+
+            head += length + 1ull;
+        }
+
+        Memory::Free(fileData);
+        PK_LOG_INFO("ShaderAsset.LoadVariantWarmupList: %u variants", registry.warmup.GetCount());
+    }
+
+    void ShaderAsset::SaveVariantWarmupList(const char* workingDirectory)
+    {
+        auto& registry = GetVariantRegistry();
+        auto requested = registry.requested;
+
+        for (auto shader = registry.loaded; shader != nullptr; shader = shader->m_nextLoaded)
+        {
+            for (auto i = 0u; i < shader->m_map.variantcount; ++i)
+            {
+                if (shader->m_variantRequests[i] > 0u)
+                {
+                    requested.Add(FixedString128("%s %u", shader->m_variantName.c_str(), i));
+                }
+            }
+        }
+
+        auto size = 0ull;
+
+        for (auto i = 0u; i < requested.GetCount(); ++i)
+        {
+            size += requested[i].Length() + 1ull;
+        }
+
+        auto fileData = Memory::Allocate<char>(size + 1ull);
+        auto head = fileData;
+
+        for (auto i = 0u; i < requested.GetCount(); ++i)
+        {
+            Memory::Memcpy(head, requested[i].c_str(), requested[i].Length());
+            head += requested[i].Length();
+            *head++ = '\n';
+        }
+
+        FileIO::WriteBinary(FixedString256({ workingDirectory, VARIANT_WARMUP_FILENAME }), true, fileData, size);
+        Memory::Free(fileData);
+    }
+
+    void ShaderAsset::LogVariantStatistics()
+    {
+        PK_LOG_HEADER_FUNC();
+
+        auto totalVariants = 0u;
+        auto totalCreated = 0u;
+        auto totalRequested = 0u;
+
+        for (auto shader = GetVariantRegistry().loaded; shader != nullptr; shader = shader->m_nextLoaded)
+        {
+            auto requested = 0u;
+            auto unused = 0u;
+            auto requests = 0ull;
+
+            for (auto i = 0u; i < shader->m_map.variantcount; ++i)
+            {
+                requested += shader->m_variantRequests[i] > 0u ? 1u : 0u;
+                unused += shader->m_variantRequests[i] == 0u && shader->m_shaders[i].get() != nullptr ? 1u : 0u;
+                requests += shader->m_variantRequests[i];
+            }
+
+            PK_LOG_INFO("%-32s variants: %4u, created: %4u, requested: %4u, created unused: %4u, requests: %llu", 
+                shader->m_variantName.c_str(),
+                shader->m_map.variantcount,
+                shader->m_variantsCreated,
+                requested,
+                unused,
+                requests);
+
+            totalVariants += shader->m_map.variantcount;
+            totalCreated += shader->m_variantsCreated;
+            totalRequested += requested;
+        }
+
+        PK_LOG_INFO("Total variants: %u, created: %u, requested: %u", totalVariants, totalCreated, totalRequested);
     }
 }
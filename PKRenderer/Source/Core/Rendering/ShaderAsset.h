@@ -1,4 +1,5 @@
 #pragma once
+#include <PKAssets/PKAsset.h>
 #include "Core/Base/Containers/ArrayList.h"
 #include "Core/Assets/Asset.h"
 #include "Core/RHI/RHInterfaces.h"
@@ -19,7 +20,7 @@ namespace PK
             inline bool SupportsKeyword(NameID name) const { return GetKeywordIndex(name) != -1; }
             bool SupportsKeywords(const NameID* names, const uint32_t count) const;
             uint32_t GetIndex(const NameID* names, size_t count) const;
-            uint32_t GetIndex(const PropertyBlock* nameblock) const;
+            uint32_t GetIndex(const VersionedPropertyBlock* nameblock) const;
             uint32_t GetIndex(const uint8_t* flags) const;
 
             uint32_t variantcount = 0u;
@@ -33,8 +34,10 @@ namespace PK
             uint32_t keywordCount = 0u;
         };
 
+        constexpr const static char* VARIANT_WARMUP_FILENAME = "shadervariants.cache";
+
         ShaderAsset(const char* filepath);
-        ~ShaderAsset() { ReleaseVariants(); }
+        ~ShaderAsset();
 
         inline ShaderStageFlags GetStageFlags() const { return m_shaders[0]->GetStageFlags(); }
         constexpr const FixedFunctionShaderAttributes& GetFixedFunctionAttributes() const { return m_attributes; }
@@ -42,12 +45,20 @@ namespace PK
         inline uint32_t GetRHIIndex(const NameID* keywords, uint32_t count) const { return m_map.GetIndex(keywords, count); }
         inline uint32_t GetRHIIndex(NameID keyword) const { return m_map.GetIndex(&keyword, 1); }
         inline uint32_t GetRHIIndex(const initializer_list<NameID>& keywords) const { return GetRHIIndex(keywords.begin(), (uint32_t)keywords.size()); }
-        inline uint32_t GetRHIIndex(const PropertyBlock* keywords) const { return m_map.GetIndex(keywords); }
+        inline uint32_t GetRHIIndex(const VersionedPropertyBlock* keywords) const { return m_map.GetIndex(keywords); }
+
+        // Variants are created on first request. Not thread safe, request only from the render thread.
+        inline const RHIShader* GetRHI(uint32_t index) const
+        {
+            ++m_variantRequests[index];
+            auto shader = m_shaders[index].get();
+            return shader != nullptr ? shader : CreateVariant(index);
+        }
 
-        inline const RHIShader* GetRHI(const NameID* keywords, uint32_t count) const { return m_shaders[GetRHIIndex(keywords, count)].get(); }
-        inline const RHIShader* GetRHI(uint32_t index) const { return m_shaders[index].get(); }
-        inline const RHIShader* GetRHI(const PropertyBlock* keywords) const { return m_shaders[GetRHIIndex(keywords)].get(); }
-        constexpr uint32_t GetRHICount() const { return (uint32_t)m_shaders.GetCount(); }
+        inline const RHIShader* GetRHI(const NameID* keywords, uint32_t count) const { return GetRHI(GetRHIIndex(keywords, count)); }
+        inline const RHIShader* GetRHI(const VersionedPropertyBlock* keywords) const { return GetRHI(GetRHIIndex(keywords)); }
+        constexpr uint32_t GetRHICount() const { return m_map.variantcount; }
+        constexpr uint32_t GetRHICreatedCount() const { return m_variantsCreated; }
 
         inline bool SupportsKeyword(const NameID keywords) const { return m_map.SupportsKeyword(keywords); }
         inline bool SupportsKeywords(const NameID* keywords, const uint32_t count) const { return m_map.SupportsKeywords(keywords, count); }
@@ -58,10 +69,25 @@ namespace PK
 
         const char* GetMetaInfo() const final;
 
+        // Variants requested during previous runs are created when their shader is loaded.
+        // The list is optional. Load before loading shaders & save before unloading them.
+        static void LoadVariantWarmupList(const char* workingDirectory);
+        static void SaveVariantWarmupList(const char* workingDirectory);
+        static void LogVariantStatistics();
+
     protected:
+        const RHIShader* CreateVariant(uint32_t index) const;
         void ReleaseVariants();
 
-        InlineArray<RHIShaderRef, 4ull> m_shaders;
+        // Kept open until all variants have been created.
+        mutable PKAssets::PKAsset m_asset{};
+        mutable PKAssets::PKShaderVariant* m_variants = nullptr;
+        mutable InlineArray<RHIShaderRef, 4ull> m_shaders;
+        mutable InlineArray<uint32_t, 4ull> m_variantRequests;
+        mutable uint32_t m_variantsCreated = 0u;
+        FixedString64 m_variantName;
+        ShaderAsset* m_prevLoaded = nullptr;
+        ShaderAsset* m_nextLoaded = nullptr;
         Map m_map;
         FixedFunctionShaderAttributes m_attributes;
         ShaderPropertyLayout m_materialPropertyLayout;
@@ -26,7 +26,7 @@ namespace PK
 
         for (const auto child : node.children())
         {
-            auto head = 0ull;
+            size_t head = 0ull;
             auto count = 0u;
             AddArg(buffer, arguments, child.key(), head, count);
 
@@ -1,5 +1,6 @@
 #pragma once
 #include "Core/Base/Containers/HashMap.h"
+#include "Core/Base/MemoryTracker.h"
 #include "Core/Base/NoCopy.h"
 #include "Core/Base/TypeMeta.h"
 #include "Core/CLI/LogScopeIndent.h"
@@ -37,6 +38,7 @@ namespace PK
         template<typename T, typename ... Args>
         T* Create(Args&& ... args)
         {
+            PK_MEMORY_TAG_SCOPE(pk_full_type_name<T>.str);
             const auto typeIndex = pk_base_type_index<T>();
             auto index = 0u;
             AssertTypeExists(m_services.AddKey(typeIndex, &index), pk_full_type_name<T>());
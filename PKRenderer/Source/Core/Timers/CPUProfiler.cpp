@@ -0,0 +1,157 @@
+#include "PrecompiledHeader.h"
+#include <stdio.h>
+#include "Core/Base/FileIO.h"
+#include "Core/CLI/Log.h"
+#include "CPUProfiler.h"
+
+namespace PK
+{
+    thread_local CPUProfiler::ThreadRing* CPUProfiler::s_threadRing = nullptr;
+
+    // Rings live for the duration of the process as threads might still record during shutdown.
+    static CPUProfiler::ThreadRing* s_threadRings[CPUProfiler::MAX_THREADS]{};
+    static volatile uint32_t s_threadCount = 0u;
+    static uint64_t s_frameBegins[CPUProfiler::MAX_FRAMES]{};
+    static uint32_t s_frameIndex = 0u;
+    static uint64_t s_calibrationCycles = 0ull;
+    static double s_calibrationSeconds = 0.0;
+    static double s_cyclesToMilliseconds = 0.0;
+
+    // Scope names are mostly function signatures. Escape anything that would break the json string.
+    static void WriteJsonString(FILE* file, const char* value)
+    {
+        fputc('"', file);
+
+        for (auto c = value ? value : ""; *c != '\0'; ++c)
+        {
+            switch (*c)
+            {
+                case '"': fputs("\\\"", file); break;
+                case '\\': fputs("\\\\", file); break;
+                case '\n': fputs("\\n", file); break;
+                case '\r': fputs("\\r", file); break;
+                case '\t': fputs("\\t", file); break;
+                default:
+                    if ((uint8_t)*c < 0x20u)
+                    {
+                        fprintf(file, "\\u%04x", (uint32_t)(uint8_t)*c);
+                    }
+                    else
+                    {
+                        fputc(*c, file);
+                    }
+                    break;
+            }
+        }
+
+        fputc('"', file);
+    }
+
+    void CPUProfiler::NextFrame()
+    {
+        auto cycles = Platform::GetTimeCycles();
+        auto seconds = Platform::GetTimeSeconds();
+
+        // Derive cycle frequency from the platform clock instead of assuming one.
+        if (s_calibrationCycles == 0ull)
+        {
+            s_calibrationCycles = cycles;
+            s_calibrationSeconds = seconds;
+        }
+        else if (cycles > s_calibrationCycles)
+        {
+            s_cyclesToMilliseconds = ((seconds - s_calibrationSeconds) * 1000.0) / (double)(cycles - s_calibrationCycles);
+        }
+
+        s_frameBegins[++s_frameIndex % MAX_FRAMES] = cycles;
+    }
+
+    uint64_t CPUProfiler::GetFrameBegin(uint32_t framesAgo)
+    {
+        return framesAgo < MAX_FRAMES && framesAgo <= s_frameIndex ? s_frameBegins[(s_frameIndex - framesAgo) % MAX_FRAMES] : 0ull;
+    }
+
+    double CPUProfiler::GetCyclesToMilliseconds()
+    {
+        return s_cyclesToMilliseconds;
+    }
+
+    uint32_t CPUProfiler::GetThreadCount()
+    {
+        return Platform::AtomicRead(&s_threadCount);
+    }
+
+    const CPUProfiler::ThreadRing* CPUProfiler::GetThreadRing(uint32_t index)
+    {
+        return index < GetThreadCount() ? s_threadRings[index] : nullptr;
+    }
+
+    bool CPUProfiler::ExportChromeTrace(const char* path)
+    {
+        if (!FileIO::CreateDirectory(path) || s_cyclesToMilliseconds <= 0.0)
+        {
+            return false;
+        }
+
+        auto file = fopen(path, "w");
+
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        // Timestamps are in microseconds relative to the oldest recorded frame.
+        const auto cyclesToMicroseconds = s_cyclesToMilliseconds * 1000.0;
+        const auto oldestFrame = s_frameIndex < MAX_FRAMES ? 0u : s_frameIndex - MAX_FRAMES + 1u;
+        const auto originCycles = GetFrameBegin(s_frameIndex - oldestFrame);
+        const auto threadCount = GetThreadCount();
+        auto isFirst = true;
+
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+        for (auto i = 0u; i < threadCount; ++i)
+        {
+            auto ring = s_threadRings[i];
+
+            if (ring == nullptr)
+            {
+                continue;
+            }
+
+            auto count = ring->head < MAX_EVENTS ? ring->head : MAX_EVENTS;
+
+            for (auto j = ring->head - count; j < ring->head; ++j)
+            {
+                auto& event = ring->events[j & (MAX_EVENTS - 1u)];
+
+                if (event.end == 0ull || event.begin < originCycles)
+                {
+                    continue;
+                }
+
+                fprintf(file, "%s\n{\"name\":", isFirst ? "" : ",");
+                WriteJsonString(file, event.name);
+                fprintf(file, ",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    ring->index,
+                    (event.begin - originCycles) * cyclesToMicroseconds,
+                    (event.end - event.begin) * cyclesToMicroseconds);
+
+                isFirst = false;
+            }
+        }
+
+        fprintf(file, "\n]}\n");
+        return fclose(file) == 0;
+    }
+
+    CPUProfiler::ThreadRing* CPUProfiler::RegisterThread()
+    {
+        auto index = Platform::InterlockedIncrement(&s_threadCount) - 1u;
+        PK_FATAL_ASSERT(index < MAX_THREADS, "CPUProfiler: Max number of profiled threads exceeded!");
+        auto ring = Memory::New<ThreadRing>();
+        ring->index = index;
+        s_threadRings[index] = ring;
+        s_threadRing = ring;
+        return ring;
+    }
+}
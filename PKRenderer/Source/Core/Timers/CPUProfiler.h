@@ -0,0 +1,110 @@
+#pragma once
+#include "Core/Base/NoCopy.h"
+
+#if defined(PK_NO_PROFILER)
+    #define PK_PROFILER_ENABLED 0
+#else
+    #define PK_PROFILER_ENABLED 1
+#endif
+
+namespace PK
+{
+    // Hierarchical cpu scope profiler.
+    // Each thread records scopes into its own ring buffer. No synchronization is required to record.
+    // Rings should only be read while other threads are idle. ie. between frames.
+    struct CPUProfiler
+    {
+        constexpr static const uint32_t MAX_THREADS = 32u;
+        constexpr static const uint32_t MAX_EVENTS = 1u << 15u;
+        constexpr static const uint32_t MAX_FRAMES = 8u;
+
+        struct Event
+        {
+            const char* name;
+            uint64_t begin;
+            uint64_t end;
+            uint32_t depth;
+        };
+
+        struct ThreadRing
+        {
+            Event events[MAX_EVENTS];
+            uint64_t head;
+            uint32_t depth;
+            uint32_t index;
+        };
+
+        // Scopes refer to their event by its sequence number on the thread ring.
+        // A scope that stays open for longer than the ring can hold has its slot recycled. Its end is then discarded.
+        constexpr static const uint64_t INVALID_EVENT = ~0ull;
+
+        struct Scope : public NoCopy
+        {
+            uint64_t event;
+            PK_FORCE_INLINE Scope(const char* name) : event(Begin(name)) {}
+            PK_FORCE_INLINE ~Scope() { End(event); }
+        };
+
+        PK_FORCE_INLINE static uint64_t Begin(const char* name)
+        {
+            if (!s_enabled)
+            {
+                return INVALID_EVENT;
+            }
+
+            auto ring = s_threadRing ? s_threadRing : RegisterThread();
+            auto sequence = ring->head++;
+            auto event = ring->events + (sequence & (MAX_EVENTS - 1u));
+            event->name = name;
+            event->depth = ring->depth++;
+            event->end = 0ull;
+            event->begin = Platform::GetTimeCycles();
+            return sequence;
+        }
+
+        PK_FORCE_INLINE static void End(uint64_t sequence)
+        {
+            if (sequence != INVALID_EVENT)
+            {
+                auto ring = s_threadRing;
+                ring->depth--;
+
+                if (ring->head - sequence <= MAX_EVENTS)
+                {
+                    ring->events[sequence & (MAX_EVENTS - 1u)].end = Platform::GetTimeCycles();
+                }
+            }
+        }
+
+        static void SetEnabled(bool value) { s_enabled = value; }
+        static bool IsEnabled() { return s_enabled; }
+
+        // Marks the beginning of a new frame on the calling thread.
+        static void NextFrame();
+        // 0 = current frame.
+        static uint64_t GetFrameBegin(uint32_t framesAgo);
+        static double GetCyclesToMilliseconds();
+
+        static uint32_t GetThreadCount();
+        static const ThreadRing* GetThreadRing(uint32_t index);
+
+        static bool ExportChromeTrace(const char* path);
+
+    private:
+        static ThreadRing* RegisterThread();
+
+        static thread_local ThreadRing* s_threadRing;
+        inline static bool s_enabled = PK_PROFILER_ENABLED != 0;
+    };
+}
+
+#define PK_PROFILE_CONCAT_INNER(a, b) a##b
+#define PK_PROFILE_CONCAT(a, b) PK_PROFILE_CONCAT_INNER(a,b)
+
+#if PK_PROFILER_ENABLED
+    #define PK_PROFILE_SCOPE(name) PK::CPUProfiler::Scope PK_PROFILE_CONCAT(pk_profile_scope_, __COUNTER__)(name)
+    #define PK_PROFILE_FUNC() PK_PROFILE_SCOPE(PK_SHORT_FUNCTION_NAME)
+#else
+    #define PK_PROFILE_SCOPE(name)
+    #define PK_PROFILE_FUNC()
+#endif
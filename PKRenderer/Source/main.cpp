@@ -26,15 +26,18 @@ int main(int argc, char** argv)
 #endif
 
     auto platformStatus = PK::Platform::Initialize();
+    auto exitCode = 0;
 
     if (platformStatus == 0)
     {
         auto application = PK::CreateProjectApplication({ argv, (uint32_t)argc });
 
         application->Execute();
+        exitCode = application->GetExitCode();
         
         PK::FreeProjectApplication(application);
     }
 
-    return PK::Platform::Terminate();
+    auto platformExitCode = PK::Platform::Terminate();
+    return platformExitCode != 0 ? platformExitCode : exitCode;
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 
 namespace PKAssets
 {
-    constexpr static const uint64_t PK_ASSET_MAGIC_NUMBER = 16056123332373007180ull;
+    // Layout version is encoded as an offset from the base magic number. Assets written before versioning read as version 0.
+    // Version 1: PKMeshletMesh cluster lod hierarchy.
+    constexpr static const uint32_t PK_ASSET_VERSION = 1u;
+    constexpr static const uint64_t PK_ASSET_MAGIC_NUMBER_BASE = 16056123332373007180ull;
+    constexpr static const uint64_t PK_ASSET_MAGIC_NUMBER = PK_ASSET_MAGIC_NUMBER_BASE + PK_ASSET_VERSION;
     constexpr static const uint32_t PK_ASSET_NAME_MAX_LENGTH = 64u;
     constexpr static const uint32_t PK_ASSET_MAX_VERTEX_ATTRIBUTES = 8u;
     constexpr static const uint32_t PK_ASSET_MAX_DESCRIPTORS_PER_SET = 64u;
@@ -76,6 +81,9 @@ namespace PKAssets
         size_t bufferSize;
     };
 
+    constexpr bool IsValidAssetHeader(const PKAssetHeader& header) { return header.magicNumber - PK_ASSET_MAGIC_NUMBER_BASE <= PK_ASSET_VERSION; }
+    constexpr uint32_t GetAssetVersion(const PKAssetHeader& header) { return (uint32_t)(header.magicNumber - PK_ASSET_MAGIC_NUMBER_BASE); }
+
     struct PKAssetStream
     {
         void* stream = nullptr;
@@ -599,6 +607,26 @@ namespace PKAssets
         uint32_t meshletCount;  // 32 bytes
     };
 
+    // A group of meshlets simplified together. Meshlets produced by the simplification share the group lod center & error.
+    // Children are the groups that produced the meshlets this group consumed. Leaf groups hold source meshlets with zero error.
+    struct alignas(4) PKMeshletGroup
+    {
+        float lodCenterError[4];    // 16 bytes
+        uint32_t meshletFirst;      // 20 bytes relative to the submesh first meshlet
+        uint32_t meshletCount;      // 24 bytes
+        uint32_t childFirst;        // 28 bytes index into group indices
+        uint32_t childCount;        // 32 bytes
+    };
+
+    // Group & child indices are relative to the submesh group first.
+    struct alignas(4) PKMeshletHierarchy
+    {
+        uint32_t groupFirst;        // 4  bytes
+        uint32_t groupCount;        // 8  bytes
+        uint32_t rootFirst;         // 12 bytes index into group indices
+        uint32_t rootCount;         // 16 bytes
+    };
+
     struct alignas(4) PKMeshletMesh
     {
         uint32_t triangleCount;                  // 4 bytes
@@ -609,6 +637,13 @@ namespace PKAssets
         RelativePtr<PKMeshletSubmesh> submeshes; // 24 bytes
         RelativePtr<PKMeshletVertex> vertices;   // 28 bytes
         RelativePtr<uint8_t> indices;            // 32 bytes
+
+        // Version 1. Group count is zero for meshes without a hierarchy.
+        uint32_t groupCount;                                // 36 bytes
+        uint32_t groupIndexCount;                           // 40 bytes
+        RelativePtr<PKMeshletHierarchy> hierarchies;        // 44 bytes one per submesh
+        RelativePtr<PKMeshletGroup> groups;                 // 48 bytes
+        RelativePtr<uint32_t> groupIndices;                 // 52 bytes
     };
 
     struct alignas(4) PKVertexAttribute
@@ -7,6 +7,10 @@
 #include "PKAssetLoader.h"
 #include "PKAssetEncoding.h"
 
+#if !defined(_WIN32)
+#define _fileno fileno
+#endif
+
 namespace PKAssets
 {
     FILE* OpenFile(const char* filepath, const char* option, size_t* size)
@@ -57,7 +61,7 @@ namespace PKAssets
         PKAssetHeader header;
         fread(&header, headerSize, 1, file);
 
-        if (header.magicNumber != PK_ASSET_MAGIC_NUMBER)
+        if (!IsValidAssetHeader(header))
         {
             fclose(file);
             return -1;
@@ -118,7 +122,7 @@ namespace PKAssets
 
         fread(&stream->header, headerSize, 1, file);
 
-        if (stream->header.magicNumber != PK_ASSET_MAGIC_NUMBER)
+        if (!IsValidAssetHeader(stream->header))
         {
             fclose(file);
             return -1;